@@ -0,0 +1,12 @@
+-- The memory budgets used by the debug memory report (Ctrl+M with the debug features).
+-- Values are in KiB. A missing or 0 value means there is no budget for the category.
+-- When at least one budget is set, the budgets are also checked at each game mode change,
+-- and a warning is printed for each exceeded one.
+
+memory_budgets = {
+    -- textures = 131072,
+    -- audio = 65536,
+    -- script = 32768,
+    -- map_objects = 8192,
+    -- particles = 4096,
+}
@@ -0,0 +1,6 @@
+function TestFunction()
+    print("Collision Benchmark");
+
+    local map_mode = vt_map.MapMode("data/story/layna_forest/layna_forest_crystal_map.lua", "data/debug/subscripts/collision_benchmark.lua");
+    ModeManager:Push(map_mode, true, true);
+end
@@ -0,0 +1,64 @@
+-- Set the namespace according to the map name.
+local ns = {};
+setmetatable(ns, {__index = _G});
+collision_benchmark = ns;
+setfenv(1, ns);
+
+-- The map name, subname and location image
+map_name = ""
+map_image_filename = ""
+map_subname = ""
+
+-- The music file used as default background music on this map.
+-- Other musics will have to handled through scripting.
+music_filename = "data/sounds/wind.ogg"
+
+-- c++ objects instances
+local Map = nil
+local EventManager = nil
+
+local bronann = nil
+
+-- the main map loading code
+function Load(m)
+
+    Map = m;
+    EventManager = Map:GetEventSupervisor();
+
+    Map:SetUnlimitedStamina(true)
+    Map:SetRunningEnabled(false) -- Hide the stamina bar
+
+    bronann = CreateSprite(Map, "Bronann", 32, 43, vt_map.MapMode.GROUND_OBJECT);
+    bronann:SetDirection(vt_map.MapMode.SOUTH);
+
+    _CreateCrowd();
+
+    -- Set the camera focus on Bronann
+    Map:SetCamera(bronann);
+
+    -- A scene map only
+    Map:PushState(vt_map.MapMode.STATE_SCENE);
+
+    -- Times the collision detection of the whole crowd, with and without the object grids.
+    Map:DEBUG_BenchmarkCollisions(20);
+end
+
+-- Fills the map with walking sprites and trees.
+function _CreateCrowd()
+    local sprite = nil
+    local index = 0
+
+    for x = 4, 112, 3 do
+        for y = 4, 96, 3 do
+            index = index + 1;
+            if (index % 4 == 0) then
+                CreateObject(Map, "Tree Small3", x, y, vt_map.MapMode.GROUND_OBJECT);
+            else
+                sprite = CreateSprite(Map, "Bronann", x, y, vt_map.MapMode.GROUND_OBJECT);
+                sprite:SetMovementSpeed(vt_map.MapMode.NORMAL_SPEED);
+                vt_map.RandomMoveSpriteEvent.Create("Random move " .. index, sprite, 1000, 2000);
+                EventManager:StartEvent("Random move " .. index, index % 2000);
+            end
+        end
+    end
+end
@@ -125,8 +125,11 @@ void BindCommonCode()
             .def("DoesEventExist", &GameGlobal::DoesEventExist)
             .def("AddNewEventGroup", &GameGlobal::AddNewEventGroup)
             .def("GetEventGroup", &GameGlobal::GetEventGroup)
-            .def("GetEventValue", &GameGlobal::GetEventValue)
-            .def("SetEventValue", &GameGlobal::SetEventValue)
+            .def("GetEventValue", (int32_t (GameGlobal:: *)(const std::string &, const std::string &) const) &GameGlobal::GetEventValue)
+            .def("SetEventValue", (void (GameGlobal:: *)(const std::string &, const std::string &, int32_t)) &GameGlobal::SetEventValue)
+            .def("GetEventHandle", &GameGlobal::GetEventHandle)
+            .def("GetEventValue", (int32_t (GameGlobal:: *)(const GlobalEventHandle &) const) &GameGlobal::GetEventValue)
+            .def("SetEventValue", (void (GameGlobal:: *)(const GlobalEventHandle &, int32_t)) &GameGlobal::SetEventValue)
             .def("GetNumberEventGroups", &GameGlobal::GetNumberEventGroups)
             .def("GetNumberEvents", &GameGlobal::GetNumberEvents)
             .def("SetMapDataFilename", (void(GameGlobal:: *)(const std::string &)) &GameGlobal::SetMapDataFilename)
@@ -335,6 +338,12 @@ void BindCommonCode()
             luabind::class_<GlobalEnemy, GlobalActor>("GlobalEnemy")
         ];
 
+        luabind::module(vt_script::ScriptManager->GetGlobalState(), "vt_global")
+        [
+            luabind::class_<GlobalEventHandle>("GlobalEventHandle")
+            .def("IsValid", &GlobalEventHandle::IsValid)
+        ];
+
         luabind::module(vt_script::ScriptManager->GetGlobalState(), "vt_global")
         [
             luabind::class_<GlobalObject>("GlobalObject")
@@ -12,9 +12,12 @@
 #include "global_attack_point.h"
 
 #include "common/global/global.h"
+#include "common/global/global_save_file.h"
 #include "common/global/objects/global_armor.h"
 #include "common/global/objects/global_weapon.h"
 
+#include "engine/virtual_file_system.h"
+
 #include "script/script_read.h"
 #include "utils/utils_files.h"
 
@@ -51,7 +54,7 @@ GlobalCharacter::GlobalCharacter(uint32_t id, bool initial) :
 
     // Load all the graphic data
     std::string portrait_filename = char_script.ReadString("portrait");
-    if(DoesFileExist(portrait_filename)) {
+    if(vt_system::FileSystemManager->DoesFileExist(portrait_filename)) {
         _portrait.Load(portrait_filename);
     }
     else if(!portrait_filename.empty()) {
@@ -60,7 +63,7 @@ GlobalCharacter::GlobalCharacter(uint32_t id, bool initial) :
     }
 
     std::string full_portrait_filename = char_script.ReadString("full_portrait");
-    if(DoesFileExist(full_portrait_filename)) {
+    if(vt_system::FileSystemManager->DoesFileExist(full_portrait_filename)) {
         _full_portrait.Load(full_portrait_filename);
     }
     else if(!full_portrait_filename.empty()) {
@@ -70,7 +73,7 @@ GlobalCharacter::GlobalCharacter(uint32_t id, bool initial) :
 
     std::string stamina_icon_filename = char_script.ReadString("stamina_icon");
     bool stamina_icon_loaded = false;
-    if(DoesFileExist(stamina_icon_filename)) {
+    if(vt_system::FileSystemManager->DoesFileExist(stamina_icon_filename)) {
         if(_stamina_icon.Load(stamina_icon_filename, 45.0f, 45.0f))
             stamina_icon_loaded = true;
     } else {
@@ -529,105 +532,144 @@ bool GlobalCharacter::LoadCharacter(ReadScriptDescriptor& file)
     return true;
 }
 
-bool GlobalCharacter::SaveCharacter(WriteScriptDescriptor& file)
+bool GlobalCharacter::LoadCharacter(SaveFileReader& file)
 {
-    if(!file.IsFileOpen()) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "the file provided in the function argument was not open" << std::endl;
-        return false;
+    Enable(file.ReadBool());
+
+    // Read in all of the character's stats data
+    SetExperienceLevel(file.ReadUInt32());
+    _unspent_experience_points = file.ReadUInt32();
+    SetTotalExperiencePoints(file.ReadUInt32());
+    _experience_for_next_level = file.ReadInt32();
+
+    SetMaxHitPoints(file.ReadUInt32());
+    SetHitPoints(file.ReadUInt32());
+    SetMaxSkillPoints(file.ReadUInt32());
+    SetSkillPoints(file.ReadUInt32());
+
+    SetPhysAtk(file.ReadUInt32());
+    SetMagAtk(file.ReadUInt32());
+    SetPhysDef(file.ReadUInt32());
+    SetMagDef(file.ReadUInt32());
+    SetStamina(file.ReadUInt32());
+    SetEvade(file.ReadFloat());
+
+    // Equip the objects on the character as long as valid equipment IDs were read
+    uint32_t equip_id = file.ReadUInt32();
+    if(equip_id != 0)
+        EquipWeapon(std::make_shared<GlobalWeapon>(equip_id));
+
+    equip_id = file.ReadUInt32();
+    if(equip_id != 0)
+        EquipHeadArmor(std::make_shared<GlobalArmor>(equip_id));
+
+    equip_id = file.ReadUInt32();
+    if(equip_id != 0)
+        EquipTorsoArmor(std::make_shared<GlobalArmor>(equip_id));
+
+    equip_id = file.ReadUInt32();
+    if(equip_id != 0)
+        EquipArmArmor(std::make_shared<GlobalArmor>(equip_id));
+
+    equip_id = file.ReadUInt32();
+    if(equip_id != 0)
+        EquipLegArmor(std::make_shared<GlobalArmor>(equip_id));
+
+    // The permanent skills
+    std::vector<uint32_t> skill_ids;
+    file.ReadUIntVector(skill_ids);
+    for(uint32_t i = 0; i < skill_ids.size(); ++i)
+        AddSkill(skill_ids[i]);
+
+    // The skill graph nodes obtained, and the current one.
+    ResetObtainedSkillNodes();
+    std::vector<uint32_t> skill_node_ids;
+    file.ReadUIntVector(skill_node_ids);
+    SetObtainedSkillNodes(skill_node_ids);
+    SetSkillNodeLocation(file.ReadUInt32());
+
+    // The active status effects: effect, intensity, duration and elapsed time.
+    ResetActiveStatusEffects();
+    uint32_t status_effects_count = file.ReadUInt32();
+    for(uint32_t i = 0; i < status_effects_count; ++i) {
+        int32_t status_effect = file.ReadInt32();
+        int32_t intensity = file.ReadInt32();
+        uint32_t duration = file.ReadUInt32();
+        uint32_t elapsed_time = file.ReadUInt32();
+
+        if (status_effect <= (int32_t)GLOBAL_STATUS_INVALID || status_effect >= (int32_t)GLOBAL_STATUS_TOTAL)
+            continue;
+        if (intensity <= GLOBAL_INTENSITY_INVALID || intensity >= GLOBAL_INTENSITY_TOTAL)
+            continue;
+
+        SetActiveStatusEffect((GLOBAL_STATUS)status_effect,
+                              (GLOBAL_INTENSITY)intensity,
+                              duration, elapsed_time);
     }
 
-    file.WriteLine("\t[" + NumberToString(GetID()) + "] = {");
+    if (file.IsErrorDetected()) {
+        PRINT_WARNING << "Invalid character data for id: " << _id
+                      << " in save file: " << file.GetFilename() << std::endl;
+        return false;
+    }
+    return true;
+}
 
-    // Store whether the character is available
-    file.WriteLine("\t\tenabled = " + std::string(IsEnabled() ? "true" : "false") + ",");
+void GlobalCharacter::SaveCharacter(SaveFileWriter& file)
+{
+    file.WriteBool(IsEnabled());
 
     // Write out the character's stats
-    file.WriteLine("\t\texperience_level = " + NumberToString(GetExperienceLevel()) + ",");
-    file.WriteLine("\t\tunspent_experience_points = " + NumberToString(GetUnspentExperiencePoints()) + ", ");
-    file.WriteLine("\t\ttotal_experience_points = " + NumberToString(GetTotalExperiencePoints()) + ",");
-    file.WriteLine("\t\texperience_points_next = " + NumberToString(GetExperienceForNextLevel()) + ", ");
+    file.WriteUInt32(GetExperienceLevel());
+    file.WriteUInt32(GetUnspentExperiencePoints());
+    file.WriteUInt32(GetTotalExperiencePoints());
+    file.WriteInt32(GetExperienceForNextLevel());
 
     // The values stored are the unmodified ones.
-    file.WriteLine("\t\tmax_hit_points = " + NumberToString(GetMaxHitPoints()) + ",");
-    file.WriteLine("\t\thit_points = " + NumberToString(GetHitPoints()) + ",");
-    file.WriteLine("\t\tmax_skill_points = " + NumberToString(GetMaxSkillPoints()) + ",");
-    file.WriteLine("\t\tskill_points = " + NumberToString(GetSkillPoints()) + ",");
-
-    file.WriteLine("\t\tphys_atk = " + NumberToString(GetPhysAtkBase()) + ",");
-    file.WriteLine("\t\tmag_atk = " + NumberToString(GetMagAtkBase()) + ",");
-    file.WriteLine("\t\tphys_def = " + NumberToString(GetPhysDefBase()) + ",");
-    file.WriteLine("\t\tmag_def = " + NumberToString(GetMagDefBase()) + ",");
-    file.WriteLine("\t\tstamina = " + NumberToString(GetStaminaBase()) + ",");
-    file.WriteLine("\t\tevade = " + NumberToString(GetEvadeBase()) + ",");
+    file.WriteUInt32(GetMaxHitPoints());
+    file.WriteUInt32(GetHitPoints());
+    file.WriteUInt32(GetMaxSkillPoints());
+    file.WriteUInt32(GetSkillPoints());
+
+    file.WriteUInt32(GetPhysAtkBase());
+    file.WriteUInt32(GetMagAtkBase());
+    file.WriteUInt32(GetPhysDefBase());
+    file.WriteUInt32(GetMagDefBase());
+    file.WriteUInt32(GetStaminaBase());
+    file.WriteFloat(GetEvadeBase());
 
     // Write out the character's equipment
-    uint32_t weapon_id = GetWeaponEquipped() ? GetWeaponEquipped()->GetID() : 0;
-    uint32_t head_id = GetHeadArmorEquipped() ? GetHeadArmorEquipped()->GetID() : 0;
-    uint32_t torso_id = GetTorsoArmorEquipped() ? GetTorsoArmorEquipped()->GetID() : 0;
-    uint32_t arm_id = GetArmArmorEquipped() ? GetArmArmorEquipped()->GetID() : 0;
-    uint32_t leg_id = GetLegArmorEquipped() ? GetLegArmorEquipped()->GetID() : 0;
-
-    file.InsertNewLine();
-    file.WriteLine("\t\tequipment = {");
-    file.WriteLine("\t\t\tweapon = " + NumberToString(weapon_id) + ",");
-    file.WriteLine("\t\t\thead_armor = " + NumberToString(head_id) + ",");
-    file.WriteLine("\t\t\ttorso_armor = " + NumberToString(torso_id) + ",");
-    file.WriteLine("\t\t\tarm_armor = " + NumberToString(arm_id) + ",");
-    file.WriteLine("\t\t\tleg_armor = " + NumberToString(leg_id));
-    file.WriteLine("\t\t},");
+    file.WriteUInt32(GetWeaponEquipped() ? GetWeaponEquipped()->GetID() : 0);
+    file.WriteUInt32(GetHeadArmorEquipped() ? GetHeadArmorEquipped()->GetID() : 0);
+    file.WriteUInt32(GetTorsoArmorEquipped() ? GetTorsoArmorEquipped()->GetID() : 0);
+    file.WriteUInt32(GetArmArmorEquipped() ? GetArmArmorEquipped()->GetID() : 0);
+    file.WriteUInt32(GetLegArmorEquipped() ? GetLegArmorEquipped()->GetID() : 0);
 
     // Write out the character's permanent skills.
     // The equipment skills will be reloaded through equipment.
-    file.InsertNewLine();
-    file.WriteLine("\t\tskills = {");
-    const std::vector<uint32_t>& skill_vector = GetPermanentSkills();
-    for(uint32_t i = 0; i < skill_vector.size(); i++) {
-        uint32_t skill_id = skill_vector.at(i);
-
-        if(i == 0)
-            file.WriteLine("\t\t\t", false);
-        else
-            file.WriteLine(", ", false);
-        file.WriteLine(NumberToString(skill_id), false);
-    }
-    file.WriteLine("\n\t\t},");
+    file.WriteUIntVector(GetPermanentSkills());
 
-    // Write out the character's obtained skill nodes.
-    file.InsertNewLine();
-    file.WriteLine("\t\tobtained_skill_nodes = {");
-    const std::vector<uint32_t>& skill_nodes = GetObtainedSkillNodes();
-    for(uint32_t i = 0; i < skill_nodes.size(); i++) {
-        uint32_t skill_node = skill_nodes.at(i);
+    file.WriteUIntVector(GetObtainedSkillNodes());
+    file.WriteUInt32(GetSkillNodeLocation());
 
-        if(i == 0)
-            file.WriteLine("\t\t\t", false);
-        else
-            file.WriteLine(", ", false);
-        bool newline = (i > 0) && !(i % 10);
-        file.WriteLine(NumberToString(skill_node), newline);
+    // Writes active status effects at the time of the save
+    uint32_t status_effects_count = 0;
+    for(uint32_t i = 0; i < _active_status_effects.size(); ++i) {
+        if (_active_status_effects[i].IsActive())
+            ++status_effects_count;
     }
-    file.WriteLine("\n\t\t},");
-    file.WriteLine("\t\tcurrent_skill_node = " + NumberToString(GetSkillNodeLocation()) + ",");
+    file.WriteUInt32(status_effects_count);
 
-    // Writes active status effects at the time of the save
-    file.InsertNewLine();
-    file.WriteLine("\t\tactive_status_effects = {");
     for(uint32_t i = 0; i < _active_status_effects.size(); ++i) {
-        const ActiveStatusEffect& effect = _active_status_effects.at(i);
+        const ActiveStatusEffect& effect = _active_status_effects[i];
         if (!effect.IsActive())
             continue;
 
-        std::string effect_str = "\t\t\t[" + NumberToString((int32_t)effect.GetEffect()) + "] = { ";
-        effect_str += "intensity = " + NumberToString((int32_t)effect.GetIntensity()) + ", ";
-        effect_str += "duration = " + NumberToString((int32_t)effect.GetEffectTime()) + ", ";
-        effect_str += "elapsed_time = " + NumberToString((int32_t)effect.GetElapsedTime()) + "},";
-
-        file.WriteLine(effect_str);
+        file.WriteInt32(effect.GetEffect());
+        file.WriteInt32(effect.GetIntensity());
+        file.WriteUInt32(effect.GetEffectTime());
+        file.WriteUInt32(effect.GetElapsedTime());
     }
-    file.WriteLine("\n\t\t}");
-
-    file.WriteLine("\t},");
-    return true;
 }
 
 bool GlobalCharacter::AddExperiencePoints(uint32_t xp)
@@ -17,7 +17,6 @@
 
 namespace vt_script {
 class ReadScriptDescriptor;
-class WriteScriptDescriptor;
 }
 
 namespace vt_global
@@ -25,6 +24,8 @@ namespace vt_global
 
 class GlobalArmor;
 class GlobalWeapon;
+class SaveFileReader;
+class SaveFileWriter;
 
 /** ****************************************************************************
 *** \brief Represents a playable game character
@@ -49,17 +50,23 @@ public:
     explicit GlobalCharacter(uint32_t id, bool initial = true);
     virtual ~GlobalCharacter() override;
 
-    /** \brief Loads character data from a saved game file and id key.
+    /** \brief Loads character data from a former Lua saved game file and id key.
     *** \param file A reference to the open and valid file from where to read the character from
     *** \returns Whether the character was successfully loaded.
     **/
     bool LoadCharacter(vt_script::ReadScriptDescriptor& file);
 
+    /** \brief Loads character data from the character record of a binary saved game file.
+    *** \param file The save file, with the character record open and its id already read.
+    *** \returns Whether the character was successfully loaded.
+    **/
+    bool LoadCharacter(SaveFileReader& file);
+
     /** \brief Writes character data to the saved game file
-    *** \param file A reference to the open and valid file where to write the character data
-    *** \returns Whether the character could successfully be saved to the save file.
+    *** \param file The save file, with the character record started and its id already written.
+    *** \note New fields must only be added at the end, to keep reading the older saves.
     **/
-    bool SaveCharacter(vt_script::WriteScriptDescriptor& file);
+    void SaveCharacter(SaveFileWriter& file);
 
     //! \brief Tells whether a character is in the visible game formation
     void Enable(bool enable) {
@@ -47,6 +47,8 @@ bool GLOBAL_DEBUG = false;
 
 GameGlobal::GameGlobal() :
     _game_slot_id(0),
+    _save_task(nullptr),
+    _last_save_succeeded(false),
     _drunes(0),
     _max_experience_level(100),
     _x_save_map_position(0),
@@ -64,21 +66,42 @@ GameGlobal::~GameGlobal()
 {
     IF_PRINT_DEBUG(GLOBAL_DEBUG) << "GameGlobal destructor invoked" << std::endl;
 
+    // Don't quit while a save is being written.
+    WaitForSaveGame();
+
     ClearAllData();
 
     _CloseGlobalScripts();
 }
 
 bool GameGlobal::SingletonInitialize()
+{
+    for(uint32_t i = 0; i < GLOBAL_INIT_TOTAL; ++i) {
+        if(!InitializeStep(static_cast<GLOBAL_INIT_STEP>(i)))
+            return false;
+    }
+    return true;
+}
+
+bool GameGlobal::InitializeStep(GLOBAL_INIT_STEP step)
 {
     // Init the media files.
-    _global_media.Initialize();
-    _battle_media.Initialize();
+    if(step == GLOBAL_INIT_MEDIA) {
+        _global_media.Initialize();
+        return true;
+    }
+    if(step == GLOBAL_INIT_BATTLE_MEDIA) {
+        _battle_media.Initialize();
+        return true;
+    }
 
-    return _LoadGlobalScripts();
+    return _LoadGlobalScripts(step);
 }
 
 void GameGlobal::_CloseGlobalScripts() {
+    // The objects definitions are read from the scripts below, and hold references to their functions.
+    _object_registry.Clear();
+
     // Close all persistent script files
     _global_script.CloseFile();
 
@@ -131,85 +154,100 @@ void GameGlobal::_CloseGlobalScripts() {
 
 bool GameGlobal::_LoadGlobalScripts()
 {
-    // Open up the persistent script files
-    if(!_global_script.OpenFile("data/global.lua"))
-        return false;
+    for(uint32_t i = GLOBAL_INIT_INVENTORY; i < GLOBAL_INIT_TOTAL; ++i) {
+        if(!_LoadGlobalScripts(static_cast<GLOBAL_INIT_STEP>(i)))
+            return false;
+    }
+    return true;
+}
 
-    if(!_items_script.OpenFile("data/inventory/items.lua") || !_items_script.OpenTable("items"))
-        return false;
+bool GameGlobal::_LoadGlobalScripts(GLOBAL_INIT_STEP step)
+{
+    switch(step) {
+    case GLOBAL_INIT_INVENTORY:
+        // Open up the persistent script files
+        if(!_global_script.OpenFile("data/global.lua"))
+            return false;
 
-    if(!_weapons_script.OpenFile("data/inventory/weapons.lua") || !_weapons_script.OpenTable("weapons"))
-        return false;
+        if(!_items_script.OpenFile("data/inventory/items.lua") || !_items_script.OpenTable("items"))
+            return false;
 
-    if(!_head_armor_script.OpenFile("data/inventory/head_armor.lua") || !_head_armor_script.OpenTable("armor"))
-        return false;
+        if(!_weapons_script.OpenFile("data/inventory/weapons.lua") || !_weapons_script.OpenTable("weapons"))
+            return false;
 
-    if(!_torso_armor_script.OpenFile("data/inventory/torso_armor.lua") || !_torso_armor_script.OpenTable("armor"))
-        return false;
+        if(!_head_armor_script.OpenFile("data/inventory/head_armor.lua") || !_head_armor_script.OpenTable("armor"))
+            return false;
 
-    if(!_arm_armor_script.OpenFile("data/inventory/arm_armor.lua") || !_arm_armor_script.OpenTable("armor"))
-        return false;
+        if(!_torso_armor_script.OpenFile("data/inventory/torso_armor.lua") || !_torso_armor_script.OpenTable("armor"))
+            return false;
 
-    if(!_leg_armor_script.OpenFile("data/inventory/leg_armor.lua") || !_leg_armor_script.OpenTable("armor"))
-        return false;
+        if(!_arm_armor_script.OpenFile("data/inventory/arm_armor.lua") || !_arm_armor_script.OpenTable("armor"))
+            return false;
 
-    if(!_spirits_script.OpenFile("data/inventory/spirits.lua") || !_spirits_script.OpenTable("spirits"))
-        return false;
+        if(!_leg_armor_script.OpenFile("data/inventory/leg_armor.lua") || !_leg_armor_script.OpenTable("armor"))
+            return false;
 
-    if(!_weapon_skills_script.OpenFile("data/skills/weapon.lua") || !_weapon_skills_script.OpenTable("skills"))
-        return false;
+        if(!_spirits_script.OpenFile("data/inventory/spirits.lua") || !_spirits_script.OpenTable("spirits"))
+            return false;
+        return true;
 
-    if(!_magic_skills_script.OpenFile("data/skills/magic.lua") || !_magic_skills_script.OpenTable("skills"))
-       return false;
+    case GLOBAL_INIT_SKILLS:
+        if(!_weapon_skills_script.OpenFile("data/skills/weapon.lua") || !_weapon_skills_script.OpenTable("skills"))
+            return false;
 
-    if(!_special_skills_script.OpenFile("data/skills/special.lua") || !_special_skills_script.OpenTable("skills"))
-        return false;
+        if(!_magic_skills_script.OpenFile("data/skills/magic.lua") || !_magic_skills_script.OpenTable("skills"))
+           return false;
 
-    if(!_bare_hands_skills_script.OpenFile("data/skills/barehands.lua") || !_bare_hands_skills_script.OpenTable("skills"))
-        return false;
+        if(!_special_skills_script.OpenFile("data/skills/special.lua") || !_special_skills_script.OpenTable("skills"))
+            return false;
 
-    if(!_status_effects_script.OpenFile("data/entities/status_effects/status_effects.lua") || !_status_effects_script.OpenTable("status_effects"))
-        return false;
+        if(!_bare_hands_skills_script.OpenFile("data/skills/barehands.lua") || !_bare_hands_skills_script.OpenTable("skills"))
+            return false;
+        return true;
 
-    if(!_characters_script.OpenFile("data/entities/characters.lua") || !_characters_script.OpenTable("characters"))
-        return false;
+    case GLOBAL_INIT_ENTITIES:
+        if(!_status_effects_script.OpenFile("data/entities/status_effects/status_effects.lua") || !_status_effects_script.OpenTable("status_effects"))
+            return false;
 
-    if(!_enemies_script.OpenFile("data/entities/enemies.lua") || !_enemies_script.OpenTable("enemies"))
-        return false;
+        if(!_characters_script.OpenFile("data/entities/characters.lua") || !_characters_script.OpenTable("characters"))
+            return false;
 
-    if(!_map_sprites_script.OpenFile("data/entities/map_sprites.lua") || !_map_sprites_script.OpenTable("sprites"))
-        return false;
+        if(!_enemies_script.OpenFile("data/entities/enemies.lua") || !_enemies_script.OpenTable("enemies"))
+            return false;
 
-    if(!_map_objects_script.OpenFile("data/entities/map_objects.lua"))
-        return false;
+        if(!_map_sprites_script.OpenFile("data/entities/map_sprites.lua") || !_map_sprites_script.OpenTable("sprites"))
+            return false;
 
-    if(!_map_treasures_script.OpenFile("data/entities/map_treasures.lua"))
-        return false;
+        if(!_map_objects_script.OpenFile("data/entities/map_objects.lua"))
+            return false;
 
-    // Reload the Quests script
-    if(!_LoadQuestsScript("data/config/quests.lua"))
-        return false;
+        if(!_map_treasures_script.OpenFile("data/entities/map_treasures.lua"))
+            return false;
+        return true;
 
-    if(!_LoadWorldLocationsScript("data/config/world_locations.lua"))
-        return false;
+    case GLOBAL_INIT_CONFIG:
+        // Reload the Quests script
+        if(!_LoadQuestsScript("data/config/quests.lua"))
+            return false;
 
-    if (!_skill_graph.Initialize("data/config/skill_graph.lua"))
-        return false;
+        if(!_LoadWorldLocationsScript("data/config/world_locations.lua"))
+            return false;
 
-    return true;
+        if (!_skill_graph.Initialize("data/config/skill_graph.lua"))
+            return false;
+        return true;
+
+    default:
+        break;
+    }
+
+    PRINT_WARNING << "Invalid global scripts initialization step: " << step << std::endl;
+    return false;
 }
 
 void GameGlobal::ClearAllData()
 {
-    _inventory.clear();
-    _inventory_items.clear();
-    _inventory_weapons.clear();
-    _inventory_head_armor.clear();
-    _inventory_torso_armor.clear();
-    _inventory_arm_armor.clear();
-    _inventory_leg_armor.clear();
-    _inventory_spirits.clear();
-    _inventory_key_items.clear();
+    _inventory.Clear();
 
     // Delete all characters
     for(std::map<uint32_t, GlobalCharacter *>::iterator it = _characters.begin(); it != _characters.end(); ++it) {
@@ -224,6 +262,7 @@ void GameGlobal::ClearAllData()
         delete(it->second);
     }
     _event_groups.clear();
+    _event_groups_by_id.clear();
 
     // Clear the quest log
     for(std::map<std::string, QuestLogEntry *>::iterator itr = _quest_log_entries.begin(); itr != _quest_log_entries.end(); ++itr)
@@ -412,58 +451,13 @@ void GameGlobal::AddToInventory(uint32_t obj_id, uint32_t obj_count)
         return;
 
     // If the object is already in the inventory, increment the count of the object.
-    if (_inventory.find(obj_id) != _inventory.end()) {
-        _inventory[obj_id]->IncrementCount(obj_count);
+    if (_inventory.IncrementCount(obj_id, obj_count))
         return;
-    }
 
     // Otherwise, create a new object instance and add it to the inventory.
-    std::shared_ptr<GlobalObject> new_object = nullptr;
-    if ((obj_id > 0 && obj_id <= MAX_ITEM_ID) ||
-        (obj_id > MAX_SPIRIT_ID && obj_id <= MAX_KEY_ITEM_ID)) {
-        auto new_item = std::make_shared<GlobalItem>(obj_id, obj_count);
-        new_object = new_item;
-        _inventory.insert(std::make_pair(obj_id, new_object));
-        _inventory_items.push_back(new_item);
-    } else if ((obj_id > MAX_ITEM_ID) && (obj_id <= MAX_WEAPON_ID)) {
-        auto new_wpn = std::make_shared<GlobalWeapon>(obj_id, obj_count);
-        new_object = new_wpn;
-        _inventory.insert(std::make_pair(obj_id, new_wpn));
-        _inventory_weapons.push_back(new_wpn);
-    } else if ((obj_id > MAX_WEAPON_ID) && (obj_id <= MAX_HEAD_ARMOR_ID)) {
-        auto new_arm = std::make_shared<GlobalArmor>(obj_id, obj_count);
-        new_object = new_arm;
-        _inventory.insert(std::make_pair(obj_id, new_arm));
-        _inventory_head_armor.push_back(new_arm);
-    } else if ((obj_id > MAX_HEAD_ARMOR_ID) && (obj_id <= MAX_TORSO_ARMOR_ID)) {
-        auto new_arm = std::make_shared<GlobalArmor>(obj_id, obj_count);
-        new_object = new_arm;
-        _inventory.insert(std::make_pair(obj_id, new_arm));
-        _inventory_torso_armor.push_back(new_arm);
-    } else if ((obj_id > MAX_TORSO_ARMOR_ID) && (obj_id <= MAX_ARM_ARMOR_ID)) {
-        auto new_arm = std::make_shared<GlobalArmor>(obj_id, obj_count);
-        new_object = new_arm;
-        _inventory.insert(std::make_pair(obj_id, new_arm));
-        _inventory_arm_armor.push_back(new_arm);
-    } else if ((obj_id > MAX_ARM_ARMOR_ID) && (obj_id <= MAX_LEG_ARMOR_ID)) {
-        auto new_arm = std::make_shared<GlobalArmor>(obj_id, obj_count);
-        new_object = new_arm;
-        _inventory.insert(std::make_pair(obj_id, new_arm));
-        _inventory_leg_armor.push_back(new_arm);
-    } else if ((obj_id > MAX_LEG_ARMOR_ID) && (obj_id <= MAX_SPIRIT_ID)) {
-        auto new_spirit = std::make_shared<GlobalSpirit>(obj_id, obj_count);
-        new_object = new_spirit;
-        _inventory.insert(std::make_pair(obj_id, new_spirit));
-        _inventory_spirits.push_back(new_spirit);
-    } else {
+    std::shared_ptr<GlobalObject> new_object = GlobalCreateNewObject(obj_id, obj_count);
+    if (new_object == nullptr || !_inventory.AddObject(new_object))
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to add invalid object to inventory with id: " << obj_id << std::endl;
-    }
-
-    // Update the key items list.
-    if (new_object != nullptr &&
-        new_object->IsKeyItem()) {
-        _inventory_key_items.push_back(new_object);
-    }
 }
 
 void GameGlobal::AddToInventory(const std::shared_ptr<GlobalObject>& object)
@@ -473,185 +467,49 @@ void GameGlobal::AddToInventory(const std::shared_ptr<GlobalObject>& object)
         return;
     }
 
-    uint32_t obj_id = object->GetID();
-    uint32_t obj_count = object->GetCount();
-
     // Don't add object instance without at least one actual item.
-    if (obj_count == 0) {
-        return;
-    }
-
-    // If an instance of the same object is already inside the inventory, just increment the count.
-    if (_inventory.find(obj_id) != _inventory.end()) {
-        _inventory[obj_id]->IncrementCount(obj_count);
+    if (object->GetCount() == 0)
         return;
-    }
-
-    // Figure out which type of object this is, cast it to the correct type, and add it to the inventory
-    if((obj_id > 0 && obj_id <= MAX_ITEM_ID) ||
-       (obj_id > MAX_SPIRIT_ID && obj_id <= MAX_KEY_ITEM_ID)) {
-        auto new_obj = std::dynamic_pointer_cast<GlobalItem>(object);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_items.push_back(new_obj);
-    } else if((obj_id > MAX_ITEM_ID) && (obj_id <= MAX_WEAPON_ID)) {
-        auto new_obj = std::dynamic_pointer_cast<GlobalWeapon>(object);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_weapons.push_back(new_obj);
-    } else if((obj_id > MAX_WEAPON_ID) && (obj_id <= MAX_HEAD_ARMOR_ID)) {
-        auto new_obj = std::dynamic_pointer_cast<GlobalArmor>(object);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_head_armor.push_back(new_obj);
-    } else if((obj_id > MAX_HEAD_ARMOR_ID) && (obj_id <= MAX_TORSO_ARMOR_ID)) {
-        auto new_obj = std::dynamic_pointer_cast<GlobalArmor>(object);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_torso_armor.push_back(new_obj);
-    } else if((obj_id > MAX_TORSO_ARMOR_ID) && (obj_id <= MAX_ARM_ARMOR_ID)) {
-        auto new_obj = std::dynamic_pointer_cast<GlobalArmor>(object);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_arm_armor.push_back(new_obj);
-    } else if((obj_id > MAX_ARM_ARMOR_ID) && (obj_id <= MAX_LEG_ARMOR_ID)) {
-        auto new_obj = std::dynamic_pointer_cast<GlobalArmor>(object);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_leg_armor.push_back(new_obj);
-    } else if((obj_id > MAX_LEG_ARMOR_ID) && (obj_id <= MAX_SPIRIT_ID)) {
-        auto new_obj = std::dynamic_pointer_cast<GlobalSpirit>(object);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_spirits.push_back(new_obj);
-    } else {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to add invalid object to inventory with id: " << obj_id << std::endl;
-        return;
-    }
 
-    // Updates the key items list.
-    if (object->IsKeyItem()) {
-        _inventory_key_items.push_back(object);
-    }
+    // If an instance of the same object is already inside the inventory, the count is incremented.
+    if (!_inventory.AddObject(object))
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to add invalid object to inventory with id: " << object->GetID() << std::endl;
 }
 
 void GameGlobal::RemoveFromInventory(uint32_t obj_id)
 {
-    auto it = _inventory.find(obj_id);
-    if (it == _inventory.end()) {
+    if (!_inventory.RemoveObject(obj_id))
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to remove an object from inventory that didn't exist with id: " << obj_id << std::endl;
-        return;
-    }
-
-    // Check whether the item is a key item to remove.
-    auto object = it->second;
-    if (object != nullptr && object->IsKeyItem()) {
-        for (auto it2 = _inventory_key_items.begin(); it2 != _inventory_key_items.end(); ++it2) {
-
-            if ((*it2)->GetID() != obj_id)
-                continue;
-
-            _inventory_key_items.erase(it2);
-            break;
-        }
-    }
-
-    // Use the id value to figure out what type of object it is, and remove it from the object vector
-    if((obj_id > 0 && obj_id <= MAX_ITEM_ID) ||
-       (obj_id > MAX_SPIRIT_ID && obj_id <= MAX_KEY_ITEM_ID)) {
-        if(_RemoveFromInventory(obj_id, _inventory_items) == false)
-            IF_PRINT_WARNING(GLOBAL_DEBUG) << "object to remove was not found in inventory items: " << obj_id << std::endl;
-    } else if((obj_id > MAX_ITEM_ID) && (obj_id <= MAX_WEAPON_ID)) {
-        if(_RemoveFromInventory(obj_id, _inventory_weapons) == false)
-            IF_PRINT_WARNING(GLOBAL_DEBUG) << "object to remove was not found in inventory weapons: " << obj_id << std::endl;
-    } else if((obj_id > MAX_WEAPON_ID) && (obj_id <= MAX_HEAD_ARMOR_ID)) {
-        if(_RemoveFromInventory(obj_id, _inventory_head_armor) == false)
-            IF_PRINT_WARNING(GLOBAL_DEBUG) << "object to remove was not found in inventory head armor: " << obj_id << std::endl;
-    } else if((obj_id > MAX_HEAD_ARMOR_ID) && (obj_id <= MAX_TORSO_ARMOR_ID)) {
-        if(_RemoveFromInventory(obj_id, _inventory_torso_armor) == false)
-            IF_PRINT_WARNING(GLOBAL_DEBUG) << "object to remove was not found in inventory torso armor: " << obj_id << std::endl;
-    } else if((obj_id > MAX_TORSO_ARMOR_ID) && (obj_id <= MAX_ARM_ARMOR_ID)) {
-        if(_RemoveFromInventory(obj_id, _inventory_arm_armor) == false)
-            IF_PRINT_WARNING(GLOBAL_DEBUG) << "object to remove was not found in inventory arm armor: " << obj_id << std::endl;
-    } else if((obj_id > MAX_ARM_ARMOR_ID) && (obj_id <= MAX_LEG_ARMOR_ID)) {
-        if(_RemoveFromInventory(obj_id, _inventory_leg_armor) == false)
-            IF_PRINT_WARNING(GLOBAL_DEBUG) << "object to remove was not found in inventory leg armor: " << obj_id << std::endl;
-    } else if((obj_id > MAX_LEG_ARMOR_ID) && (obj_id <= MAX_SPIRIT_ID)) {
-        if(_RemoveFromInventory(obj_id, _inventory_spirits) == false)
-            IF_PRINT_WARNING(GLOBAL_DEBUG) << "object to remove was not found in inventory spirits: " << obj_id << std::endl;
-    } else {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to remove an object from inventory with an invalid id: " << obj_id << std::endl;
-    }
 }
 
 std::shared_ptr<GlobalObject> GameGlobal::GetGlobalObject(uint32_t obj_id)
 {
-    if (_inventory.find(obj_id) == _inventory.end()) {
+    if (!_inventory.HasObject(obj_id)) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to retrieve an object from inventory that didn't exist with id: " << obj_id << std::endl;
         return nullptr;
     }
 
-    std::shared_ptr<GlobalObject> return_object = nullptr;
-    // Use the id value to figure out what type of object it is, and remove it from the object vector
-    if((obj_id > 0 && obj_id <= MAX_ITEM_ID) ||
-       (obj_id > MAX_SPIRIT_ID && obj_id <= MAX_KEY_ITEM_ID)) {
-        return_object = _GetFromInventory(obj_id, _inventory_items);
-        if(return_object == nullptr)
-            IF_PRINT_WARNING(GLOBAL_DEBUG) << "object to retrieve was not found in inventory items: " << obj_id << std::endl;
-    } else if((obj_id > MAX_ITEM_ID) && (obj_id <= MAX_WEAPON_ID)) {
-        return_object = _GetFromInventory(obj_id, _inventory_weapons);
-        if(return_object == nullptr)
-            IF_PRINT_WARNING(GLOBAL_DEBUG) << "object to retrieve was not found in inventory weapons: " << obj_id << std::endl;
-    } else if((obj_id > MAX_WEAPON_ID) && (obj_id <= MAX_HEAD_ARMOR_ID)) {
-        return_object = _GetFromInventory(obj_id, _inventory_head_armor);
-        if(return_object == nullptr)
-            IF_PRINT_WARNING(GLOBAL_DEBUG) << "object to retrieve was not found in inventory head armor: " << obj_id << std::endl;
-    } else if((obj_id > MAX_HEAD_ARMOR_ID) && (obj_id <= MAX_TORSO_ARMOR_ID)) {
-        return_object = _GetFromInventory(obj_id, _inventory_torso_armor);
-        if(return_object == nullptr)
-            IF_PRINT_WARNING(GLOBAL_DEBUG) << "object to retrieve was not found in inventory torso armor: " << obj_id << std::endl;
-    } else if((obj_id > MAX_TORSO_ARMOR_ID) && (obj_id <= MAX_ARM_ARMOR_ID)) {
-        return_object = _GetFromInventory(obj_id, _inventory_arm_armor);
-        if(return_object == nullptr)
-            IF_PRINT_WARNING(GLOBAL_DEBUG) << "object to retrieve was not found in inventory arm armor: " << obj_id << std::endl;
-    } else if((obj_id > MAX_ARM_ARMOR_ID) && (obj_id <= MAX_LEG_ARMOR_ID)) {
-        return_object = _GetFromInventory(obj_id, _inventory_leg_armor);
-        if(return_object == nullptr)
-            IF_PRINT_WARNING(GLOBAL_DEBUG) << "object to retrieve was not found in inventory leg armor: " << obj_id << std::endl;
-    } else if((obj_id > MAX_LEG_ARMOR_ID) && (obj_id <= MAX_SPIRIT_ID)) {
-        return_object = _GetFromInventory(obj_id, _inventory_spirits);
-        if(return_object == nullptr)
-            IF_PRINT_WARNING(GLOBAL_DEBUG) << "object to retrieve was not found in inventory spirits: " << obj_id << std::endl;
-    } else {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to retrieve an object from inventory with an invalid id: " << obj_id << std::endl;
-    }
-
-    return return_object;
+    // The copy shares the object definition.
+    return GlobalCreateNewObject(obj_id, 1);
 }
 
 void GameGlobal::IncrementItemCount(uint32_t obj_id, uint32_t count)
 {
     // Do nothing if the item does not exist in the inventory
-    if(_inventory.find(obj_id) == _inventory.end()) {
+    if (!_inventory.IncrementCount(obj_id, count))
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to increment count for an object that was not present in the inventory: " << obj_id << std::endl;
-        return;
-    }
-
-    _inventory[obj_id]->IncrementCount(count);
 }
 
 void GameGlobal::DecrementItemCount(uint32_t obj_id, uint32_t count)
 {
-    // Do nothing if the item does not exist in the inventory
-    if(_inventory.find(obj_id) == _inventory.end()) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to decrement count for an object that was not present in the inventory: " << obj_id << std::endl;
-        return;
-    }
-
     // Print a warning if the amount to decrement by exceeds the object's current count
-    if(count > _inventory[obj_id]->GetCount()) {
+    if (count > _inventory.GetObjectCount(obj_id) && _inventory.HasObject(obj_id)) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "amount to decrement count by exceeded available count: " << obj_id << std::endl;
     }
 
-    // Decrement the number of objects so long as the number to decrement by does not equal or exceed the count
-    if(count < _inventory[obj_id]->GetCount())
-        _inventory[obj_id]->DecrementCount(count);
-    // Otherwise remove the object from the inventory completely
-    else
-        RemoveFromInventory(obj_id);
+    // The object is removed from the inventory when the count reaches zero.
+    if (!_inventory.DecrementCount(obj_id, count))
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to decrement count for an object that was not present in the inventory: " << obj_id << std::endl;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -660,15 +518,11 @@ void GameGlobal::DecrementItemCount(uint32_t obj_id, uint32_t count)
 
 bool GameGlobal::DoesEventExist(const std::string &group_name, const std::string &event_name) const
 {
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
-    if(group_iter == _event_groups.end())
-        return false;
-
-    std::map<std::string, int32_t>::const_iterator event_iter = group_iter->second->GetEvents().find(event_name);
-    if(event_iter == group_iter->second->GetEvents().end())
+    GlobalEventGroup* group = _GetEventGroup(EventNameTable::Find(group_name));
+    if(group == nullptr)
         return false;
 
-    return true;
+    return group->DoesEventExist(event_name);
 }
 
 
@@ -681,59 +535,97 @@ void GameGlobal::AddNewEventGroup(const std::string &group_name)
         return;
     }
 
-    GlobalEventGroup *geg = new GlobalEventGroup(group_name);
-    _event_groups.insert(std::make_pair(group_name, geg));
+    _CreateEventGroup(group_name);
 }
 
 
 
 GlobalEventGroup *GameGlobal::GetEventGroup(const std::string &group_name) const
 {
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
-    if(group_iter == _event_groups.end()) {
+    GlobalEventGroup* group = _GetEventGroup(EventNameTable::Find(group_name));
+    if(group == nullptr) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "could not find any event group by the requested name: " << group_name << std::endl;
         return nullptr;
     }
-    return (group_iter->second);
+    return group;
 }
 
 
 
 int32_t GameGlobal::GetEventValue(const std::string &group_name, const std::string &event_name) const
 {
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
-    if(group_iter == _event_groups.end())
-        return 0;
-
-    std::map<std::string, int32_t>::const_iterator event_iter = group_iter->second->GetEvents().find(event_name);
-    if(event_iter == group_iter->second->GetEvents().end())
+    GlobalEventGroup* group = _GetEventGroup(EventNameTable::Find(group_name));
+    if(group == nullptr)
         return 0;
 
-    return event_iter->second;
+    return group->GetEvent(EventNameTable::Find(event_name));
 }
 
 void GameGlobal::SetEventValue(const std::string &group_name, const std::string &event_name, int32_t event_value)
 {
-    GlobalEventGroup *geg = 0;
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
-    if(group_iter == _event_groups.end()) {
-        geg = new GlobalEventGroup(group_name);
-        _event_groups.insert(std::make_pair(group_name, geg));
-    } else {
-        geg = group_iter->second;
+    SetEventValue(GetEventHandle(group_name, event_name), event_value);
+}
+
+GlobalEventHandle GameGlobal::GetEventHandle(const std::string &group_name, const std::string &event_name) const
+{
+    return GlobalEventHandle(EventNameTable::Intern(group_name), EventNameTable::Intern(event_name));
+}
+
+void GameGlobal::SetEventValue(const GlobalEventHandle &handle, int32_t event_value)
+{
+    if(!handle.IsValid()) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid event handle" << std::endl;
+        return;
     }
 
-    geg->SetEvent(event_name, event_value);
+    GlobalEventGroup* group = _GetEventGroup(handle.group_id);
+    if(group == nullptr)
+        group = _CreateEventGroup(EventNameTable::GetName(handle.group_id));
+
+    group->SetEvent(handle.event_id, event_value);
+}
+
+GlobalEventSnapshot GameGlobal::GetEventSnapshot() const
+{
+    GlobalEventSnapshot snapshot;
+    // The groups are in interned name order, as the snapshot values.
+    for(uint32_t i = 0; i < _event_groups_by_id.size(); ++i) {
+        if(_event_groups_by_id[i] != nullptr)
+            _event_groups_by_id[i]->AppendToSnapshot(snapshot);
+    }
+    return snapshot;
+}
+
+GlobalEventSnapshot GameGlobal::GetEventChanges(const GlobalEventSnapshot &snapshot) const
+{
+    GlobalEventSnapshot current = GetEventSnapshot();
+    GlobalEventSnapshot changes;
+
+    // Both snapshots are ordered by group and event, and events are never removed.
+    uint32_t j = 0;
+    for(uint32_t i = 0; i < current.size(); ++i) {
+        const GlobalEventHandle& handle = current[i].handle;
+        while(j < snapshot.size() &&
+                (snapshot[j].handle.group_id < handle.group_id ||
+                 (snapshot[j].handle.group_id == handle.group_id && snapshot[j].handle.event_id < handle.event_id)))
+            ++j;
+
+        if(j < snapshot.size() && snapshot[j].handle.group_id == handle.group_id
+                && snapshot[j].handle.event_id == handle.event_id && snapshot[j].value == current[i].value)
+            continue;
+        changes.push_back(current[i]);
+    }
+    return changes;
 }
 
 uint32_t GameGlobal::GetNumberEvents(const std::string &group_name) const
 {
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
-    if(group_iter == _event_groups.end()) {
+    GlobalEventGroup* group = _GetEventGroup(EventNameTable::Find(group_name));
+    if(group == nullptr) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "could not find any event group by the requested name: " << group_name << std::endl;
         return 0;
     }
-    return group_iter->second->GetNumberEvents();
+    return group->GetNumberEvents();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -784,12 +676,10 @@ bool GameGlobal::NewGame()
 }
 
 bool GameGlobal::AutoSave(const std::string& map_data_file, const std::string& map_script_file,
+                          const std::string& map_name, const std::string& map_image_filename,
                           uint32_t stamina,
                           uint32_t x_position, uint32_t y_position)
 {
-    std::ostringstream filename;
-    filename << GetUserDataPath() + "saved_game_" << GetGameSlotId() << "_autosave.lua";
-
     // Make the map location known globally to other code that may need to know this information
     std::string previous_map_data = _map_data_filename;
     std::string previous_map_script = _map_script_filename;
@@ -798,8 +688,9 @@ bool GameGlobal::AutoSave(const std::string& map_data_file, const std::string& m
     _map_data_filename = map_data_file;
     _map_script_filename = map_script_file;
     _save_stamina = stamina;
+    SetSaveLocation(map_name, map_image_filename);
 
-    bool save_completed = SaveGame(filename.str(), GetGameSlotId(), x_position, y_position);
+    bool save_completed = SaveGame(GetSaveFilename(GetGameSlotId(), true), GetGameSlotId(), x_position, y_position);
 
     // Restore previous map data
     _map_data_filename = previous_map_data;
@@ -813,107 +704,504 @@ bool GameGlobal::SaveGame(const std::string& filename, uint32_t slot_id, uint32_
     if (slot_id >= SystemManager->GetGameSaveSlots())
         return false;
 
-    WriteScriptDescriptor file;
-    if(file.OpenFile(filename) == false) {
-        return false;
-    }
+    SaveFileWriter file;
 
-    // Open the save_game1 table
-    file.WriteLine("save_game1 = {");
+    // The save preview comes first, as a header.
+    _SavePreview(file);
 
     // Save simple play data
-    file.InsertNewLine();
-    file.WriteLine("map_data_filename = \"" + _map_data_filename + "\",");
-    file.WriteLine("map_script_filename = \"" + _map_script_filename + "\",");
+    file.BeginSection(SAVE_SECTION_PLAY);
+    file.WriteString(_map_data_filename);
+    file.WriteString(_map_script_filename);
     //! \note Coords are in map tiles
-    file.WriteLine("location_x = " + NumberToString(x_position) + ",");
-    file.WriteLine("location_y = " + NumberToString(y_position) + ",");
-    file.WriteLine("play_hours = " + NumberToString(SystemManager->GetPlayHours()) + ",");
-    file.WriteLine("play_minutes = " + NumberToString(SystemManager->GetPlayMinutes()) + ",");
-    file.WriteLine("play_seconds = " + NumberToString(SystemManager->GetPlaySeconds()) + ",");
-    file.WriteLine("drunes = " + NumberToString(_drunes) + ",");
-    file.WriteLine("stamina = " + NumberToString(_save_stamina) + ",");
+    file.WriteUInt32(x_position);
+    file.WriteUInt32(y_position);
+    file.WriteUInt32(SystemManager->GetPlayHours());
+    file.WriteUInt32(SystemManager->GetPlayMinutes());
+    file.WriteUInt32(SystemManager->GetPlaySeconds());
+    file.WriteUInt32(_drunes);
+    file.WriteUInt32(_save_stamina);
+    file.EndSection();
 
     // Save latest home map data, if any.
     if (_home_map.IsValid()) {
-        file.InsertNewLine();
-        file.WriteLine("home_map = {");
-        file.WriteLine("\tmap_data_filename = \"" + _home_map.GetMapDataFilename() + "\",");
-        file.WriteLine("\tmap_script_filename = \"" + _home_map.GetMapDataFilename() + "\",");
+        file.BeginSection(SAVE_SECTION_HOME);
+        file.WriteString(_home_map.GetMapDataFilename());
+        file.WriteString(_home_map.GetMapScriptFilename());
         //! \note Coords are in map tiles
-        file.WriteLine("\tlocation_x = " + NumberToString(_home_map.GetMapPosition().x) + ",");
-        file.WriteLine("\tlocation_y = " + NumberToString(_home_map.GetMapPosition().y) + ",");
-        file.WriteLine("},");
-    }
-
-    // Save the inventory (object id + object count pairs)
-    // NOTE: This does not save any weapons/armor that are equipped on the characters. That data
-    // is stored alongside the character data when it is saved
-    _SaveInventory(file, "items", _inventory_items);
-    _SaveInventory(file, "weapons", _inventory_weapons);
-    _SaveInventory(file, "head_armor", _inventory_head_armor);
-    _SaveInventory(file, "torso_armor", _inventory_torso_armor);
-    _SaveInventory(file, "arm_armor", _inventory_arm_armor);
-    _SaveInventory(file, "leg_armor", _inventory_leg_armor);
-    _SaveInventory(file, "spirits", _inventory_spirits);
-
-    // ----- (5) Save character data
-    file.InsertNewLine();
-    file.WriteLine("characters = {");
-    // First save the order of the characters in the party
-    file.WriteLine("\t[\"order\"] = {");
-    for(uint32_t i = 0; i < _ordered_characters.size(); ++i) {
-        if(i == 0)
-            file.WriteLine("\t\t" + NumberToString(_ordered_characters[i]->GetID()), false);
-        else
-            file.WriteLine(", " + NumberToString(_ordered_characters[i]->GetID()), false);
+        file.WriteFloat(_home_map.GetMapPosition().x);
+        file.WriteFloat(_home_map.GetMapPosition().y);
+        file.EndSection();
+    }
+
+    _SaveInventory(file);
+    _SaveCharacters(file);
+    _SaveEvents(file);
+    _SaveQuests(file);
+    _SaveWorldMap(file);
+    _SaveShopData(file);
+
+    // Only one file is written at a time, so that they are written in order.
+    WaitForSaveGame();
+    _save_task = new SaveFileTask(filename, file);
+
+    // Store the game slot the game is coming from.
+    _game_slot_id = slot_id;
+
+    return true;
+}
+
+bool GameGlobal::IsSavingGame()
+{
+    if (_save_task && _save_task->IsDone())
+        _FinishSaveTask();
+    return _save_task != nullptr;
+}
+
+bool GameGlobal::WaitForSaveGame()
+{
+    if (_save_task)
+        _FinishSaveTask();
+    return _last_save_succeeded;
+}
+
+void GameGlobal::_FinishSaveTask()
+{
+    // The write errors are already reported by the task.
+    _last_save_succeeded = _save_task->Wait();
+    delete _save_task;
+    _save_task = nullptr;
+}
+
+bool GameGlobal::LoadGame(const std::string &filename, uint32_t slot_id)
+{
+    // The file might still be being written.
+    WaitForSaveGame();
+
+    // The former Lua saves are still loaded, and replaced by binary saves once the game is saved.
+    bool loaded = IsBinarySaveFile(filename) ? _LoadBinaryGame(filename) : _LoadLegacyGame(filename);
+    if (!loaded)
+        return false;
+
+    // Store the game slot the game is coming from.
+    _game_slot_id = slot_id;
+
+    return true;
+}
+
+void GameGlobal::LoadEmotes(const std::string &emotes_filename)
+{
+    // First, clear the list in case of reloading
+    _emotes.clear();
+
+    vt_script::ReadScriptDescriptor emotes_script;
+    if(!emotes_script.OpenFile(emotes_filename))
+        return;
+
+    if(!emotes_script.DoesTableExist("emotes")) {
+        emotes_script.CloseFile();
+        return;
     }
-    file.WriteLine("\n\t},"); // order
 
-    // Now save each individual character's data
-    for(uint32_t i = 0; i < _ordered_characters.size(); ++i) {
+    std::vector<std::string> emotes_id;
+    emotes_script.ReadTableKeys("emotes", emotes_id);
+
+    // Read all the values
+    emotes_script.OpenTable("emotes");
+    for(uint32_t i = 0; i < emotes_id.size(); ++i) {
+
+        if(!emotes_script.DoesTableExist(emotes_id[i]))
+            continue;
+        emotes_script.OpenTable(emotes_id[i]);
+
+        std::string animation_file = emotes_script.ReadString("animation");
+
+        AnimatedImage anim;
+        if(anim.LoadFromAnimationScript(animation_file)) {
+            // NOTE: The map mode should one day be fixed to use the same coords
+            // than everything else, thus making possible to remove this
+            vt_map::MapMode::ScaleToMapZoomRatio(anim);
+
+            _emotes.insert(std::make_pair(emotes_id[i], anim));
+
+            // The vector containing the offsets
+            std::vector<std::pair<float, float> > emote_offsets;
+            emote_offsets.resize(vt_map::private_map::NUM_ANIM_DIRECTIONS);
+
+            // For each directions
+            for(uint32_t j = 0; j < vt_map::private_map::NUM_ANIM_DIRECTIONS; ++j) {
+                emotes_script.OpenTable(j);
+
+                std::pair<float, float> offsets;
+                offsets.first = emotes_script.ReadFloat("x");
+                offsets.second = emotes_script.ReadFloat("y");
+
+                emote_offsets[j] = offsets;
+
+                emotes_script.CloseTable(); // direction table.
+            }
+
+            _emotes_offsets.insert(std::make_pair(emotes_id[i], emote_offsets));
+        }
+
+        emotes_script.CloseTable(); // emote_id[i]
+    }
+    emotes_script.CloseAllTables();
+    emotes_script.CloseFile();
+}
+
+void GameGlobal::GetEmoteOffset(float &x, float &y, const std::string &emote_id, vt_map::private_map::ANIM_DIRECTIONS dir)
+{
+
+    x = 0.0f;
+    y = 0.0f;
+
+    if(dir < vt_map::private_map::ANIM_SOUTH || dir >= vt_map::private_map::NUM_ANIM_DIRECTIONS)
+        return;
+
+    std::map<std::string, std::vector<std::pair<float, float> > >::const_iterator it =
+        _emotes_offsets.find(emote_id);
+
+    if(it == _emotes_offsets.end())
+        return;
+
+    x = it->second[dir].first;
+    y = it->second[dir].second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// GameGlobal class - Private Methods
+////////////////////////////////////////////////////////////////////////////////
+
+GlobalEventGroup* GameGlobal::_CreateEventGroup(const std::string &group_name)
+{
+    GlobalEventGroup *geg = new GlobalEventGroup(group_name);
+    _event_groups.insert(std::make_pair(group_name, geg));
+
+    uint32_t group_id = geg->GetGroupId();
+    if(group_id >= _event_groups_by_id.size())
+        _event_groups_by_id.resize(group_id + 1, nullptr);
+    _event_groups_by_id[group_id] = geg;
+    return geg;
+}
+
+void GameGlobal::_SavePreview(SaveFileWriter& file)
+{
+    file.BeginSection(SAVE_SECTION_PREVIEW);
+    file.WriteString(_map_data_filename);
+    file.WriteString(_map_script_filename);
+    file.WriteString(_save_map_name);
+    file.WriteString(_save_map_image_filename);
+    file.WriteUInt32(SystemManager->GetPlayHours());
+    file.WriteUInt32(SystemManager->GetPlayMinutes());
+    file.WriteUInt32(SystemManager->GetPlaySeconds());
+    file.WriteUInt32(_drunes);
+
+    // The first characters, visible in battles.
+    // Their names are read in the current language when shown.
+    uint32_t characters_count = std::min<uint32_t>(_ordered_characters.size(), GLOBAL_MAX_PARTY_SIZE);
+    file.WriteUInt32(characters_count);
+    for (uint32_t i = 0; i < characters_count; ++i) {
+        GlobalCharacter* character = _ordered_characters[i];
+        file.BeginRecord();
+        file.WriteUInt32(character->GetID());
+        file.WriteString(character->GetPortrait().GetFilename());
+        file.WriteUInt32(character->GetExperienceLevel());
+        file.WriteUInt32(character->GetHitPoints());
+        file.WriteUInt32(character->GetMaxHitPoints());
+        file.WriteUInt32(character->GetSkillPoints());
+        file.WriteUInt32(character->GetMaxSkillPoints());
+        file.EndRecord();
+    }
+    file.EndSection();
+}
+
+void GameGlobal::_SaveInventory(SaveFileWriter& file)
+{
+    // Save the object id + object count pairs
+    const std::vector<std::shared_ptr<GlobalObject>>& objects = _inventory.GetObjects();
+    file.BeginSection(SAVE_SECTION_INVENTORY);
+    file.WriteUInt32(objects.size());
+    for (uint32_t i = 0; i < objects.size(); ++i) {
+        file.WriteUInt32(objects[i]->GetID());
+        file.WriteUInt32(objects[i]->GetCount());
+    }
+    file.EndSection();
+}
+
+void GameGlobal::_SaveCharacters(SaveFileWriter& file)
+{
+    // The characters are saved in the party order.
+    file.BeginSection(SAVE_SECTION_CHARACTERS);
+    file.WriteUInt32(_ordered_characters.size());
+    for (uint32_t i = 0; i < _ordered_characters.size(); ++i) {
+        file.BeginRecord();
+        file.WriteUInt32(_ordered_characters[i]->GetID());
         _ordered_characters[i]->SaveCharacter(file);
+        file.EndRecord();
     }
-    file.WriteLine("},"); // characters
+    file.EndSection();
+}
 
-    // ----- (6) Save event data
-    file.InsertNewLine();
-    file.WriteLine("event_groups = {");
-    for(std::map<std::string, GlobalEventGroup *>::iterator it = _event_groups.begin(); it != _event_groups.end(); ++it) {
-        _SaveEvents(file, it->second);
+void GameGlobal::_SaveEvents(SaveFileWriter& file)
+{
+    // The snapshot is ordered by group, as _event_groups_by_id.
+    const GlobalEventSnapshot snapshot = GetEventSnapshot();
+
+    // The events are saved by name, as their interned numbers differ between game runs.
+    file.BeginSection(SAVE_SECTION_EVENTS);
+    file.WriteUInt32(_event_groups.size());
+    uint32_t first_event = 0;
+    for (uint32_t group_id = 0; group_id < _event_groups_by_id.size(); ++group_id) {
+        if (_event_groups_by_id[group_id] == nullptr)
+            continue;
+        file.WriteString(EventNameTable::GetName(group_id));
+
+        uint32_t last_event = first_event;
+        while (last_event < snapshot.size() && snapshot[last_event].handle.group_id == group_id)
+            ++last_event;
+
+        file.WriteUInt32(last_event - first_event);
+        for (; first_event < last_event; ++first_event) {
+            file.WriteString(EventNameTable::GetName(snapshot[first_event].handle.event_id));
+            file.WriteInt32(snapshot[first_event].value);
+        }
     }
-    file.WriteLine("},");
-    file.InsertNewLine();
+    file.EndSection();
+}
 
-    // ------ (7) Save quest log
-    file.WriteLine("quest_log = {");
-    for(std::map<std::string, QuestLogEntry *>::const_iterator itr = _quest_log_entries.begin(); itr != _quest_log_entries.end(); ++itr)
-        _SaveQuests(file, itr->second);
-    file.WriteLine("},");
-    file.InsertNewLine();
+void GameGlobal::_SaveQuests(SaveFileWriter& file)
+{
+    file.BeginSection(SAVE_SECTION_QUESTS);
+    file.WriteUInt32(_quest_log_entries.size());
+    for (std::map<std::string, QuestLogEntry *>::const_iterator it = _quest_log_entries.begin(); it != _quest_log_entries.end(); ++it) {
+        file.WriteString(it->second->GetQuestId());
+        file.WriteUInt32(it->second->GetQuestLogNumber());
+        file.WriteBool(it->second->IsRead());
+    }
+    file.EndSection();
+}
 
-    _SaveWorldMap(file);
+void GameGlobal::_SaveWorldMap(SaveFileWriter& file)
+{
+    file.BeginSection(SAVE_SECTION_WORLD_MAP);
+    file.WriteString(GetWorldMapFilename());
+    file.WriteUInt32(_viewable_world_locations.size());
+    for (uint32_t i = 0; i < _viewable_world_locations.size(); ++i)
+        file.WriteString(_viewable_world_locations[i]);
+    file.WriteString(GetCurrentLocationId());
+    file.EndSection();
+}
 
-    _SaveShopData(file);
+void GameGlobal::_SaveShopData(SaveFileWriter& file)
+{
+    file.BeginSection(SAVE_SECTION_SHOPS);
+    file.WriteUInt32(_shop_data.size());
+    for (auto it = _shop_data.begin(); it != _shop_data.end(); ++it) {
+        const ShopData& shop_data = it->second;
+        file.WriteString(it->first);
 
-    if(file.IsErrorDetected()) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "One or more errors occurred while writing the save game file - they are listed below:" << std::endl
-            << file.GetErrorMessages() << std::endl;
-        file.ClearErrors();
+        // The item id + count pairs
+        file.WriteUInt32(shop_data._available_buy.size());
+        for (auto it2 = shop_data._available_buy.begin(); it2 != shop_data._available_buy.end(); ++it2) {
+            file.WriteUInt32(it2->first);
+            file.WriteUInt32(it2->second);
+        }
+
+        file.WriteUInt32(shop_data._available_trade.size());
+        for (auto it3 = shop_data._available_trade.begin(); it3 != shop_data._available_trade.end(); ++it3) {
+            file.WriteUInt32(it3->first);
+            file.WriteUInt32(it3->second);
+        }
     }
+    file.EndSection();
+}
 
-    file.InsertNewLine();
-    file.WriteLine("} -- save_game1"); //save_game1
+bool GameGlobal::_LoadBinaryGame(const std::string& filename)
+{
+    SaveFileReader file;
+    if (!file.OpenFile(filename))
+        return false;
 
-    file.CloseFile();
+    ClearAllData();
 
-    // Store the game slot the game is coming from.
-    _game_slot_id = slot_id;
+    // Load play data
+    if (!file.OpenSection(SAVE_SECTION_PLAY)) {
+        PRINT_ERROR << "Couldn't find the play data in the savegame " << filename << std::endl;
+        return false;
+    }
+    _map_data_filename = file.ReadString();
+    _map_script_filename = file.ReadString();
+    _x_save_map_position = file.ReadUInt32();
+    _y_save_map_position = file.ReadUInt32();
+    uint8_t hours = file.ReadUInt32();
+    uint8_t minutes = file.ReadUInt32();
+    uint8_t seconds = file.ReadUInt32();
+    SystemManager->SetPlayTime(hours, minutes, seconds);
+    _drunes = file.ReadUInt32();
+    _save_stamina = file.ReadUInt32();
+    file.CloseSection();
+
+    // Load home map data, if any
+    if (file.OpenSection(SAVE_SECTION_HOME)) {
+        std::string home_map_data = file.ReadString();
+        std::string home_map_script = file.ReadString();
+        float x_pos = file.ReadFloat();
+        float y_pos = file.ReadFloat();
 
+        _home_map = vt_map::MapLocation(home_map_data,
+                                        home_map_script,
+                                        x_pos, y_pos);
+        file.CloseSection();
+    }
+
+    _LoadInventory(file);
+    _LoadCharacters(file);
+
+    if (_characters.empty()) {
+        PRINT_ERROR << "No characters were added by save game file: " << filename << std::endl;
+        return false;
+    }
+
+    _LoadEvents(file);
+    _LoadQuests(file);
+    _LoadWorldMap(file);
+    _LoadShopData(file);
+
+    if (file.IsErrorDetected()) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "One or more sections of the save game file were invalid: "
+                                       << filename << std::endl;
+    }
     return true;
 }
 
-bool GameGlobal::LoadGame(const std::string &filename, uint32_t slot_id)
+void GameGlobal::_LoadInventory(SaveFileReader& file)
+{
+    if (!file.OpenSection(SAVE_SECTION_INVENTORY))
+        return;
+
+    uint32_t objects_count = file.ReadUInt32();
+    for (uint32_t i = 0; i < objects_count; ++i) {
+        uint32_t object_id = file.ReadUInt32();
+        uint32_t count = file.ReadUInt32();
+        AddToInventory(object_id, count);
+    }
+    file.CloseSection();
+}
+
+void GameGlobal::_LoadCharacters(SaveFileReader& file)
+{
+    if (!file.OpenSection(SAVE_SECTION_CHARACTERS)) {
+        PRINT_ERROR << "Couldn't find the characters data in " << file.GetFilename() << std::endl;
+        return;
+    }
+
+    // Load characters into the party in the correct order
+    uint32_t characters_count = file.ReadUInt32();
+    for (uint32_t i = 0; i < characters_count; ++i) {
+        if (!file.OpenRecord())
+            break;
+
+        GlobalCharacter* character = new GlobalCharacter(file.ReadUInt32(), false);
+        if (character->LoadCharacter(file))
+            AddCharacter(character);
+        else
+            delete character;
+
+        file.CloseRecord();
+    }
+    file.CloseSection();
+}
+
+void GameGlobal::_LoadEvents(SaveFileReader& file)
+{
+    if (!file.OpenSection(SAVE_SECTION_EVENTS))
+        return;
+
+    uint32_t groups_count = file.ReadUInt32();
+    for (uint32_t i = 0; i < groups_count; ++i) {
+        std::string group_name = file.ReadString();
+        AddNewEventGroup(group_name);
+        GlobalEventGroup *group = GetEventGroup(group_name); // group is guaranteed not to be nullptr
+
+        uint32_t events_count = file.ReadUInt32();
+        for (uint32_t j = 0; j < events_count; ++j) {
+            std::string event_name = file.ReadString();
+            group->SetEvent(event_name, file.ReadInt32());
+        }
+    }
+    file.CloseSection();
+}
+
+void GameGlobal::_LoadQuests(SaveFileReader& file)
+{
+    if (!file.OpenSection(SAVE_SECTION_QUESTS))
+        return;
+
+    uint32_t quests_count = file.ReadUInt32();
+    for (uint32_t i = 0; i < quests_count; ++i) {
+        std::string quest_id = file.ReadString();
+        uint32_t quest_log_number = file.ReadUInt32();
+        bool is_read = file.ReadBool();
+
+        if (!_AddQuestLog(quest_id, quest_log_number, is_read)) {
+            IF_PRINT_WARNING(GLOBAL_DEBUG) << "save file has duplicate quest log id entries" << std::endl;
+            continue;
+        }
+
+        //update the quest log count value if the current number is greater
+        if (_quest_log_count < quest_log_number)
+            _quest_log_count = quest_log_number;
+    }
+    file.CloseSection();
+}
+
+void GameGlobal::_LoadWorldMap(SaveFileReader& file)
+{
+    if (!file.OpenSection(SAVE_SECTION_WORLD_MAP))
+        return;
+
+    SetWorldMap(file.ReadString());
+
+    uint32_t locations_count = file.ReadUInt32();
+    for (uint32_t i = 0; i < locations_count; ++i)
+        ShowWorldLocation(file.ReadString());
+
+    std::string current_location = file.ReadString();
+    if (!current_location.empty())
+        SetCurrentLocationId(current_location);
+
+    file.CloseSection();
+}
+
+void GameGlobal::_LoadShopData(SaveFileReader& file)
+{
+    if (!file.OpenSection(SAVE_SECTION_SHOPS))
+        return;
+
+    uint32_t shops_count = file.ReadUInt32();
+    for (uint32_t i = 0; i < shops_count; ++i) {
+        std::string shop_id = file.ReadString();
+
+        ShopData shop_data;
+        uint32_t buy_count = file.ReadUInt32();
+        for (uint32_t j = 0; j < buy_count; ++j) {
+            uint32_t item_id = file.ReadUInt32();
+            shop_data._available_buy[item_id] = file.ReadUInt32();
+        }
+
+        uint32_t trade_count = file.ReadUInt32();
+        for (uint32_t j = 0; j < trade_count; ++j) {
+            uint32_t item_id = file.ReadUInt32();
+            shop_data._available_trade[item_id] = file.ReadUInt32();
+        }
+
+        _shop_data[shop_id] = shop_data;
+    }
+    file.CloseSection();
+}
+
+bool GameGlobal::_LoadLegacyGame(const std::string &filename)
 {
     ReadScriptDescriptor file;
     if(!file.OpenFile(filename))
@@ -1069,225 +1357,9 @@ bool GameGlobal::LoadGame(const std::string &filename, uint32_t slot_id)
 
     file.CloseFile();
 
-    // Store the game slot the game is coming from.
-    _game_slot_id = slot_id;
-
     return true;
 }
 
-void GameGlobal::LoadEmotes(const std::string &emotes_filename)
-{
-    // First, clear the list in case of reloading
-    _emotes.clear();
-
-    vt_script::ReadScriptDescriptor emotes_script;
-    if(!emotes_script.OpenFile(emotes_filename))
-        return;
-
-    if(!emotes_script.DoesTableExist("emotes")) {
-        emotes_script.CloseFile();
-        return;
-    }
-
-    std::vector<std::string> emotes_id;
-    emotes_script.ReadTableKeys("emotes", emotes_id);
-
-    // Read all the values
-    emotes_script.OpenTable("emotes");
-    for(uint32_t i = 0; i < emotes_id.size(); ++i) {
-
-        if(!emotes_script.DoesTableExist(emotes_id[i]))
-            continue;
-        emotes_script.OpenTable(emotes_id[i]);
-
-        std::string animation_file = emotes_script.ReadString("animation");
-
-        AnimatedImage anim;
-        if(anim.LoadFromAnimationScript(animation_file)) {
-            // NOTE: The map mode should one day be fixed to use the same coords
-            // than everything else, thus making possible to remove this
-            vt_map::MapMode::ScaleToMapZoomRatio(anim);
-
-            _emotes.insert(std::make_pair(emotes_id[i], anim));
-
-            // The vector containing the offsets
-            std::vector<std::pair<float, float> > emote_offsets;
-            emote_offsets.resize(vt_map::private_map::NUM_ANIM_DIRECTIONS);
-
-            // For each directions
-            for(uint32_t j = 0; j < vt_map::private_map::NUM_ANIM_DIRECTIONS; ++j) {
-                emotes_script.OpenTable(j);
-
-                std::pair<float, float> offsets;
-                offsets.first = emotes_script.ReadFloat("x");
-                offsets.second = emotes_script.ReadFloat("y");
-
-                emote_offsets[j] = offsets;
-
-                emotes_script.CloseTable(); // direction table.
-            }
-
-            _emotes_offsets.insert(std::make_pair(emotes_id[i], emote_offsets));
-        }
-
-        emotes_script.CloseTable(); // emote_id[i]
-    }
-    emotes_script.CloseAllTables();
-    emotes_script.CloseFile();
-}
-
-void GameGlobal::GetEmoteOffset(float &x, float &y, const std::string &emote_id, vt_map::private_map::ANIM_DIRECTIONS dir)
-{
-
-    x = 0.0f;
-    y = 0.0f;
-
-    if(dir < vt_map::private_map::ANIM_SOUTH || dir >= vt_map::private_map::NUM_ANIM_DIRECTIONS)
-        return;
-
-    std::map<std::string, std::vector<std::pair<float, float> > >::const_iterator it =
-        _emotes_offsets.find(emote_id);
-
-    if(it == _emotes_offsets.end())
-        return;
-
-    x = it->second[dir].first;
-    y = it->second[dir].second;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-// GameGlobal class - Private Methods
-////////////////////////////////////////////////////////////////////////////////
-
-void GameGlobal::_SaveEvents(WriteScriptDescriptor &file, GlobalEventGroup *event_group)
-{
-    if(file.IsFileOpen() == false) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "the file provided in the function argument was not open" << std::endl;
-        return;
-    }
-    if(event_group == nullptr) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "function received a nullptr event group pointer argument" << std::endl;
-        return;
-    }
-
-    file.WriteLine("\t" + event_group->GetGroupName() + " = {");
-
-    uint32_t i = 0;
-    for(std::map<std::string, int32_t>::const_iterator it = event_group->GetEvents().begin(); it != event_group->GetEvents().end(); ++it) {
-        if(it == event_group->GetEvents().begin())
-            file.WriteLine("\t\t", false);
-        else
-            file.WriteLine(", ", false);
-
-        // Add a new line every 4 entries for better readability and debugging
-        if ((i > 0) && !(i % 4)) {
-            file.InsertNewLine();
-            file.WriteLine("\t\t", false);
-        }
-
-        file.WriteLine("[\"" + it->first + "\"] = " + NumberToString(it->second), false);
-
-        ++i;
-    }
-    file.WriteLine("\n\t},");
-}
-
-void GameGlobal::_SaveQuests(WriteScriptDescriptor &file, const QuestLogEntry *quest_log_entry)
-{
-    if(file.IsFileOpen() == false)
-    {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "the file provided in the function argument was not open" << std::endl;
-        return;
-    }
-
-    if(quest_log_entry == nullptr)
-    {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "_SaveQuests function received a nullptr quest log entry pointer argument" << std::endl;
-        return;
-    }
-
-    // Start writting
-    file.WriteLine("\t" + quest_log_entry->GetQuestId() + " = {", false);
-    // Write the quest log number. this is written as a string because loading needs a uniform type of data in the array
-    file.WriteLine("\"" + NumberToString(quest_log_entry->GetQuestLogNumber()) + "\", ", false);
-    // Write the "false" or "true" string if this entry has been read or not
-    const std::string is_read(quest_log_entry->IsRead() ? "true" : "false");
-    file.WriteLine("\"" + is_read + "\"", false);
-    // End writing
-    file.WriteLine("},");
-}
-
-void GameGlobal::_SaveWorldMap(vt_script::WriteScriptDescriptor &file)
-{
-    if(!file.IsFileOpen()) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "the file provided in the function argument was not open" << std::endl;
-        return;
-    }
-
-    // Write the 'worldmap' table
-    file.WriteLine("worldmap = {");
-
-    //write the world map filename
-    file.WriteLine("\tworld_map_file = \"" + GetWorldMapFilename() + "\",");
-    file.InsertNewLine();
-
-    //write the viewable locations
-    file.WriteLine("\tviewable_locations = {");
-    for(uint32_t i = 0; i < _viewable_world_locations.size(); ++i)
-        file.WriteLine("\t\t\"" + _viewable_world_locations[i]+"\",");
-    file.WriteLine("\t},");
-    file.InsertNewLine();
-
-    file.WriteLine("\tcurrent_location = \"" + GetCurrentLocationId() + "\"");
-
-    file.WriteLine("},"); // close the main table
-    file.InsertNewLine();
-}
-
-void GameGlobal::_SaveShopData(vt_script::WriteScriptDescriptor& file)
-{
-    if(!file.IsFileOpen()) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "The file was not open: " << file.GetFilename() << std::endl;
-        return;
-    }
-
-    file.WriteLine("shop_data = {");
-    file.InsertNewLine();
-
-    auto it = _shop_data.begin();
-    auto it_end = _shop_data.end();
-    for (; it != it_end; ++it) {
-        std::string shop_id = it->first;
-        const ShopData& shop_data = it->second;
-
-        file.WriteLine("\t[\"" + shop_id + "\"] = {");
-
-        file.WriteLine("\t\tavailable_buy = {");
-        auto it2 = shop_data._available_buy.begin();
-        auto it2_end = shop_data._available_buy.end();
-        for(; it2 != it2_end; ++it2) {
-            std::string item_id = NumberToString(it2->first);
-            std::string count = NumberToString(it2->second);
-            file.WriteLine("\t\t\t[\"" + item_id + "\"] = " + count + ",");
-        }
-        file.WriteLine("\t\t},");
-
-        file.WriteLine("\t\tavailable_trade = {");
-        auto it3 = shop_data._available_trade.begin();
-        auto it3_end = shop_data._available_trade.end();
-        for(; it3 != it3_end; ++it3) {
-            std::string item_id = NumberToString(it3->first);
-            std::string count = NumberToString(it3->second);
-            file.WriteLine("\t\t\t[\"" + item_id + "\"] = " + count + ",");
-        }
-        file.WriteLine("\t\t}");
-
-        file.WriteLine("\t},");
-    }
-    file.WriteLine("},"); // Close the shop_data table
-    file.InsertNewLine();
-}
-
 void GameGlobal::_LoadInventory(ReadScriptDescriptor &file, const std::string &category_name)
 {
     if(file.IsFileOpen() == false) {
@@ -37,8 +37,11 @@
 
 #include "global_skills.h"
 #include "global_utils.h"
+#include "objects/global_object_registry.h"
+#include "global_inventory.h"
 
 #include "global_event_group.h"
+#include "global_save_file.h"
 #include "quest_log.h"
 #include "shop_data.h"
 #include "worldmap_location.h"
@@ -61,6 +64,17 @@ extern GameGlobal* GlobalManager;
 //! \brief Determines whether the code in the vt_global namespace should print debug statements or not.
 extern bool GLOBAL_DEBUG;
 
+//! \brief The global data initialization steps, in the order they must be run.
+enum GLOBAL_INIT_STEP {
+    GLOBAL_INIT_MEDIA        = 0,
+    GLOBAL_INIT_BATTLE_MEDIA = 1,
+    GLOBAL_INIT_INVENTORY    = 2,
+    GLOBAL_INIT_SKILLS       = 3,
+    GLOBAL_INIT_ENTITIES     = 4,
+    GLOBAL_INIT_CONFIG       = 5,
+    GLOBAL_INIT_TOTAL        = 6
+};
+
 /** ****************************************************************************
 *** \brief Retains all the state information about the active game
 ***
@@ -81,8 +95,15 @@ class GameGlobal : public vt_utils::Singleton<GameGlobal>
 public:
     ~GameGlobal();
 
+    //! \brief Runs every initialization step at once.
     bool SingletonInitialize();
 
+    /** \brief Runs a single initialization step, so that the startup can spread
+    *** the global data loading over several frames.
+    *** \note The steps must be run in order, and replace the SingletonInitialize() call.
+    **/
+    bool InitializeStep(GLOBAL_INIT_STEP step);
+
     //! Reloads the persistent scripts. Used when changing the language for instance.
     bool ReloadGlobalScripts()
     { _CloseGlobalScripts(); return _LoadGlobalScripts(); }
@@ -212,16 +233,16 @@ public:
     *** \param id The id of the object (item, weapon, armor, etc.) to check for
     *** \return True if the object was found in the inventor, or false if it was not found
     **/
-    bool IsItemInInventory(uint32_t id) {
-        return (_inventory.find(id) != _inventory.end());
+    bool IsItemInInventory(uint32_t id) const {
+        return _inventory.HasObject(id);
     }
 
     /** \brief Gives how many of a given item is in the inventory
     *** \param id The id of the object (item, weapon, armor, etc.) to check for
     *** \return The number of the object found in the inventory
     **/
-    uint32_t HowManyObjectsInInventory(uint32_t id) {
-        return (_inventory.find(id) != _inventory.end()) ? _inventory.at(id)->GetCount() : 0;
+    uint32_t HowManyObjectsInInventory(uint32_t id) const {
+        return _inventory.GetObjectCount(id);
     }
     //@}
 
@@ -278,6 +299,28 @@ public:
     **/
     void SetEventValue(const std::string &group_name, const std::string &event_name, int32_t event_value);
 
+    /** \brief Returns a handle to an event, which can then be read and written without looking up its names.
+    *** The handle stays valid even if the event or its group don't exist yet, or are cleared.
+    **/
+    GlobalEventHandle GetEventHandle(const std::string &group_name, const std::string &event_name) const;
+
+    //! \brief Returns the value of an event from its handle, or 0 if the event was not found.
+    int32_t GetEventValue(const GlobalEventHandle &handle) const {
+        GlobalEventGroup* group = _GetEventGroup(handle.group_id);
+        return group ? group->GetEvent(handle.event_id) : 0;
+    }
+
+    //! \brief Sets the value of an event from its handle. The event and its group are created when necessary.
+    void SetEventValue(const GlobalEventHandle &handle, int32_t event_value);
+
+    //! \brief Returns a copy of every event value.
+    GlobalEventSnapshot GetEventSnapshot() const;
+
+    /** \brief Returns the events added or changed since the given snapshot was taken.
+    *** \note Events are never removed, apart from when the whole game data is cleared.
+    **/
+    GlobalEventSnapshot GetEventChanges(const GlobalEventSnapshot &snapshot) const;
+
     //! \brief Returns the number of event groups stored in the class
     uint32_t GetNumberEventGroups() const {
         return _event_groups.size();
@@ -543,27 +586,41 @@ public:
     //! \returns whether it succeeded.
     bool NewGame();
 
-    /** \brief Saves all global data to a saved game file
+    /** \brief Saves all global data to a binary saved game file
+    *** The data is gathered right away, but the file is written on a worker thread.
+    *** Use IsSavingGame() and WaitForSaveGame() to know when and whether it was written.
     *** \param filename The filename of the saved game file where to write the data to
     *** \param slot_id The game slot id used for the save menu.
     *** \param positions When used in a save point, the save map tile positions are given there.
-    *** \return True if the game was successfully saved, false if it was not
+    *** \return True if the file writing was started, false if it was not
     **/
     bool SaveGame(const std::string &filename, uint32_t slot_id, uint32_t x_position = 0, uint32_t y_position = 0);
 
-    //! \brief Attempts an autosave on the current slot, using given map and location.
+    /** \brief Attempts an autosave on the current slot, using given map and location.
+    *** \param map_name The untranslated map name and the map image filename, shown when browsing the saves.
+    **/
     bool AutoSave(const std::string& map_data_file, const std::string& map_script_file,
+                  const std::string& map_name, const std::string& map_image_filename,
                   uint32_t stamina,
                   uint32_t x_position = 0, uint32_t y_position = 0);
 
     /** \brief Loads all global data from a saved game file
-    *** \param filename The filename of the saved game file where to read the data from
+    *** \param filename The filename of the saved game file where to read the data from,
+    *** either a binary save or a former Lua one.
     *** \param slot_id The save slot the file correspond to. Used to set the correct cursor position
     *** when further saving.
     *** \return True if the game was successfully loaded, false if it was not
     **/
     bool LoadGame(const std::string &filename, uint32_t slot_id);
 
+    //! \brief Tells whether a saved game file is still being written. Doesn't wait.
+    bool IsSavingGame();
+
+    /** \brief Waits for the saved game file being written, if any.
+    *** \return Whether the last saved game file was successfully written.
+    **/
+    bool WaitForSaveGame();
+
     //! \brief Gets the last load/save position.
     uint32_t GetGameSlotId() const {
         return _game_slot_id;
@@ -611,6 +668,15 @@ public:
         _save_stamina = stamina;
     }
 
+    /** \brief Sets the location shown when browsing the saves.
+    *** \param map_name The untranslated map name, translated when shown.
+    *** \param map_image_filename The image presenting the map.
+    **/
+    void SetSaveLocation(const std::string& map_name, const std::string& map_image_filename) {
+        _save_map_name = map_name;
+        _save_map_image_filename = map_image_filename;
+    }
+
     /** \brief Unset the save data once retreived at load time.
     *** It should be done in the map code once this data has been restored.
     **/
@@ -618,6 +684,8 @@ public:
         _x_save_map_position = 0;
         _y_save_map_position = 0;
         _save_stamina = 0;
+        _save_map_name.clear();
+        _save_map_image_filename.clear();
     }
 
     vt_video::StillImage& GetMapImage() {
@@ -677,40 +745,8 @@ public:
         return &_active_party;
     }
 
-    std::map<uint32_t, std::shared_ptr<GlobalObject>>* GetInventory() {
-        return &_inventory;
-    }
-
-    std::vector<std::shared_ptr<GlobalItem>>* GetInventoryItems() {
-        return &_inventory_items;
-    }
-
-    std::vector<std::shared_ptr<GlobalWeapon>>* GetInventoryWeapons() {
-        return &_inventory_weapons;
-    }
-
-    std::vector<std::shared_ptr<GlobalArmor>>* GetInventoryHeadArmors() {
-        return &_inventory_head_armor;
-    }
-
-    std::vector<std::shared_ptr<GlobalArmor>>* GetInventoryTorsoArmors() {
-        return &_inventory_torso_armor;
-    }
-
-    std::vector<std::shared_ptr<GlobalArmor>>* GetInventoryArmArmors() {
-        return &_inventory_arm_armor;
-    }
-
-    std::vector<std::shared_ptr<GlobalArmor>>* GetInventoryLegArmors() {
-        return &_inventory_leg_armor;
-    }
-
-    std::vector<std::shared_ptr<GlobalSpirit>>* GetInventorySpirits() {
-        return &_inventory_spirits;
-    }
-
-    std::vector<std::shared_ptr<GlobalObject>>* GetInventoryKeyItems() {
-        return &_inventory_key_items;
+    GlobalInventory& GetInventory() {
+        return _inventory;
     }
 
     vt_script::ReadScriptDescriptor &GetItemsScript() {
@@ -774,6 +810,11 @@ public:
     }
     //@}
 
+    //! \brief Returns the items, weapons, armor and spirits definitions, read from the scripts above.
+    GlobalObjectRegistry& GetObjectRegistry() {
+        return _object_registry;
+    }
+
     //! \brief loads the emotes used for character feelings expression in the given lua file.
     void LoadEmotes(const std::string &emotes_filename);
 
@@ -816,6 +857,12 @@ private:
     //! \brief The slot id the game was loaded from/saved to, or 0 if none.
     uint32_t _game_slot_id;
 
+    //! \brief The saved game file being written, if any.
+    SaveFileTask* _save_task;
+
+    //! \brief Whether the last saved game file was successfully written.
+    bool _last_save_succeeded;
+
     //! \brief The amount of financial resources (drunes) that the party currently has
     uint32_t _drunes;
 
@@ -835,6 +882,10 @@ private:
     //! \brief last save party stamina value.
     uint32_t _save_stamina;
 
+    //! \brief The untranslated map name and map image filename written in the saves preview.
+    std::string _save_map_name;
+    std::string _save_map_image_filename;
+
     //! \brief The graphical image which represents the current location
     vt_video::StillImage _map_image;
 
@@ -879,30 +930,8 @@ private:
     **/
     GlobalParty _active_party;
 
-    /** \brief Retains a list of all of the objects currently stored in the player's inventory
-    *** This map is used to quickly check if an item is in the inventory or not. The key to the map is the object's
-    *** identification number. When an object is added to the inventory, if it already exists then the object counter
-    *** is simply increased instead of adding an entire new class object. When the object count becomes zero, the object
-    *** is removed from the inventory. Duplicates of all objects are retained in the various inventory containers below.
-    **/
-    std::map<uint32_t, std::shared_ptr<GlobalObject>> _inventory;
-
-    /** \brief Inventory containers
-    *** These vectors contain the inventory of the entire party. The vectors are sorted according to the player's personal preferences.
-    *** When a new object is added to the inventory, by default it will be placed at the end of the vector.
-    **/
-    //@{
-    std::vector<std::shared_ptr<GlobalItem>>    _inventory_items;
-    std::vector<std::shared_ptr<GlobalWeapon>>  _inventory_weapons;
-    std::vector<std::shared_ptr<GlobalArmor>>   _inventory_head_armor;
-    std::vector<std::shared_ptr<GlobalArmor>>   _inventory_torso_armor;
-    std::vector<std::shared_ptr<GlobalArmor>>   _inventory_arm_armor;
-    std::vector<std::shared_ptr<GlobalArmor>>   _inventory_leg_armor;
-    std::vector<std::shared_ptr<GlobalSpirit>>  _inventory_spirits;
-
-    //! \brief The key items can be any kind of items.
-    std::vector<std::shared_ptr<GlobalObject>> _inventory_key_items;
-    //@}
+    //! \brief The objects currently stored in the player's inventory.
+    GlobalInventory _inventory;
 
     //! \name Global data and function script files
     //@{
@@ -961,11 +990,17 @@ private:
     vt_script::ReadScriptDescriptor _map_treasures_script;
     //@}
 
+    //! \brief The objects definitions, loaded from the inventory scripts when first needed.
+    GlobalObjectRegistry _object_registry;
+
     /** \brief The container which stores all of the groups of events that have occured in the game
     *** The name of each GlobalEventGroup object serves as its key in this map data structure.
     **/
     std::map<std::string, GlobalEventGroup *> _event_groups;
 
+    //! \brief The same event groups, by interned group name. The entries can be nullptr.
+    std::vector<GlobalEventGroup *> _event_groups_by_id;
+
     /** \brief The container which stores the quest log entries in the game. the quest log key
     *** acts as the key for this quest
     *** \note due to a limitation with OptionBoxes, we can only currently only support 255
@@ -1012,34 +1047,23 @@ private:
 
     // ----- Private methods
 
-    /** \brief A helper template function that finds and removes an object from the inventory
-    *** \param obj_id The ID of the object to remove from the inventory
-    *** \param inv The vector container of the appropriate inventory type
-    *** \return True if the object was successfully removed, or false if it was not
-    **/
-    template <class T> bool _RemoveFromInventory(uint32_t obj_id, std::vector<std::shared_ptr<T>>& inv);
-
-    /** \brief A helper template function that finds and returns a copy of an object from the inventory
-    *** \param obj_id The ID of the object to obtain from the inventory
-    *** \param inv The vector container of the appropriate inventory type
-    *** \return A pointer to the newly created copy of the object, or nullptr if the object could not be found
-    **/
-    template <class T> std::shared_ptr<T> _GetFromInventory(uint32_t obj_id, const std::vector<std::shared_ptr<T>>& inv);
-
-    /** \brief A helper function to GameGlobal::SaveGame() that stores the contents of a type of inventory to the saved game file
-    *** \param file A reference to the open and valid file where to write the inventory list
-    *** \param name The name under which this set of inventory data should be categorized (ie "items", "weapons", etc)
-    *** \param inv A reference to the inventory vector to store
-    *** \note The class type T must be a derived class of GlobalObject
+    /** \brief Helper functions to GameGlobal::SaveGame() writing each a section of the saved game file.
+    *** \param file The save file being written.
+    *** \note The inventory doesn't contain the weapons and armor equipped on the characters.
+    *** That data is stored alongside the character data.
     **/
-    template <class T> void _SaveInventory(vt_script::WriteScriptDescriptor &file, const std::string &name, const std::vector<std::shared_ptr<T>>& inv);
+    //@{
+    void _SavePreview(SaveFileWriter& file);
+    void _SaveInventory(SaveFileWriter& file);
+    void _SaveCharacters(SaveFileWriter& file);
+    void _SaveEvents(SaveFileWriter& file);
+    void _SaveQuests(SaveFileWriter& file);
+    void _SaveWorldMap(SaveFileWriter& file);
+    void _SaveShopData(SaveFileWriter& file);
+    //@}
 
-    /** \brief A helper function to GameGlobal::SaveGame() that writes a group of event data to the saved game file
-    *** \param file A reference to the open and valid file where to write the event data
-    *** \param event_group A pointer to the group of events to store
-    *** This method will need to be called once for each GlobalEventGroup contained by this class.
-    **/
-    void _SaveEvents(vt_script::WriteScriptDescriptor &file, GlobalEventGroup *event_group);
+    //! \brief Waits for the saved game file task, and keeps its result.
+    void _FinishSaveTask();
 
     /** \brief adds a new quest log entry into the quest log entries table. also updates the quest log number
     *** \param quest_id for the quest
@@ -1059,21 +1083,27 @@ private:
         return true;
     }
 
-    /** \brief Helper function that saves the Quest Log entries. this is called from SaveGame()
-    *** \param file Reference to open and valid file set for writting the data
-    *** \param the quest log entry we wish to write
+    /** \brief Loads a binary saved game file, without the help of the script engine.
+    *** \return false if the file is invalid or doesn't contain any character.
     **/
-    void _SaveQuests(vt_script::WriteScriptDescriptor& file, const QuestLogEntry* quest_log_entry);
+    bool _LoadBinaryGame(const std::string& filename);
 
-    /** \brief saves the world map information. this is called from SaveGame()
-    *** \param file Reference to open and valid file for writting the data
+    /** \brief Helper functions to GameGlobal::_LoadBinaryGame() reading each a section of the saved game file.
+    *** \param file The save file being read. The missing sections are ignored.
     **/
-    void _SaveWorldMap(vt_script::WriteScriptDescriptor& file);
+    //@{
+    void _LoadInventory(SaveFileReader& file);
+    void _LoadCharacters(SaveFileReader& file);
+    void _LoadEvents(SaveFileReader& file);
+    void _LoadQuests(SaveFileReader& file);
+    void _LoadWorldMap(SaveFileReader& file);
+    void _LoadShopData(SaveFileReader& file);
+    //@}
 
-    /** \brief saves the shop data information. this is called from SaveGame()
-    *** \param file Reference to open and valid file for writting the data
+    /** \brief Loads a former Lua saved game file, through the script engine.
+    *** \return false if the file is invalid or doesn't contain any character.
     **/
-    void _SaveShopData(vt_script::WriteScriptDescriptor& file);
+    bool _LoadLegacyGame(const std::string& filename);
 
     /** \brief A helper function to GameGlobal::LoadGame() that restores the contents of the inventory from a saved game file
     *** \param file A reference to the open and valid file from where to read the inventory list
@@ -1117,75 +1147,20 @@ private:
     //! Loads every persistent scripts, used at the global initialization time.
     bool _LoadGlobalScripts();
 
+    //! Loads the persistent scripts of a single initialization step.
+    bool _LoadGlobalScripts(GLOBAL_INIT_STEP step);
+
     //! Unloads every persistent scripts by closing their files.
     void _CloseGlobalScripts();
-}; // class GameGlobal : public vt_utils::Singleton<GameGlobal>
-
-//-----------------------------------------------------------------------------
-// Template Function Definitions
-//-----------------------------------------------------------------------------
-
-template <class T> bool GameGlobal::_RemoveFromInventory(uint32_t obj_id, std::vector<std::shared_ptr<T>>& inv)
-{
-    for (auto i = inv.begin(); i != inv.end(); i++) {
-        if ((*i)->GetID() == obj_id) {
-            inv.erase(i);
-            _inventory.erase(obj_id);
-            return true;
-        }
-    }
-
-    return false;
-}
-
-template <class T> std::shared_ptr<T> GameGlobal::_GetFromInventory(uint32_t obj_id, const std::vector<std::shared_ptr<T>>& inv)
-{
-    for (auto it = inv.begin(); it != inv.end(); ++it) {
-
-        if ((*it)->GetID() != obj_id)
-            continue;
-
-        auto return_object = std::make_shared<T>(**it);
-        return_object->SetCount(1);
-        return return_object;
-    }
-
-    return nullptr;
-}
 
-template <class T> void GameGlobal::_SaveInventory(vt_script::WriteScriptDescriptor &file, const std::string &name, const std::vector<std::shared_ptr<T>>& inv)
-{
-    if (file.IsFileOpen() == false) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "failed because the argument file was not open" << std::endl;
-        return;
-    }
-
-    file.InsertNewLine();
-    file.WriteLine(name + " = {");
-
-    for (uint32_t i = 0; i < inv.size(); i++) {
-        // Don't save inventory items with 0 count
-        if (inv[i]->GetCount() == 0)
-            continue;
-
-        if (i == 0)
-            file.WriteLine("\t", false);
-        else
-            file.WriteLine(", ", false);
-
-        // Add a new line every 10 entries for better readability and debugging
-        if ((i > 0) && !(i % 10)) {
-            file.InsertNewLine();
-            file.WriteLine("\t", false);
-        }
-
-        file.WriteLine("[" + vt_utils::NumberToString(inv[i]->GetID()) + "] = " +
-                       vt_utils::NumberToString(inv[i]->GetCount()), false);
+    //! \brief Returns the event group of an interned group name, or nullptr.
+    GlobalEventGroup* _GetEventGroup(uint32_t group_id) const {
+        return group_id < _event_groups_by_id.size() ? _event_groups_by_id[group_id] : nullptr;
     }
 
-    file.InsertNewLine();
-    file.WriteLine("},");
-}
+    //! \brief Creates a new event group. The group must not already exist.
+    GlobalEventGroup* _CreateEventGroup(const std::string &group_name);
+}; // class GameGlobal : public vt_utils::Singleton<GameGlobal>
 
 } // namespace vt_global
 
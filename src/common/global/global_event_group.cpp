@@ -10,41 +10,218 @@
 
 #include "global_event_group.h"
 
+#include "engine/binary_utils.h"
+
 #include "utils/utils_common.h"
+#include "utils/utils_strings.h"
+
+#include <algorithm>
 
 namespace vt_global {
 
 extern bool GLOBAL_DEBUG;
 
+namespace private_global {
+
+//! \brief The initial number of slots of the hash tables. Must be a power of two.
+const uint32_t EVENT_TABLE_INITIAL_SIZE = 16;
+
+EventNameTable& EventNameTable::_GetInstance()
+{
+    static EventNameTable table;
+    return table;
+}
+
+uint32_t EventNameTable::_FindSlot(const std::string& name, uint64_t hash) const
+{
+    uint32_t mask = _slots.size() - 1;
+    uint32_t slot = static_cast<uint32_t>(hash) & mask;
+    while (_slots[slot] != 0) {
+        uint32_t index = _slots[slot] - 1;
+        if (_hashes[index] == hash && _names[index] == name)
+            break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+uint32_t EventNameTable::Intern(const std::string& name)
+{
+    EventNameTable& table = _GetInstance();
+    if (table._slots.empty())
+        table._slots.resize(EVENT_TABLE_INITIAL_SIZE, 0);
+
+    uint64_t hash = vt_system::ComputeHash(name);
+    uint32_t slot = table._FindSlot(name, hash);
+    if (table._slots[slot] != 0)
+        return table._slots[slot];
+
+    table._names.push_back(name);
+    table._hashes.push_back(hash);
+    uint32_t id = table._names.size();
+
+    // Keep the table at most half full.
+    if (id * 2 > table._slots.size()) {
+        table._slots.assign(table._slots.size() * 2, 0);
+        uint32_t mask = table._slots.size() - 1;
+        for (uint32_t i = 0; i < table._names.size(); ++i) {
+            uint32_t new_slot = static_cast<uint32_t>(table._hashes[i]) & mask;
+            while (table._slots[new_slot] != 0)
+                new_slot = (new_slot + 1) & mask;
+            table._slots[new_slot] = i + 1;
+        }
+    }
+    else {
+        table._slots[slot] = id;
+    }
+    return id;
+}
+
+uint32_t EventNameTable::Find(const std::string& name)
+{
+    const EventNameTable& table = _GetInstance();
+    if (table._slots.empty())
+        return 0;
+    return table._slots[table._FindSlot(name, vt_system::ComputeHash(name))];
+}
+
+const std::string& EventNameTable::GetName(uint32_t id)
+{
+    const EventNameTable& table = _GetInstance();
+    if (id == 0 || id > table._names.size())
+        return vt_utils::_empty_string;
+    return table._names[id - 1];
+}
+
+} // namespace private_global
+
+using namespace private_global;
+
+//! \brief Spreads the consecutive interned numbers over the table.
+static inline uint32_t _HashEventId(uint32_t event_id)
+{
+    return event_id * 2654435761u;
+}
+
+GlobalEventGroup::GlobalEventGroup(const std::string &group_name) :
+    _group_name(group_name),
+    _group_id(EventNameTable::Intern(group_name)),
+    _number_events(0)
+{
+}
+
 void GlobalEventGroup::AddNewEvent(const std::string &event_name, int32_t event_value)
 {
-    if(DoesEventExist(event_name)) {
+    uint32_t event_id = EventNameTable::Intern(event_name);
+    if(DoesEventExist(event_id)) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "an event with the desired name \"" << event_name << "\" already existed in this group: "
                                        << _group_name << std::endl;
         return;
     }
-    _events.insert(std::make_pair(event_name, event_value));
+    SetEvent(event_id, event_value);
 }
 
-int32_t GlobalEventGroup::GetEvent(const std::string &event_name)
+int32_t GlobalEventGroup::GetEvent(const std::string &event_name) const
 {
-    std::map<std::string, int32_t>::iterator event_iter = _events.find(event_name);
-    if(event_iter == _events.end()) {
+    const EventSlot* slot = _FindSlot(EventNameTable::Find(event_name));
+    if(slot == nullptr) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "an event with the specified name \"" << event_name << "\" did not exist in this group: "
                                        << _group_name << std::endl;
         return 0;
     }
-    return event_iter->second;
+    return slot->value;
 }
 
-void GlobalEventGroup::SetEvent(const std::string &event_name, int32_t event_value)
+void GlobalEventGroup::SetEvent(uint32_t event_id, int32_t event_value)
 {
-    std::map<std::string, int32_t>::iterator event_iter = _events.find(event_name);
-    if(event_iter == _events.end()) {
-        AddNewEvent(event_name, event_value);
+    if (event_id == 0)
         return;
+
+    EventSlot* slot = const_cast<EventSlot*>(_FindSlot(event_id));
+    if (slot != nullptr) {
+        slot->value = event_value;
+        return;
+    }
+
+    // Keep the table at most half full.
+    if ((_number_events + 1) * 2 > _slots.size())
+        _Grow();
+
+    uint32_t mask = _slots.size() - 1;
+    uint32_t index = _HashEventId(event_id) & mask;
+    while (_slots[index].id != 0)
+        index = (index + 1) & mask;
+    _slots[index].id = event_id;
+    _slots[index].value = event_value;
+    ++_number_events;
+}
+
+std::map<std::string, int32_t> GlobalEventGroup::GetEvents() const
+{
+    std::map<std::string, int32_t> events;
+    for (uint32_t i = 0; i < _slots.size(); ++i) {
+        if (_slots[i].id != 0)
+            events.insert(std::make_pair(EventNameTable::GetName(_slots[i].id), _slots[i].value));
+    }
+    return events;
+}
+
+//! \brief Orders the snapshots values by group, then event number.
+static bool _CompareEventValues(const GlobalEventValue& a, const GlobalEventValue& b)
+{
+    if (a.handle.group_id != b.handle.group_id)
+        return a.handle.group_id < b.handle.group_id;
+    return a.handle.event_id < b.handle.event_id;
+}
+
+void GlobalEventGroup::AppendToSnapshot(GlobalEventSnapshot& snapshot) const
+{
+    size_t start = snapshot.size();
+    for (uint32_t i = 0; i < _slots.size(); ++i) {
+        if (_slots[i].id == 0)
+            continue;
+        GlobalEventValue event_value;
+        event_value.handle = GlobalEventHandle(_group_id, _slots[i].id);
+        event_value.value = _slots[i].value;
+        snapshot.push_back(event_value);
+    }
+    std::sort(snapshot.begin() + start, snapshot.end(), _CompareEventValues);
+}
+
+const GlobalEventGroup::EventSlot* GlobalEventGroup::_FindSlot(uint32_t event_id) const
+{
+    if (event_id == 0 || _slots.empty())
+        return nullptr;
+
+    uint32_t mask = _slots.size() - 1;
+    uint32_t index = _HashEventId(event_id) & mask;
+    while (_slots[index].id != 0) {
+        if (_slots[index].id == event_id)
+            return &_slots[index];
+        index = (index + 1) & mask;
+    }
+    return nullptr;
+}
+
+void GlobalEventGroup::_Grow()
+{
+    std::vector<EventSlot> old_slots;
+    old_slots.swap(_slots);
+
+    EventSlot empty_slot;
+    empty_slot.id = 0;
+    empty_slot.value = 0;
+    _slots.assign(old_slots.empty() ? EVENT_TABLE_INITIAL_SIZE : old_slots.size() * 2, empty_slot);
+
+    uint32_t mask = _slots.size() - 1;
+    for (uint32_t i = 0; i < old_slots.size(); ++i) {
+        if (old_slots[i].id == 0)
+            continue;
+        uint32_t index = _HashEventId(old_slots[i].id) & mask;
+        while (_slots[index].id != 0)
+            index = (index + 1) & mask;
+        _slots[index] = old_slots[i];
     }
-    event_iter->second = event_value;
 }
 
 } // namespace vt_global
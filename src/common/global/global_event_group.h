@@ -13,10 +13,90 @@
 
 #include <string>
 #include <map>
+#include <vector>
+#include <cstdint>
 
 namespace vt_global
 {
 
+namespace private_global
+{
+
+/** ****************************************************************************
+*** \brief Gives a unique number to each event and event group name.
+***
+*** The names are hashed only once, when interned, and the events are then
+*** stored and found by their number. The numbers start at 1, 0 being
+*** used for unknown names. The names are never forgotten, so that a number
+*** stays valid for the whole game run.
+***
+*** \note The table isn't thread safe: it must only be used from the main thread.
+*** ***************************************************************************/
+class EventNameTable
+{
+public:
+    //! \brief Returns the number of the given name, adding it when new.
+    static uint32_t Intern(const std::string& name);
+
+    //! \brief Returns the number of the given name, or 0 when it was never interned.
+    static uint32_t Find(const std::string& name);
+
+    //! \brief Returns the name of an interned number, or an empty string.
+    static const std::string& GetName(uint32_t id);
+
+private:
+    EventNameTable() {}
+
+    //! \brief The names, by number - 1, and their hash.
+    std::vector<std::string> _names;
+    std::vector<uint64_t> _hashes;
+
+    //! \brief The open addressing table, containing the names numbers. 0 for empty slots.
+    std::vector<uint32_t> _slots;
+
+    static EventNameTable& _GetInstance();
+
+    //! \brief Returns the slot where the name is, or the empty slot where it should be.
+    uint32_t _FindSlot(const std::string& name, uint64_t hash) const;
+};
+
+} // namespace private_global
+
+/** ****************************************************************************
+*** \brief A resolved reference to an event, for the code and scripts checking
+*** the same event often. Obtained through GameGlobal::GetEventHandle().
+*** ***************************************************************************/
+struct GlobalEventHandle {
+    GlobalEventHandle():
+        group_id(0),
+        event_id(0)
+    {}
+
+    GlobalEventHandle(uint32_t group, uint32_t event):
+        group_id(group),
+        event_id(event)
+    {}
+
+    bool IsValid() const {
+        return group_id != 0 && event_id != 0;
+    }
+
+    //! \brief The interned group and event names.
+    uint32_t group_id;
+    uint32_t event_id;
+};
+
+//! \brief An event value, as stored in the events snapshots.
+struct GlobalEventValue {
+    GlobalEventHandle handle;
+    int32_t value;
+};
+
+/** \brief A copy of every event value, ordered by group and event number,
+*** e.g. to save the game events or to know which ones changed since.
+**/
+typedef std::vector<GlobalEventValue> GlobalEventSnapshot;
+
 /** ****************************************************************************
 *** \brief A container that manages the occurences of several related game events
 ***
@@ -36,6 +116,8 @@ namespace vt_global
 *** event group could represent all of the events that occured on a particular
 *** map, for instance.
 ***
+*** The events are stored in a flat hash table, by interned event name number.
+***
 *** \note Other parts of the code should not have a need to construct objects of
 *** this class. The GameGlobal class maintains a container of GlobalEventGroup
 *** objects and provides methods to allow the creation, modification, and
@@ -45,8 +127,7 @@ class GlobalEventGroup
 {
 public:
     //! \param group_name The name of the group to create (this can not be changed)
-    explicit GlobalEventGroup(const std::string &group_name) :
-        _group_name(group_name) {}
+    explicit GlobalEventGroup(const std::string &group_name);
 
     ~GlobalEventGroup() {}
 
@@ -54,9 +135,12 @@ public:
     *** \param event_name The name of the event to check for
     *** \return True if the event name was found in the group, false if it was not
     **/
-    bool DoesEventExist(const std::string &event_name) {
-        if(_events.find(event_name) != _events.end()) return true;
-        else return false;
+    bool DoesEventExist(const std::string &event_name) const {
+        return DoesEventExist(private_global::EventNameTable::Find(event_name));
+    }
+
+    bool DoesEventExist(uint32_t event_id) const {
+        return _FindSlot(event_id) != nullptr;
     }
 
     /** \brief Adds a new event to the group
@@ -72,18 +156,29 @@ public:
     *** \return The value of the event, or 0 if there is no event corresponding to
     *** the requested event named
     **/
-    int32_t GetEvent(const std::string &event_name);
+    int32_t GetEvent(const std::string &event_name) const;
+
+    //! \brief Returns the value of an event from its interned name, or 0 when not found.
+    int32_t GetEvent(uint32_t event_id) const {
+        const EventSlot* slot = _FindSlot(event_id);
+        return slot ? slot->value : 0;
+    }
 
     /** \brief Sets the value for an existing event
     *** \param event_name The name of the event whose value should be changed
     *** \param event_value The value to set for the event.
     *** \note If the event by the given name is not found, the event group will be created.
     **/
-    void SetEvent(const std::string &event_name, int32_t event_value);
+    void SetEvent(const std::string &event_name, int32_t event_value) {
+        SetEvent(private_global::EventNameTable::Intern(event_name), event_value);
+    }
+
+    //! \brief Sets the value of an event from its interned name, adding the event when needed.
+    void SetEvent(uint32_t event_id, int32_t event_value);
 
     //! \brief Returns the number of events currently stored within the group
     uint32_t GetNumberEvents() const {
-        return _events.size();
+        return _number_events;
     }
 
     //! \brief Returns a copy of the name of this group
@@ -91,21 +186,41 @@ public:
         return _group_name;
     }
 
-    //! \brief Returns an immutable reference to the private _events container
-    const std::map<std::string, int32_t>& GetEvents() const {
-        return _events;
+    //! \brief Returns the interned group name.
+    uint32_t GetGroupId() const {
+        return _group_id;
     }
 
+    //! \brief Returns the events, ordered by name.
+    std::map<std::string, int32_t> GetEvents() const;
+
+    //! \brief Appends the events values to a snapshot, ordered by event number.
+    void AppendToSnapshot(GlobalEventSnapshot& snapshot) const;
+
 private:
+    //! \brief An event, 0 being the id of empty slots.
+    struct EventSlot {
+        uint32_t id;
+        int32_t value;
+    };
+
     //! \brief The name given to this group of events
     std::string _group_name;
+    uint32_t _group_id;
 
-    /** \brief The map container for all the events in the group
-    *** The string is the name of the event, which is unique within the group. The integer value
-    *** represents the event's state and can take on multiple meanings depending on the context
-    *** of this specific event.
+    /** \brief The open addressing table containing the events of the group
+    *** The integer value represents the event's state and can take on multiple meanings
+    *** depending on the context of this specific event. The size is a power of two.
     **/
-    std::map<std::string, int32_t> _events;
+    std::vector<EventSlot> _slots;
+
+    uint32_t _number_events;
+
+    //! \brief Returns the slot of an event, or nullptr.
+    const EventSlot* _FindSlot(uint32_t event_id) const;
+
+    //! \brief Doubles the table size.
+    void _Grow();
 }; // class GlobalEventGroup
 
 } // namespace vt_global
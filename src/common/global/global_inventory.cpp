@@ -0,0 +1,426 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    global_inventory.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the party inventory.
+*** ***************************************************************************/
+
+#include "global_inventory.h"
+
+#include <algorithm>
+
+using namespace vt_global::private_global;
+
+namespace vt_global
+{
+
+extern bool GLOBAL_DEBUG;
+
+//! \brief Orders the objects of a view. The ties are broken by id, so that the order is total.
+class InventorySortCompare
+{
+public:
+    explicit InventorySortCompare(INVENTORY_SORT sort):
+        _sort(sort)
+    {}
+
+    bool operator()(const std::shared_ptr<GlobalObject>& a, const std::shared_ptr<GlobalObject>& b) const {
+        switch (_sort) {
+        case INVENTORY_SORT_NAME: {
+            const vt_utils::ustring& name_a = a->GetName();
+            const vt_utils::ustring& name_b = b->GetName();
+            if (std::lexicographical_compare(name_a.c_str(), name_a.c_str() + name_a.length(),
+                                             name_b.c_str(), name_b.c_str() + name_b.length()))
+                return true;
+            if (std::lexicographical_compare(name_b.c_str(), name_b.c_str() + name_b.length(),
+                                             name_a.c_str(), name_a.c_str() + name_a.length()))
+                return false;
+            break;
+        }
+        case INVENTORY_SORT_TYPE:
+            if (a->GetObjectType() != b->GetObjectType())
+                return a->GetObjectType() < b->GetObjectType();
+            break;
+        case INVENTORY_SORT_COUNT:
+            if (a->GetCount() != b->GetCount())
+                return a->GetCount() > b->GetCount();
+            break;
+        case INVENTORY_SORT_VALUE:
+            if (a->GetPrice() != b->GetPrice())
+                return a->GetPrice() > b->GetPrice();
+            break;
+        default:
+            break;
+        }
+        return a->GetID() < b->GetID();
+    }
+
+private:
+    INVENTORY_SORT _sort;
+};
+
+//! \brief Inserts an object in a sorted view.
+static void _InsertInView(std::vector<std::shared_ptr<GlobalObject>>& view,
+                          const std::shared_ptr<GlobalObject>& object, INVENTORY_SORT sort)
+{
+    InventorySortCompare compare(sort);
+    view.insert(std::upper_bound(view.begin(), view.end(), object, compare), object);
+}
+
+//! \brief Removes an object from a sorted view. Its sort keys must not have changed since its insertion.
+static void _EraseFromView(std::vector<std::shared_ptr<GlobalObject>>& view,
+                           const std::shared_ptr<GlobalObject>& object, INVENTORY_SORT sort)
+{
+    InventorySortCompare compare(sort);
+    auto it = std::lower_bound(view.begin(), view.end(), object, compare);
+    if (it != view.end() && *it == object)
+        view.erase(it);
+    else
+        PRINT_WARNING << "object not found in the inventory view: " << object->GetID() << std::endl;
+}
+
+GlobalInventory::GlobalInventory()
+{
+    for (uint32_t i = 0; i < ITEM_CATEGORY_SIZE; ++i) {
+        _revisions[i] = 1;
+        for (uint32_t j = 0; j < INVENTORY_SORT_TOTAL; ++j)
+            _views_built[i][j] = false;
+    }
+}
+
+void GlobalInventory::Clear()
+{
+    _indices.clear();
+    _objects.clear();
+    _entries.clear();
+    _items.clear();
+    _weapons.clear();
+    _head_armor.clear();
+    _torso_armor.clear();
+    _arm_armor.clear();
+    _leg_armor.clear();
+    _spirits.clear();
+    _key_items.clear();
+
+    // The cleared views are still sorted.
+    for (uint32_t i = 0; i < ITEM_CATEGORY_SIZE; ++i) {
+        ++_revisions[i];
+        for (uint32_t j = 0; j < INVENTORY_SORT_TOTAL; ++j)
+            _views[i][j].clear();
+    }
+}
+
+bool GlobalInventory::AddObject(const std::shared_ptr<GlobalObject>& object)
+{
+    if (object == nullptr || !object->IsValid()) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to add an invalid object to the inventory" << std::endl;
+        return false;
+    }
+
+    uint32_t id = object->GetID();
+    if (HasObject(id)) {
+        IncrementCount(id, object->GetCount());
+        return true;
+    }
+
+    InventoryEntry entry;
+    entry.key_index = 0;
+    switch (object->GetObjectType()) {
+    case GLOBAL_OBJECT_ITEM:
+        entry.category_index = _items.size();
+        _items.push_back(std::static_pointer_cast<GlobalItem>(object));
+        break;
+    case GLOBAL_OBJECT_WEAPON:
+        entry.category_index = _weapons.size();
+        _weapons.push_back(std::static_pointer_cast<GlobalWeapon>(object));
+        break;
+    case GLOBAL_OBJECT_HEAD_ARMOR:
+        entry.category_index = _head_armor.size();
+        _head_armor.push_back(std::static_pointer_cast<GlobalArmor>(object));
+        break;
+    case GLOBAL_OBJECT_TORSO_ARMOR:
+        entry.category_index = _torso_armor.size();
+        _torso_armor.push_back(std::static_pointer_cast<GlobalArmor>(object));
+        break;
+    case GLOBAL_OBJECT_ARM_ARMOR:
+        entry.category_index = _arm_armor.size();
+        _arm_armor.push_back(std::static_pointer_cast<GlobalArmor>(object));
+        break;
+    case GLOBAL_OBJECT_LEG_ARMOR:
+        entry.category_index = _leg_armor.size();
+        _leg_armor.push_back(std::static_pointer_cast<GlobalArmor>(object));
+        break;
+    case GLOBAL_OBJECT_SPIRIT:
+        entry.category_index = _spirits.size();
+        _spirits.push_back(std::static_pointer_cast<GlobalSpirit>(object));
+        break;
+    default:
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to add an object of unknown type to the inventory: " << id << std::endl;
+        return false;
+    }
+
+    if (object->IsKeyItem()) {
+        _key_items.push_back(object);
+        entry.key_index = _key_items.size();
+    }
+
+    if (id >= _indices.size())
+        _indices.resize(id + 1, 0);
+    _objects.push_back(object);
+    _entries.push_back(entry);
+    _indices[id] = _objects.size();
+
+    _AddToViews(object);
+    return true;
+}
+
+bool GlobalInventory::RemoveObject(uint32_t id)
+{
+    if (!HasObject(id))
+        return false;
+
+    uint32_t index = _indices[id] - 1;
+    std::shared_ptr<GlobalObject> object = _objects[index];
+    InventoryEntry entry = _entries[index];
+
+    _RemoveFromViews(object);
+
+    if (entry.key_index != 0)
+        _RemoveAt(_key_items, entry.key_index - 1, true);
+
+    switch (object->GetObjectType()) {
+    case GLOBAL_OBJECT_ITEM:
+        _RemoveAt(_items, entry.category_index, false);
+        break;
+    case GLOBAL_OBJECT_WEAPON:
+        _RemoveAt(_weapons, entry.category_index, false);
+        break;
+    case GLOBAL_OBJECT_HEAD_ARMOR:
+        _RemoveAt(_head_armor, entry.category_index, false);
+        break;
+    case GLOBAL_OBJECT_TORSO_ARMOR:
+        _RemoveAt(_torso_armor, entry.category_index, false);
+        break;
+    case GLOBAL_OBJECT_ARM_ARMOR:
+        _RemoveAt(_arm_armor, entry.category_index, false);
+        break;
+    case GLOBAL_OBJECT_LEG_ARMOR:
+        _RemoveAt(_leg_armor, entry.category_index, false);
+        break;
+    case GLOBAL_OBJECT_SPIRIT:
+        _RemoveAt(_spirits, entry.category_index, false);
+        break;
+    default:
+        break;
+    }
+
+    // Move the last object in place of the removed one.
+    uint32_t last = _objects.size() - 1;
+    if (index != last) {
+        _objects[index] = _objects[last];
+        _entries[index] = _entries[last];
+        _indices[_objects[index]->GetID()] = index + 1;
+    }
+    _objects.pop_back();
+    _entries.pop_back();
+    _indices[id] = 0;
+    return true;
+}
+
+bool GlobalInventory::IncrementCount(uint32_t id, uint32_t count)
+{
+    if (!HasObject(id))
+        return false;
+
+    if (count == 0)
+        return true;
+
+    const std::shared_ptr<GlobalObject>& object = _objects[_indices[id] - 1];
+    _SetCount(object, object->GetCount() + count);
+    return true;
+}
+
+bool GlobalInventory::DecrementCount(uint32_t id, uint32_t count)
+{
+    if (!HasObject(id))
+        return false;
+
+    if (count == 0)
+        return true;
+
+    const std::shared_ptr<GlobalObject>& object = _objects[_indices[id] - 1];
+    if (count >= object->GetCount())
+        RemoveObject(id);
+    else
+        _SetCount(object, object->GetCount() - count);
+    return true;
+}
+
+const std::shared_ptr<GlobalObject>& GlobalInventory::GetObject(uint32_t id) const
+{
+    static const std::shared_ptr<GlobalObject> no_object;
+    return HasObject(id) ? _objects[_indices[id] - 1] : no_object;
+}
+
+bool GlobalInventory::IsEmpty(ITEM_CATEGORY category) const
+{
+    switch (category) {
+    case ITEM_ALL:
+        return _objects.empty();
+    case ITEM_ITEM:
+        return _items.empty();
+    case ITEM_WEAPON:
+        return _weapons.empty();
+    case ITEM_HEAD_ARMOR:
+        return _head_armor.empty();
+    case ITEM_TORSO_ARMOR:
+        return _torso_armor.empty();
+    case ITEM_ARMS_ARMOR:
+        return _arm_armor.empty();
+    case ITEM_LEGS_ARMOR:
+        return _leg_armor.empty();
+    case ITEM_KEY:
+        return _key_items.empty();
+    default:
+        return true;
+    }
+}
+
+const std::vector<std::shared_ptr<GlobalObject>>& GlobalInventory::GetView(ITEM_CATEGORY category, INVENTORY_SORT sort)
+{
+    if (category >= ITEM_CATEGORY_SIZE || sort >= INVENTORY_SORT_TOTAL) {
+        PRINT_WARNING << "invalid inventory view: " << category << ", " << sort << std::endl;
+        category = ITEM_ALL;
+        sort = INVENTORY_SORT_ID;
+    }
+
+    std::vector<std::shared_ptr<GlobalObject>>& view = _views[category][sort];
+    if (_views_built[category][sort])
+        return view;
+
+    view.clear();
+    switch (category) {
+    case ITEM_ALL:
+        view.assign(_objects.begin(), _objects.end());
+        break;
+    case ITEM_ITEM:
+        view.assign(_items.begin(), _items.end());
+        break;
+    case ITEM_WEAPON:
+        view.assign(_weapons.begin(), _weapons.end());
+        break;
+    case ITEM_HEAD_ARMOR:
+        view.assign(_head_armor.begin(), _head_armor.end());
+        break;
+    case ITEM_TORSO_ARMOR:
+        view.assign(_torso_armor.begin(), _torso_armor.end());
+        break;
+    case ITEM_ARMS_ARMOR:
+        view.assign(_arm_armor.begin(), _arm_armor.end());
+        break;
+    case ITEM_LEGS_ARMOR:
+        view.assign(_leg_armor.begin(), _leg_armor.end());
+        break;
+    case ITEM_KEY:
+        view.assign(_key_items.begin(), _key_items.end());
+        break;
+    default:
+        break;
+    }
+    std::sort(view.begin(), view.end(), InventorySortCompare(sort));
+
+    _views_built[category][sort] = true;
+    return view;
+}
+
+uint32_t GlobalInventory::_GetCategories(const GlobalObject& object, ITEM_CATEGORY categories[3])
+{
+    uint32_t number = 0;
+    categories[number++] = ITEM_ALL;
+
+    // The spirits are only listed with all the objects.
+    switch (object.GetObjectType()) {
+    case GLOBAL_OBJECT_ITEM:
+        categories[number++] = ITEM_ITEM;
+        break;
+    case GLOBAL_OBJECT_WEAPON:
+        categories[number++] = ITEM_WEAPON;
+        break;
+    case GLOBAL_OBJECT_HEAD_ARMOR:
+        categories[number++] = ITEM_HEAD_ARMOR;
+        break;
+    case GLOBAL_OBJECT_TORSO_ARMOR:
+        categories[number++] = ITEM_TORSO_ARMOR;
+        break;
+    case GLOBAL_OBJECT_ARM_ARMOR:
+        categories[number++] = ITEM_ARMS_ARMOR;
+        break;
+    case GLOBAL_OBJECT_LEG_ARMOR:
+        categories[number++] = ITEM_LEGS_ARMOR;
+        break;
+    default:
+        break;
+    }
+
+    if (object.IsKeyItem())
+        categories[number++] = ITEM_KEY;
+    return number;
+}
+
+void GlobalInventory::_AddToViews(const std::shared_ptr<GlobalObject>& object)
+{
+    ITEM_CATEGORY categories[3];
+    uint32_t number = _GetCategories(*object, categories);
+    for (uint32_t i = 0; i < number; ++i) {
+        ITEM_CATEGORY category = categories[i];
+        ++_revisions[category];
+        for (uint32_t j = 0; j < INVENTORY_SORT_TOTAL; ++j) {
+            if (_views_built[category][j])
+                _InsertInView(_views[category][j], object, static_cast<INVENTORY_SORT>(j));
+        }
+    }
+}
+
+void GlobalInventory::_RemoveFromViews(const std::shared_ptr<GlobalObject>& object)
+{
+    ITEM_CATEGORY categories[3];
+    uint32_t number = _GetCategories(*object, categories);
+    for (uint32_t i = 0; i < number; ++i) {
+        ITEM_CATEGORY category = categories[i];
+        ++_revisions[category];
+        for (uint32_t j = 0; j < INVENTORY_SORT_TOTAL; ++j) {
+            if (_views_built[category][j])
+                _EraseFromView(_views[category][j], object, static_cast<INVENTORY_SORT>(j));
+        }
+    }
+}
+
+void GlobalInventory::_SetCount(const std::shared_ptr<GlobalObject>& object, uint32_t count)
+{
+    ITEM_CATEGORY categories[3];
+    uint32_t number = _GetCategories(*object, categories);
+
+    // Only the views sorted by count need to be reordered.
+    for (uint32_t i = 0; i < number; ++i) {
+        if (_views_built[categories[i]][INVENTORY_SORT_COUNT])
+            _EraseFromView(_views[categories[i]][INVENTORY_SORT_COUNT], object, INVENTORY_SORT_COUNT);
+    }
+
+    object->SetCount(count);
+
+    for (uint32_t i = 0; i < number; ++i) {
+        ++_revisions[categories[i]];
+        if (_views_built[categories[i]][INVENTORY_SORT_COUNT])
+            _InsertInView(_views[categories[i]][INVENTORY_SORT_COUNT], object, INVENTORY_SORT_COUNT);
+    }
+}
+
+} // namespace vt_global
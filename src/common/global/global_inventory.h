@@ -0,0 +1,231 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    global_inventory.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the party inventory.
+***
+*** The objects are stored in dense arrays, per kind of object, and found by id
+*** through a flat index. The menus and shops read the objects through sorted
+*** views, which are built the first time they are requested and then kept
+*** up to date by the inventory changes.
+*** ***************************************************************************/
+
+#ifndef __GLOBAL_INVENTORY_HEADER__
+#define __GLOBAL_INVENTORY_HEADER__
+
+#include "objects/global_item.h"
+#include "objects/global_weapon.h"
+#include "objects/global_armor.h"
+#include "objects/global_spirit.h"
+
+namespace vt_global
+{
+
+//! \brief The orders in which the inventory views can be sorted.
+enum INVENTORY_SORT {
+    INVENTORY_SORT_ID = 0,
+    INVENTORY_SORT_NAME = 1,
+    //! \brief By object type, then by id.
+    INVENTORY_SORT_TYPE = 2,
+    //! \brief The most numerous objects first.
+    INVENTORY_SORT_COUNT = 3,
+    //! \brief The most expensive objects first.
+    INVENTORY_SORT_VALUE = 4,
+    INVENTORY_SORT_TOTAL = 5
+};
+
+namespace private_global
+{
+
+//! \brief Where an inventory object is stored, besides the objects array.
+struct InventoryEntry {
+    //! \brief The object index in the array of its kind.
+    uint32_t category_index;
+
+    //! \brief The object index + 1 in the key items array, or 0 when not a key item.
+    uint32_t key_index;
+};
+
+} // namespace private_global
+
+/** ****************************************************************************
+*** \brief Stores the objects owned by the party.
+***
+*** Each object is present only once, with its count. Looking for an object,
+*** adding or removing it doesn't depend on the inventory size, apart from
+*** keeping the views already built sorted.
+***
+*** The objects arrays are not ordered: removing an object moves the last
+*** one of the array in its place. Use the views to display the objects.
+***
+*** \note The objects count must be changed through the inventory, so that
+*** the views sorted by count and the revisions are kept up to date.
+*** ***************************************************************************/
+class GlobalInventory
+{
+public:
+    GlobalInventory();
+
+    //! \brief Removes every object. The revisions keep increasing.
+    void Clear();
+
+    /** \brief Adds an object to the inventory, or increases its count when already there.
+    *** \param object The object to add. It is kept as is when not already in the inventory.
+    *** \return false if the object is invalid.
+    **/
+    bool AddObject(const std::shared_ptr<GlobalObject>& object);
+
+    //! \brief Removes an object from the inventory, whatever its count. Returns false if not found.
+    bool RemoveObject(uint32_t id);
+
+    //! \brief Increments the count of an object. Returns false if not found.
+    bool IncrementCount(uint32_t id, uint32_t count);
+
+    /** \brief Decrements the count of an object, and removes it once its count reaches zero.
+    *** \return false if not found.
+    **/
+    bool DecrementCount(uint32_t id, uint32_t count);
+
+    //! \brief Returns the inventory object with the given id, or nullptr.
+    const std::shared_ptr<GlobalObject>& GetObject(uint32_t id) const;
+
+    bool HasObject(uint32_t id) const {
+        return id < _indices.size() && _indices[id] != 0;
+    }
+
+    //! \brief Returns the count of an object, or 0 when not in the inventory.
+    uint32_t GetObjectCount(uint32_t id) const {
+        return HasObject(id) ? _objects[_indices[id] - 1]->GetCount() : 0;
+    }
+
+    bool IsEmpty() const {
+        return _objects.empty();
+    }
+
+    //! \brief Tells whether any object of the given category is in the inventory.
+    bool IsEmpty(ITEM_CATEGORY category) const;
+
+    /** \brief Returns the objects of a category, in the given order.
+    *** The view is sorted when first requested, and updated by the following
+    *** inventory changes. The reference is valid until the inventory is cleared.
+    **/
+    const std::vector<std::shared_ptr<GlobalObject>>& GetView(ITEM_CATEGORY category, INVENTORY_SORT sort);
+
+    /** \brief Returns a number changing whenever an object of the category is added,
+    *** removed or has its count changed. Used to know when the displayed lists are outdated.
+    **/
+    uint32_t GetRevision(ITEM_CATEGORY category) const {
+        return _revisions[category];
+    }
+
+    //! \name Unordered objects arrays
+    //@{
+    const std::vector<std::shared_ptr<GlobalObject>>& GetObjects() const {
+        return _objects;
+    }
+
+    const std::vector<std::shared_ptr<GlobalItem>>& GetItems() const {
+        return _items;
+    }
+
+    const std::vector<std::shared_ptr<GlobalWeapon>>& GetWeapons() const {
+        return _weapons;
+    }
+
+    const std::vector<std::shared_ptr<GlobalArmor>>& GetHeadArmors() const {
+        return _head_armor;
+    }
+
+    const std::vector<std::shared_ptr<GlobalArmor>>& GetTorsoArmors() const {
+        return _torso_armor;
+    }
+
+    const std::vector<std::shared_ptr<GlobalArmor>>& GetArmArmors() const {
+        return _arm_armor;
+    }
+
+    const std::vector<std::shared_ptr<GlobalArmor>>& GetLegArmors() const {
+        return _leg_armor;
+    }
+
+    const std::vector<std::shared_ptr<GlobalSpirit>>& GetSpirits() const {
+        return _spirits;
+    }
+
+    //! \brief The key items can be any kind of items, and are also stored with the objects of their kind.
+    const std::vector<std::shared_ptr<GlobalObject>>& GetKeyItems() const {
+        return _key_items;
+    }
+    //@}
+
+private:
+    //! \brief The object index + 1 in the objects array, by object id. 0 when not in the inventory.
+    std::vector<uint32_t> _indices;
+
+    //! \brief Every inventory object, and where it is stored in the other arrays.
+    std::vector<std::shared_ptr<GlobalObject>> _objects;
+    std::vector<private_global::InventoryEntry> _entries;
+
+    std::vector<std::shared_ptr<GlobalItem>>    _items;
+    std::vector<std::shared_ptr<GlobalWeapon>>  _weapons;
+    std::vector<std::shared_ptr<GlobalArmor>>   _head_armor;
+    std::vector<std::shared_ptr<GlobalArmor>>   _torso_armor;
+    std::vector<std::shared_ptr<GlobalArmor>>   _arm_armor;
+    std::vector<std::shared_ptr<GlobalArmor>>   _leg_armor;
+    std::vector<std::shared_ptr<GlobalSpirit>>  _spirits;
+    std::vector<std::shared_ptr<GlobalObject>>  _key_items;
+
+    //! \brief The sorted views, by category and sort order, and whether they were built.
+    std::vector<std::shared_ptr<GlobalObject>> _views[ITEM_CATEGORY_SIZE][INVENTORY_SORT_TOTAL];
+    bool _views_built[ITEM_CATEGORY_SIZE][INVENTORY_SORT_TOTAL];
+
+    uint32_t _revisions[ITEM_CATEGORY_SIZE];
+
+    /** \brief Gives the categories an object is listed in: all, the one of its kind
+    *** and the key items one.
+    *** \return The number of categories written.
+    **/
+    static uint32_t _GetCategories(const GlobalObject& object, ITEM_CATEGORY categories[3]);
+
+    //! \brief Adds the object in, or removes it from, the views of its categories.
+    void _AddToViews(const std::shared_ptr<GlobalObject>& object);
+    void _RemoveFromViews(const std::shared_ptr<GlobalObject>& object);
+
+    //! \brief Changes the count of an object, keeping the views sorted by count in order.
+    void _SetCount(const std::shared_ptr<GlobalObject>& object, uint32_t count);
+
+    /** \brief Removes an object from one of the typed arrays, moving the last one in its place.
+    *** \param key_items Whether the array is the key items one, to update the right index.
+    **/
+    template <class T> void _RemoveAt(std::vector<std::shared_ptr<T>>& objects, uint32_t index, bool key_items);
+};
+
+//-----------------------------------------------------------------------------
+// Template Function Definitions
+//-----------------------------------------------------------------------------
+
+template <class T> void GlobalInventory::_RemoveAt(std::vector<std::shared_ptr<T>>& objects, uint32_t index, bool key_items)
+{
+    if (index + 1 < objects.size()) {
+        objects[index] = objects.back();
+
+        private_global::InventoryEntry& moved_entry = _entries[_indices[objects[index]->GetID()] - 1];
+        if (key_items)
+            moved_entry.key_index = index + 1;
+        else
+            moved_entry.category_index = index;
+    }
+    objects.pop_back();
+}
+
+} // namespace vt_global
+
+#endif // __GLOBAL_INVENTORY_HEADER__
@@ -0,0 +1,467 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    global_save_file.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the binary save game files.
+*** ***************************************************************************/
+
+#include "global_save_file.h"
+
+#include "common/app_settings.h"
+
+#include "engine/binary_utils.h"
+
+#include "utils/utils_common.h"
+#include "utils/utils_files.h"
+
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace vt_global
+{
+
+extern bool GLOBAL_DEBUG;
+
+//! \brief The save file magic number.
+const char SAVE_FILE_MAGIC[4] = { 'V', 'T', 'S', 'V' };
+
+//! \brief The save file header size in bytes.
+const uint32_t SAVE_FILE_HEADER_SIZE = 20;
+
+//! \brief Flushes the file content to the disk, so that it is complete before being renamed.
+static bool _SyncFile(FILE* file)
+{
+    if (fflush(file) != 0)
+        return false;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+//! \brief Replaces the destination file by the source one, in a single step.
+static bool _ReplaceFile(const std::string& source, const std::string& destination)
+{
+#ifdef _WIN32
+    return MoveFileExA(source.c_str(), destination.c_str(),
+                       MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(source.c_str(), destination.c_str()) == 0;
+#endif
+}
+
+std::string GetSaveFilename(uint32_t slot_id, bool autosave)
+{
+    std::ostringstream filename;
+    filename << vt_common::GetUserDataPath() << "saved_game_" << slot_id;
+    if (autosave)
+        filename << "_autosave";
+    filename << ".sav";
+    return filename.str();
+}
+
+std::string GetLegacySaveFilename(uint32_t slot_id, bool autosave)
+{
+    std::ostringstream filename;
+    filename << vt_common::GetUserDataPath() << "saved_game_" << slot_id;
+    if (autosave)
+        filename << "_autosave";
+    filename << ".lua";
+    return filename.str();
+}
+
+std::string FindSaveFilename(uint32_t slot_id, bool autosave)
+{
+    std::string filename = GetSaveFilename(slot_id, autosave);
+    if (vt_utils::DoesFileExist(filename))
+        return filename;
+
+    std::string legacy_filename = GetLegacySaveFilename(slot_id, autosave);
+    if (vt_utils::DoesFileExist(legacy_filename))
+        return legacy_filename;
+
+    return filename;
+}
+
+bool IsBinarySaveFile(const std::string& filename)
+{
+    std::ifstream file(filename.c_str(), std::ifstream::binary);
+    if (!file.is_open())
+        return false;
+
+    char magic[sizeof(SAVE_FILE_MAGIC)];
+    if (!file.read(magic, sizeof(magic)))
+        return false;
+    return memcmp(magic, SAVE_FILE_MAGIC, sizeof(magic)) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// SaveFileWriter class
+////////////////////////////////////////////////////////////////////////////////
+
+void SaveFileWriter::BeginSection(uint32_t tag)
+{
+    if (!_block_starts.empty()) {
+        PRINT_WARNING << "A section was started before the previous one was ended." << std::endl;
+        return;
+    }
+
+    WriteUInt32(tag);
+    BeginRecord();
+}
+
+void SaveFileWriter::EndSection()
+{
+    if (_block_starts.size() != 1) {
+        PRINT_WARNING << "Ended a section with " << (_block_starts.empty() ? 0 : _block_starts.size() - 1)
+                      << " record(s) still open." << std::endl;
+        return;
+    }
+    _EndBlock();
+}
+
+void SaveFileWriter::BeginRecord()
+{
+    // The block size is written once the block is ended.
+    _block_starts.push_back(_data.size());
+    WriteUInt32(0);
+}
+
+void SaveFileWriter::EndRecord()
+{
+    if (_block_starts.size() < 2) {
+        PRINT_WARNING << "Ended a record that wasn't started." << std::endl;
+        return;
+    }
+    _EndBlock();
+}
+
+void SaveFileWriter::WriteUInt32(uint32_t value)
+{
+    size_t position = _data.size();
+    _data.resize(position + sizeof(value));
+    vt_system::WriteUInt32(&_data[position], value);
+}
+
+void SaveFileWriter::WriteFloat(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    WriteUInt32(bits);
+}
+
+void SaveFileWriter::WriteString(const std::string& value)
+{
+    WriteUInt32(value.size());
+    _data.insert(_data.end(), value.begin(), value.end());
+}
+
+void SaveFileWriter::WriteUIntVector(const std::vector<uint32_t>& values)
+{
+    WriteUInt32(values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+        WriteUInt32(values[i]);
+}
+
+bool SaveFileWriter::SaveFile(const std::string& filename) const
+{
+    if (!_block_starts.empty()) {
+        PRINT_ERROR << "The save data is incomplete, a section wasn't ended: " << filename << std::endl;
+        return false;
+    }
+
+    uint8_t header[SAVE_FILE_HEADER_SIZE];
+    memcpy(header, SAVE_FILE_MAGIC, sizeof(SAVE_FILE_MAGIC));
+    vt_system::WriteUInt32(header + 4, SAVE_FILE_VERSION);
+    vt_system::WriteUInt32(header + 8, _data.size());
+    vt_system::WriteUInt64(header + 12, vt_system::ComputeHash(_data.data(), _data.size()));
+
+    // The data is written into a temporary file first, which then replaces the former save.
+    // This way, the slot is never left with a partially written save.
+    std::string temp_filename = filename + ".tmp";
+    FILE* file = fopen(temp_filename.c_str(), "wb");
+    if (!file) {
+        PRINT_ERROR << "Couldn't open the save file for writing: " << temp_filename << std::endl;
+        return false;
+    }
+
+    bool written = fwrite(header, 1, sizeof(header), file) == sizeof(header)
+                   && (_data.empty() || fwrite(_data.data(), 1, _data.size(), file) == _data.size())
+                   && _SyncFile(file);
+    written = (fclose(file) == 0) && written;
+    if (!written) {
+        PRINT_ERROR << "Couldn't write the save file: " << temp_filename << std::endl;
+        remove(temp_filename.c_str());
+        return false;
+    }
+
+    if (!_ReplaceFile(temp_filename, filename)) {
+        PRINT_ERROR << "Couldn't replace the save file: " << filename << std::endl;
+        remove(temp_filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+void SaveFileWriter::_EndBlock()
+{
+    size_t start = _block_starts.back();
+    _block_starts.pop_back();
+    vt_system::WriteUInt32(&_data[start], _data.size() - start - sizeof(uint32_t));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// SaveFileTask class
+////////////////////////////////////////////////////////////////////////////////
+
+SaveFileTask::SaveFileTask(const std::string& filename, SaveFileWriter& writer):
+    _filename(filename),
+    _writer(std::move(writer)),
+    _thread(nullptr),
+    _result(false)
+{
+    SDL_AtomicSet(&_done, 0);
+
+    _thread = SDL_CreateThread(_Run, "SaveFileTask", this);
+    if (!_thread) {
+        // Write it on the main thread rather than not at all.
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "Couldn't create the save thread: " << SDL_GetError() << std::endl;
+        _Run(this);
+    }
+}
+
+SaveFileTask::~SaveFileTask()
+{
+    Wait();
+}
+
+bool SaveFileTask::Wait()
+{
+    if (_thread) {
+        SDL_WaitThread(_thread, nullptr);
+        _thread = nullptr;
+    }
+    return _result;
+}
+
+int SaveFileTask::_Run(void* data)
+{
+    SaveFileTask* task = static_cast<SaveFileTask*>(data);
+    task->_result = task->_writer.SaveFile(task->_filename);
+    SDL_AtomicSet(&task->_done, 1);
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// SaveFileReader class
+////////////////////////////////////////////////////////////////////////////////
+
+bool SaveFileReader::OpenFile(const std::string& filename)
+{
+    _filename = filename;
+    _version = 0;
+    _data.clear();
+    _sections.clear();
+    _position = 0;
+    _block_ends.clear();
+    _error_detected = false;
+
+    std::ifstream file(filename.c_str(), std::ifstream::binary);
+    if (!file.is_open()) {
+        PRINT_WARNING << "Couldn't open the save file: " << filename << std::endl;
+        return false;
+    }
+
+    uint8_t header[SAVE_FILE_HEADER_SIZE];
+    if (!file.read(reinterpret_cast<char*>(header), sizeof(header))
+            || memcmp(header, SAVE_FILE_MAGIC, sizeof(SAVE_FILE_MAGIC)) != 0) {
+        PRINT_WARNING << "Not a binary save file: " << filename << std::endl;
+        return false;
+    }
+
+    _version = vt_system::ReadUInt32(header + 4);
+    if (_version == 0 || _version > SAVE_FILE_VERSION) {
+        PRINT_WARNING << "Unsupported save file version " << _version
+                      << " (up to " << SAVE_FILE_VERSION << " supported): " << filename << std::endl;
+        return false;
+    }
+
+    // Check the data size against the file length before allocating anything,
+    // so that a corrupted header can't request a huge buffer.
+    uint32_t size = vt_system::ReadUInt32(header + 8);
+    file.seekg(0, std::ifstream::end);
+    std::streamoff file_size = file.tellg();
+    if (file_size < 0 || static_cast<uint64_t>(file_size) < SAVE_FILE_HEADER_SIZE + static_cast<uint64_t>(size)) {
+        PRINT_WARNING << "Truncated save file: " << filename << std::endl;
+        return false;
+    }
+    file.seekg(SAVE_FILE_HEADER_SIZE, std::ifstream::beg);
+
+    _data.resize(size);
+    if (size > 0 && !file.read(reinterpret_cast<char*>(&_data[0]), size)) {
+        PRINT_WARNING << "Truncated save file: " << filename << std::endl;
+        _data.clear();
+        return false;
+    }
+
+    if (vt_system::ComputeHash(_data.data(), _data.size()) != vt_system::ReadUInt64(header + 12)) {
+        PRINT_WARNING << "Corrupted save file, the checksum doesn't match: " << filename << std::endl;
+        _data.clear();
+        return false;
+    }
+
+    // Index the sections.
+    size_t position = 0;
+    while (position + 2 * sizeof(uint32_t) <= _data.size()) {
+        uint32_t tag = vt_system::ReadUInt32(&_data[position]);
+        uint32_t section_size = vt_system::ReadUInt32(&_data[position + sizeof(uint32_t)]);
+        position += 2 * sizeof(uint32_t);
+        if (section_size > _data.size() - position)
+            break;
+
+        _sections[tag] = std::make_pair(position, position + section_size);
+        position += section_size;
+    }
+
+    if (position != _data.size()) {
+        PRINT_WARNING << "Invalid sections in save file: " << filename << std::endl;
+        _data.clear();
+        _sections.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool SaveFileReader::OpenSection(uint32_t tag)
+{
+    _block_ends.clear();
+
+    std::map<uint32_t, std::pair<size_t, size_t> >::const_iterator it = _sections.find(tag);
+    if (it == _sections.end())
+        return false;
+
+    _position = it->second.first;
+    _block_ends.push_back(it->second.second);
+    return true;
+}
+
+void SaveFileReader::CloseSection()
+{
+    _block_ends.clear();
+}
+
+bool SaveFileReader::OpenRecord()
+{
+    // A missing record, in older files.
+    if (!_CanRead(sizeof(uint32_t)))
+        return false;
+
+    uint32_t size = ReadUInt32();
+    if (size > _block_ends.back() - _position) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "Invalid record size in save file: " << _filename << std::endl;
+        _error_detected = true;
+        _position = _block_ends.back();
+        return false;
+    }
+
+    _block_ends.push_back(_position + size);
+    return true;
+}
+
+void SaveFileReader::CloseRecord()
+{
+    if (_block_ends.size() < 2) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "Closed a record that wasn't open." << std::endl;
+        return;
+    }
+
+    _position = _block_ends.back();
+    _block_ends.pop_back();
+}
+
+uint8_t SaveFileReader::ReadUInt8()
+{
+    if (!_CanRead(sizeof(uint8_t)))
+        return 0;
+    return _data[_position++];
+}
+
+uint32_t SaveFileReader::ReadUInt32()
+{
+    if (!_CanRead(sizeof(uint32_t)))
+        return 0;
+    uint32_t value = vt_system::ReadUInt32(&_data[_position]);
+    _position += sizeof(uint32_t);
+    return value;
+}
+
+float SaveFileReader::ReadFloat()
+{
+    uint32_t bits = ReadUInt32();
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string SaveFileReader::ReadString()
+{
+    uint32_t size = ReadUInt32();
+    if (size == 0)
+        return std::string();
+
+    if (!_CanRead(size)) {
+        _error_detected = true;
+        return std::string();
+    }
+
+    std::string value(reinterpret_cast<const char*>(&_data[_position]), size);
+    _position += size;
+    return value;
+}
+
+void SaveFileReader::ReadUIntVector(std::vector<uint32_t>& values)
+{
+    values.clear();
+    uint32_t count = ReadUInt32();
+    if (count == 0)
+        return;
+
+    if (!_CanRead(static_cast<size_t>(count) * sizeof(uint32_t))) {
+        _error_detected = true;
+        return;
+    }
+
+    values.reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+        values.push_back(ReadUInt32());
+}
+
+bool SaveFileReader::_CanRead(size_t size)
+{
+    if (_block_ends.empty()) {
+        _error_detected = true;
+        return false;
+    }
+    return size <= _block_ends.back() - _position;
+}
+
+} // namespace vt_global
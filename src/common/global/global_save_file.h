@@ -0,0 +1,301 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    global_save_file.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the binary save game files.
+***
+*** A save file is made of a header followed by the save data:
+*** - The "VTSV" magic number,
+*** - the format version, as an unsigned 32 bits integer,
+*** - the save data size, as an unsigned 32 bits integer,
+*** - the FNV-1a 64 bits hash of the save data, used as a checksum.
+***
+*** The save data is a list of tagged sections: a 4 characters tag, the section
+*** size, then the section content. The numbers are stored in little endian and
+*** the strings as their size followed by their characters.
+***
+*** The section contents and the records within them only ever get new fields
+*** appended: the fields missing from older files are read as 0 or empty,
+*** and the unknown trailing fields and sections of newer files are skipped.
+*** The format version is only increased when this isn't enough.
+***
+*** The former Lua save files are still loaded through the script engine,
+*** and are replaced by binary files once the game is saved again.
+*** ***************************************************************************/
+
+#ifndef __GLOBAL_SAVE_FILE_HEADER__
+#define __GLOBAL_SAVE_FILE_HEADER__
+
+#include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_atomic.h>
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+namespace vt_global
+{
+
+//! \brief The current save files format version.
+const uint32_t SAVE_FILE_VERSION = 1;
+
+//! \brief Builds the 4 characters tag of a save file section.
+constexpr uint32_t SaveSectionTag(char a, char b, char c, char d)
+{
+    return static_cast<uint32_t>(a) | (static_cast<uint32_t>(b) << 8) |
+           (static_cast<uint32_t>(c) << 16) | (static_cast<uint32_t>(d) << 24);
+}
+
+//! \brief The save file sections.
+//@{
+/** \brief The data shown when browsing the saves: the map files, name and image, the play time,
+*** the drunes and the visible characters. It is not read when loading the game.
+**/
+const uint32_t SAVE_SECTION_PREVIEW = SaveSectionTag('P', 'R', 'E', 'V');
+//! \brief The map location, play time, drunes and stamina.
+const uint32_t SAVE_SECTION_PLAY = SaveSectionTag('P', 'L', 'A', 'Y');
+//! \brief The home map location, when there is one.
+const uint32_t SAVE_SECTION_HOME = SaveSectionTag('H', 'O', 'M', 'E');
+//! \brief The inventory objects ids and counts.
+const uint32_t SAVE_SECTION_INVENTORY = SaveSectionTag('I', 'N', 'V', 'T');
+//! \brief One record per character, in the party order.
+const uint32_t SAVE_SECTION_CHARACTERS = SaveSectionTag('C', 'H', 'A', 'R');
+//! \brief The event groups, with their events names and values.
+const uint32_t SAVE_SECTION_EVENTS = SaveSectionTag('E', 'V', 'N', 'T');
+const uint32_t SAVE_SECTION_QUESTS = SaveSectionTag('Q', 'U', 'S', 'T');
+const uint32_t SAVE_SECTION_WORLD_MAP = SaveSectionTag('W', 'M', 'A', 'P');
+const uint32_t SAVE_SECTION_SHOPS = SaveSectionTag('S', 'H', 'O', 'P');
+//@}
+
+//! \brief Returns the filename of a game slot save, or autosave.
+std::string GetSaveFilename(uint32_t slot_id, bool autosave = false);
+
+//! \brief Returns the filename of a game slot save, or autosave, in the former Lua format.
+std::string GetLegacySaveFilename(uint32_t slot_id, bool autosave = false);
+
+/** \brief Returns the filename of the existing save of a slot, the binary one being preferred
+*** over the Lua one. Returns the binary save filename when there is none.
+**/
+std::string FindSaveFilename(uint32_t slot_id, bool autosave = false);
+
+//! \brief Tells whether the given file starts like a binary save file.
+bool IsBinarySaveFile(const std::string& filename);
+
+/** ****************************************************************************
+*** \brief Writes a binary save file.
+***
+*** The whole save is built in memory, and only written once complete.
+*** ***************************************************************************/
+class SaveFileWriter
+{
+public:
+    SaveFileWriter() {}
+
+    //! \brief Starts a new section. The sections can't be nested.
+    void BeginSection(uint32_t tag);
+
+    void EndSection();
+
+    /** \brief Starts a record, a sized block of data within a section
+    *** that can get new fields without breaking the older readers.
+    **/
+    void BeginRecord();
+
+    void EndRecord();
+
+    void WriteBool(bool value) {
+        WriteUInt8(value ? 1 : 0);
+    }
+
+    void WriteUInt8(uint8_t value) {
+        _data.push_back(value);
+    }
+
+    void WriteUInt32(uint32_t value);
+
+    void WriteInt32(int32_t value) {
+        WriteUInt32(static_cast<uint32_t>(value));
+    }
+
+    void WriteFloat(float value);
+
+    void WriteString(const std::string& value);
+
+    //! \brief Writes the vector size, then its values.
+    void WriteUIntVector(const std::vector<uint32_t>& values);
+
+    //! \brief Returns the save data, without the file header.
+    const std::vector<uint8_t>& GetData() const {
+        return _data;
+    }
+
+    /** \brief Writes the header and the save data into the given file.
+    *** The data is written into a temporary file which then replaces the given one,
+    *** so that an interrupted write never leaves a partial save behind.
+    *** \return false if a section or record was left open, or on write errors.
+    **/
+    bool SaveFile(const std::string& filename) const;
+
+private:
+    std::vector<uint8_t> _data;
+
+    //! \brief The positions of the sizes to write once the open sections and records are ended.
+    std::vector<size_t> _block_starts;
+
+    //! \brief Writes the size of the last opened block.
+    void _EndBlock();
+};
+
+/** ****************************************************************************
+*** \brief Writes a save file on a worker thread.
+***
+*** The save data is built on the main thread, which is quick, then handed over
+*** to the task so that the game isn't frozen while the file is written.
+*** ***************************************************************************/
+class SaveFileTask
+{
+public:
+    //! \brief Takes over the writer data, and starts writing it into the given file.
+    SaveFileTask(const std::string& filename, SaveFileWriter& writer);
+
+    //! \brief Waits for the file to be written.
+    ~SaveFileTask();
+
+    const std::string& GetFilename() const {
+        return _filename;
+    }
+
+    //! \brief Tells whether the file writing is over, without waiting for it.
+    bool IsDone() {
+        return SDL_AtomicGet(&_done) != 0;
+    }
+
+    //! \brief Waits for the file to be written, and returns whether it succeeded.
+    bool Wait();
+
+private:
+    std::string _filename;
+
+    SaveFileWriter _writer;
+
+    //! \brief The worker thread, if any.
+    SDL_Thread* _thread;
+
+    //! \brief Set to 1 once the file is written. Atomic since set from the worker thread.
+    SDL_atomic_t _done;
+
+    //! \brief Whether the file was written. Only read once the task is done.
+    bool _result;
+
+    SaveFileTask(const SaveFileTask&) = delete;
+    SaveFileTask& operator=(const SaveFileTask&) = delete;
+
+    //! \brief The worker thread function.
+    static int _Run(void* data);
+};
+
+/** ****************************************************************************
+*** \brief Reads a binary save file.
+***
+*** The whole file is read and checked when opened. The values are then read
+*** in the order they were written, section per section.
+*** ***************************************************************************/
+class SaveFileReader
+{
+public:
+    SaveFileReader():
+        _version(0),
+        _position(0),
+        _error_detected(false)
+    {}
+
+    /** \brief Reads the given file, and checks its header and checksum.
+    *** \return false if the file isn't a valid binary save file.
+    **/
+    bool OpenFile(const std::string& filename);
+
+    const std::string& GetFilename() const {
+        return _filename;
+    }
+
+    //! \brief The format version the file was written with.
+    uint32_t GetVersion() const {
+        return _version;
+    }
+
+    bool DoesSectionExist(uint32_t tag) const {
+        return _sections.find(tag) != _sections.end();
+    }
+
+    //! \brief Starts reading a section. Returns false when the file doesn't contain it.
+    bool OpenSection(uint32_t tag);
+
+    void CloseSection();
+
+    //! \brief Starts reading a record of the current section or record.
+    bool OpenRecord();
+
+    //! \brief Skips what is left of the current record.
+    void CloseRecord();
+
+    bool ReadBool() {
+        return ReadUInt8() != 0;
+    }
+
+    uint8_t ReadUInt8();
+
+    uint32_t ReadUInt32();
+
+    int32_t ReadInt32() {
+        return static_cast<int32_t>(ReadUInt32());
+    }
+
+    float ReadFloat();
+
+    std::string ReadString();
+
+    void ReadUIntVector(std::vector<uint32_t>& values);
+
+    //! \brief Tells whether values were read outside of any section, or a record was larger than its section.
+    bool IsErrorDetected() const {
+        return _error_detected;
+    }
+
+private:
+    std::string _filename;
+
+    uint32_t _version;
+
+    //! \brief The save data, without the file header.
+    std::vector<uint8_t> _data;
+
+    //! \brief The sections content start and end positions, by tag.
+    std::map<uint32_t, std::pair<size_t, size_t> > _sections;
+
+    //! \brief The reading position.
+    size_t _position;
+
+    //! \brief The end positions of the open section and records.
+    std::vector<size_t> _block_ends;
+
+    bool _error_detected;
+
+    /** \brief Tells whether the given size can be read in the current block.
+    *** Reading past the end of a block is expected when reading older files,
+    *** the missing values being then read as 0.
+    **/
+    bool _CanRead(size_t size);
+};
+
+} // namespace vt_global
+
+#endif // __GLOBAL_SAVE_FILE_HEADER__
@@ -19,18 +19,34 @@ using namespace vt_global::private_global;
 namespace vt_global
 {
 
-GlobalArmor::GlobalArmor(uint32_t id, uint32_t count) :
-    GlobalObject(id, count)
+namespace private_global
+{
+
+//! \brief Returns the approriate armor type (head, torso, arm, leg) depending on the object ID
+static GLOBAL_OBJECT GetArmorType(uint32_t id)
+{
+    if((id > MAX_WEAPON_ID) && (id <= MAX_HEAD_ARMOR_ID))
+        return GLOBAL_OBJECT_HEAD_ARMOR;
+    else if((id > MAX_HEAD_ARMOR_ID) && (id <= MAX_TORSO_ARMOR_ID))
+        return GLOBAL_OBJECT_TORSO_ARMOR;
+    else if((id > MAX_TORSO_ARMOR_ID) && (id <= MAX_ARM_ARMOR_ID))
+        return GLOBAL_OBJECT_ARM_ARMOR;
+    else if((id > MAX_ARM_ARMOR_ID) && (id <= MAX_LEG_ARMOR_ID))
+        return GLOBAL_OBJECT_LEG_ARMOR;
+    else
+        return GLOBAL_OBJECT_INVALID;
+}
+
+void GlobalArmorDefinition::Load(uint32_t object_id)
 {
-    if((_id <= MAX_WEAPON_ID) || (_id > MAX_LEG_ARMOR_ID)) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << _id << std::endl;
-        _InvalidateObject();
+    if((object_id <= MAX_WEAPON_ID) || (object_id > MAX_LEG_ARMOR_ID)) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid armor id: " << object_id << std::endl;
         return;
     }
 
     // Figure out the appropriate script reference to grab based on the id value
     ReadScriptDescriptor *script_file;
-    switch(GetObjectType()) {
+    switch(GetArmorType(object_id)) {
     case GLOBAL_OBJECT_HEAD_ARMOR:
         script_file = &(GlobalManager->GetHeadArmorScript());
         break;
@@ -44,36 +60,34 @@ GlobalArmor::GlobalArmor(uint32_t id, uint32_t count) :
         script_file = &(GlobalManager->GetLegArmorScript());
         break;
     default:
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "could not determine armor type: " << _id << std::endl;
-        _InvalidateObject();
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "could not determine armor type: " << object_id << std::endl;
         return;
     }
 
-    if(script_file->DoesTableExist(_id) == false) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "no valid data for armor in definition file: " << _id << std::endl;
-        _InvalidateObject();
+    if(script_file->DoesTableExist(object_id) == false) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "no valid data for armor in definition file: " << object_id << std::endl;
         return;
     }
 
     // Load the armor data from the script
-    script_file->OpenTable(_id);
-    _LoadObjectData(*script_file);
+    script_file->OpenTable(object_id);
+    LoadObjectData(object_id, *script_file);
 
-    _LoadStatusEffects(*script_file);
-    _LoadEquipmentSkills(*script_file);
+    LoadStatusEffects(*script_file);
+    LoadEquipmentSkills(*script_file);
 
-    _physical_defense = script_file->ReadUInt("physical_defense");
-    _magical_defense = script_file->ReadUInt("magical_defense");
+    physical_defense = script_file->ReadUInt("physical_defense");
+    magical_defense = script_file->ReadUInt("magical_defense");
 
-    _usable_by = script_file->ReadUInt("usable_by");
+    usable_by = script_file->ReadUInt("usable_by");
 
     uint32_t spirits_number = script_file->ReadUInt("slots");
     // Only permit a max of 5 spirits for equipment
     if (spirits_number > 5) {
         spirits_number = 5;
-        PRINT_WARNING << "More than 5 spirit slots declared in item " << _id << std::endl;
+        PRINT_WARNING << "More than 5 spirit slots declared in item " << object_id << std::endl;
     }
-    _spirit_slots.resize(spirits_number, nullptr);
+    spirit_slots.resize(spirits_number, nullptr);
 
     script_file->CloseTable();
     if(script_file->IsErrorDetected()) {
@@ -81,22 +95,20 @@ GlobalArmor::GlobalArmor(uint32_t id, uint32_t count) :
             PRINT_WARNING << "one or more errors occurred while reading armor data - they are listed below"
                           << std::endl << script_file->GetErrorMessages() << std::endl;
         }
-        _InvalidateObject();
+        id = 0;
     }
 }
 
+} // namespace private_global
+
+GlobalArmor::GlobalArmor(uint32_t id, uint32_t count) :
+    GlobalObject(GlobalManager->GetObjectRegistry().GetArmorDefinition(id), count)
+{
+}
+
 GLOBAL_OBJECT GlobalArmor::GetObjectType() const
 {
-    if((_id > MAX_WEAPON_ID) && (_id <= MAX_HEAD_ARMOR_ID))
-        return GLOBAL_OBJECT_HEAD_ARMOR;
-    else if((_id > MAX_HEAD_ARMOR_ID) && (_id <= MAX_TORSO_ARMOR_ID))
-        return GLOBAL_OBJECT_TORSO_ARMOR;
-    else if((_id > MAX_TORSO_ARMOR_ID) && (_id <= MAX_ARM_ARMOR_ID))
-        return GLOBAL_OBJECT_ARM_ARMOR;
-    else if((_id > MAX_ARM_ARMOR_ID) && (_id <= MAX_LEG_ARMOR_ID))
-        return GLOBAL_OBJECT_LEG_ARMOR;
-    else
-        return GLOBAL_OBJECT_INVALID;
+    return GetArmorType(GetID());
 }
 
 } // namespace vt_global
@@ -18,6 +18,41 @@ namespace vt_global
 
 class GlobalSpirit;
 
+namespace private_global
+{
+
+//! \brief The armor data read from its definition script. See GlobalObjectDefinition.
+struct GlobalArmorDefinition : public GlobalObjectDefinition {
+    GlobalArmorDefinition() :
+        physical_defense(0),
+        magical_defense(0),
+        usable_by(0)
+    {
+    }
+
+    //! \brief The amount of physical defense that the armor provides
+    uint32_t physical_defense;
+
+    //! \brief The amount of magical defense that the armor provides against each elements
+    uint32_t magical_defense;
+
+    /** \brief A bit-mask that determines which characters can use or equip the object
+    *** See the game character ID constants in global_actors.h for more information
+    **/
+    uint32_t usable_by;
+
+    /** \brief Sockets which may be used to place spirits on the armor
+    *** Armor may have no sockets, so it is not uncommon for the size of this vector to be zero.
+    *** No spirit can be attached yet, so every pointer is nullptr.
+    **/
+    std::vector<GlobalSpirit *> spirit_slots;
+
+    //! \brief Loads the armor data from the matching armor script. The id is left to zero on failure.
+    void Load(uint32_t object_id);
+};
+
+} // namespace private_global
+
 /** ****************************************************************************
 *** \brief Represents all types of armor that may be equipped on characters and enemies
 ***
@@ -46,44 +81,30 @@ public:
     GLOBAL_OBJECT GetObjectType() const override;
 
     uint32_t GetPhysicalDefense() const {
-        return _physical_defense;
+        return _GetDefinition().physical_defense;
     }
 
     uint32_t GetMagicalDefense() const {
-        return _magical_defense;
+        return _GetDefinition().magical_defense;
     }
 
     uint32_t GetUsableBy() const {
-        return _usable_by;
+        return _GetDefinition().usable_by;
     }
 
     const std::vector<GlobalSpirit *>& GetSpiritSlots() const {
-        return _spirit_slots;
+        return _GetDefinition().spirit_slots;
     }
 
     //! \brief Gives the list of learned skill thanks to this piece of equipment.
     const std::vector<uint32_t>& GetEquipmentSkills() const {
-        return _equipment_skills;
+        return _GetDefinition().equipment_skills;
     }
 
 private:
-    //! \brief The amount of physical defense that the armor provides
-    uint32_t _physical_defense;
-
-    //! \brief The amount of magical defense that the armor provides against each elements
-    uint32_t _magical_defense;
-
-    /** \brief A bit-mask that determines which characters can use or equip the object
-    *** See the game character ID constants in global_actors.h for more information
-    **/
-    uint32_t _usable_by;
-
-    /** \brief Sockets which may be used to place spirits on the armor
-    *** Armor may have no sockets, so it is not uncommon for the size of this vector to be zero.
-    *** When a socket is available but empty (has no attached spirit), the pointer at that index
-    *** will be nullptr.
-    **/
-    std::vector<GlobalSpirit *> _spirit_slots;
+    const private_global::GlobalArmorDefinition& _GetDefinition() const {
+        return static_cast<const private_global::GlobalArmorDefinition&>(*_definition);
+    }
 }; // class GlobalArmor : public GlobalObject
 
 } // namespace vt_global
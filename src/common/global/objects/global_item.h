@@ -18,6 +18,42 @@
 namespace vt_global
 {
 
+namespace private_global
+{
+
+//! \brief The item data read from its definition script. See GlobalObjectDefinition.
+struct GlobalItemDefinition : public GlobalObjectDefinition {
+    GlobalItemDefinition() :
+        target_type(GLOBAL_TARGET_INVALID),
+        warmup_time(0),
+        cooldown_time(0)
+    {
+    }
+
+    //! \brief The type of target for the item
+    GLOBAL_TARGET target_type;
+
+    //! \brief A reference to the script function that performs the item's effect while in battle
+    luabind::object battle_use_function;
+
+    //! \brief A reference to the script function that performs the item's effect while in a menu
+    luabind::object field_use_function;
+
+    //! \brief The warmup time in milliseconds needed before using this item in battles.
+    uint32_t warmup_time;
+
+    //! \brief The cooldown time in milliseconds needed after using this item in battles.
+    uint32_t cooldown_time;
+
+    //! \brief map containing the animation scripts names linked to each characters id for the given skill.
+    std::map <uint32_t, std::string> animation_scripts;
+
+    //! \brief Loads the item data from the items script. The id is left to zero on failure.
+    void Load(uint32_t object_id);
+};
+
+} // namespace private_global
+
 /** ****************************************************************************
 *** \brief Represents items used throughout the game
 ***
@@ -38,51 +74,48 @@ public:
     {
     }
 
-    GlobalItem(const GlobalItem& copy);
-    GlobalItem& operator=(const GlobalItem& copy);
-
     GLOBAL_OBJECT GetObjectType() const override {
         return GLOBAL_OBJECT_ITEM;
     }
 
     //! \brief Returns true if the item can be used in battle
     bool IsUsableInBattle() const {
-        return _battle_use_function.is_valid();
+        return _GetDefinition().battle_use_function.is_valid();
     }
 
     //! \brief Returns true if the item can be used in the field
     bool IsUsableInField() const {
-        return _field_use_function.is_valid();
+        return _GetDefinition().field_use_function.is_valid();
     }
 
     //! \name Class Member Access Functions
     //@{
     GLOBAL_TARGET GetTargetType() const {
-        return _target_type;
+        return _GetDefinition().target_type;
     }
 
     /** \brief Returns a pointer to the luabind::object of the battle use function
     *** \note This function will return nullptr if the skill is not usable in battle
     **/
     const luabind::object& GetBattleUseFunction() const {
-        return _battle_use_function;
+        return _GetDefinition().battle_use_function;
     }
 
     /** \brief Returns a pointer to the luabind::object of the field use function
     *** \note This function will return nullptr if the skill is not usable in the field
     **/
     const luabind::object& GetFieldUseFunction() const {
-        return _field_use_function;
+        return _GetDefinition().field_use_function;
     }
 
     //! \brief Returns Warmup time needed before using this item in battles.
     inline uint32_t GetWarmUpTime() const {
-        return _warmup_time;
+        return _GetDefinition().warmup_time;
     }
 
     //! \brief Returns Warmup time needed before using this item in battles.
     inline uint32_t GetCoolDownTime() const {
-        return _cooldown_time;
+        return _GetDefinition().cooldown_time;
     }
 
     /** \brief Tells the animation script filename linked to the skill for the given character,
@@ -92,23 +125,9 @@ public:
     //@}
 
 private:
-    //! \brief The type of target for the item
-    GLOBAL_TARGET _target_type;
-
-    //! \brief A reference to the script function that performs the item's effect while in battle
-    luabind::object _battle_use_function;
-
-    //! \brief A reference to the script function that performs the item's effect while in a menu
-    luabind::object _field_use_function;
-
-    //! \brief The warmup time in milliseconds needed before using this item in battles.
-    uint32_t _warmup_time;
-
-    //! \brief The cooldown time in milliseconds needed after using this item in battles.
-    uint32_t _cooldown_time;
-
-    //! \brief map containing the animation scripts names linked to each characters id for the given skill.
-    std::map <uint32_t, std::string> _animation_scripts;
+    const private_global::GlobalItemDefinition& _GetDefinition() const {
+        return static_cast<const private_global::GlobalItemDefinition&>(*_definition);
+    }
 }; // class GlobalItem : public GlobalObject
 
 } // namespace vt_global
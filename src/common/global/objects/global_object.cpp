@@ -15,20 +15,24 @@
 namespace vt_global
 {
 
-void GlobalObject::_LoadObjectData(vt_script::ReadScriptDescriptor &script)
+namespace private_global
 {
-    _name = vt_utils::MakeUnicodeString(script.ReadString("name"));
-    _description = vt_utils::MakeUnicodeString(script.ReadString("description"));
-    _price = script.ReadUInt("standard_price");
-    _LoadTradeConditions(script);
+
+void GlobalObjectDefinition::LoadObjectData(uint32_t object_id, vt_script::ReadScriptDescriptor &script)
+{
+    id = object_id;
+    name = vt_utils::MakeUnicodeString(script.ReadString("name"));
+    description = vt_utils::MakeUnicodeString(script.ReadString("description"));
+    price = script.ReadUInt("standard_price");
+    LoadTradeConditions(script);
     std::string icon_file = script.ReadString("icon");
     if (script.DoesBoolExist("key_item"))
-        _is_key_item = script.ReadBool("key_item");
-    if(!_icon_image.Load(icon_file)) {
-        PRINT_WARNING << "failed to load icon image for item: " << _id << std::endl;
+        is_key_item = script.ReadBool("key_item");
+    if(!icon_image.Load(icon_file)) {
+        PRINT_WARNING << "failed to load icon image for item: " << id << std::endl;
 
         // try a default icon in that case
-        _icon_image.Load("data/gui/battle/default_special.png");
+        icon_image.Load("data/gui/battle/default_special.png");
     }
 }
 
@@ -40,22 +44,22 @@ static bool CompareStatusEffects(std::pair<GLOBAL_STATUS, GLOBAL_INTENSITY> one,
     return (status1 < status2);
 }
 
-void GlobalObject::_LoadStatusEffects(vt_script::ReadScriptDescriptor &script)
+void GlobalObjectDefinition::LoadStatusEffects(vt_script::ReadScriptDescriptor &script)
 {
     if(!script.DoesTableExist("status_effects"))
         return;
 
-    std::vector<int32_t> status_effects;
-    script.ReadTableKeys("status_effects", status_effects);
+    std::vector<int32_t> status_keys;
+    script.ReadTableKeys("status_effects", status_keys);
 
-    if(status_effects.empty())
+    if(status_keys.empty())
         return;
 
     script.OpenTable("status_effects");
 
-    for(uint32_t i = 0; i < status_effects.size(); ++i) {
+    for(uint32_t i = 0; i < status_keys.size(); ++i) {
 
-        int32_t key = status_effects[i];
+        int32_t key = status_keys[i];
         if(key <= GLOBAL_STATUS_INVALID || key >= GLOBAL_STATUS_TOTAL)
             continue;
 
@@ -64,15 +68,15 @@ void GlobalObject::_LoadStatusEffects(vt_script::ReadScriptDescriptor &script)
         if(intensity <= GLOBAL_INTENSITY_INVALID || intensity >= GLOBAL_INTENSITY_TOTAL)
             continue;
 
-        _status_effects.push_back(std::pair<GLOBAL_STATUS, GLOBAL_INTENSITY>((GLOBAL_STATUS)key, (GLOBAL_INTENSITY)intensity));
+        status_effects.push_back(std::pair<GLOBAL_STATUS, GLOBAL_INTENSITY>((GLOBAL_STATUS)key, (GLOBAL_INTENSITY)intensity));
     }
     // Make the effects be always presented in the same order.
-    std::sort(_status_effects.begin(), _status_effects.end(), CompareStatusEffects);
+    std::sort(status_effects.begin(), status_effects.end(), CompareStatusEffects);
 
     script.CloseTable(); // status_effects
 }
 
-void GlobalObject::_LoadTradeConditions(vt_script::ReadScriptDescriptor &script)
+void GlobalObjectDefinition::LoadTradeConditions(vt_script::ReadScriptDescriptor &script)
 {
     if(!script.DoesTableExist("trade_conditions"))
         return;
@@ -91,21 +95,23 @@ void GlobalObject::_LoadTradeConditions(vt_script::ReadScriptDescriptor &script)
 
         // Set the trade price
         if (key == 0)
-            _trade_price = quantity;
+            trade_price = quantity;
         else // Or the conditions.
-            _trade_conditions.push_back(std::pair<uint32_t, uint32_t>(key, quantity));
+            trade_conditions.push_back(std::pair<uint32_t, uint32_t>(key, quantity));
     }
 
     script.CloseTable(); // trade_conditions
 }
 
-void GlobalObject::_LoadEquipmentSkills(vt_script::ReadScriptDescriptor &script)
+void GlobalObjectDefinition::LoadEquipmentSkills(vt_script::ReadScriptDescriptor &script)
 {
-    _equipment_skills.clear();
+    equipment_skills.clear();
     if(!script.DoesTableExist("equipment_skills"))
         return;
 
-    script.ReadUIntVector("equipment_skills", _equipment_skills);
+    script.ReadUIntVector("equipment_skills", equipment_skills);
 }
 
+} // namespace private_global
+
 } // namespace vt_global
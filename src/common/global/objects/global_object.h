@@ -22,6 +22,80 @@ class ReadScriptDescriptor;
 namespace vt_global
 {
 
+namespace private_global
+{
+
+/** ****************************************************************************
+*** \brief The object data read from its definition script
+***
+*** A definition is loaded once per object id by the GlobalObjectRegistry, and
+*** shared by every instance of the object. It is never modified once loaded.
+*** An id of zero indicates that the definition couldn't be loaded.
+*** ***************************************************************************/
+struct GlobalObjectDefinition {
+    GlobalObjectDefinition() :
+        id(0),
+        is_key_item(false),
+        price(0),
+        trade_price(0)
+    {
+    }
+
+    virtual ~GlobalObjectDefinition()
+    {
+    }
+
+    //! \brief The object id, or zero when the definition is invalid.
+    uint32_t id;
+
+    //! \brief The name of the object as it would be displayed on a screen
+    vt_utils::ustring name;
+
+    //! \brief A short description of the item to display on the screen
+    vt_utils::ustring description;
+
+    //! \brief Tells whether an item is a key item, preventing from being consumed or sold.
+    bool is_key_item;
+
+    //! \brief The base price of the object for purchase/sale in the game
+    uint32_t price;
+
+    //! \brief The additional price of the object requested when trading it.
+    uint32_t trade_price;
+
+    //! \brief The trade conditions of the item <item_id, number>
+    //! There is an exception: If the item_id is zero, the second value is the trade price.
+    std::vector<std::pair<uint32_t, uint32_t> > trade_conditions;
+
+    //! \brief A loaded icon image of the object at its original size of 60x60 pixels
+    vt_video::StillImage icon_image;
+
+    /** \brief Container that holds the intensity of each type of status effect of the object
+    *** Effects with an intensity of GLOBAL_INTENSITY_NEUTRAL indicate no status effect bonus
+    **/
+    std::vector<std::pair<GLOBAL_STATUS, GLOBAL_INTENSITY> > status_effects;
+
+    //! \brief The skills that can be learned when equipping that piece of equipment.
+    std::vector<uint32_t> equipment_skills;
+
+    /** \brief Reads the common object data from an open script file
+    *** \param object_id The object id, set once the data is read.
+    *** \param script A script file with the object table opened.
+    **/
+    void LoadObjectData(uint32_t object_id, vt_script::ReadScriptDescriptor& script);
+
+    //! \brief Loads status effects data
+    void LoadStatusEffects(vt_script::ReadScriptDescriptor& script);
+
+    //! \brief Loads trading conditions data
+    void LoadTradeConditions(vt_script::ReadScriptDescriptor& script);
+
+    //! \brief Loads the object linked skills (used by equipment only)
+    void LoadEquipmentSkills(vt_script::ReadScriptDescriptor& script);
+};
+
+} // namespace private_global
+
 /** ****************************************************************************
 *** \brief An abstract base class for representing a game object
 ***
@@ -33,51 +107,31 @@ namespace vt_global
 *** class object rather than having to create and managed 50 class objects, one for
 *** each potion. The _count member achieves this convenient function.
 ***
-*** A GlobalObject with an ID value of zero is considered invalid. Most of the
-*** protected members of this class can only be set by the constructors or methods
-*** of deriving classes.
+*** The object data itself is kept in a definition shared by all the instances of
+*** the same object, so that creating an object is only a matter of setting its
+*** count and definition pointer.
+***
+*** A GlobalObject with an ID value of zero is considered invalid.
 ***
 *** \note The price of an object is not actually the price it is bought or sold
 *** at in the game. It is a "base price" from which all levels of buy and sell
 *** prices are derived from.
-***
-*** \todo The "lore" for an object is a feature that we have discussed but not
-*** yet decided if we wish to implement. Placeholders exist in this class for now,
-*** but if lore is not to be implemented as a game feature they should be removed.
 *** ***************************************************************************/
 class GlobalObject
 {
 public:
-    GlobalObject() :
-        _id(0),
-        _is_key_item(false),
-        _count(0),
-        _price(0),
-        _trade_price(0)
-    {
-    }
-
-    explicit GlobalObject(uint32_t id, uint32_t count = 1) :
-        _id(id),
-        _is_key_item(false),
-        _count(count),
-        _price(0),
-        _trade_price(0)
-    {
-    }
-
     virtual ~GlobalObject()
     {
     }
 
     //! \brief Returns true if the object is properly initialized and ready to be used
     bool IsValid() const {
-        return (_id != 0);
+        return (_definition->id != 0);
     }
 
     //! \brief Returns true if the object is properly initialized and ready to be used
     bool IsKeyItem() const {
-        return _is_key_item;
+        return _definition->is_key_item;
     }
 
     /** \brief Purely virtual function used to distinguish between object types
@@ -105,15 +159,15 @@ public:
     //! \name Class Member Access Functions
     //@{
     uint32_t GetID() const {
-        return _id;
+        return _definition->id;
     }
 
     const vt_utils::ustring &GetName() const {
-        return _name;
+        return _definition->name;
     }
 
     const vt_utils::ustring &GetDescription() const {
-        return _description;
+        return _definition->description;
     }
 
     void SetCount(uint32_t count) {
@@ -125,88 +179,41 @@ public:
     }
 
     uint32_t GetPrice() const {
-        return _price;
+        return _definition->price;
     }
 
     uint32_t GetTradingPrice() const {
-        return _trade_price;
+        return _definition->trade_price;
     }
 
     const std::vector<std::pair<uint32_t, uint32_t> >& GetTradeConditions() const {
-        return _trade_conditions;
+        return _definition->trade_conditions;
     }
 
     const vt_video::StillImage& GetIconImage() const {
-        return _icon_image;
+        return _definition->icon_image;
     }
 
     const std::vector<std::pair<GLOBAL_STATUS, GLOBAL_INTENSITY> >& GetStatusEffects() const {
-        return _status_effects;
+        return _definition->status_effects;
     }
     //@}
 
 protected:
-    /** \brief An identification number for each unique item
-    *** \note An ID number of zero indicates an invalid object
+    /** \param definition The object definition, given by the GlobalObjectRegistry. Never nullptr.
+    *** \param count The number of objects represented by this class object instance
     **/
-    uint32_t _id;
-
-    //! \brief The name of the object as it would be displayed on a screen
-    vt_utils::ustring _name;
-
-    //! \brief A short description of the item to display on the screen
-    vt_utils::ustring _description;
-
-    //! \brief Tells whether an item is a key item, preventing from being consumed or sold.
-    bool _is_key_item;
+    GlobalObject(const std::shared_ptr<const private_global::GlobalObjectDefinition>& definition, uint32_t count) :
+        _count(count),
+        _definition(definition)
+    {
+    }
 
     //! \brief Retains how many occurences of the object are represented by this class object instance
     uint32_t _count;
 
-    //! \brief The base price of the object for purchase/sale in the game
-    uint32_t _price;
-
-    //! \brief The additional price of the object requested when trading it.
-    uint32_t _trade_price;
-
-    //! \brief The trade conditions of the item <item_id, number>
-    //! There is an exception: If the item_id is zero, the second value is the trade price.
-    std::vector<std::pair<uint32_t, uint32_t> > _trade_conditions;
-
-    //! \brief A loaded icon image of the object at its original size of 60x60 pixels
-    vt_video::StillImage _icon_image;
-
-    /** \brief Container that holds the intensity of each type of status effect of the object
-    *** Effects with an intensity of GLOBAL_INTENSITY_NEUTRAL indicate no status effect bonus
-    **/
-    std::vector<std::pair<GLOBAL_STATUS, GLOBAL_INTENSITY> > _status_effects;
-
-    //! \brief The skills that can be learned when equipping that piece of equipment.
-    std::vector<uint32_t> _equipment_skills;
-
-    //! \brief Causes the object to become invalid due to a loading error or other significant issue
-    void _InvalidateObject() {
-        _id = 0;
-    }
-
-    /** \brief Reads object data from an open script file
-    *** \param script A reference to a script file that has been opened and prepared
-    ***
-    *** This method does not do any of its own error case checking. Only derived classes may call this
-    *** protected function and they are expected to have the script file successfully opened and the correct
-    *** table context prepared. This function will do nothing more but read the expected key/values of
-    *** the open table in the script file and return.
-    **/
-    void _LoadObjectData(vt_script::ReadScriptDescriptor &script);
-
-    //! \brief Loads status effects data
-    void _LoadStatusEffects(vt_script::ReadScriptDescriptor &script);
-
-    //! \brief Loads trading conditions data
-    void _LoadTradeConditions(vt_script::ReadScriptDescriptor &script);
-
-    //! \brief Loads the object linked skills (used by equipment only)
-    void _LoadEquipmentSkills(vt_script::ReadScriptDescriptor &script);
+    //! \brief The object data, shared by every instance of the object.
+    std::shared_ptr<const private_global::GlobalObjectDefinition> _definition;
 }; // class GlobalObject
 
 } // namespace vt_global
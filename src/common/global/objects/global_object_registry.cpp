@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    global_object_registry.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the registry of the objects definitions.
+*** ***************************************************************************/
+
+#include "global_object_registry.h"
+
+using namespace vt_global::private_global;
+
+namespace vt_global
+{
+
+//! \brief Returns the definition of the given id, loading it on first use.
+template <typename T>
+static std::shared_ptr<const T> GetDefinition(std::map<uint32_t, std::shared_ptr<const T> >& definitions, uint32_t id)
+{
+    typename std::map<uint32_t, std::shared_ptr<const T> >::const_iterator it = definitions.find(id);
+    if (it != definitions.end())
+        return it->second;
+
+    std::shared_ptr<T> definition = std::make_shared<T>();
+    definition->Load(id);
+    definitions.insert(std::make_pair(id, definition));
+    return definition;
+}
+
+std::shared_ptr<const GlobalItemDefinition> GlobalObjectRegistry::GetItemDefinition(uint32_t id)
+{
+    return GetDefinition(_items, id);
+}
+
+std::shared_ptr<const GlobalWeaponDefinition> GlobalObjectRegistry::GetWeaponDefinition(uint32_t id)
+{
+    return GetDefinition(_weapons, id);
+}
+
+std::shared_ptr<const GlobalArmorDefinition> GlobalObjectRegistry::GetArmorDefinition(uint32_t id)
+{
+    return GetDefinition(_armor, id);
+}
+
+std::shared_ptr<const GlobalSpiritDefinition> GlobalObjectRegistry::GetSpiritDefinition(uint32_t id)
+{
+    return GetDefinition(_spirits, id);
+}
+
+void GlobalObjectRegistry::Clear()
+{
+    _items.clear();
+    _weapons.clear();
+    _armor.clear();
+    _spirits.clear();
+}
+
+} // namespace vt_global
@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    global_object_registry.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the registry of the objects definitions.
+***
+*** Items, weapons, armor and spirits are defined in the inventory scripts.
+*** Each definition is read the first time an object with its id is created,
+*** and then shared by every instance of that object, including the icon image
+*** and the script functions.
+*** ***************************************************************************/
+
+#ifndef __GLOBAL_OBJECT_REGISTRY_HEADER__
+#define __GLOBAL_OBJECT_REGISTRY_HEADER__
+
+#include "global_item.h"
+#include "global_weapon.h"
+#include "global_armor.h"
+#include "global_spirit.h"
+
+namespace vt_global
+{
+
+/** ****************************************************************************
+*** \brief Loads and keeps the objects definitions, by object id.
+***
+*** The returned definitions are never nullptr: an invalid definition, with an id
+*** of zero, is kept for the ids that couldn't be loaded so that they are only
+*** reported once.
+***
+*** \note The definitions must be cleared whenever the inventory scripts are
+*** reloaded, e.g. when changing the language.
+*** ***************************************************************************/
+class GlobalObjectRegistry
+{
+public:
+    GlobalObjectRegistry()
+    {
+    }
+
+    std::shared_ptr<const private_global::GlobalItemDefinition> GetItemDefinition(uint32_t id);
+
+    std::shared_ptr<const private_global::GlobalWeaponDefinition> GetWeaponDefinition(uint32_t id);
+
+    std::shared_ptr<const private_global::GlobalArmorDefinition> GetArmorDefinition(uint32_t id);
+
+    std::shared_ptr<const private_global::GlobalSpiritDefinition> GetSpiritDefinition(uint32_t id);
+
+    //! \brief Forgets every definition. The existing objects keep theirs.
+    void Clear();
+
+    //! \brief Returns the number of definitions loaded.
+    uint32_t GetNumberDefinitions() const {
+        return static_cast<uint32_t>(_items.size() + _weapons.size() + _armor.size() + _spirits.size());
+    }
+
+private:
+    //! \brief The definitions loaded, by object id.
+    std::map<uint32_t, std::shared_ptr<const private_global::GlobalItemDefinition> > _items;
+    std::map<uint32_t, std::shared_ptr<const private_global::GlobalWeaponDefinition> > _weapons;
+    std::map<uint32_t, std::shared_ptr<const private_global::GlobalArmorDefinition> > _armor;
+    std::map<uint32_t, std::shared_ptr<const private_global::GlobalSpiritDefinition> > _spirits;
+
+    GlobalObjectRegistry(const GlobalObjectRegistry&) = delete;
+    GlobalObjectRegistry& operator=(const GlobalObjectRegistry&) = delete;
+};
+
+} // namespace vt_global
+
+#endif // __GLOBAL_OBJECT_REGISTRY_HEADER__
@@ -19,33 +19,40 @@ using namespace vt_global::private_global;
 namespace vt_global
 {
 
-GlobalSpirit::GlobalSpirit(uint32_t id, uint32_t count) :
-    GlobalObject(id, count)
+namespace private_global
+{
+
+void GlobalSpiritDefinition::Load(uint32_t object_id)
 {
-    if((_id <= MAX_LEG_ARMOR_ID) || (_id > MAX_SPIRIT_ID)) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << _id << std::endl;
-        _InvalidateObject();
+    if((object_id <= MAX_LEG_ARMOR_ID) || (object_id > MAX_SPIRIT_ID)) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid spirit id: " << object_id << std::endl;
         return;
     }
 
     ReadScriptDescriptor& script_file = GlobalManager->GetSpiritsScript();
-    if (script_file.DoesTableExist(_id) == false) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "No valid data for spirit id: " << _id << std::endl;
-        _InvalidateObject();
+    if (script_file.DoesTableExist(object_id) == false) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "No valid data for spirit id: " << object_id << std::endl;
         return;
     }
 
     // Load the spirit data from the script
-    script_file.OpenTable(_id);
-    _LoadObjectData(script_file);
+    script_file.OpenTable(object_id);
+    LoadObjectData(object_id, script_file);
 
     script_file.CloseTable();
     if (script_file.IsErrorDetected()) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "one or more errors occurred while reading spirit data - they are listed below" << std::endl
             << script_file.GetErrorMessages() << std::endl;
 
-        _InvalidateObject();
+        id = 0;
     }
 }
 
+} // namespace private_global
+
+GlobalSpirit::GlobalSpirit(uint32_t id, uint32_t count) :
+    GlobalObject(GlobalManager->GetObjectRegistry().GetSpiritDefinition(id), count)
+{
+}
+
 } // namespace vt_global
@@ -16,6 +16,17 @@
 namespace vt_global
 {
 
+namespace private_global
+{
+
+//! \brief The spirit data read from its definition script. See GlobalObjectDefinition.
+struct GlobalSpiritDefinition : public GlobalObjectDefinition {
+    //! \brief Loads the spirit data from the spirits script. The id is left to zero on failure.
+    void Load(uint32_t object_id);
+};
+
+} // namespace private_global
+
 /** ****************************************************************************
 *** \brief Represents any type of spirit that can be attached to weapons and armor
 ***
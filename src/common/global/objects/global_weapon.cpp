@@ -21,48 +21,48 @@ using namespace vt_utils;
 namespace vt_global
 {
 
-GlobalWeapon::GlobalWeapon(uint32_t id, uint32_t count) :
-    GlobalObject(id, count)
+namespace private_global
+{
+
+void GlobalWeaponDefinition::Load(uint32_t object_id)
 {
-    if((_id <= MAX_ITEM_ID) || (_id > MAX_WEAPON_ID)) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << _id << std::endl;
-        _InvalidateObject();
+    if((object_id <= MAX_ITEM_ID) || (object_id > MAX_WEAPON_ID)) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid weapon id: " << object_id << std::endl;
         return;
     }
 
     ReadScriptDescriptor &script_file = GlobalManager->GetWeaponsScript();
-    if(script_file.DoesTableExist(_id) == false) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "no valid data for weapon in definition file: " << _id << std::endl;
-        _InvalidateObject();
+    if(script_file.DoesTableExist(object_id) == false) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "no valid data for weapon in definition file: " << object_id << std::endl;
         return;
     }
 
     // Load the weapon data from the script
-    script_file.OpenTable(_id);
-    _LoadObjectData(script_file);
+    script_file.OpenTable(object_id);
+    LoadObjectData(object_id, script_file);
 
-    _LoadStatusEffects(script_file);
-    _LoadEquipmentSkills(script_file);
+    LoadStatusEffects(script_file);
+    LoadEquipmentSkills(script_file);
 
-    _physical_attack = script_file.ReadUInt("physical_attack");
-    _magical_attack = script_file.ReadUInt("magical_attack");
+    physical_attack = script_file.ReadUInt("physical_attack");
+    magical_attack = script_file.ReadUInt("magical_attack");
 
-    _usable_by = script_file.ReadUInt("usable_by");
+    usable_by = script_file.ReadUInt("usable_by");
 
     uint32_t spirits_number = script_file.ReadUInt("slots");
     // Only permit a max of 5 spirits for equipment
     if (spirits_number > 5) {
         spirits_number = 5;
-        PRINT_WARNING << "More than 5 spirit slots declared in item " << _id << std::endl;
+        PRINT_WARNING << "More than 5 spirit slots declared in item " << object_id << std::endl;
     }
-    _spirit_slots.resize(spirits_number, nullptr);
+    spirit_slots.resize(spirits_number, nullptr);
 
     // Load the possible battle ammo animated image filename.
-    _ammo_animation_file = script_file.ReadString("battle_ammo_animation_file");
+    ammo_animation_file = script_file.ReadString("battle_ammo_animation_file");
 
     // Load the weapon battle animation info
     if (script_file.DoesTableExist("battle_animations"))
-        _LoadWeaponBattleAnimations(script_file);
+        LoadWeaponBattleAnimations(script_file);
 
     script_file.CloseTable(); // id
     if(script_file.IsErrorDetected()) {
@@ -70,26 +70,13 @@ GlobalWeapon::GlobalWeapon(uint32_t id, uint32_t count) :
             PRINT_WARNING << "one or more errors occurred while reading weapon data - they are listed below"
                           << std::endl << script_file.GetErrorMessages() << std::endl;
         }
-        _InvalidateObject();
+        id = 0;
     }
 }
 
-const std::string& GlobalWeapon::GetWeaponAnimationFile(uint32_t character_id, const std::string& animation_alias)
+void GlobalWeaponDefinition::LoadWeaponBattleAnimations(ReadScriptDescriptor& script)
 {
-    if (_weapon_animations.find(character_id) == _weapon_animations.end())
-        return _empty_string;
-
-    const std::map<std::string, std::string>& char_map = _weapon_animations.at(character_id);
-    if (char_map.find(animation_alias) == char_map.end())
-        return _empty_string;
-
-    return char_map.at(animation_alias);
-}
-
-void GlobalWeapon::_LoadWeaponBattleAnimations(ReadScriptDescriptor& script)
-{
-    //std::map <uint32_t, std::map<std::string, std::string> > _weapon_animations;
-    _weapon_animations.clear();
+    weapon_animations.clear();
 
     // The character id keys
     std::vector<uint32_t> char_ids;
@@ -117,7 +104,7 @@ void GlobalWeapon::_LoadWeaponBattleAnimations(ReadScriptDescriptor& script)
         for (uint32_t j = 0; j < anim_aliases.size(); ++j) {
             std::string anim_alias = anim_aliases[j];
             std::string anim_file = script.ReadString(anim_alias);
-            _weapon_animations[char_id].insert(std::make_pair(anim_alias, anim_file));
+            weapon_animations[char_id].insert(std::make_pair(anim_alias, anim_file));
         }
 
         script.CloseTable(); // char_id
@@ -126,4 +113,24 @@ void GlobalWeapon::_LoadWeaponBattleAnimations(ReadScriptDescriptor& script)
     script.CloseTable(); // battle_animations
 }
 
+} // namespace private_global
+
+GlobalWeapon::GlobalWeapon(uint32_t id, uint32_t count) :
+    GlobalObject(GlobalManager->GetObjectRegistry().GetWeaponDefinition(id), count)
+{
+}
+
+const std::string& GlobalWeapon::GetWeaponAnimationFile(uint32_t character_id, const std::string& animation_alias) const
+{
+    const std::map<uint32_t, std::map<std::string, std::string> >& weapon_animations = _GetDefinition().weapon_animations;
+    if (weapon_animations.find(character_id) == weapon_animations.end())
+        return _empty_string;
+
+    const std::map<std::string, std::string>& char_map = weapon_animations.at(character_id);
+    if (char_map.find(animation_alias) == char_map.end())
+        return _empty_string;
+
+    return char_map.at(animation_alias);
+}
+
 } // namespace vt_global
@@ -18,6 +18,51 @@ namespace vt_global
 
 class GlobalSpirit;
 
+namespace private_global
+{
+
+//! \brief The weapon data read from its definition script. See GlobalObjectDefinition.
+struct GlobalWeaponDefinition : public GlobalObjectDefinition {
+    GlobalWeaponDefinition() :
+        physical_attack(0),
+        magical_attack(0),
+        usable_by(0)
+    {
+    }
+
+    //! \brief The battle image animation file used to display the weapon ammo.
+    std::string ammo_animation_file;
+
+    //! \brief The amount of physical damage that the weapon causes
+    uint32_t physical_attack;
+
+    //! \brief The amount of magical damage that the weapon causes for each elements.
+    uint32_t magical_attack;
+
+    /** \brief A bit-mask that determines which characters can use or equip the object
+    *** See the game character ID constants in global_actors.h for more information
+    **/
+    uint32_t usable_by;
+
+    //! \brief The info about weapon animations for each global character.
+    //! map < character_id, map < animation alias, animation filename > >
+    std::map <uint32_t, std::map<std::string, std::string> > weapon_animations;
+
+    /** \brief Spirit slots which may be used to place spirits on the weapon
+    *** Weapons may have no slots, so it is not uncommon for the size of this vector to be zero.
+    *** No spirit can be attached yet, so every pointer is nullptr.
+    **/
+    std::vector<GlobalSpirit *> spirit_slots;
+
+    //! \brief Loads the weapon data from the weapons script. The id is left to zero on failure.
+    void Load(uint32_t object_id);
+
+    //! \brief Loads the battle animations data for each character that can use the weapon.
+    void LoadWeaponBattleAnimations(vt_script::ReadScriptDescriptor& script);
+};
+
+} // namespace private_global
+
 /** ****************************************************************************
 *** \brief Represents weapon that may be equipped by characters or enemies
 ***
@@ -49,63 +94,39 @@ public:
     //! \name Class Member Access Functions
     //@{
     uint32_t GetPhysicalAttack() const {
-        return _physical_attack;
+        return _GetDefinition().physical_attack;
     }
 
     uint32_t GetMagicalAttack() const {
-        return _magical_attack;
+        return _GetDefinition().magical_attack;
     }
 
     uint32_t GetUsableBy() const {
-        return _usable_by;
+        return _GetDefinition().usable_by;
     }
 
     const std::vector<GlobalSpirit *>& GetSpiritSlots() const {
-        return _spirit_slots;
+        return _GetDefinition().spirit_slots;
     }
 
     const std::string& GetAmmoAnimationFile() const {
-        return _ammo_animation_file;
+        return _GetDefinition().ammo_animation_file;
     }
 
     //! \brief Get the animation filename corresponding to the character weapon animation
     //! requested.
-    const std::string& GetWeaponAnimationFile(uint32_t character_id, const std::string& animation_alias);
+    const std::string& GetWeaponAnimationFile(uint32_t character_id, const std::string& animation_alias) const;
 
     //! \brief Gives the list of learned skill thanks to this piece of equipment.
     const std::vector<uint32_t>& GetEquipmentSkills() const {
-        return _equipment_skills;
+        return _GetDefinition().equipment_skills;
     }
     //@}
 
 private:
-    //! \brief The battle image animation file used to display the weapon ammo.
-    std::string _ammo_animation_file;
-
-    //! \brief The amount of physical damage that the weapon causes
-    uint32_t _physical_attack;
-
-    //! \brief The amount of magical damage that the weapon causes for each elements.
-    uint32_t _magical_attack;
-
-    /** \brief A bit-mask that determines which characters can use or equip the object
-    *** See the game character ID constants in global_actors.h for more information
-    **/
-    uint32_t _usable_by;
-
-    //! \brief The info about weapon animations for each global character.
-    //! map < character_id, map < animation alias, animation filename > >
-    std::map <uint32_t, std::map<std::string, std::string> > _weapon_animations;
-
-    /** \brief Spirit slots which may be used to place spirits on the weapon
-    *** Weapons may have no slots, so it is not uncommon for the size of this vector to be zero.
-    *** When spirit slots are available but empty (has no attached spirit), the pointer at that index
-    *** will be nullptr.
-    **/
-    std::vector<GlobalSpirit *> _spirit_slots;
-
-    //! \brief Loads the battle animations data for each character that can use the weapon.
-    void _LoadWeaponBattleAnimations(vt_script::ReadScriptDescriptor& script);
+    const private_global::GlobalWeaponDefinition& _GetDefinition() const {
+        return static_cast<const private_global::GlobalWeaponDefinition&>(*_definition);
+    }
 }; // class GlobalWeapon : public GlobalObject
 
 } // namespace vt_global
@@ -25,6 +25,8 @@
 
 #include "engine/system.h"
 #include "engine/mode_manager.h"
+#include "engine/memory_accounting.h"
+#include "engine/virtual_file_system.h"
 
 #include "utils/utils_strings.h"
 #include "utils/utils_files.h"
@@ -590,6 +592,16 @@ void AudioEngine::DEBUG_PrintInfo()
     }
 }
 
+void AudioEngine::DEBUG_ReportMemoryUsage(vt_system::MemoryAccounting& accounting) const
+{
+    for(std::map<std::string, AudioCacheElement>::const_iterator it = _audio_cache.begin();
+            it != _audio_cache.end(); ++it) {
+        if(it->second.audio == nullptr)
+            continue;
+        accounting.Report(MEMORY_AUDIO, it->first, it->second.audio->DEBUG_GetMemorySize());
+    }
+}
+
 private_audio::AudioSource *AudioEngine::_AcquireAudioSource()
 {
     // (1) Find and return the first source that does not have an owner
@@ -618,7 +630,7 @@ private_audio::AudioSource *AudioEngine::_AcquireAudioSource()
 
 bool AudioEngine::_LoadAudio(const std::string &filename, bool is_music, vt_mode_manager::GameMode *gm)
 {
-    if(!DoesFileExist(filename))
+    if(!vt_system::FileSystemManager->DoesFileExist(filename))
         return false;
 
     std::map<std::string, private_audio::AudioCacheElement>::iterator it = _audio_cache.find(filename);
@@ -32,6 +32,10 @@
 
 #include <map>
 
+namespace vt_system {
+class MemoryAccounting;
+}
+
 //! \brief All related audio engine code is wrapped within this namespace
 namespace vt_audio
 {
@@ -327,6 +331,9 @@ public:
     //! \brief Prints information about the audio properties and settings of the user's machine
     void DEBUG_PrintInfo();
 
+    //! \brief Reports the memory used by each cached audio file to the memory accounting.
+    void DEBUG_ReportMemoryUsage(vt_system::MemoryAccounting& accounting) const;
+
 private:
     //! \note Constructors are kept private since this class is a singleton
     //@{
@@ -718,6 +718,26 @@ void AudioDescriptor::DEBUG_PrintInfo()
     }
 } // void AudioDescriptor::DEBUG_PrintInfo()
 
+uint32_t AudioDescriptor::DEBUG_GetMemorySize() const
+{
+    if(_input == nullptr)
+        return 0;
+
+    // Static audio data is entirely stored in its OpenAL buffer.
+    if(_stream == nullptr)
+        return _input->GetDataSize();
+
+    // The OpenAL streaming buffers and the buffer used to fill them.
+    uint32_t stream_bytes = _stream_buffer_size * _input->GetSampleSize();
+    uint32_t bytes = stream_bytes * (NUMBER_STREAMING_BUFFERS + 1);
+
+    // Audio streamed from memory keeps the whole data decoded.
+    if(dynamic_cast<const AudioMemory *>(_input) != nullptr)
+        bytes += _input->GetDataSize();
+
+    return bytes;
+}
+
 
 
 void AudioDescriptor::_SetVolumeControl(float volume)
@@ -372,6 +372,11 @@ public:
     //! \brief Prints various properties about the audio data managed by this class
     void DEBUG_PrintInfo();
 
+    /** \brief Returns the number of bytes held for this audio: The OpenAL buffer(s),
+    *** the streaming buffer and the decoded data when streamed from memory.
+    **/
+    uint32_t DEBUG_GetMemorySize() const;
+
 protected:
     //! \brief The current state of the audio (playing, stopped, etc.)
     AUDIO_STATE _state;
@@ -26,6 +26,8 @@
 
 #include "utils/utils_common.h"
 
+#include <cstdio>
+
 #include <cstring>
 
 namespace vt_audio
@@ -71,40 +73,49 @@ bool WavFile::Initialize()
 
     char buffer[4];
 
-    _file_input.open(_filename.c_str(), std::ios::binary);
-    if(_file_input.fail()) {
-        _file_input.clear();
-        return false;
+    // Archive entries are read in place, while the files on disk are streamed
+    // so that large files aren't held in memory.
+    _file_position = 0;
+    if(vt_system::FileSystemManager->IsInArchive(_filename)) {
+        if(!vt_system::FileSystemManager->ReadFile(_filename, _file_data))
+            return false;
+    }
+    else {
+        _file_input.open(_filename.c_str(), std::ios::binary);
+        if(_file_input.fail()) {
+            _file_input.clear();
+            return false;
+        }
     }
 
     // Check that the initial chunk ID is "RIFF" -- 4 bytes
-    _file_input.read(buffer, 4);
+    _ReadBytes(buffer, 4);
     if(buffer[0] != 'R' || buffer[1] != 'I' || buffer[2] != 'F' || buffer[3] != 'F') {
         IF_PRINT_WARNING(AUDIO_DEBUG) << "failed because initial chunk ID was not \"RIFF\"" << std::endl;
         return false;
     }
 
     // Get chunk size (file size - 8) -- 4 bytes
-    _file_input.read(buffer, 4);
+    _ReadBytes(buffer, 4);
     memcpy(&size, buffer, 4);
     SWAP_U32_FROM_LITTLE(size);
 
     // Check format to be "WAVE" -- 4 bytes
-    _file_input.read(buffer, 4);
+    _ReadBytes(buffer, 4);
     if(buffer[0] != 'W' || buffer[1] != 'A' || buffer[2] != 'V' || buffer[3] != 'E') {
         IF_PRINT_WARNING(AUDIO_DEBUG) << "failed because file format was not \"WAVE\"" << std::endl;
         return false;
     }
 
     // Check SubChunk ID to be "fmt " -- 4 bytes
-    _file_input.read(buffer, 4);
+    _ReadBytes(buffer, 4);
     if(buffer[0] != 'f' || buffer[1] != 'm' || buffer[2] != 't' || buffer[3] != ' ') {
         IF_PRINT_WARNING(AUDIO_DEBUG) << "failed because initial subchunk ID was not \"fmt \"" << std::endl;
         return false;
     }
 
     // Check subchunk size (to be 16) -- 4 bytes
-    _file_input.read(buffer, 4);
+    _ReadBytes(buffer, 4);
     memcpy(&size, buffer, 4);
     SWAP_U32_FROM_LITTLE(size);
     if(size != 16) {
@@ -113,7 +124,7 @@ bool WavFile::Initialize()
     }
 
     // Check audio format (only PCM supported currently) -- 2 bytes
-    _file_input.read(buffer, 2);
+    _ReadBytes(buffer, 2);
     size = 0;
     memcpy(&size, buffer, 2);
     SWAP_U32_FROM_LITTLE(size);
@@ -123,7 +134,7 @@ bool WavFile::Initialize()
     }
 
     // Get the number of channels (only mono and stereo supported) -- 2 bytes
-    _file_input.read(buffer, 2);
+    _ReadBytes(buffer, 2);
     memcpy(&_number_channels, buffer, 2);
     SWAP_U16_FROM_LITTLE(_number_channels);
     if(_number_channels != 1 && _number_channels != 2) {
@@ -132,23 +143,23 @@ bool WavFile::Initialize()
     }
 
     // Get sample rate (usually 11025, 22050, or 44100 Hz) -- 4 bytes
-    _file_input.read(buffer, 4);
+    _ReadBytes(buffer, 4);
     memcpy(&_samples_per_second, buffer, 4);
     SWAP_U32_FROM_LITTLE(_samples_per_second);
 
     // Get byte rate -- 4 bytes
     uint32_t byte_rate;
-    _file_input.read(buffer, 4);
+    _ReadBytes(buffer, 4);
     memcpy(&byte_rate, buffer, 4);
     SWAP_U32_FROM_LITTLE(byte_rate);
 
     // Get block alignment (channels * bits_per_sample / 8) -- 2 bytes
-    _file_input.read(buffer, 2);
+    _ReadBytes(buffer, 2);
     memcpy(&_sample_size, buffer, 2);
     SWAP_U16_FROM_LITTLE(_sample_size);
 
     // Get bits per sample -- 2 bytes
-    _file_input.read(buffer, 2);
+    _ReadBytes(buffer, 2);
     memcpy(&_bits_per_sample, buffer, 2);
     SWAP_U16_FROM_LITTLE(_bits_per_sample);
     if(_sample_size != (_number_channels * _bits_per_sample) / 8) {
@@ -157,18 +168,18 @@ bool WavFile::Initialize()
     }
 
     // Check subchunk 2 ID (to be "data") -- 4 bytes
-    _file_input.read(buffer, 4);
+    _ReadBytes(buffer, 4);
     if(buffer[0] != 'd' || buffer[1] != 'a' || buffer[2] != 't' || buffer[3] != 'a') {
         IF_PRINT_WARNING(AUDIO_DEBUG) << "failed because subchunk 2 ID was not \"data\"" << std::endl;
         return false;
     }
 
     // Check subchunk 2 size -- 4 bytes
-    _file_input.read(buffer, 4);
+    _ReadBytes(buffer, 4);
     memcpy(&_data_size, buffer, 4);
     SWAP_U32_FROM_LITTLE(_data_size);
 
-    _data_init = _file_input.tellg();
+    _data_init = _file_position;
     _total_number_samples = _data_size / _sample_size;
     _play_time = static_cast<float>(_total_number_samples) / static_cast<float>(_samples_per_second);
     return true;
@@ -185,17 +196,18 @@ void WavFile::Seek(uint32_t sample_position)
         return;
     }
 
-    _file_input.clear();
-    _file_input.seekg(static_cast<std::streamoff>(sample + _data_init), std::ios_base::beg);
+    _file_position = _data_init + sample;
+    if(_file_input.is_open()) {
+        _file_input.clear();
+        _file_input.seekg(static_cast<std::streamoff>(_file_position), std::ios_base::beg);
+    }
 }
 
 
 
 uint32_t WavFile::Read(uint8_t *buffer, uint32_t size, bool &end)
 {
-    _file_input.read(reinterpret_cast<char *>(buffer), size * _sample_size);
-
-    uint32_t read = _file_input.gcount() / _sample_size;
+    uint32_t read = _ReadBytes(reinterpret_cast<char *>(buffer), size * _sample_size) / _sample_size;
     end = (read != size);
 
 #ifdef __BIG_ENDIAN__
@@ -212,6 +224,26 @@ uint32_t WavFile::Read(uint8_t *buffer, uint32_t size, bool &end)
     return read;
 }
 
+size_t WavFile::_ReadBytes(char *buffer, size_t size)
+{
+    if(_file_input.is_open()) {
+        _file_input.read(buffer, size);
+        size = static_cast<size_t>(_file_input.gcount());
+        _file_position += size;
+        return size;
+    }
+
+    if(_file_position >= _file_data.GetSize())
+        return 0;
+
+    if(size > _file_data.GetSize() - _file_position)
+        size = _file_data.GetSize() - _file_position;
+
+    memcpy(buffer, _file_data.GetData() + _file_position, size);
+    _file_position += size;
+    return size;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // OggFile class methods
 ////////////////////////////////////////////////////////////////////////////////
@@ -220,7 +252,8 @@ OggFile::OggFile(const std::string& file_name) :
     AudioInput(),
     _read_buffer_position(0),
     _read_buffer_size(0),
-    _initialized(false)
+    _initialized(false),
+    _file_position(0)
 {
     // Fill the buffer with 0
     memset(_read_buffer, 0, 4096);
@@ -240,41 +273,62 @@ bool OggFile::Initialize()
 {
     _initialized = false;
 
-    // Windows requires a special loading method in order load ogg files
-    // properly when dynamically linking vorbis libs. The workaround is
-    // to use the ov_open_callbacks function
-#ifdef _WIN32
-    // Callbacks struct defining the open, closing, seeking and location behaviors.
-    ov_callbacks callbacks =  {
-        (size_t ( *)(void *, size_t, size_t, void *)) fread,
-        (int ( *)(void *, ogg_int64_t, int)) _FileSeekWrapper,
-        (int ( *)(void *)) fclose,
-        (long( *)(void *)) ftell
-    };
-
-    FILE *file = fopen(_filename.c_str(), "rb");
-
-    if (!file)
-        return false;
-
-    if(ov_open_callbacks(file, &_vorbis_file, nullptr, 0, callbacks) < 0) {
-        fclose(file);
-        IF_PRINT_WARNING(AUDIO_DEBUG) << "input file does not appear to be an Ogg bitstream: " << _filename << std::endl;
-        return false;
+    // Archive entries are decoded from memory, in place when not compressed.
+    if(vt_system::FileSystemManager->IsInArchive(_filename)) {
+        _file_position = 0;
+        if(!vt_system::FileSystemManager->ReadFile(_filename, _file_data))
+            return false;
+
+        ov_callbacks callbacks = {
+            _MemoryRead,
+            _MemorySeek,
+            nullptr, // Nothing to close, the file data is released with the object.
+            _MemoryTell
+        };
+
+        if(ov_open_callbacks(this, &_vorbis_file, nullptr, 0, callbacks) < 0) {
+            _file_data.Clear();
+            IF_PRINT_WARNING(AUDIO_DEBUG) << "input file does not appear to be an Ogg bitstream: " << _filename << std::endl;
+            return false;
+        }
     }
+    else {
+        // Windows requires a special loading method in order load ogg files
+        // properly when dynamically linking vorbis libs. The workaround is
+        // to use the ov_open_callbacks function
+#ifdef _WIN32
+        // Callbacks struct defining the open, closing, seeking and location behaviors.
+        ov_callbacks callbacks =  {
+            (size_t ( *)(void *, size_t, size_t, void *)) fread,
+            (int ( *)(void *, ogg_int64_t, int)) _FileSeekWrapper,
+            (int ( *)(void *)) fclose,
+            (long( *)(void *)) ftell
+        };
+
+        FILE *file = fopen(_filename.c_str(), "rb");
+
+        if (!file)
+            return false;
+
+        if(ov_open_callbacks(file, &_vorbis_file, nullptr, 0, callbacks) < 0) {
+            fclose(file);
+            IF_PRINT_WARNING(AUDIO_DEBUG) << "input file does not appear to be an Ogg bitstream: " << _filename << std::endl;
+            return false;
+        }
 #else
-    // File loading code for non Win32 platforms.  Much simpler.
-    FILE *file = fopen(_filename.c_str(), "rb");
+        // File loading code for non Win32 platforms.  Much simpler.
+        FILE *file = fopen(_filename.c_str(), "rb");
 
-    if (!file)
-        return false;
+        if (!file)
+            return false;
 
-    if(ov_open(file, &_vorbis_file, nullptr, 0) < 0) {
-        fclose(file);
-        IF_PRINT_WARNING(AUDIO_DEBUG) << "input file does not appear to be an Ogg bitstream: " << _filename << std::endl;
-        return false;
-    }
+        if(ov_open(file, &_vorbis_file, nullptr, 0) < 0) {
+            fclose(file);
+            IF_PRINT_WARNING(AUDIO_DEBUG) << "input file does not appear to be an Ogg bitstream: " << _filename << std::endl;
+            return false;
+        }
 #endif
+    }
 
     _number_channels = _vorbis_file.vi->channels;
     _samples_per_second = _vorbis_file.vi->rate;
@@ -361,6 +415,54 @@ uint32_t OggFile::Read(uint8_t *buffer, uint32_t size, bool &end)
 } // uint32_t OggFile::Read(uint8_t* buffer, uint32_t size, bool& end)
 
 
+size_t OggFile::_MemoryRead(void *buffer, size_t size, size_t count, void *data_source)
+{
+    OggFile *ogg_file = static_cast<OggFile *>(data_source);
+    const vt_system::FileData &file_data = ogg_file->_file_data;
+
+    if(size == 0 || ogg_file->_file_position >= file_data.GetSize())
+        return 0;
+
+    size_t available = (file_data.GetSize() - ogg_file->_file_position) / size;
+    if(count > available)
+        count = available;
+
+    memcpy(buffer, file_data.GetData() + ogg_file->_file_position, size * count);
+    ogg_file->_file_position += size * count;
+    return count;
+}
+
+int OggFile::_MemorySeek(void *data_source, ogg_int64_t offset, int whence)
+{
+    OggFile *ogg_file = static_cast<OggFile *>(data_source);
+    ogg_int64_t position = 0;
+
+    switch(whence) {
+    case SEEK_SET:
+        position = offset;
+        break;
+    case SEEK_CUR:
+        position = static_cast<ogg_int64_t>(ogg_file->_file_position) + offset;
+        break;
+    case SEEK_END:
+        position = static_cast<ogg_int64_t>(ogg_file->_file_data.GetSize()) + offset;
+        break;
+    default:
+        return -1;
+    }
+
+    if(position < 0 || position > static_cast<ogg_int64_t>(ogg_file->_file_data.GetSize()))
+        return -1;
+
+    ogg_file->_file_position = static_cast<size_t>(position);
+    return 0;
+}
+
+long OggFile::_MemoryTell(void *data_source)
+{
+    return static_cast<long>(static_cast<OggFile *>(data_source)->_file_position);
+}
+
 #ifdef _WIN32
 int OggFile::_FileSeekWrapper(FILE *file, ogg_int64_t off, int whence)
 {
@@ -26,6 +26,8 @@
 #ifndef __AUDIO_INPUT_HEADER__
 #define __AUDIO_INPUT_HEADER__
 
+#include "engine/virtual_file_system.h"
+
 #include <vorbis/vorbisfile.h>
 
 #include <fstream>
@@ -147,12 +149,17 @@ protected:
 *** Wav files are usually used for sounds. This class implements its own custom
 *** wav file parser/loader to interpret the data from the file into meaningful
 *** audio data.
+***
+*** \note Files from an archive are read in place through the virtual file system,
+*** while the files on disk are streamed.
 *** ***************************************************************************/
 class WavFile : public AudioInput
 {
 public:
     explicit WavFile(const std::string& file_name) :
-        AudioInput() {
+        AudioInput(),
+        _file_position(0),
+        _data_init(0) {
         _filename = file_name;
     }
 
@@ -173,11 +180,22 @@ public:
     //@}
 
 private:
-    //! \brief The input I/O stream for the file
+    //! \brief The input I/O stream for the files on disk
     std::ifstream _file_input;
 
+    //! \brief The file content, when read from an archive
+    vt_system::FileData _file_data;
+
+    //! \brief The read cursor position in the file
+    size_t _file_position;
+
     //! \brief The offset to where the data begins in the file (past the header information)
-    std::streampos _data_init;
+    size_t _data_init;
+
+    /** \brief Reads bytes from the file content, and moves the read cursor.
+    *** \return The number of bytes actually read.
+    **/
+    size_t _ReadBytes(char *buffer, size_t size);
 }; // class WavFile : public AudioInput
 
 
@@ -221,6 +239,21 @@ private:
     //! It is used to know whether they can be deallocated.
     bool _initialized;
 
+    //! \brief The file content, when read from an archive.
+    vt_system::FileData _file_data;
+
+    //! \brief The read cursor position in the archive file content.
+    size_t _file_position;
+
+    /** \brief The vorbisfile callbacks used to read from the archive file content.
+    *** \note They use the C types, as expected by the vorbisfile library.
+    **/
+    //@{
+    static size_t _MemoryRead(void *buffer, size_t size, size_t count, void *data_source);
+    static int _MemorySeek(void *data_source, ogg_int64_t offset, int whence);
+    static long _MemoryTell(void *data_source);
+    //@}
+
 #ifdef _WIN32
     /** \brief A wrapper function for file seek operations
     *** \param ffile A pointer to the FILE struct which represents the input stream
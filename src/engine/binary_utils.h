@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    binary_utils.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the binary data helpers.
+***
+*** The binary files written by the game (archives, compiled maps, save files,
+*** caches) are all little endian, and their fields are possibly unaligned.
+*** They are validated using the same 64 bits FNV-1a hash.
+*** ***************************************************************************/
+
+#ifndef __BINARY_UTILS_HEADER__
+#define __BINARY_UTILS_HEADER__
+
+#include <SDL2/SDL_endian.h>
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+namespace vt_system
+{
+
+//! \brief Returns the FNV-1a hash (64 bits) of the given data.
+inline uint64_t ComputeHash(const uint8_t* data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+inline uint64_t ComputeHash(const std::string& text)
+{
+    return ComputeHash(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+}
+
+//! \brief Little endian readers.
+inline uint16_t ReadUInt16(const uint8_t* data)
+{
+    uint16_t value;
+    memcpy(&value, data, sizeof(value));
+    return SDL_SwapLE16(value);
+}
+
+inline uint32_t ReadUInt32(const uint8_t* data)
+{
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return SDL_SwapLE32(value);
+}
+
+inline uint64_t ReadUInt64(const uint8_t* data)
+{
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+    return SDL_SwapLE64(value);
+}
+
+//! \brief Little endian writers.
+inline void WriteUInt16(uint8_t* data, uint16_t value)
+{
+    value = SDL_SwapLE16(value);
+    memcpy(data, &value, sizeof(value));
+}
+
+inline void WriteUInt32(uint8_t* data, uint32_t value)
+{
+    value = SDL_SwapLE32(value);
+    memcpy(data, &value, sizeof(value));
+}
+
+inline void WriteUInt64(uint8_t* data, uint64_t value)
+{
+    value = SDL_SwapLE64(value);
+    memcpy(data, &value, sizeof(value));
+}
+
+} // namespace vt_system
+
+#endif // __BINARY_UTILS_HEADER__
@@ -335,6 +335,32 @@ void InputEngine::_KeyEventHandler(SDL_KeyboardEvent &key_event)
                 // Display and cycle through the texture sheets
                 TextureManager->DEBUG_NextTexSheet();
                 return;
+            } else if(key_event.keysym.sym == SDLK_e) {
+                // Dump the recorded frame telemetry, or start recording it.
+                FrameTelemetry& telemetry = SystemManager->GetTelemetry();
+                if(telemetry.IsEnabled())
+                    telemetry.DumpToUserDataPath();
+                else
+                    telemetry.SetEnabled(true);
+                return;
+            } else if(key_event.keysym.sym == SDLK_p) {
+                // Start profiling the scripts, or stop and write the profile.
+                ScriptProfiler& profiler = SystemManager->GetScriptProfiler();
+                if(profiler.IsEnabled()) {
+                    profiler.SetEnabled(false);
+                    profiler.DumpToUserDataPath();
+                    profiler.Reset();
+                } else {
+                    profiler.SetEnabled(true);
+                }
+                return;
+            } else if(key_event.keysym.sym == SDLK_m) {
+                // Print the memory used per subsystem, and check the budgets
+                MemoryAccounting& accounting = SystemManager->GetMemoryAccounting();
+                accounting.Collect();
+                accounting.PrintReport(std::cout);
+                accounting.CheckBudgets();
+                return;
             }
 #endif
 
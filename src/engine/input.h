@@ -142,6 +142,10 @@ public:
 *** - Ctrl+F     :: toggles the game between running in windowed and fullscreen mode
 *** - Ctrl+Q     :: brings up the quit menu/quits the game
 *** - Ctrl+S     :: saves a screenshot of the current screen
+*** - Ctrl+E     :: starts recording the frame telemetry, or dumps it when already recording
+***                 (only with the debug features)
+*** - Ctrl+M     :: prints the memory used per subsystem and warns about exceeded budgets
+***                 (only with the debug features)
 *** - Quit Event :: same as Ctrl+Q, this happens when the user tries to close the game window
 ***
 *** \note This class is a singleton.
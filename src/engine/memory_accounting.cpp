@@ -0,0 +1,227 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    memory_accounting.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the per subsystem memory accounting.
+*** ***************************************************************************/
+
+#include "engine/memory_accounting.h"
+
+#include "engine/audio/audio.h"
+#include "engine/video/texture_controller.h"
+#include "engine/mode_manager.h"
+
+#include "script/script.h"
+#include "script/script_read.h"
+
+#include "utils/utils_files.h"
+#include "utils/utils_strings.h"
+
+using namespace vt_utils;
+using namespace vt_script;
+
+namespace vt_system
+{
+
+//! \brief Formats a bytes count as KiB for the report.
+static std::string _FormatBytes(uint64_t bytes)
+{
+    return NumberToString<uint64_t>((bytes + 1023) / 1024) + " KiB";
+}
+
+MemoryAccounting::MemoryAccounting()
+{
+    for (uint32_t i = 0; i < MEMORY_TOTAL; ++i)
+        _budgets[i] = 0;
+}
+
+void MemoryAccounting::SetBudget(MEMORY_CATEGORY category, uint64_t bytes)
+{
+    if (category <= MEMORY_INVALID || category >= MEMORY_TOTAL) {
+        PRINT_WARNING << "Invalid memory category: " << category << std::endl;
+        return;
+    }
+    _budgets[category] = bytes;
+}
+
+bool MemoryAccounting::HasBudgets() const
+{
+    for (uint32_t i = 0; i < MEMORY_TOTAL; ++i) {
+        if (_budgets[i] > 0)
+            return true;
+    }
+    return false;
+}
+
+bool MemoryAccounting::LoadBudgets(const std::string& filename)
+{
+    // The budgets file is optional.
+    if (!DoesFileExist(filename))
+        return true;
+
+    ReadScriptDescriptor budgets_script;
+    if (!budgets_script.OpenFile(filename))
+        return false;
+
+    if (!budgets_script.OpenTable("memory_budgets")) {
+        PRINT_WARNING << "No 'memory_budgets' table in file: " << filename << std::endl;
+        budgets_script.CloseFile();
+        return false;
+    }
+
+    // The budgets are only applied once the whole file has been read without error.
+    uint64_t budgets[MEMORY_TOTAL];
+    for (uint32_t i = 0; i < MEMORY_TOTAL; ++i) {
+        MEMORY_CATEGORY category = static_cast<MEMORY_CATEGORY>(i);
+        const char* name = GetCategoryName(category);
+        budgets[i] = _budgets[i];
+        if (budgets_script.DoesUIntExist(name))
+            budgets[i] = static_cast<uint64_t>(budgets_script.ReadUInt(name)) * 1024;
+    }
+
+    budgets_script.CloseTable(); // memory_budgets
+
+    if (budgets_script.IsErrorDetected()) {
+        PRINT_WARNING << "Errors while loading the memory budgets: " << filename << std::endl
+                      << budgets_script.GetErrorMessages() << std::endl;
+        budgets_script.CloseFile();
+        return false;
+    }
+
+    budgets_script.CloseFile();
+
+    for (uint32_t i = 0; i < MEMORY_TOTAL; ++i)
+        _budgets[i] = budgets[i];
+    return true;
+}
+
+void MemoryAccounting::Clear()
+{
+    for (uint32_t i = 0; i < MEMORY_TOTAL; ++i)
+        _entries[i].clear();
+}
+
+void MemoryAccounting::Collect()
+{
+    Clear();
+
+    if (vt_video::TextureManager)
+        vt_video::TextureManager->DEBUG_ReportMemoryUsage(*this);
+
+    if (vt_audio::AudioManager)
+        vt_audio::AudioManager->DEBUG_ReportMemoryUsage(*this);
+
+    if (ScriptManager) {
+        // The Lua heap is reported as a whole, as it can't be split per script.
+        lua_State* lua_state = ScriptManager->GetGlobalState();
+        uint64_t lua_bytes = static_cast<uint64_t>(lua_gc(lua_state, LUA_GCCOUNT, 0)) * 1024
+                             + static_cast<uint64_t>(lua_gc(lua_state, LUA_GCCOUNTB, 0));
+        Report(MEMORY_SCRIPT, "Lua heap", lua_bytes);
+    }
+
+    if (vt_mode_manager::ModeManager)
+        vt_mode_manager::ModeManager->DEBUG_ReportMemoryUsage(*this);
+}
+
+void MemoryAccounting::Report(MEMORY_CATEGORY category, const std::string& name, uint64_t bytes, uint32_t count)
+{
+    if (category <= MEMORY_INVALID || category >= MEMORY_TOTAL) {
+        PRINT_WARNING << "Invalid memory category: " << category << std::endl;
+        return;
+    }
+    _entries[category].push_back(MemoryUsage(name, bytes, count));
+}
+
+uint64_t MemoryAccounting::GetBytes(MEMORY_CATEGORY category) const
+{
+    uint64_t bytes = 0;
+    for (uint32_t i = 0; i < _entries[category].size(); ++i)
+        bytes += _entries[category][i].bytes;
+    return bytes;
+}
+
+uint32_t MemoryAccounting::GetCount(MEMORY_CATEGORY category) const
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < _entries[category].size(); ++i)
+        count += _entries[category][i].count;
+    return count;
+}
+
+bool MemoryAccounting::CheckBudgets() const
+{
+    bool within_budgets = true;
+    for (uint32_t i = 0; i < MEMORY_TOTAL; ++i) {
+        if (_budgets[i] == 0)
+            continue;
+
+        MEMORY_CATEGORY category = static_cast<MEMORY_CATEGORY>(i);
+        uint64_t bytes = GetBytes(category);
+        if (bytes <= _budgets[i])
+            continue;
+
+        PRINT_WARNING << "Memory budget exceeded for '" << GetCategoryName(category) << "': "
+                      << _FormatBytes(bytes) << " used, for a budget of "
+                      << _FormatBytes(_budgets[i]) << std::endl;
+        within_budgets = false;
+    }
+    return within_budgets;
+}
+
+void MemoryAccounting::PrintReport(std::ostream& stream) const
+{
+    uint64_t total_bytes = 0;
+    for (uint32_t i = 0; i < MEMORY_TOTAL; ++i)
+        total_bytes += GetBytes(static_cast<MEMORY_CATEGORY>(i));
+
+    stream << "Memory report: " << _FormatBytes(total_bytes) << std::endl;
+
+    for (uint32_t i = 0; i < MEMORY_TOTAL; ++i) {
+        MEMORY_CATEGORY category = static_cast<MEMORY_CATEGORY>(i);
+        bool last_category = (i + 1 == MEMORY_TOTAL);
+
+        stream << (last_category ? "`-- " : "|-- ") << GetCategoryName(category) << ": "
+               << _FormatBytes(GetBytes(category)) << ", "
+               << GetCount(category) << " object(s)";
+        if (_budgets[i] > 0)
+            stream << " (budget: " << _FormatBytes(_budgets[i]) << ")";
+        stream << std::endl;
+
+        const std::vector<MemoryUsage>& entries = _entries[i];
+        for (uint32_t j = 0; j < entries.size(); ++j) {
+            stream << (last_category ? "    " : "|   ")
+                   << (j + 1 == entries.size() ? "`-- " : "|-- ")
+                   << entries[j].name << ": " << _FormatBytes(entries[j].bytes)
+                   << ", " << entries[j].count << " object(s)" << std::endl;
+        }
+    }
+}
+
+const char* MemoryAccounting::GetCategoryName(MEMORY_CATEGORY category)
+{
+    switch(category) {
+    case MEMORY_TEXTURES:
+        return "textures";
+    case MEMORY_AUDIO:
+        return "audio";
+    case MEMORY_SCRIPT:
+        return "script";
+    case MEMORY_MAP_OBJECTS:
+        return "map_objects";
+    case MEMORY_PARTICLES:
+        return "particles";
+    default:
+        break;
+    }
+    return "invalid";
+}
+
+} // namespace vt_system
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    memory_accounting.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the per subsystem memory accounting.
+***
+*** Each subsystem reports its live bytes and object counts into the memory
+*** accounting, which can then print a report tree and warn when the budget
+*** set for a category is exceeded.
+*** ***************************************************************************/
+
+#ifndef __MEMORY_ACCOUNTING_HEADER__
+#define __MEMORY_ACCOUNTING_HEADER__
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+
+namespace vt_system
+{
+
+//! \brief The memory categories, one per reporting subsystem.
+enum MEMORY_CATEGORY {
+    MEMORY_INVALID     = -1,
+    //! The texture sheets managed by the texture controller.
+    MEMORY_TEXTURES    = 0,
+    //! The decoded audio data and OpenAL buffers held by the audio cache.
+    MEMORY_AUDIO       = 1,
+    //! The Lua heap used by the script engine.
+    MEMORY_SCRIPT      = 2,
+    //! The objects and collision data of the loaded maps.
+    MEMORY_MAP_OBJECTS = 3,
+    //! The particle buffers of the game modes particle managers.
+    MEMORY_PARTICLES   = 4,
+    MEMORY_TOTAL       = 5
+};
+
+//! \brief A single reported memory usage entry.
+struct MemoryUsage {
+    MemoryUsage(const std::string& usage_name, uint64_t usage_bytes, uint32_t usage_count):
+        name(usage_name),
+        bytes(usage_bytes),
+        count(usage_count)
+    {}
+
+    //! \brief The name of the entry, e.g.: a filename.
+    std::string name;
+
+    //! \brief The live bytes used.
+    uint64_t bytes;
+
+    //! \brief The number of objects those bytes are used by.
+    uint32_t count;
+};
+
+/** ****************************************************************************
+*** \brief Gathers the memory used by the engine subsystems.
+***
+*** Collect() clears the previous entries and asks every subsystem to report
+*** its memory usage through Report(). The result can then be printed as a tree
+*** (category -> entries) and compared to the budgets.
+***
+*** \note The budgets can be set from the optional data/config/memory_budgets.lua
+*** file. A budget of 0 means there is no budget for the category.
+*** ***************************************************************************/
+class MemoryAccounting
+{
+public:
+    MemoryAccounting();
+
+    /** \brief Sets the budget of a category.
+    *** \param bytes The maximum number of bytes, or 0 to disable the budget.
+    **/
+    void SetBudget(MEMORY_CATEGORY category, uint64_t bytes);
+
+    uint64_t GetBudget(MEMORY_CATEGORY category) const {
+        return _budgets[category];
+    }
+
+    //! \brief Tells whether at least one budget is set.
+    bool HasBudgets() const;
+
+    /** \brief Loads the budgets from a script file containing a 'memory_budgets' table,
+    *** with values in KiB, e.g.: memory_budgets = { textures = 131072, script = 32768 }
+    *** \return false if the file exists but couldn't be read. The budgets are then left as they were.
+    **/
+    bool LoadBudgets(const std::string& filename);
+
+    //! \brief Removes all the reported entries.
+    void Clear();
+
+    //! \brief Clears the entries and asks every subsystem to report its memory usage.
+    void Collect();
+
+    /** \brief Adds a memory usage entry to a category.
+    *** \param name The entry name, shown in the report.
+    *** \param bytes The live bytes used.
+    *** \param count The number of objects using those bytes.
+    **/
+    void Report(MEMORY_CATEGORY category, const std::string& name, uint64_t bytes, uint32_t count = 1);
+
+    //! \brief Returns the total bytes reported in a category.
+    uint64_t GetBytes(MEMORY_CATEGORY category) const;
+
+    //! \brief Returns the total objects count reported in a category.
+    uint32_t GetCount(MEMORY_CATEGORY category) const;
+
+    const std::vector<MemoryUsage>& GetEntries(MEMORY_CATEGORY category) const {
+        return _entries[category];
+    }
+
+    /** \brief Prints a warning for each category exceeding its budget.
+    *** \return false if at least one budget is exceeded.
+    **/
+    bool CheckBudgets() const;
+
+    //! \brief Prints the report tree of the collected entries.
+    void PrintReport(std::ostream& stream) const;
+
+    //! \brief Returns the name of a category, as used in the report and the budgets file.
+    static const char* GetCategoryName(MEMORY_CATEGORY category);
+
+private:
+    //! \brief The reported entries, per category.
+    std::vector<MemoryUsage> _entries[MEMORY_TOTAL];
+
+    //! \brief The budget of each category in bytes, 0 when not set.
+    uint64_t _budgets[MEMORY_TOTAL];
+};
+
+} // namespace vt_system
+
+#endif // __MEMORY_ACCOUNTING_HEADER__
@@ -18,12 +18,15 @@
 #include "mode_manager.h"
 
 #include "system.h"
+#include "memory_accounting.h"
 
 #include "engine/video/video.h"
 #include "engine/audio/audio.h"
 
 #include "modes/mode_help_window.h"
 
+#include "utils/utils_strings.h"
+
 using namespace vt_utils;
 using namespace vt_system;
 using namespace vt_video;
@@ -78,6 +81,9 @@ void GameMode::Update()
     _effect_supervisor.Update(frame_time);
     _particle_manager.Update(frame_time);
     _indicator_supervisor.Update();
+
+    vt_system::SystemManager->GetTelemetry().SetValue(vt_system::TELEMETRY_PARTICLES,
+                                                      static_cast<uint32_t>(_particle_manager.GetNumParticles()));
 }
 
 
@@ -105,6 +111,13 @@ ParticleManager& GameMode::GetParticleManager()
     return _particle_manager;
 }
 
+void GameMode::DEBUG_ReportMemoryUsage(vt_system::MemoryAccounting& accounting)
+{
+    accounting.Report(vt_system::MEMORY_PARTICLES,
+                      "Game mode " + NumberToString<uint32_t>(_mode_type) + " particle effects",
+                      _particle_manager.GetMemorySize(), _particle_manager.GetNumEffects());
+}
+
 ScriptSupervisor& GameMode::GetScriptSupervisor()
 {
     return _script_supervisor;
@@ -307,6 +320,9 @@ void ModeEngine::Update()
             SystemManager->ExitGame();
         }
 
+        // Clear the telemetry context, the game mode can set its own on reset.
+        SystemManager->GetTelemetry().SetContext(std::string());
+
         // Call the newly active game mode's Reset() function
         // to re-initialize the game mode
         _game_stack.back()->Reset();
@@ -320,6 +336,16 @@ void ModeEngine::Update()
         // We can now fade in, or not
         VideoManager->_TransitionalFadeIn(_fade_in ? FADE_IN_OUT_TIME : 0);
 
+        // Collect the garbage left by the previous modes and the new mode loading.
+        SystemManager->GetScriptCollector().FullCollect();
+
+        // Check the memory budgets, if any, now that the new mode is loaded.
+        MemoryAccounting& accounting = SystemManager->GetMemoryAccounting();
+        if(accounting.HasBudgets()) {
+            accounting.Collect();
+            accounting.CheckBudgets();
+        }
+
         // Call the system manager and tell it that the active game mode changed
         // so it can update timers accordingly
         SystemManager->ExamineSystemTimers();
@@ -378,4 +404,10 @@ void ModeEngine::DEBUG_PrintStack()
     PRINT_WARNING << "***bottom of stack***" << std::endl;
 }
 
+void ModeEngine::DEBUG_ReportMemoryUsage(vt_system::MemoryAccounting& accounting)
+{
+    for(uint32_t i = 0; i < _game_stack.size(); ++i)
+        _game_stack[i]->DEBUG_ReportMemoryUsage(accounting);
+}
+
 } // namespace vt_mode_manager
@@ -23,6 +23,10 @@
 #include "engine/script_supervisor.h"
 #include "engine/indicator_supervisor.h"
 
+namespace vt_system {
+class MemoryAccounting;
+}
+
 //! All calls to the mode management code are wrapped inside this namespace
 namespace vt_mode_manager
 {
@@ -127,6 +131,10 @@ public:
         return true;
     }
 
+    //! \brief Reports the memory used by the game mode to the memory accounting.
+    //! Game modes owning big data sets (e.g. maps) should extend it.
+    virtual void DEBUG_ReportMemoryUsage(vt_system::MemoryAccounting& accounting);
+
 protected:
     //! Indicates what 'mode' this object is in (what type of inherited class).
     uint8_t _mode_type;
@@ -278,6 +286,9 @@ public:
 
     //! \brief Prints the contents of the game_stack member to standard output.
     void DEBUG_PrintStack();
+
+    //! \brief Reports the memory used by every game mode in the stack to the memory accounting.
+    void DEBUG_ReportMemoryUsage(vt_system::MemoryAccounting& accounting);
 }; // class ModeEngine : public vt_utils::Singleton<ModeEngine>
 
 } // namespace vt_mode_manager
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    script_collector.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the frame budgeted Lua garbage collection.
+*** ***************************************************************************/
+
+#include "engine/script_collector.h"
+
+#include "engine/system.h"
+
+#include "script/script.h"
+
+namespace vt_system
+{
+
+float SCRIPT_GC_BUDGET = 1.0f;
+
+//! \brief The amount of memory, in KiB, processed by each incremental step.
+const int32_t SCRIPT_GC_STEP_SIZE = 4;
+
+//! \brief The memory growth, in percent, before starting a new cycle. The same as the Lua default pause.
+const uint32_t SCRIPT_GC_PAUSE = 200;
+
+ScriptCollector::ScriptCollector():
+    _lua_state(nullptr),
+    _budget(0),
+    _cycle_running(false),
+    _next_cycle_memory(0),
+    _number_cycles(0)
+{}
+
+void ScriptCollector::Initialize(lua_State* lua_state)
+{
+    if (SCRIPT_GC_BUDGET < 0.0f || !lua_state) {
+        IF_PRINT_DEBUG(SYSTEM_DEBUG) << "The Lua garbage collection is left automatic." << std::endl;
+        return;
+    }
+
+    _lua_state = lua_state;
+    _budget = static_cast<uint32_t>(SCRIPT_GC_BUDGET * 1000.0f);
+    lua_gc(_lua_state, LUA_GCSTOP, 0);
+
+    // Start from a clean state.
+    FullCollect();
+}
+
+void ScriptCollector::Step(uint32_t time_left)
+{
+    if (!_lua_state || _budget == 0)
+        return;
+
+    if (!_cycle_running) {
+        if (static_cast<uint32_t>(lua_gc(_lua_state, LUA_GCCOUNT, 0)) < _next_cycle_memory)
+            return;
+        _cycle_running = true;
+    }
+
+    TelemetryScope gc_scope(TELEMETRY_LUA_GC_TIME);
+
+    uint32_t budget = time_left < _budget ? time_left : _budget;
+    uint64_t start = FrameTelemetry::GetMicroseconds();
+    do {
+        // Returns 1 when the step ended a cycle.
+        if (lua_gc(_lua_state, LUA_GCSTEP, SCRIPT_GC_STEP_SIZE) == 1) {
+            _EndCycle();
+            break;
+        }
+    } while (FrameTelemetry::GetMicroseconds() - start < budget);
+
+    lua_gc(_lua_state, LUA_GCSTOP, 0);
+}
+
+void ScriptCollector::FullCollect()
+{
+    if (!_lua_state)
+        return;
+
+    TelemetryScope gc_scope(TELEMETRY_LUA_GC_TIME);
+
+    lua_gc(_lua_state, LUA_GCCOLLECT, 0);
+    lua_gc(_lua_state, LUA_GCSTOP, 0);
+    _EndCycle();
+}
+
+void ScriptCollector::_EndCycle()
+{
+    _cycle_running = false;
+    ++_number_cycles;
+
+    uint32_t memory = static_cast<uint32_t>(lua_gc(_lua_state, LUA_GCCOUNT, 0));
+    _next_cycle_memory = memory * SCRIPT_GC_PAUSE / 100;
+}
+
+} // namespace vt_system
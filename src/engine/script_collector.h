@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    script_collector.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the frame budgeted Lua garbage collection.
+***
+*** Lua normally runs a collection step whenever enough memory was allocated,
+*** which can happen in the middle of any script call. Once initialized,
+*** the automatic collection is stopped, and the collector is only run from
+*** the main loop, within a time budget given each frame, and fully during
+*** the game modes transitions.
+*** ***************************************************************************/
+
+#ifndef __SCRIPT_COLLECTOR_HEADER__
+#define __SCRIPT_COLLECTOR_HEADER__
+
+#include <cstdint>
+
+struct lua_State;
+
+namespace vt_system
+{
+
+/** \brief The time given to the Lua garbage collector each frame, in milliseconds. Set from the command line.
+*** A negative value keeps the Lua automatic collection.
+**/
+extern float SCRIPT_GC_BUDGET;
+
+/** ****************************************************************************
+*** \brief Runs the Lua garbage collector from the main loop.
+***
+*** \note Lua 5.1 resets its collection threshold on every step, so the automatic
+*** collection is stopped again after each one.
+*** ***************************************************************************/
+class ScriptCollector
+{
+public:
+    ScriptCollector();
+
+    /** \brief Stops the Lua automatic collection, unless the budget is negative.
+    *** \param lua_state The Lua state to collect, which must outlive the collector use.
+    **/
+    void Initialize(lua_State* lua_state);
+
+    //! \brief Tells whether the collection is driven by the collector.
+    bool IsActive() const {
+        return _lua_state != nullptr;
+    }
+
+    //! \brief Sets the time given to the collector each frame, in microseconds.
+    void SetBudget(uint32_t budget) {
+        _budget = budget;
+    }
+
+    uint32_t GetBudget() const {
+        return _budget;
+    }
+
+    /** \brief Runs incremental collection steps until the budget, or the given time left
+    *** in the frame, is spent. At least one step is done once a cycle is started,
+    *** so that the collection keeps up with the allocations.
+    *** Nothing is done when the budget is 0: the garbage is then only collected
+    *** during the game modes transitions.
+    *** \param time_left The time left before the frame end, in microseconds.
+    **/
+    void Step(uint32_t time_left);
+
+    /** \brief Runs the collection steps of a frame budget while a game mode is loading,
+    *** so that the garbage created by the loading scripts doesn't pile up
+    *** until the full collection ending the transition.
+    **/
+    void LoadStep() {
+        Step(_budget);
+    }
+
+    //! \brief Runs a full collection cycle, e.g. when a new game mode is loaded.
+    void FullCollect();
+
+    //! \brief Returns the number of collection cycles completed since the initialization.
+    uint32_t GetNumberCycles() const {
+        return _number_cycles;
+    }
+
+private:
+    //! \brief The collected Lua state, or nullptr when the collection is left to Lua.
+    lua_State* _lua_state;
+
+    //! \brief The time given to the collector each frame, in microseconds.
+    uint32_t _budget;
+
+    //! \brief Whether a collection cycle is in progress.
+    bool _cycle_running;
+
+    //! \brief The Lua memory usage, in KiB, from which a new cycle is started.
+    uint32_t _next_cycle_memory;
+
+    //! \brief The number of collection cycles completed.
+    uint32_t _number_cycles;
+
+    //! \brief Sets when to start the next cycle, from the current memory usage.
+    void _EndCycle();
+};
+
+} // namespace vt_system
+
+#endif // __SCRIPT_COLLECTOR_HEADER__
@@ -0,0 +1,264 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    script_profiler.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the Lua scripts profiler.
+*** ***************************************************************************/
+
+#include "engine/script_profiler.h"
+
+#include "engine/system.h"
+
+#include "script/script.h"
+
+#include "common/app_settings.h"
+
+#include "utils/utils_files.h"
+#include "utils/utils_strings.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+using namespace vt_utils;
+using namespace vt_common;
+using namespace vt_system::private_system;
+
+namespace vt_system
+{
+
+bool SCRIPT_PROFILER_ENABLE = false;
+
+//! \brief The number of Lua instructions between two count hook events.
+const int32_t SCRIPT_PROFILER_COUNT_INTERVAL = 1000;
+
+ScriptProfiler* ScriptProfiler::_active_profiler = nullptr;
+
+//! \brief Sorts the function profiles by decreasing self time.
+static bool _CompareSelfTime(const ScriptFunctionProfile* a, const ScriptFunctionProfile* b)
+{
+    return a->self_time > b->self_time;
+}
+
+ScriptProfiler::ScriptProfiler():
+    _lua_state(nullptr),
+    _enabled(false)
+{}
+
+ScriptProfiler::~ScriptProfiler()
+{
+    if (_active_profiler == this)
+        _active_profiler = nullptr;
+}
+
+void ScriptProfiler::Initialize(lua_State* lua_state)
+{
+    _lua_state = lua_state;
+    if (SCRIPT_PROFILER_ENABLE)
+        SetEnabled(true);
+}
+
+void ScriptProfiler::SetEnabled(bool enabled)
+{
+    if (!_lua_state || enabled == _enabled)
+        return;
+
+    _enabled = enabled;
+    _call_stack.clear();
+
+    if (_enabled) {
+        _active_profiler = this;
+        lua_sethook(_lua_state, _Hook, LUA_MASKCALL | LUA_MASKRET | LUA_MASKCOUNT,
+                    SCRIPT_PROFILER_COUNT_INTERVAL);
+    }
+    else {
+        lua_sethook(_lua_state, nullptr, 0, 0);
+        _active_profiler = nullptr;
+    }
+    IF_PRINT_DEBUG(SYSTEM_DEBUG) << "Scripts profiling " << (_enabled ? "started" : "stopped") << std::endl;
+}
+
+void ScriptProfiler::Reset()
+{
+    _functions.clear();
+    _function_indices.clear();
+    _call_sites.clear();
+    _call_stack.clear();
+}
+
+std::vector<const ScriptFunctionProfile*> ScriptProfiler::GetTopFunctions(uint32_t count) const
+{
+    std::vector<const ScriptFunctionProfile*> functions;
+    for (uint32_t i = 0; i < _functions.size(); ++i)
+        functions.push_back(&_functions[i]);
+
+    std::sort(functions.begin(), functions.end(), _CompareSelfTime);
+    if (functions.size() > count)
+        functions.resize(count);
+    return functions;
+}
+
+void ScriptProfiler::PrintReport(std::ostream& stream) const
+{
+    stream << "Engine calls into Lua:" << std::endl
+           << std::setw(10) << "calls" << std::setw(12) << "total ms" << "  call site" << std::endl;
+    for (std::map<std::string, ScriptCallSiteProfile>::const_iterator it = _call_sites.begin();
+            it != _call_sites.end(); ++it) {
+        stream << std::setw(10) << it->second.calls
+               << std::setw(12) << it->second.total_time / 1000
+               << "  " << it->first << std::endl;
+    }
+
+    stream << std::endl << "Lua functions, by self time:" << std::endl
+           << std::setw(10) << "calls" << std::setw(12) << "total ms" << std::setw(12) << "self ms"
+           << std::setw(12) << "k instr." << "  function" << std::endl;
+    std::vector<const ScriptFunctionProfile*> functions = GetTopFunctions(static_cast<uint32_t>(_functions.size()));
+    for (uint32_t i = 0; i < functions.size(); ++i) {
+        stream << std::setw(10) << functions[i]->calls
+               << std::setw(12) << functions[i]->total_time / 1000
+               << std::setw(12) << functions[i]->self_time / 1000
+               << std::setw(12) << functions[i]->instructions / 1000
+               << "  " << functions[i]->label << std::endl;
+    }
+}
+
+void ScriptProfiler::DumpToUserDataPath() const
+{
+    // Find a free file name, the same way screenshots are named.
+    static uint32_t i = 1;
+    std::string path;
+    while(true) {
+        path = GetUserDataPath() + "script_profile_" + NumberToString<uint32_t>(i) + ".txt";
+        if(!DoesFileExist(path))
+            break;
+        ++i;
+    }
+
+    std::ofstream file(path.c_str());
+    if (!file.is_open()) {
+        PRINT_WARNING << "Couldn't write the scripts profile: " << path << std::endl;
+        return;
+    }
+    PrintReport(file);
+    std::cout << "Scripts profile written to: " << path << std::endl;
+}
+
+void ScriptProfiler::_Hook(lua_State* lua_state, lua_Debug* debug)
+{
+    // The coroutine threads created while profiling keep the hook once the profiling
+    // is stopped, as only the main state hook is cleared: clear it on their first event.
+    ScriptProfiler* profiler = _active_profiler;
+    if (!profiler) {
+        lua_sethook(lua_state, nullptr, 0, 0);
+        return;
+    }
+
+    switch (debug->event) {
+    case LUA_HOOKCALL: {
+        ScriptCallFrame frame;
+        frame.function = profiler->_GetFunctionIndex(lua_state, debug);
+        frame.children_time = 0;
+        frame.start = FrameTelemetry::GetMicroseconds();
+        profiler->_call_stack.push_back(frame);
+        break;
+    }
+    case LUA_HOOKRET:
+    case LUA_HOOKTAILRET:
+        // The calls made before the profiling started have no frame.
+        if (!profiler->_call_stack.empty())
+            profiler->_PopCall(FrameTelemetry::GetMicroseconds());
+        break;
+    case LUA_HOOKCOUNT:
+        if (!profiler->_call_stack.empty())
+            profiler->_functions[profiler->_call_stack.back().function].instructions += SCRIPT_PROFILER_COUNT_INTERVAL;
+        break;
+    default:
+        break;
+    }
+}
+
+uint32_t ScriptProfiler::_GetFunctionIndex(lua_State* lua_state, lua_Debug* debug)
+{
+    lua_getinfo(lua_state, "Sn", debug);
+
+    // The source and name strings are interned by Lua, so their addresses identify them.
+    ScriptFunctionKey key;
+    key.source = debug->source;
+    key.line = debug->linedefined;
+    key.name = (debug->what[0] == 'C') ? debug->name : nullptr;
+
+    std::map<ScriptFunctionKey, uint32_t>::const_iterator it = _function_indices.find(key);
+    if (it != _function_indices.end())
+        return it->second;
+
+    ScriptFunctionProfile profile;
+    profile.label = debug->short_src;
+    if (debug->what[0] == 'm') {
+        profile.label += " (main chunk)";
+    }
+    else {
+        if (debug->linedefined > 0)
+            profile.label += ":" + NumberToString(debug->linedefined);
+        profile.label += std::string(" ") + (debug->name ? debug->name : "?");
+    }
+
+    uint32_t index = static_cast<uint32_t>(_functions.size());
+    _functions.push_back(profile);
+    _function_indices[key] = index;
+    return index;
+}
+
+void ScriptProfiler::_PopCall(uint64_t end)
+{
+    ScriptCallFrame frame = _call_stack.back();
+    _call_stack.pop_back();
+
+    uint64_t elapsed = end - frame.start;
+    ScriptFunctionProfile& profile = _functions[frame.function];
+    ++profile.calls;
+    profile.total_time += elapsed;
+    profile.self_time += elapsed > frame.children_time ? elapsed - frame.children_time : 0;
+
+    if (!_call_stack.empty())
+        _call_stack.back().children_time += elapsed;
+}
+
+ScriptProfilerScope::ScriptProfilerScope(const char* call_site):
+    _call_site(call_site),
+    _start(0),
+    _stack_size(0)
+{
+    ScriptProfiler* profiler = ScriptProfiler::_active_profiler;
+    if (!profiler)
+        return;
+
+    _stack_size = profiler->_call_stack.size();
+    _start = FrameTelemetry::GetMicroseconds();
+}
+
+ScriptProfilerScope::~ScriptProfilerScope()
+{
+    ScriptProfiler* profiler = ScriptProfiler::_active_profiler;
+    if (_start == 0 || !profiler)
+        return;
+
+    uint64_t end = FrameTelemetry::GetMicroseconds();
+
+    // Close the calls interrupted by a Lua error.
+    while (profiler->_call_stack.size() > _stack_size)
+        profiler->_PopCall(end);
+
+    ScriptCallSiteProfile& call_site = profiler->_call_sites[_call_site];
+    ++call_site.calls;
+    call_site.total_time += end - _start;
+}
+
+} // namespace vt_system
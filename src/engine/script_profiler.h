@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    script_profiler.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the Lua scripts profiler.
+***
+*** When enabled, the profiler sets Lua call, return and count hooks to gather
+*** the calls, the time and the instructions spent in every Lua function.
+*** The engine calls into Lua are also timed per call site, using
+*** ScriptProfilerScope objects.
+***
+*** The profiler is toggled with Ctrl+P (debug builds), or enabled from the start
+*** with the --profile-scripts option. Its report is written in the user data folder.
+*** ***************************************************************************/
+
+#ifndef __SCRIPT_PROFILER_HEADER__
+#define __SCRIPT_PROFILER_HEADER__
+
+#include <string>
+#include <vector>
+#include <map>
+#include <ostream>
+#include <cstdint>
+
+struct lua_State;
+struct lua_Debug;
+
+namespace vt_system
+{
+
+//! \brief Whether the scripts profiler starts with the game. Set from the command line.
+extern bool SCRIPT_PROFILER_ENABLE;
+
+//! \brief The profiling data of a Lua function.
+struct ScriptFunctionProfile {
+    ScriptFunctionProfile():
+        calls(0),
+        total_time(0),
+        self_time(0),
+        instructions(0)
+    {}
+
+    //! \brief The function source file, line and name. E.g: "data/x.lua:12 Update"
+    std::string label;
+
+    uint32_t calls;
+
+    //! \brief The time spent in the function, with and without the functions it called, in microseconds.
+    uint64_t total_time;
+    uint64_t self_time;
+
+    //! \brief The (approximate) number of Lua instructions run in the function itself.
+    uint64_t instructions;
+};
+
+//! \brief The profiling data of an engine call site into Lua.
+struct ScriptCallSiteProfile {
+    ScriptCallSiteProfile():
+        calls(0),
+        total_time(0)
+    {}
+
+    uint32_t calls;
+
+    //! \brief The time spent in the call, in microseconds.
+    uint64_t total_time;
+};
+
+namespace private_system
+{
+
+//! \brief Identifies a Lua function from its debug information.
+struct ScriptFunctionKey {
+    //! \brief The source string, interned by Lua.
+    const void* source;
+
+    //! \brief The line the function is defined at.
+    int32_t line;
+
+    //! \brief The function name string, only used for C functions.
+    const void* name;
+
+    bool operator<(const ScriptFunctionKey& other) const {
+        if (source != other.source)
+            return source < other.source;
+        if (line != other.line)
+            return line < other.line;
+        return name < other.name;
+    }
+};
+
+//! \brief A function call in progress.
+struct ScriptCallFrame {
+    //! \brief The function index in the profiles.
+    uint32_t function;
+
+    //! \brief The call start, in microseconds.
+    uint64_t start;
+
+    //! \brief The time spent in the called functions, in microseconds.
+    uint64_t children_time;
+};
+
+} // namespace private_system
+
+/** ****************************************************************************
+*** \brief Gathers where the time is spent in the Lua scripts.
+***
+*** \note Errors thrown from Lua skip the return hooks: the calls left on the
+*** stack are closed when the engine call site scope ends.
+*** \note Lua threads copy the hook of the global state when created, so the
+*** scripts opened before the profiling started are only timed per call site.
+*** ***************************************************************************/
+class ScriptProfiler
+{
+    friend class ScriptProfilerScope;
+
+public:
+    ScriptProfiler();
+
+    ~ScriptProfiler();
+
+    //! \brief Sets the profiled Lua state, and starts profiling if SCRIPT_PROFILER_ENABLE is set.
+    void Initialize(lua_State* lua_state);
+
+    //! \brief Starts or stops profiling. The data is kept until Reset() is called.
+    void SetEnabled(bool enabled);
+
+    bool IsEnabled() const {
+        return _enabled;
+    }
+
+    //! \brief Clears the gathered data.
+    void Reset();
+
+    //! \brief Returns the profiled functions, the ones with the most self time first.
+    std::vector<const ScriptFunctionProfile*> GetTopFunctions(uint32_t count) const;
+
+    //! \brief Prints the call sites and functions reports.
+    void PrintReport(std::ostream& stream) const;
+
+    //! \brief Writes the report in a new script_profile_<n>.txt file in the user data folder.
+    void DumpToUserDataPath() const;
+
+private:
+    //! \brief The profiled Lua state.
+    lua_State* _lua_state;
+
+    bool _enabled;
+
+    //! \brief The functions profiles, and their index by function.
+    std::vector<ScriptFunctionProfile> _functions;
+    std::map<private_system::ScriptFunctionKey, uint32_t> _function_indices;
+
+    //! \brief The engine call sites profiles, by call site name.
+    std::map<std::string, ScriptCallSiteProfile> _call_sites;
+
+    //! \brief The Lua calls in progress.
+    std::vector<private_system::ScriptCallFrame> _call_stack;
+
+    //! \brief The enabled profiler, used by the Lua hook.
+    static ScriptProfiler* _active_profiler;
+
+    //! \brief The Lua hook, handling the call, return and count events.
+    static void _Hook(lua_State* lua_state, lua_Debug* debug);
+
+    //! \brief Returns the profile index of the function being called.
+    uint32_t _GetFunctionIndex(lua_State* lua_state, lua_Debug* debug);
+
+    //! \brief Closes the call on top of the stack.
+    void _PopCall(uint64_t end);
+
+    ScriptProfiler(const ScriptProfiler&) = delete;
+    ScriptProfiler& operator=(const ScriptProfiler&) = delete;
+};
+
+/** ****************************************************************************
+*** \brief Times an engine call into Lua, when the profiler is enabled.
+***
+*** Example: { ScriptProfilerScope scope("map_update"); call_function<void>(f); }
+*** \note The call site name must be a string literal.
+*** ***************************************************************************/
+class ScriptProfilerScope
+{
+public:
+    explicit ScriptProfilerScope(const char* call_site);
+
+    ~ScriptProfilerScope();
+
+private:
+    const char* _call_site;
+
+    //! \brief The call start, 0 when not profiling.
+    uint64_t _start;
+
+    //! \brief The Lua call stack size at the call start.
+    size_t _stack_size;
+
+    ScriptProfilerScope(const ScriptProfilerScope&) = delete;
+    ScriptProfilerScope& operator=(const ScriptProfilerScope&) = delete;
+};
+
+} // namespace vt_system
+
+#endif // __SCRIPT_PROFILER_HEADER__
@@ -16,9 +16,11 @@
 #include "engine/script_supervisor.h"
 
 #include "engine/mode_manager.h"
+#include "engine/system.h"
 
 using namespace vt_video;
 using namespace vt_script;
+using namespace vt_system;
 
 ScriptSupervisor::~ScriptSupervisor()
 {
@@ -80,8 +82,10 @@ void ScriptSupervisor::Initialize(vt_mode_manager::GameMode *gm)
 
         // Trigger the Initialize functions in the loading order.
         luabind::object init_function = scene_script->ReadFunctionPointer("Initialize");
-        if(init_function.is_valid() && gm)
+        if(init_function.is_valid() && gm) {
+            ScriptProfilerScope profiler_scope("scene_initialize");
             luabind::call_function<void>(init_function, gm);
+        }
         else
             PRINT_ERROR << "Couldn't initialize the scene component" << std::endl; // Should never happen
     }
@@ -94,6 +98,8 @@ void ScriptSupervisor::SetDrawFlag(vt_video::VIDEO_DRAW_FLAGS draw_flag)
 
 void ScriptSupervisor::Reset()
 {
+    ScriptProfilerScope profiler_scope("scene_reset");
+
     // Updates custom scripts
     for(uint32_t i = 0; i < _reset_functions.size(); ++i)
         ReadScriptDescriptor::RunScriptObject(_reset_functions[i]);
@@ -101,6 +107,8 @@ void ScriptSupervisor::Reset()
 
 void ScriptSupervisor::Restart()
 {
+    ScriptProfilerScope profiler_scope("scene_restart");
+
     // Updates custom scripts
     for(uint32_t i = 0; i < _restart_functions.size(); ++i)
         ReadScriptDescriptor::RunScriptObject(_restart_functions[i]);
@@ -108,6 +116,9 @@ void ScriptSupervisor::Restart()
 
 void ScriptSupervisor::Update()
 {
+    TelemetryScope lua_scope(TELEMETRY_LUA_TIME);
+    ScriptProfilerScope profiler_scope("scene_update");
+
     // Updates custom scripts
     for(uint32_t i = 0; i < _update_functions.size(); ++i)
         ReadScriptDescriptor::RunScriptObject(_update_functions[i]);
@@ -115,6 +126,9 @@ void ScriptSupervisor::Update()
 
 void ScriptSupervisor::DrawBackground()
 {
+    TelemetryScope lua_scope(TELEMETRY_LUA_TIME);
+    ScriptProfilerScope profiler_scope("scene_draw_background");
+
     // Handles custom scripted draw before sprites
     for(uint32_t i = 0; i < _draw_background_functions.size(); ++i)
         ReadScriptDescriptor::RunScriptObject(_draw_background_functions[i]);
@@ -122,12 +136,18 @@ void ScriptSupervisor::DrawBackground()
 
 void ScriptSupervisor::DrawForeground()
 {
+    TelemetryScope lua_scope(TELEMETRY_LUA_TIME);
+    ScriptProfilerScope profiler_scope("scene_draw_foreground");
+
     for(uint32_t i = 0; i < _draw_foreground_functions.size(); ++i)
         ReadScriptDescriptor::RunScriptObject(_draw_foreground_functions[i]);
 }
 
 void ScriptSupervisor::DrawPostEffects()
 {
+    TelemetryScope lua_scope(TELEMETRY_LUA_TIME);
+    ScriptProfilerScope profiler_scope("scene_draw_post_effects");
+
     for(uint32_t i = 0; i < _draw_post_effects_functions.size(); ++i)
         ReadScriptDescriptor::RunScriptObject(_draw_post_effects_functions[i]);
 }
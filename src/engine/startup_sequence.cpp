@@ -0,0 +1,303 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    startup_sequence.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the dependency aware startup sequence.
+*** ***************************************************************************/
+
+#include "engine/startup_sequence.h"
+
+#include "engine/system.h"
+
+#include "utils/utils_files.h"
+
+#include <SDL2/SDL_timer.h>
+
+#include <fstream>
+
+using namespace vt_utils;
+
+namespace vt_system
+{
+
+namespace private_system
+{
+
+StartupPhase::StartupPhase(const std::string& phase_name,
+                           const std::function<bool()>& phase_function,
+                           const std::vector<std::string>& phase_dependencies,
+                           STARTUP_PHASE_TYPE phase_type):
+    name(phase_name),
+    function(phase_function),
+    dependencies(phase_dependencies),
+    type(phase_type),
+    thread(nullptr),
+    started(false),
+    result(false),
+    duration(0)
+{
+    SDL_AtomicSet(&done, 0);
+}
+
+} // namespace private_system
+
+using namespace private_system;
+
+//! \brief Returns a printable phase type, for the logs.
+static const char* _GetPhaseTypeName(STARTUP_PHASE_TYPE type)
+{
+    switch(type) {
+    case STARTUP_PHASE_MAIN:
+        return "main";
+    case STARTUP_PHASE_DEFERRED:
+        return "deferred";
+    case STARTUP_PHASE_WORKER:
+        return "worker";
+    default:
+        break;
+    }
+    return "invalid";
+}
+
+StartupSequence::StartupSequence():
+    _start_time(0),
+    _done(true)
+{}
+
+StartupSequence::~StartupSequence()
+{
+    // The worker threads must not outlive their phases.
+    for (uint32_t i = 0; i < _phases.size(); ++i) {
+        if (_phases[i]->thread)
+            SDL_WaitThread(_phases[i]->thread, nullptr);
+        delete _phases[i];
+    }
+    _phases.clear();
+}
+
+bool StartupSequence::AddPhase(const std::string& name,
+                               const std::function<bool()>& function,
+                               const std::vector<std::string>& dependencies,
+                               STARTUP_PHASE_TYPE type)
+{
+    if (type <= STARTUP_PHASE_INVALID || type >= STARTUP_PHASE_TOTAL) {
+        PRINT_WARNING << "Invalid startup phase type for phase: " << name << std::endl;
+        return false;
+    }
+
+    if (_GetPhase(name)) {
+        PRINT_WARNING << "The startup phase already exists: " << name << std::endl;
+        return false;
+    }
+
+    for (uint32_t i = 0; i < dependencies.size(); ++i) {
+        StartupPhase* dependency = _GetPhase(dependencies[i]);
+        if (!dependency) {
+            PRINT_WARNING << "Unknown dependency '" << dependencies[i]
+                          << "' for the startup phase: " << name << std::endl;
+            return false;
+        }
+
+        // A worker thread can't wait for the main thread.
+        if (type == STARTUP_PHASE_WORKER && dependency->type != STARTUP_PHASE_WORKER) {
+            PRINT_WARNING << "The worker startup phase '" << name
+                          << "' can't depend on the main thread phase: " << dependencies[i] << std::endl;
+            return false;
+        }
+
+        // The main phases are all done before the first deferred one.
+        if (type == STARTUP_PHASE_MAIN && dependency->type == STARTUP_PHASE_DEFERRED) {
+            PRINT_WARNING << "The main startup phase '" << name
+                          << "' can't depend on the deferred phase: " << dependencies[i] << std::endl;
+            return false;
+        }
+    }
+
+    _phases.push_back(new StartupPhase(name, function, dependencies, type));
+    _done = false;
+    return true;
+}
+
+bool StartupSequence::Run()
+{
+    _start_time = FrameTelemetry::GetMicroseconds();
+
+    _StartReadyWorkers();
+
+    for (uint32_t i = 0; i < _phases.size(); ++i) {
+        StartupPhase* phase = _phases[i];
+        if (phase->type != STARTUP_PHASE_MAIN)
+            continue;
+
+        // Wait for the worker dependencies, the main ones being run in order.
+        for (uint32_t j = 0; j < phase->dependencies.size(); ++j)
+            _WaitFor(_GetPhase(phase->dependencies[j]));
+
+        phase->started = true;
+        _RunPhase(phase);
+        if (!phase->result) {
+            PRINT_ERROR << "The startup phase failed: " << phase->name << std::endl;
+            return false;
+        }
+
+        _StartReadyWorkers();
+    }
+
+    IF_PRINT_DEBUG(SYSTEM_DEBUG) << "Main startup phases done in "
+        << (FrameTelemetry::GetMicroseconds() - _start_time) / 1000 << " ms" << std::endl;
+
+    // Finish at once when there is nothing deferred.
+    UpdateDeferred();
+    return true;
+}
+
+bool StartupSequence::UpdateDeferred()
+{
+    if (_done)
+        return true;
+
+    _StartReadyWorkers();
+
+    for (uint32_t i = 0; i < _phases.size(); ++i) {
+        StartupPhase* phase = _phases[i];
+        if (phase->type != STARTUP_PHASE_DEFERRED || phase->started)
+            continue;
+
+        // Try again on the next frame when the workers aren't done yet.
+        if (!_AreDependenciesDone(phase))
+            return true;
+
+        // Only one deferred phase per frame.
+        phase->started = true;
+        _RunPhase(phase);
+        if (!phase->result) {
+            PRINT_ERROR << "The deferred startup phase failed: " << phase->name << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // Don't block the main loop on the workers still running.
+    for (uint32_t i = 0; i < _phases.size(); ++i) {
+        if (SDL_AtomicGet(&_phases[i]->done) == 0)
+            return true;
+    }
+
+    _Finish();
+    return true;
+}
+
+uint64_t StartupSequence::GetPhaseDuration(const std::string& name) const
+{
+    StartupPhase* phase = _GetPhase(name);
+    if (!phase || SDL_AtomicGet(&phase->done) == 0)
+        return 0;
+    return phase->duration;
+}
+
+bool StartupSequence::PrefetchDirectory(const std::string& directory, const std::string& extension)
+{
+    std::vector<std::string> files = ListDirectory(directory, extension);
+
+    // Reading the files is enough to have them in the system cache.
+    char buffer[16384];
+    for (uint32_t i = 0; i < files.size(); ++i) {
+        std::ifstream file((directory + "/" + files[i]).c_str(), std::ifstream::binary);
+        while (file.read(buffer, sizeof(buffer)))
+            continue;
+    }
+    return true;
+}
+
+StartupPhase* StartupSequence::_GetPhase(const std::string& name) const
+{
+    for (uint32_t i = 0; i < _phases.size(); ++i) {
+        if (_phases[i]->name == name)
+            return _phases[i];
+    }
+    return nullptr;
+}
+
+bool StartupSequence::_AreDependenciesDone(const StartupPhase* phase) const
+{
+    for (uint32_t i = 0; i < phase->dependencies.size(); ++i) {
+        if (SDL_AtomicGet(&_GetPhase(phase->dependencies[i])->done) == 0)
+            return false;
+    }
+    return true;
+}
+
+void StartupSequence::_StartReadyWorkers()
+{
+    for (uint32_t i = 0; i < _phases.size(); ++i) {
+        StartupPhase* phase = _phases[i];
+        if (phase->type != STARTUP_PHASE_WORKER || phase->started)
+            continue;
+
+        if (!_AreDependenciesDone(phase))
+            continue;
+
+        phase->started = true;
+        phase->thread = SDL_CreateThread(_RunWorkerPhase, phase->name.c_str(), phase);
+        if (!phase->thread) {
+            // Run it on the main thread rather than not at all.
+            IF_PRINT_WARNING(SYSTEM_DEBUG) << "Couldn't create the worker thread of the startup phase '"
+                << phase->name << "': " << SDL_GetError() << std::endl;
+            _RunPhase(phase);
+        }
+    }
+}
+
+void StartupSequence::_WaitFor(StartupPhase* phase)
+{
+    // The worker dependencies must be started to be waited for.
+    while (!phase->started) {
+        SDL_Delay(1);
+        _StartReadyWorkers();
+    }
+
+    if (phase->thread) {
+        SDL_WaitThread(phase->thread, nullptr);
+        phase->thread = nullptr;
+    }
+}
+
+void StartupSequence::_RunPhase(StartupPhase* phase)
+{
+    uint64_t start = FrameTelemetry::GetMicroseconds();
+    phase->result = phase->function();
+    phase->duration = FrameTelemetry::GetMicroseconds() - start;
+
+    IF_PRINT_DEBUG(SYSTEM_DEBUG) << "Startup phase '" << phase->name << "' ("
+        << _GetPhaseTypeName(phase->type) << ") done in "
+        << phase->duration / 1000 << " ms" << std::endl;
+
+    SDL_AtomicSet(&phase->done, 1);
+}
+
+int StartupSequence::_RunWorkerPhase(void* data)
+{
+    _RunPhase(static_cast<StartupPhase*>(data));
+    return 0;
+}
+
+void StartupSequence::_Finish()
+{
+    for (uint32_t i = 0; i < _phases.size(); ++i)
+        _WaitFor(_phases[i]);
+
+    _done = true;
+
+    IF_PRINT_DEBUG(SYSTEM_DEBUG) << "Startup done in "
+        << (FrameTelemetry::GetMicroseconds() - _start_time) / 1000 << " ms" << std::endl;
+}
+
+} // namespace vt_system
@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    startup_sequence.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the dependency aware startup sequence.
+***
+*** The game startup is split into named phases with dependencies.
+*** The phases touching OpenGL or the Lua state run on the main thread,
+*** in dependency order, while the phases safe to run concurrently
+*** (e.g. data files prefetching) run on worker threads.
+*** Phases can also be deferred: they are then run one per frame once the
+*** main loop is started, so that the boot mode is shown while they finish.
+*** ***************************************************************************/
+
+#ifndef __STARTUP_SEQUENCE_HEADER__
+#define __STARTUP_SEQUENCE_HEADER__
+
+#include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_atomic.h>
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+namespace vt_system
+{
+
+//! \brief Where and when a startup phase is run.
+enum STARTUP_PHASE_TYPE {
+    STARTUP_PHASE_INVALID  = -1,
+    //! Run on the main thread, before the main loop starts.
+    STARTUP_PHASE_MAIN     = 0,
+    //! Run on the main thread, one per frame, once the main loop is started.
+    STARTUP_PHASE_DEFERRED = 1,
+    //! Run on a worker thread. It mustn't use OpenGL, OpenAL or the Lua state.
+    STARTUP_PHASE_WORKER   = 2,
+    STARTUP_PHASE_TOTAL    = 3
+};
+
+namespace private_system
+{
+
+//! \brief A single startup phase, and its run state.
+class StartupPhase
+{
+public:
+    StartupPhase(const std::string& phase_name,
+                 const std::function<bool()>& phase_function,
+                 const std::vector<std::string>& phase_dependencies,
+                 STARTUP_PHASE_TYPE phase_type);
+
+    std::string name;
+
+    //! \brief The function doing the phase work. Returns false on failure.
+    std::function<bool()> function;
+
+    //! \brief The names of the phases that must be done before this one starts.
+    std::vector<std::string> dependencies;
+
+    STARTUP_PHASE_TYPE type;
+
+    //! \brief The worker thread, if any.
+    SDL_Thread* thread;
+
+    //! \brief Whether the phase was started. Only used by the main thread.
+    bool started;
+
+    //! \brief Set to 1 once the phase is done. Atomic since set from the worker threads.
+    SDL_atomic_t done;
+
+    //! \brief The phase function result.
+    bool result;
+
+    //! \brief The time spent in the phase, in microseconds.
+    uint64_t duration;
+};
+
+} // namespace private_system
+
+/** ****************************************************************************
+*** \brief Runs the startup phases according to their dependencies and type.
+***
+*** Phases are added with AddPhase(), and their dependencies must have been
+*** added before them. Run() then starts the worker phases and runs the main
+*** thread ones, while UpdateDeferred() is called once per frame by the main
+*** loop to run the deferred phases.
+***
+*** Every phase is timed, and the timings are logged with the system debug output.
+*** ***************************************************************************/
+class StartupSequence
+{
+public:
+    StartupSequence();
+
+    //! \brief Waits for the potential worker threads.
+    ~StartupSequence();
+
+    /** \brief Adds a new startup phase.
+    *** \param name The phase name, used for the dependencies and the logs.
+    *** \param function The function doing the phase work. It returns false on failure.
+    *** \param dependencies The names of the phases to be done before this one.
+    *** \param type Where and when the phase is run.
+    *** \return false if a dependency is unknown or can't be waited for, in which case the phase isn't added.
+    *** \note Worker phases can only depend on other worker phases.
+    **/
+    bool AddPhase(const std::string& name,
+                  const std::function<bool()>& function,
+                  const std::vector<std::string>& dependencies = std::vector<std::string>(),
+                  STARTUP_PHASE_TYPE type = STARTUP_PHASE_MAIN);
+
+    /** \brief Starts the worker phases and runs the main phases, in order.
+    *** \return false if a main phase failed.
+    *** \note The deferred and worker phases may still be running after this call.
+    **/
+    bool Run();
+
+    /** \brief Runs the next deferred phase whose dependencies are done.
+    *** Must be called once per frame from the main loop until IsDone() returns true.
+    *** \return false if the deferred phase failed.
+    **/
+    bool UpdateDeferred();
+
+    //! \brief Tells whether every phase is done.
+    bool IsDone() const {
+        return _done;
+    }
+
+    //! \brief Returns the time spent in a phase in microseconds, or 0 if unknown or not done.
+    uint64_t GetPhaseDuration(const std::string& name) const;
+
+    /** \brief Reads the matching files of a directory, to have them in the system file cache
+    *** when loaded later. This is meant to be used by worker phases.
+    *** \param directory The directory to prefetch, without the trailing slash.
+    *** \param extension The files extension to prefetch, e.g.: ".lua"
+    *** \return always true, as prefetching is only a hint.
+    **/
+    static bool PrefetchDirectory(const std::string& directory, const std::string& extension);
+
+private:
+    //! \brief The phases, in the order they were added.
+    std::vector<private_system::StartupPhase*> _phases;
+
+    //! \brief The startup timestamp in microseconds, used for the total time log.
+    uint64_t _start_time;
+
+    //! \brief Whether every phase is done.
+    bool _done;
+
+    //! \brief Returns the phase of the given name, or nullptr.
+    private_system::StartupPhase* _GetPhase(const std::string& name) const;
+
+    //! \brief Tells whether the dependencies of a phase are done.
+    bool _AreDependenciesDone(const private_system::StartupPhase* phase) const;
+
+    //! \brief Starts the worker phases whose dependencies are done.
+    void _StartReadyWorkers();
+
+    //! \brief Starts the ready worker phases until the given phase is done.
+    void _WaitFor(private_system::StartupPhase* phase);
+
+    /** \brief Runs a phase on the calling thread, and times it.
+    *** \note The phase must have been flagged as started by the main thread beforehand.
+    **/
+    static void _RunPhase(private_system::StartupPhase* phase);
+
+    //! \brief The worker threads entry point.
+    static int _RunWorkerPhase(void* data);
+
+    //! \brief Waits for all the worker threads and logs the total startup time.
+    void _Finish();
+};
+
+} // namespace vt_system
+
+#endif // __STARTUP_SEQUENCE_HEADER__
@@ -527,6 +527,13 @@ void SystemEngine::SetGameDifficulty(uint32_t game_difficulty)
 bool SystemEngine::SingletonInitialize()
 {
     LoadLanguages();
+
+    // Start the telemetry recording if requested on the command line.
+    if(TELEMETRY_ENABLE) {
+        _telemetry.SetEnabled(true);
+        if(TELEMETRY_STREAM_INTERVAL > 0)
+            _telemetry.StartStreaming(GetUserDataPath() + "telemetry.csv", TELEMETRY_STREAM_INTERVAL);
+    }
     return true;
 }
 
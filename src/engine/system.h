@@ -25,6 +25,12 @@
 #ifndef __SYSTEM_HEADER__
 #define __SYSTEM_HEADER__
 
+#include "engine/telemetry.h"
+#include "engine/memory_accounting.h"
+#include "engine/startup_sequence.h"
+#include "engine/script_collector.h"
+#include "engine/script_profiler.h"
+
 #include "utils/ustring.h"
 #include "utils/singleton.h"
 
@@ -606,6 +612,36 @@ public:
         return _game_save_slots;
     }
 
+    //! \brief Returns the per-frame telemetry recorder.
+    FrameTelemetry& GetTelemetry() {
+        return _telemetry;
+    }
+
+    //! \brief Returns the per subsystem memory accounting.
+    MemoryAccounting& GetMemoryAccounting() {
+        return _memory_accounting;
+    }
+
+    //! \brief Returns the game startup phases sequence.
+    StartupSequence& GetStartupSequence() {
+        return _startup_sequence;
+    }
+
+    //! \brief Returns the frame budgeted Lua garbage collector.
+    ScriptCollector& GetScriptCollector() {
+        return _script_collector;
+    }
+
+    //! \brief Returns the Lua scripts profiler.
+    ScriptProfiler& GetScriptProfiler() {
+        return _script_profiler;
+    }
+
+    //! \brief Tells whether every startup phase, including the deferred ones, is done.
+    bool IsStartupDone() const {
+        return _startup_sequence.IsDone();
+    }
+
     //! \brief Gets the save slot number to handle.
     void SetGameSaveSlots(uint32_t game_save_slots) {
         _game_save_slots = game_save_slots;
@@ -664,6 +700,21 @@ private:
     *** The timers in this container are updated on each call to UpdateTimers().
     **/
     std::set<SystemTimer *> _auto_system_timers;
+
+    //! \brief Records the timing and counter samples of the last frames.
+    FrameTelemetry _telemetry;
+
+    //! \brief Gathers the memory used by the engine subsystems, for debugging purpose.
+    MemoryAccounting _memory_accounting;
+
+    //! \brief The startup phases, some of them finishing while the boot mode is shown.
+    StartupSequence _startup_sequence;
+
+    //! \brief Runs the Lua garbage collection from the main loop.
+    ScriptCollector _script_collector;
+
+    //! \brief Gathers the time spent in the Lua scripts, for debugging purpose.
+    ScriptProfiler _script_profiler;
 }; // class SystemEngine : public vt_utils::Singleton<SystemEngine>
 
 } // namepsace vt_system
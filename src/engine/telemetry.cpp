@@ -0,0 +1,387 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    telemetry.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the per-frame telemetry recorder.
+*** ***************************************************************************/
+
+#include "engine/telemetry.h"
+
+#include "engine/system.h"
+
+#include "common/app_settings.h"
+
+#include "utils/utils_strings.h"
+#include "utils/utils_files.h"
+
+#include <SDL2/SDL.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace vt_utils;
+
+#ifdef DEBUG_FEATURES
+// Counts the heap allocations made by the game so that they can be graphed.
+// This is only done with the debug features, as replacing the global
+// allocation functions isn't free.
+static std::atomic<uint32_t> _telemetry_allocation_count(0);
+
+void* operator new(std::size_t size)
+{
+    ++_telemetry_allocation_count;
+    void* ptr = std::malloc(size > 0 ? size : 1);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+    ++_telemetry_allocation_count;
+    void* ptr = std::malloc(size > 0 ? size : 1);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+#endif
+
+namespace vt_system
+{
+
+bool TELEMETRY_ENABLE = false;
+uint32_t TELEMETRY_STREAM_INTERVAL = 0;
+
+//! \brief The default number of frames kept in memory: One minute at 60 FPS.
+const uint32_t TELEMETRY_DEFAULT_CAPACITY = 3600;
+
+FrameTelemetry::FrameTelemetry():
+    _enabled(false),
+    _next_sample(0),
+    _number_samples(0),
+    _frame_count(0),
+    _last_allocation_count(0),
+    _current_context_id(0),
+    _stream_interval(0),
+    _stream_pending(0)
+{
+    // The context 0 is the 'no context' one.
+    _contexts.push_back(std::string());
+    _samples.resize(TELEMETRY_DEFAULT_CAPACITY);
+}
+
+FrameTelemetry::~FrameTelemetry()
+{
+    StopStreaming();
+}
+
+void FrameTelemetry::SetEnabled(bool enabled)
+{
+    _enabled = enabled;
+    _next_sample = 0;
+    _number_samples = 0;
+    _frame_count = 0;
+    _current = TelemetrySample();
+    _last_allocation_count = GetAllocationCount();
+}
+
+void FrameTelemetry::SetCapacity(uint32_t capacity)
+{
+    if (capacity == 0) {
+        PRINT_WARNING << "Invalid telemetry capacity: 0. Keeping the current one." << std::endl;
+        return;
+    }
+
+    _samples.clear();
+    _samples.resize(capacity);
+    _next_sample = 0;
+    _number_samples = 0;
+
+    if (_stream_interval > capacity)
+        _stream_interval = capacity;
+}
+
+bool FrameTelemetry::StartStreaming(const std::string& filename, uint32_t frames_interval)
+{
+    StopStreaming();
+
+    if (frames_interval == 0) {
+        PRINT_WARNING << "Invalid telemetry stream interval: 0. Streaming disabled." << std::endl;
+        return false;
+    }
+
+    _stream_file.open(filename.c_str(), std::ofstream::out | std::ofstream::trunc);
+    if (!_stream_file.is_open()) {
+        PRINT_ERROR << "Couldn't open the telemetry stream file: " << filename << std::endl;
+        return false;
+    }
+
+    _stream_interval = frames_interval;
+    if (_stream_interval > _samples.size())
+        _stream_interval = _samples.size();
+    _stream_pending = 0;
+
+    _WriteCSVHeader(_stream_file);
+    _stream_file.flush();
+    return true;
+}
+
+void FrameTelemetry::StopStreaming()
+{
+    if (!_stream_file.is_open())
+        return;
+
+    _FlushStream();
+    _stream_file.close();
+    _stream_interval = 0;
+}
+
+void FrameTelemetry::SetContext(const std::string& context)
+{
+    for (uint32_t i = 0; i < _contexts.size(); ++i) {
+        if (_contexts[i] == context) {
+            _current_context_id = static_cast<uint16_t>(i);
+            return;
+        }
+    }
+
+    // Keep the id within the sample type range.
+    if (_contexts.size() >= 0xFFFF) {
+        _current_context_id = 0;
+        return;
+    }
+
+    _current_context_id = static_cast<uint16_t>(_contexts.size());
+    _contexts.push_back(context);
+}
+
+void FrameTelemetry::EndFrame(uint32_t frame_time, uint8_t mode_type)
+{
+    if (!_enabled)
+        return;
+
+    uint32_t allocation_count = GetAllocationCount();
+    _current.values[TELEMETRY_ALLOCATIONS] = allocation_count - _last_allocation_count;
+    _last_allocation_count = allocation_count;
+
+    _current.frame = _frame_count++;
+    _current.ticks = SDL_GetTicks();
+    _current.frame_time = frame_time;
+    _current.mode_type = mode_type;
+    _current.context_id = _current_context_id;
+
+    _samples[_next_sample] = _current;
+    _next_sample = (_next_sample + 1) % _samples.size();
+    if (_number_samples < _samples.size())
+        ++_number_samples;
+
+    _current = TelemetrySample();
+
+    if (_stream_interval > 0) {
+        ++_stream_pending;
+        if (_stream_pending >= _stream_interval)
+            _FlushStream();
+    }
+}
+
+const TelemetrySample& FrameTelemetry::GetSample(uint32_t index) const
+{
+    // The oldest sample is right after the last written one once the buffer is full.
+    uint32_t first = (_number_samples < _samples.size()) ? 0 : _next_sample;
+    return _samples[(first + index) % _samples.size()];
+}
+
+bool FrameTelemetry::DumpCSV(const std::string& filename) const
+{
+    std::ofstream file(filename.c_str(), std::ofstream::out | std::ofstream::trunc);
+    if (!file.is_open()) {
+        PRINT_ERROR << "Couldn't open the telemetry file: " << filename << std::endl;
+        return false;
+    }
+
+    _WriteCSVHeader(file);
+    for (uint32_t i = 0; i < _number_samples; ++i)
+        _WriteCSVLine(file, GetSample(i));
+
+    file.close();
+    return true;
+}
+
+bool FrameTelemetry::DumpJSON(const std::string& filename) const
+{
+    std::ofstream file(filename.c_str(), std::ofstream::out | std::ofstream::trunc);
+    if (!file.is_open()) {
+        PRINT_ERROR << "Couldn't open the telemetry file: " << filename << std::endl;
+        return false;
+    }
+
+    file << "{" << std::endl << "  \"contexts\": [";
+    for (uint32_t i = 0; i < _contexts.size(); ++i) {
+        file << (i > 0 ? ", " : "") << "\"";
+        // Escape the characters JSON doesn't allow in strings.
+        for (uint32_t j = 0; j < _contexts[i].size(); ++j) {
+            char c = _contexts[i][j];
+            if (c == '"' || c == '\\')
+                file << '\\';
+            file << c;
+        }
+        file << "\"";
+    }
+    file << "]," << std::endl << "  \"samples\": [" << std::endl;
+
+    for (uint32_t i = 0; i < _number_samples; ++i) {
+        const TelemetrySample& sample = GetSample(i);
+        file << "    {\"frame\": " << sample.frame
+             << ", \"ticks\": " << sample.ticks
+             << ", \"frame_time\": " << sample.frame_time
+             << ", \"mode\": " << static_cast<uint32_t>(sample.mode_type)
+             << ", \"context\": " << sample.context_id;
+        for (uint32_t j = 0; j < TELEMETRY_TOTAL; ++j) {
+            file << ", \"" << GetCounterName(static_cast<TELEMETRY_COUNTER>(j))
+                 << "\": " << sample.values[j];
+        }
+        file << "}" << (i + 1 < _number_samples ? "," : "") << std::endl;
+    }
+
+    file << "  ]" << std::endl << "}" << std::endl;
+    file.close();
+    return true;
+}
+
+void FrameTelemetry::DumpToUserDataPath() const
+{
+    // Find a free file name, the same way screenshots are named.
+    static uint32_t i = 1;
+    std::string path;
+    while(true) {
+        path = GetUserDataPath() + "telemetry_" + NumberToString<uint32_t>(i);
+        if(!DoesFileExist(path + ".csv") && !DoesFileExist(path + ".json"))
+            break;
+        ++i;
+    }
+
+    if (DumpCSV(path + ".csv") && DumpJSON(path + ".json"))
+        PRINT_DEBUG << "Telemetry samples written to: " << path << ".csv/.json" << std::endl;
+}
+
+const char* FrameTelemetry::GetCounterName(TELEMETRY_COUNTER counter)
+{
+    switch(counter) {
+    case TELEMETRY_UPDATE_TIME:
+        return "update_us";
+    case TELEMETRY_DRAW_TIME:
+        return "draw_us";
+    case TELEMETRY_LUA_TIME:
+        return "lua_us";
+    case TELEMETRY_AUDIO_TIME:
+        return "audio_us";
+    case TELEMETRY_TEXTURE_UPLOADS:
+        return "texture_uploads";
+    case TELEMETRY_ALLOCATIONS:
+        return "allocations";
+    case TELEMETRY_PARTICLES:
+        return "particles";
+    case TELEMETRY_MAP_OBJECTS:
+        return "map_objects";
+    case TELEMETRY_LUA_GC_TIME:
+        return "lua_gc_us";
+    case TELEMETRY_MAP_SORT_TIME:
+        return "map_sort_us";
+    case TELEMETRY_MAP_SORTED_OBJECTS:
+        return "map_sorted_objects";
+    case TELEMETRY_SWAP_TIME:
+        return "swap_us";
+    default:
+        break;
+    }
+    return "invalid";
+}
+
+uint64_t FrameTelemetry::GetMicroseconds()
+{
+    static const uint64_t frequency = SDL_GetPerformanceFrequency();
+    // Split the conversion to avoid overflowing with high resolution counters.
+    uint64_t counter = SDL_GetPerformanceCounter();
+    return (counter / frequency) * 1000000 + ((counter % frequency) * 1000000) / frequency;
+}
+
+uint32_t FrameTelemetry::GetAllocationCount()
+{
+#ifdef DEBUG_FEATURES
+    return _telemetry_allocation_count;
+#else
+    return 0;
+#endif
+}
+
+void FrameTelemetry::_WriteCSVHeader(std::ostream& stream) const
+{
+    stream << "frame,ticks,frame_time,mode,context";
+    for (uint32_t i = 0; i < TELEMETRY_TOTAL; ++i)
+        stream << "," << GetCounterName(static_cast<TELEMETRY_COUNTER>(i));
+    stream << std::endl;
+}
+
+void FrameTelemetry::_WriteCSVLine(std::ostream& stream, const TelemetrySample& sample) const
+{
+    // Contexts are written by name, as CSV files are read separately.
+    stream << sample.frame << "," << sample.ticks << "," << sample.frame_time << ","
+           << static_cast<uint32_t>(sample.mode_type) << "," << _contexts[sample.context_id];
+    for (uint32_t i = 0; i < TELEMETRY_TOTAL; ++i)
+        stream << "," << sample.values[i];
+    stream << std::endl;
+}
+
+void FrameTelemetry::_FlushStream()
+{
+    if (!_stream_file.is_open() || _stream_pending == 0)
+        return;
+
+    uint32_t pending = _stream_pending > _number_samples ? _number_samples : _stream_pending;
+    for (uint32_t i = _number_samples - pending; i < _number_samples; ++i)
+        _WriteCSVLine(_stream_file, GetSample(i));
+    _stream_file.flush();
+    _stream_pending = 0;
+}
+
+// -----------------------------------------------------------------------------
+// TelemetryScope Class
+// -----------------------------------------------------------------------------
+
+TelemetryScope::TelemetryScope(TELEMETRY_COUNTER counter):
+    _counter(counter),
+    _start(0)
+{
+    if (SystemManager && SystemManager->GetTelemetry().IsEnabled())
+        _start = FrameTelemetry::GetMicroseconds();
+}
+
+TelemetryScope::~TelemetryScope()
+{
+    if (_start == 0)
+        return;
+
+    uint64_t elapsed = FrameTelemetry::GetMicroseconds() - _start;
+    SystemManager->GetTelemetry().AddTime(_counter, static_cast<uint32_t>(elapsed));
+}
+
+} // namespace vt_system
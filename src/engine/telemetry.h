@@ -0,0 +1,277 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    telemetry.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the per-frame telemetry recorder.
+***
+*** The frame telemetry keeps the last frames timing and counter samples
+*** published by the main loop and the game modes in a ring buffer.
+*** The samples can be dumped to CSV or JSON files, or streamed to a file
+*** every N frames, to graph hitches over long play sessions.
+*** ***************************************************************************/
+
+#ifndef __TELEMETRY_HEADER__
+#define __TELEMETRY_HEADER__
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+namespace vt_system
+{
+
+//! \brief Whether the frame telemetry recording starts with the game. Set from the command line.
+extern bool TELEMETRY_ENABLE;
+
+//! \brief The number of frames between two writes of the telemetry stream file, 0 disables streaming.
+extern uint32_t TELEMETRY_STREAM_INTERVAL;
+
+//! \brief The different values sampled for each frame.
+enum TELEMETRY_COUNTER {
+    TELEMETRY_INVALID          = -1,
+    //! Time spent updating the game (input, video, modes), in microseconds.
+    TELEMETRY_UPDATE_TIME      = 0,
+    //! Time spent drawing the game modes and the debug information, in microseconds.
+    TELEMETRY_DRAW_TIME        = 1,
+    //! Time spent running script functions, in microseconds.
+    TELEMETRY_LUA_TIME         = 2,
+    //! Time spent refilling the audio stream buffers, in microseconds.
+    TELEMETRY_AUDIO_TIME       = 3,
+    //! The number of pixel data uploads made to OpenGL textures.
+    TELEMETRY_TEXTURE_UPLOADS  = 4,
+    //! The number of heap allocations (only counted with debug features).
+    TELEMETRY_ALLOCATIONS      = 5,
+    //! The number of particles alive in the active game mode.
+    TELEMETRY_PARTICLES        = 6,
+    //! The number of objects handled by the active map.
+    TELEMETRY_MAP_OBJECTS      = 7,
+    //! Time spent collecting the Lua garbage, in microseconds.
+    TELEMETRY_LUA_GC_TIME      = 8,
+    //! Time spent sorting the active map objects in draw order, in microseconds.
+    TELEMETRY_MAP_SORT_TIME    = 9,
+    //! The number of map objects which moved vertically, and thus had to be sorted again.
+    TELEMETRY_MAP_SORTED_OBJECTS = 10,
+    //! Time spent swapping the buffers, vertical synchronization waits included, in microseconds.
+    TELEMETRY_SWAP_TIME        = 11,
+    TELEMETRY_TOTAL            = 12
+};
+
+//! \brief A single frame worth of telemetry data.
+struct TelemetrySample {
+    TelemetrySample():
+        frame(0),
+        ticks(0),
+        frame_time(0),
+        mode_type(0),
+        context_id(0)
+    {
+        for (uint32_t i = 0; i < TELEMETRY_TOTAL; ++i)
+            values[i] = 0;
+    }
+
+    //! \brief The frame number since the recording started.
+    uint32_t frame;
+
+    //! \brief The SDL ticks at the end of the frame.
+    uint32_t ticks;
+
+    //! \brief The game update time given by the system engine for this frame.
+    uint32_t frame_time;
+
+    //! \brief The type of the active game mode.
+    uint8_t mode_type;
+
+    //! \brief The id of the context (e.g. the map filename) the frame was run in.
+    uint16_t context_id;
+
+    //! \brief The counter values, indexed with TELEMETRY_COUNTER.
+    uint32_t values[TELEMETRY_TOTAL];
+};
+
+/** ****************************************************************************
+*** \brief Records the timing and counter values of the last frames.
+***
+*** Every subsystem adds its values to the current frame sample using
+*** AddTime(), AddCount() or SetValue(). The main loop then calls EndFrame()
+*** which stores the sample in the ring buffer and starts a new one.
+***
+*** \note Recording is disabled by default, so that the only cost of the
+*** calls spread in the code is a boolean test.
+*** ***************************************************************************/
+class FrameTelemetry
+{
+public:
+    FrameTelemetry();
+
+    ~FrameTelemetry();
+
+    //! \brief Enables or disables the recording, and clears the samples.
+    void SetEnabled(bool enabled);
+
+    bool IsEnabled() const {
+        return _enabled;
+    }
+
+    /** \brief Sets the number of frames samples kept in memory.
+    *** \note This clears the already recorded samples.
+    **/
+    void SetCapacity(uint32_t capacity);
+
+    /** \brief Streams the recorded samples to a CSV file every N frames.
+    *** \param filename The file to write the samples into. It is truncated first.
+    *** \param frames_interval The number of frames between two writes.
+    *** It can't be higher than the ring buffer capacity.
+    *** \return whether the file could be opened.
+    **/
+    bool StartStreaming(const std::string& filename, uint32_t frames_interval);
+
+    //! \brief Writes the pending samples and closes the stream file.
+    void StopStreaming();
+
+    /** \brief Sets the context name of the next frames samples.
+    *** Typically called by the game modes when they become active,
+    *** so that the hitches can be grouped by map for instance.
+    **/
+    void SetContext(const std::string& context);
+
+    //! \brief Adds the given amount of microseconds to a time counter of the current frame.
+    void AddTime(TELEMETRY_COUNTER counter, uint32_t microseconds) {
+        if (_enabled)
+            _current.values[counter] += microseconds;
+    }
+
+    //! \brief Increments a counter of the current frame.
+    void AddCount(TELEMETRY_COUNTER counter, uint32_t count = 1) {
+        if (_enabled)
+            _current.values[counter] += count;
+    }
+
+    //! \brief Sets a counter value of the current frame, used for 'live amount' values.
+    void SetValue(TELEMETRY_COUNTER counter, uint32_t value) {
+        if (_enabled)
+            _current.values[counter] = value;
+    }
+
+    /** \brief Stores the current frame sample and begins a new one.
+    *** \param frame_time The update time of the frame, as given by the system engine.
+    *** \param mode_type The type of the active game mode.
+    *** This should only be called once per main loop iteration.
+    **/
+    void EndFrame(uint32_t frame_time, uint8_t mode_type);
+
+    //! \brief Returns the number of samples currently held in the ring buffer.
+    uint32_t GetNumberSamples() const {
+        return _number_samples;
+    }
+
+    /** \brief Returns a sample held in the ring buffer.
+    *** \param index The index of the sample, 0 being the oldest one.
+    **/
+    const TelemetrySample& GetSample(uint32_t index) const;
+
+    /** \brief Writes the samples held in the ring buffer to a CSV or JSON file.
+    *** \return whether the file could be written.
+    **/
+    bool DumpCSV(const std::string& filename) const;
+    bool DumpJSON(const std::string& filename) const;
+
+    /** \brief Dumps the samples in the user data folder, in both CSV and JSON format.
+    *** Used by the debug key and on exit.
+    **/
+    void DumpToUserDataPath() const;
+
+    //! \brief Returns the name of a counter, as used in the CSV header and the JSON keys.
+    static const char* GetCounterName(TELEMETRY_COUNTER counter);
+
+    /** \brief Returns a timestamp in microseconds, using the performance counter.
+    *** Only differences between two timestamps are meaningful.
+    **/
+    static uint64_t GetMicroseconds();
+
+    /** \brief Returns the heap allocations count since the program start.
+    *** The count is only maintained when the game is compiled with the debug features.
+    **/
+    static uint32_t GetAllocationCount();
+
+private:
+    //! \brief Tells whether samples are recorded.
+    bool _enabled;
+
+    //! \brief The ring buffer of samples.
+    std::vector<TelemetrySample> _samples;
+
+    //! \brief The ring buffer index where the next sample will be stored.
+    uint32_t _next_sample;
+
+    //! \brief The number of valid samples in the ring buffer.
+    uint32_t _number_samples;
+
+    //! \brief The number of frames recorded since recording was enabled.
+    uint32_t _frame_count;
+
+    //! \brief The frame sample being filled.
+    TelemetrySample _current;
+
+    //! \brief The allocation count at the end of the last frame.
+    uint32_t _last_allocation_count;
+
+    //! \brief The known contexts names, indexed by TelemetrySample::context_id.
+    std::vector<std::string> _contexts;
+
+    //! \brief The current context id.
+    uint16_t _current_context_id;
+
+    //! \brief The streaming file, if any.
+    std::ofstream _stream_file;
+
+    //! \brief The number of frames between two stream file writes. 0 when not streaming.
+    uint32_t _stream_interval;
+
+    //! \brief The number of samples not yet written in the stream file.
+    uint32_t _stream_pending;
+
+    //! \brief Writes the CSV header line.
+    void _WriteCSVHeader(std::ostream& stream) const;
+
+    //! \brief Writes a sample as a CSV line.
+    void _WriteCSVLine(std::ostream& stream, const TelemetrySample& sample) const;
+
+    //! \brief Writes the pending samples to the stream file.
+    void _FlushStream();
+};
+
+/** ****************************************************************************
+*** \brief Measures the time spent in a scope and adds it to a telemetry counter.
+***
+*** Example: { TelemetryScope scope(TELEMETRY_DRAW_TIME); DrawStuff(); }
+*** ***************************************************************************/
+class TelemetryScope
+{
+public:
+    explicit TelemetryScope(TELEMETRY_COUNTER counter);
+
+    ~TelemetryScope();
+
+private:
+    //! \brief The counter the time is added to.
+    TELEMETRY_COUNTER _counter;
+
+    //! \brief The scope start timestamp, or 0 when the telemetry is disabled.
+    uint64_t _start;
+
+    TelemetryScope(const TelemetryScope&) = delete;
+    TelemetryScope& operator=(const TelemetryScope&) = delete;
+};
+
+} // namespace vt_system
+
+#endif // __TELEMETRY_HEADER__
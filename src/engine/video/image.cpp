@@ -19,6 +19,7 @@
 
 #include "script/script_read.h"
 #include "engine/system.h"
+#include "engine/virtual_file_system.h"
 #include "engine/video/color.h"
 
 #include "utils/utils_files.h"
@@ -209,7 +210,8 @@ bool ImageDescriptor::GetImageInfo(const std::string& filename,
     cols = 0;
     bpp = 0;
 
-    SDL_Surface* surf = IMG_Load(filename.c_str());
+    vt_system::FileData file_data;
+    SDL_Surface* surf = IMG_Load_RW(vt_system::FileSystemManager->OpenRWops(filename, file_data), 1);
 
     if (!surf) {
         PRINT_ERROR << "Couldn't load image " << filename
@@ -271,7 +273,7 @@ bool ImageDescriptor::LoadMultiImageFromElementSize(std::vector<StillImage>& ima
 bool ImageDescriptor::LoadMultiImageFromElementGrid(std::vector<StillImage>& images, const std::string &filename,
         const uint32_t grid_rows, const uint32_t grid_cols)
 {
-    if(!DoesFileExist(filename)) {
+    if(!vt_system::FileSystemManager->DoesFileExist(filename)) {
         PRINT_WARNING << "Multi-image file not found: "
                       << filename << std::endl;
         return false;
@@ -1097,7 +1099,7 @@ bool AnimatedImage::LoadFromAnimationScript(const std::string &filename)
     if (image_script.DoesBoolExist("blended_animation"))
         _blended_animation = image_script.ReadBool("blended_animation");
 
-    if(!vt_utils::DoesFileExist(image_filename)) {
+    if(!vt_system::FileSystemManager->DoesFileExist(image_filename)) {
         PRINT_WARNING << "The image file doesn't exist: " << image_filename << std::endl;
         image_script.CloseTable();
         image_script.CloseFile();
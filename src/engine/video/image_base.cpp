@@ -19,6 +19,9 @@
 
 #include "video.h"
 
+#include "engine/system.h"
+#include "engine/virtual_file_system.h"
+
 #include "utils/utils_common.h"
 
 #include <cassert>
@@ -73,7 +76,19 @@ bool ImageMemory::LoadImage(const std::string& filename)
         IF_PRINT_WARNING(VIDEO_DEBUG) << "_pixels member was not empty upon function invocation" << std::endl;
     }
 
-    SDL_Surface* temp_surf = IMG_Load(filename.c_str());
+    // Takes the image decoded ahead of time, when it was preloaded.
+    ImageMemory* preloaded = TextureManager->_TakePreloadedImage(filename);
+    if (preloaded != nullptr) {
+        _width = preloaded->_width;
+        _height = preloaded->_height;
+        _rgb_format = preloaded->_rgb_format;
+        _pixels.swap(preloaded->_pixels);
+        delete preloaded;
+        return true;
+    }
+
+    vt_system::FileData file_data;
+    SDL_Surface* temp_surf = IMG_Load_RW(vt_system::FileSystemManager->OpenRWops(filename, file_data), 1);
     if (temp_surf == nullptr) {
         PRINT_ERROR << "Couldn't load image file: " << filename << std::endl;
         return false;
@@ -459,6 +474,8 @@ void ImageMemory::GlGetTexImage()
 
 void ImageMemory::GlTexSubImage(int32_t x, int32_t y)
 {
+    vt_system::SystemManager->GetTelemetry().AddCount(vt_system::TELEMETRY_TEXTURE_UPLOADS);
+
     glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, _width, _height,
                     _rgb_format ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, &_pixels[0]);
 }
@@ -91,6 +91,15 @@ public:
         return _rgb_format ? 3 : 4;
     }
 
+    //! \brief Returns the pixels, row after row, or nullptr when there are none.
+    uint8_t* GetPixels() {
+        return _pixels.empty() ? nullptr : &_pixels[0];
+    }
+
+    const uint8_t* GetPixels() const {
+        return _pixels.empty() ? nullptr : &_pixels[0];
+    }
+
     /** \brief Loads raw image data from a file and stores the data in the class members
     *** \param filename The name of the image file to load.
     *** \return True if the image was loaded successfully, false if it was not
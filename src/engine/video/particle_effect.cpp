@@ -22,6 +22,7 @@
 
 #include "script/script_read.h"
 #include "engine/system.h"
+#include "engine/virtual_file_system.h"
 
 #include "utils/utils_files.h"
 
@@ -214,7 +215,7 @@ bool ParticleEffect::_LoadEffectDef(const std::string &particle_file)
         std::vector<std::string>::const_iterator it, it_end;
         for(it = sys_def.animation_frame_filenames.begin(),
                 it_end = sys_def.animation_frame_filenames.end(); it != it_end; ++it) {
-            if(!vt_utils::DoesFileExist(*it)) {
+            if(!vt_system::FileSystemManager->DoesFileExist(*it)) {
                 PRINT_WARNING << "Could not find file: "
                               << *it << " in system #" << sys << " in particle effect "
                               << particle_file << std::endl;
@@ -518,4 +519,12 @@ const vt_common::Position2D& ParticleEffect::GetPosition() const
     return _pos;
 }
 
+uint32_t ParticleEffect::GetMemorySize() const
+{
+    uint32_t bytes = 0;
+    for(uint32_t i = 0; i < _systems.size(); ++i)
+        bytes += _systems[i].GetMemorySize();
+    return bytes;
+}
+
 } // namespace vt_mode_manager
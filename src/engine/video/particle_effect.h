@@ -202,6 +202,12 @@ public:
         return _num_particles;
     }
 
+    /*!
+     *  \brief return the number of bytes allocated for the particles buffers of the effect systems
+     * \return the buffers size in bytes
+     */
+    uint32_t GetMemorySize() const;
+
     //! \brief return the position of the effect into x and y
     const vt_common::Position2D& GetPosition() const;
 
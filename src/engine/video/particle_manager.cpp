@@ -93,6 +93,14 @@ void ParticleManager::Update(int32_t frame_time)
     }
 }
 
+uint32_t ParticleManager::GetMemorySize() const
+{
+    uint32_t bytes = 0;
+    for(uint32_t i = 0; i < _all_effects.size(); ++i)
+        bytes += _all_effects[i]->GetMemorySize();
+    return bytes;
+}
+
 void ParticleManager::StopAll(bool kill_immediate)
 {
     std::vector<ParticleEffect *>::iterator it = _active_effects.begin();
@@ -43,7 +43,9 @@ public:
     /*!
      *  \brief Constructor
      */
-    ParticleManager() {}
+    ParticleManager():
+        _num_particles(0)
+    {}
 
     ~ParticleManager() {
         _Destroy();
@@ -87,6 +89,17 @@ public:
         return _num_particles;
     }
 
+    /*!
+     *  \brief returns the number of bytes allocated for the particles buffers of all the registered effects
+     * \return the buffers size in bytes
+     */
+    uint32_t GetMemorySize() const;
+
+    //! \brief returns the number of registered effects
+    uint32_t GetNumEffects() const {
+        return _all_effects.size();
+    }
+
 private:
     /*!
      *  \brief destroys the system. Called by VideoEngine's destructor
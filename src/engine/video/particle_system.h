@@ -326,6 +326,17 @@ public:
         return _num_particles;
     }
 
+    /*!
+     *  \brief returns the number of bytes allocated for the particles buffers
+     * \return the buffers size in bytes
+     */
+    uint32_t GetMemorySize() const {
+        return _particle_vertices.capacity() * sizeof(ParticleVertex)
+            + _particle_colors.capacity() * sizeof(vt_video::Color)
+            + _particle_texcoords.capacity() * sizeof(ParticleTexCoord)
+            + _particles.capacity() * sizeof(Particle);
+    }
+
     /*!
      *  \brief returns the number of seconds since this system was created
      * \return the age of the system
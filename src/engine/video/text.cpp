@@ -27,6 +27,7 @@
 
 #include "script/script_read.h"
 #include "engine/system.h"
+#include "engine/virtual_file_system.h"
 
 #ifdef __APPLE__
 #   include <SDL_ttf.h>
@@ -744,8 +745,20 @@ bool TextSupervisor::_LoadFont(const std::string& textstyle_name,
             return true;
     }
 
-    // Attempt to load the font
-    TTF_Font *font = TTF_OpenFont(font_filename.c_str(), font_size);
+    // Attempt to load the font.
+    // SDL_ttf reads the font file while rendering, so only the fonts read in place
+    // from an archive are opened from memory, as their data stays valid.
+    TTF_Font *font = nullptr;
+    vt_system::FileData font_data;
+    if (vt_system::FileSystemManager->IsInArchive(font_filename)
+            && vt_system::FileSystemManager->ReadFile(font_filename, font_data)
+            && !font_data.IsCopy()) {
+        font = TTF_OpenFontRW(SDL_RWFromConstMem(font_data.GetData(), static_cast<int>(font_data.GetSize())),
+                              1, font_size);
+    }
+    else {
+        font = TTF_OpenFont(font_filename.c_str(), font_size);
+    }
     if(font == nullptr) {
         PRINT_ERROR << "Call to TTF_OpenFont() failed to load the font file: "
                     << font_filename  << std::endl
@@ -1064,6 +1077,8 @@ void TextSupervisor::_RenderText(const uint16_t* text, FontProperties* font_prop
     // Send the surface pixel data to OpenGL.
     //
 
+    vt_system::SystemManager->GetTelemetry().AddCount(vt_system::TELEMETRY_TEXTURE_UPLOADS);
+
     if (_text_texture_width == static_cast<GLuint>(surface->w) &&
         _text_texture_height == static_cast<GLuint>(surface->h)) {
         // The size of the old texture is the same.  Just update the pixel data.
@@ -1194,6 +1209,8 @@ void TextSupervisor::_RenderText(const uint16_t* text, FontProperties* font_prop
     // Send the surface pixel data to OpenGL.
     //
 
+    vt_system::SystemManager->GetTelemetry().AddCount(vt_system::TELEMETRY_TEXTURE_UPLOADS);
+
     if (_text_texture_width == static_cast<GLuint>(surface->w) &&
         _text_texture_height == static_cast<GLuint>(surface->h)) {
         // The size of the old texture is the same.  Just update the pixel data.
@@ -17,9 +17,11 @@
 
 #include "texture_controller.h"
 #include "utils/utils_files.h"
+#include "utils/utils_strings.h"
 
 #include "engine/mode_manager.h"
 #include "engine/video/video.h"
+#include "engine/memory_accounting.h"
 
 using namespace vt_video::private_video;
 
@@ -30,7 +32,8 @@ namespace vt_video
 TextureController* TextureManager = nullptr;
 
 TextureController::TextureController() :
-    _debug_current_sheet(-1)
+    _debug_current_sheet(-1),
+    _preload_mutex(SDL_CreateMutex())
 {
 }
 
@@ -50,6 +53,10 @@ TextureController::~TextureController()
     for(std::vector<TexSheet *>::iterator i = _tex_sheets.begin(); i != _tex_sheets.end(); ++i) {
         delete *i;
     }
+
+    ClearPreloadedImages();
+    if(_preload_mutex != nullptr)
+        SDL_DestroyMutex(_preload_mutex);
 }
 
 bool TextureController::SingletonInitialize()
@@ -172,6 +179,81 @@ void TextureController::DEBUG_ShowTexSheet()
     VideoManager->PopState();
 }
 
+bool TextureController::PreloadImage(const std::string& filename)
+{
+    SDL_LockMutex(_preload_mutex);
+    bool preloaded = (_preloaded_images.find(filename) != _preloaded_images.end());
+    SDL_UnlockMutex(_preload_mutex);
+    if(preloaded)
+        return true;
+
+    // The decoding is done out of the lock, as it is the long part.
+    ImageMemory *image = new ImageMemory();
+    if(!image->LoadImage(filename)) {
+        delete image;
+        return false;
+    }
+
+    SDL_LockMutex(_preload_mutex);
+    std::pair<std::map<std::string, ImageMemory *>::iterator, bool> result =
+        _preloaded_images.insert(std::make_pair(filename, image));
+    SDL_UnlockMutex(_preload_mutex);
+
+    if(!result.second)
+        delete image;
+    return true;
+}
+
+void TextureController::ClearPreloadedImages()
+{
+    SDL_LockMutex(_preload_mutex);
+    for(std::map<std::string, ImageMemory *>::iterator it = _preloaded_images.begin(); it != _preloaded_images.end(); ++it)
+        delete it->second;
+    _preloaded_images.clear();
+    SDL_UnlockMutex(_preload_mutex);
+}
+
+ImageMemory *TextureController::_TakePreloadedImage(const std::string &filename)
+{
+    ImageMemory *image = nullptr;
+
+    SDL_LockMutex(_preload_mutex);
+    std::map<std::string, ImageMemory *>::iterator it = _preloaded_images.find(filename);
+    if(it != _preloaded_images.end()) {
+        image = it->second;
+        _preloaded_images.erase(it);
+    }
+    SDL_UnlockMutex(_preload_mutex);
+
+    return image;
+}
+
+void TextureController::DEBUG_ReportMemoryUsage(vt_system::MemoryAccounting& accounting) const
+{
+    for(uint32_t i = 0; i < _tex_sheets.size(); ++i) {
+        TexSheet *sheet = _tex_sheets[i];
+        if(sheet == nullptr)
+            continue;
+
+        std::string type;
+        if(sheet->type == VIDEO_TEXSHEET_32x32)
+            type = "32x32";
+        else if(sheet->type == VIDEO_TEXSHEET_32x64)
+            type = "32x64";
+        else if(sheet->type == VIDEO_TEXSHEET_64x64)
+            type = "64x64";
+        else
+            type = "any size";
+
+        // The sheets are always stored as RGBA textures. Unloaded ones have no OpenGL storage.
+        uint64_t bytes = sheet->loaded ? static_cast<uint64_t>(sheet->width) * sheet->height * 4 : 0;
+        accounting.Report(vt_system::MEMORY_TEXTURES,
+                          "Sheet " + vt_utils::NumberToString(i) + " (" + vt_utils::NumberToString(sheet->width) + "x"
+                          + vt_utils::NumberToString(sheet->height) + ", " + type + (sheet->is_static ? ", static)" : ")"),
+                          bytes, sheet->GetNumberTextures());
+    }
+}
+
 GLuint TextureController::_CreateBlankGLTexture(int32_t width, int32_t height)
 {
     GLuint tex_id;
@@ -27,12 +27,18 @@
 #include "texture.h"
 #include "image_base.h"
 
+#include <SDL2/SDL_mutex.h>
+
 #include <map>
 
 namespace vt_mode_manager {
 class ParticleSystem;
 }
 
+namespace vt_system {
+class MemoryAccounting;
+}
+
 namespace vt_video
 {
 
@@ -73,6 +79,19 @@ public:
     **/
     void DEBUG_ShowTexSheet();
 
+    //! \brief Reports the memory used by each texture sheet to the memory accounting.
+    void DEBUG_ReportMemoryUsage(vt_system::MemoryAccounting& accounting) const;
+
+    /** \brief Decodes an image file ahead of time, so that loading it later on
+    *** only has to copy it in a texture sheet.
+    *** \note This is the only method which can be called from another thread.
+    *** \return false if the image couldn't be decoded.
+    **/
+    bool PreloadImage(const std::string& filename);
+
+    //! \brief Frees the preloaded images which haven't been loaded.
+    void ClearPreloadedImages();
+
 private:
     virtual ~TextureController() override;
 
@@ -88,6 +107,12 @@ private:
     //! \brief An index to _tex_sheets of the current texture sheet being shown in debug mode. -1 indicates no sheet
     int32_t _debug_current_sheet;
 
+    //! \brief The images decoded ahead of time, by filename, until they are loaded.
+    std::map<std::string, private_video::ImageMemory *> _preloaded_images;
+
+    //! \brief Protects the preloaded images, filled by other threads.
+    SDL_mutex* _preload_mutex;
+
     // ---------- Private methods
 
     //! \name Texture Operations
@@ -175,6 +200,11 @@ private:
     }
     //@}
 
+    /** \brief Gives the preloaded image of the given file, and forgets it.
+    *** \return The decoded image, to be deleted by the caller, or nullptr if it wasn't preloaded.
+    **/
+    private_video::ImageMemory *_TakePreloadedImage(const std::string &filename);
+
     //! \name Text Texture Operations
     //@{
     /** \brief Adds a TextTexture object to the map registery
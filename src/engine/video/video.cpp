@@ -84,6 +84,10 @@ VideoEngine::VideoEngine():
     _current_sample(0),
     _number_samples(0),
     _FPS_textimage(nullptr),
+    _script_profile_textimage(nullptr),
+    _script_profile_time(0),
+    _loading_display(false),
+    _loading_textimage(nullptr),
     _gl_error_code(GL_NO_ERROR),
     _gl_blend_is_active(false),
     _gl_texture_2d_is_active(false),
@@ -178,6 +182,16 @@ VideoEngine::~VideoEngine()
         _FPS_textimage = nullptr;
     }
 
+    if (_script_profile_textimage != nullptr) {
+        delete _script_profile_textimage;
+        _script_profile_textimage = nullptr;
+    }
+
+    if (_loading_textimage != nullptr) {
+        delete _loading_textimage;
+        _loading_textimage = nullptr;
+    }
+
     TextureManager->SingletonDestroy();
 }
 
@@ -381,6 +395,9 @@ void VideoEngine::Update()
 
     if (_fps_display)
         _UpdateFPS();
+
+    if (vt_system::SystemManager->GetScriptProfiler().IsEnabled())
+        _UpdateScriptProfile();
 }
 
 void VideoEngine::DrawDebugInfo()
@@ -390,6 +407,9 @@ void VideoEngine::DrawDebugInfo()
 
     if (_fps_display)
         _DrawFPS();
+
+    if (vt_system::SystemManager->GetScriptProfiler().IsEnabled())
+        _DrawScriptProfile();
 }
 
 bool VideoEngine::CheckGLError() {
@@ -961,6 +981,9 @@ void VideoEngine::Scale(float x, float y)
 void VideoEngine::DrawFadeEffect()
 {
     _screen_fader.Draw();
+
+    if (_loading_display)
+        _DrawLoadingIndicator();
 }
 
 void VideoEngine::DisableFadeEffect()
@@ -1439,4 +1462,58 @@ void VideoEngine::_DrawFPS()
     PopState();
 }
 
+void VideoEngine::_UpdateScriptProfile()
+{
+    //! \brief The number of functions shown, and the time between two updates in milliseconds.
+    const uint32_t SCRIPT_PROFILE_LINES = 5;
+    const uint32_t SCRIPT_PROFILE_UPDATE_TIME = 1000;
+
+    _script_profile_time += vt_system::SystemManager->GetUpdateTime();
+    if (_script_profile_textimage && _script_profile_time < SCRIPT_PROFILE_UPDATE_TIME)
+        return;
+    _script_profile_time = 0;
+
+    // We only create the text image when needed, to permit getting the text style correctly.
+    if (!_script_profile_textimage)
+        _script_profile_textimage = new TextImage(std::string(), TextStyle("text20", Color::white));
+
+    std::vector<const vt_system::ScriptFunctionProfile*> functions =
+        vt_system::SystemManager->GetScriptProfiler().GetTopFunctions(SCRIPT_PROFILE_LINES);
+
+    std::string text = "Lua self ms:";
+    for (uint32_t i = 0; i < functions.size(); ++i)
+        text += "\n" + NumberToString(functions[i]->self_time / 1000) + "  " + functions[i]->label;
+    _script_profile_textimage->SetText(text);
+}
+
+void VideoEngine::_DrawScriptProfile()
+{
+    if (!_script_profile_textimage)
+        return;
+
+    PushState();
+    SetStandardCoordSys();
+    SetDrawFlags(VIDEO_X_LEFT, VIDEO_Y_TOP, VIDEO_X_NOFLIP, VIDEO_Y_NOFLIP,
+                 VIDEO_BLEND, 0);
+    Move(10.0f, 60.0f); // Upper left hand corner of the screen
+    _script_profile_textimage->Draw();
+    PopState();
+}
+
+void VideoEngine::_DrawLoadingIndicator()
+{
+    // We only create the text image when needed, to permit getting the text style correctly.
+    if (!_loading_textimage)
+        _loading_textimage = new TextImage(vt_system::UTranslate("Loading..."),
+                                           TextStyle("text20", Color::white, VIDEO_TEXT_SHADOW_DARK));
+
+    PushState();
+    SetStandardCoordSys();
+    SetDrawFlags(VIDEO_X_RIGHT, VIDEO_Y_BOTTOM, VIDEO_X_NOFLIP, VIDEO_Y_NOFLIP,
+                 VIDEO_BLEND, 0);
+    Move(1004.0f, 748.0f); // Lower right hand corner of the screen
+    _loading_textimage->Draw();
+    PopState();
+}
+
 }  // namespace vt_video
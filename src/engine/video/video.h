@@ -649,6 +649,11 @@ private:
         _screen_fader.TransitionalFadeIn(time);
     }
 
+    //! \brief Shows or hides the loading text, drawn above the fade while a map is being loaded.
+    void _ShowLoadingIndicator(bool show) {
+        _loading_display = show;
+    }
+
     //-- Private variables ----------------------------------------------------
 
     //! The SDL2 Window handle
@@ -681,6 +686,16 @@ private:
     //! The FPS text
     TextImage* _FPS_textimage;
 
+    //! \brief The most time consuming Lua functions text, shown while the scripts profiler is enabled.
+    TextImage* _script_profile_textimage;
+
+    //! \brief The time since the script profile text was last updated, in milliseconds.
+    uint32_t _script_profile_time;
+
+    //! \brief Whether the loading text is shown, and the text itself.
+    bool _loading_display;
+    TextImage* _loading_textimage;
+
     //! \brief Holds the most recently fetched OpenGL error code
     GLenum _gl_error_code;
 
@@ -804,6 +819,15 @@ private:
 
     //! \brief Draws the current average FPS to the screen.
     void _DrawFPS();
+
+    //! \brief Updates the most time consuming Lua functions text, once a second.
+    void _UpdateScriptProfile();
+
+    //! \brief Draws the most time consuming Lua functions to the screen.
+    void _DrawScriptProfile();
+
+    //! \brief Draws the loading text in the lower right hand corner of the screen.
+    void _DrawLoadingIndicator();
 };
 
 } // namespace vt_video
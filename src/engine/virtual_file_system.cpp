@@ -0,0 +1,418 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    virtual_file_system.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the virtual file system and the packed data archives.
+*** ***************************************************************************/
+
+#include "engine/virtual_file_system.h"
+
+#include "engine/system.h"
+#include "engine/binary_utils.h"
+
+#include "script/script.h"
+
+#include "utils/utils_files.h"
+
+#include <SDL2/SDL_rwops.h>
+
+#include <zlib.h>
+
+#include <fstream>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace vt_system
+{
+
+VirtualFileSystem* FileSystemManager = nullptr;
+
+namespace private_system
+{
+
+//! \brief The archive header size in bytes.
+const uint32_t ARCHIVE_HEADER_SIZE = 16;
+
+//! \brief The fixed part size of an index entry, in bytes.
+const uint32_t ARCHIVE_ENTRY_SIZE = 22;
+
+PackedArchive::PackedArchive():
+    _data(nullptr),
+    _size(0),
+    _mapped(false)
+#ifdef _WIN32
+    ,
+    _file_handle(nullptr),
+    _mapping_handle(nullptr)
+#endif
+{}
+
+PackedArchive::~PackedArchive()
+{
+    Close();
+}
+
+bool PackedArchive::Open(const std::string& filename)
+{
+    Close();
+    _filename = filename;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER file_size;
+        HANDLE mapping = nullptr;
+        if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (view) {
+            _file_handle = file;
+            _mapping_handle = mapping;
+            _data = static_cast<const uint8_t*>(view);
+            _size = static_cast<uint64_t>(file_size.QuadPart);
+            _mapped = true;
+        }
+        else {
+            if (mapping)
+                CloseHandle(mapping);
+            CloseHandle(file);
+        }
+    }
+#else
+    int file = open(filename.c_str(), O_RDONLY);
+    if (file >= 0) {
+        struct stat file_stat;
+        if (fstat(file, &file_stat) == 0 && file_stat.st_size > 0) {
+            void* map = mmap(nullptr, static_cast<size_t>(file_stat.st_size),
+                             PROT_READ, MAP_PRIVATE, file, 0);
+            if (map != MAP_FAILED) {
+                _data = static_cast<const uint8_t*>(map);
+                _size = static_cast<uint64_t>(file_stat.st_size);
+                _mapped = true;
+            }
+        }
+        // The mapping stays valid once the file is closed.
+        close(file);
+    }
+#endif
+
+    // Fall back to reading the whole archive in memory.
+    if (!_mapped) {
+        std::ifstream file(filename.c_str(), std::ifstream::binary);
+        if (!file.is_open()) {
+            PRINT_WARNING << "Couldn't open the archive: " << filename << std::endl;
+            return false;
+        }
+
+        file.seekg(0, std::ifstream::end);
+        std::streamoff file_size = file.tellg();
+        file.seekg(0, std::ifstream::beg);
+        if (file_size <= 0) {
+            PRINT_WARNING << "Empty archive: " << filename << std::endl;
+            return false;
+        }
+
+        _buffer.resize(static_cast<size_t>(file_size));
+        if (!file.read(reinterpret_cast<char*>(&_buffer[0]), file_size)) {
+            PRINT_WARNING << "Couldn't read the archive: " << filename << std::endl;
+            _buffer.clear();
+            return false;
+        }
+        _data = &_buffer[0];
+        _size = static_cast<uint64_t>(file_size);
+
+        IF_PRINT_WARNING(SYSTEM_DEBUG) << "The archive couldn't be memory-mapped and was read in memory: "
+                                       << filename << std::endl;
+    }
+
+    if (!_ReadIndex()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void PackedArchive::Close()
+{
+    if (_mapped) {
+#ifdef _WIN32
+        UnmapViewOfFile(_data);
+        CloseHandle(static_cast<HANDLE>(_mapping_handle));
+        CloseHandle(static_cast<HANDLE>(_file_handle));
+        _mapping_handle = nullptr;
+        _file_handle = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(_data), static_cast<size_t>(_size));
+#endif
+        _mapped = false;
+    }
+
+    _buffer.clear();
+    _data = nullptr;
+    _size = 0;
+    _entries.clear();
+}
+
+const ArchiveEntry* PackedArchive::FindEntry(const std::string& path) const
+{
+    std::map<std::string, ArchiveEntry>::const_iterator it = _entries.find(path);
+    if (it == _entries.end())
+        return nullptr;
+    return &it->second;
+}
+
+bool PackedArchive::_ReadIndex()
+{
+    if (_size < ARCHIVE_HEADER_SIZE || memcmp(_data, "VTPK", 4) != 0) {
+        PRINT_WARNING << "Invalid archive header: " << _filename << std::endl;
+        return false;
+    }
+
+    uint32_t version = ReadUInt32(_data + 4);
+    if (version != ARCHIVE_VERSION) {
+        PRINT_WARNING << "Unsupported archive version " << version
+                      << " in: " << _filename << std::endl;
+        return false;
+    }
+
+    uint32_t number_entries = ReadUInt32(_data + 8);
+    uint64_t index_end = ARCHIVE_HEADER_SIZE + static_cast<uint64_t>(ReadUInt32(_data + 12));
+    if (index_end > _size) {
+        PRINT_WARNING << "Truncated archive index: " << _filename << std::endl;
+        return false;
+    }
+
+    const uint8_t* index = _data + ARCHIVE_HEADER_SIZE;
+    const uint8_t* index_limit = _data + index_end;
+    for (uint32_t i = 0; i < number_entries; ++i) {
+        if (index + ARCHIVE_ENTRY_SIZE > index_limit) {
+            PRINT_WARNING << "Truncated archive index: " << _filename << std::endl;
+            return false;
+        }
+
+        ArchiveEntry entry;
+        entry.offset = ReadUInt64(index);
+        entry.stored_size = ReadUInt32(index + 8);
+        entry.size = ReadUInt32(index + 12);
+        entry.flags = ReadUInt32(index + 16);
+        uint16_t path_length = ReadUInt16(index + 20);
+        index += ARCHIVE_ENTRY_SIZE;
+
+        if (index + path_length > index_limit
+                || entry.offset + entry.stored_size > _size) {
+            PRINT_WARNING << "Invalid archive entry #" << i << " in: " << _filename << std::endl;
+            return false;
+        }
+
+        _entries[std::string(reinterpret_cast<const char*>(index), path_length)] = entry;
+        index += path_length;
+    }
+
+    IF_PRINT_DEBUG(SYSTEM_DEBUG) << "Archive " << _filename << " opened with "
+                                 << _entries.size() << " entries" << std::endl;
+    return true;
+}
+
+} // namespace private_system
+
+using namespace private_system;
+
+// -----------------------------------------------------------------------------
+// Lua loaders
+// -----------------------------------------------------------------------------
+
+//! \brief Replacement of the Lua 'loadfile' function.
+static int _LuaLoadFile(lua_State* lua_state)
+{
+    const char* filename = luaL_checkstring(lua_state, 1);
+    if (FileSystemManager->LoadScript(lua_state, filename) != 0) {
+        // Returns nil and the error message, as the original function.
+        lua_pushnil(lua_state);
+        lua_insert(lua_state, -2);
+        return 2;
+    }
+    return 1;
+}
+
+//! \brief Replacement of the Lua 'dofile' function.
+static int _LuaDoFile(lua_State* lua_state)
+{
+    const char* filename = luaL_checkstring(lua_state, 1);
+    int top = lua_gettop(lua_state);
+    if (FileSystemManager->LoadScript(lua_state, filename) != 0)
+        return lua_error(lua_state);
+    lua_call(lua_state, 0, LUA_MULTRET);
+    return lua_gettop(lua_state) - top;
+}
+
+// -----------------------------------------------------------------------------
+// VirtualFileSystem Class
+// -----------------------------------------------------------------------------
+
+VirtualFileSystem::~VirtualFileSystem()
+{
+    UnmountArchives();
+}
+
+bool VirtualFileSystem::MountArchive(const std::string& filename)
+{
+    PackedArchive* archive = new PackedArchive();
+    if (!archive->Open(filename)) {
+        delete archive;
+        return false;
+    }
+
+    _archives.push_back(archive);
+    return true;
+}
+
+void VirtualFileSystem::UnmountArchives()
+{
+    for (uint32_t i = 0; i < _archives.size(); ++i)
+        delete _archives[i];
+    _archives.clear();
+}
+
+bool VirtualFileSystem::DoesFileExist(const std::string& filename) const
+{
+    return IsInArchive(filename) || vt_utils::DoesFileExist(filename);
+}
+
+bool VirtualFileSystem::IsInArchive(const std::string& filename) const
+{
+    const PackedArchive* archive = nullptr;
+    return _FindEntry(filename, &archive) != nullptr;
+}
+
+bool VirtualFileSystem::ReadFile(const std::string& filename, FileData& file_data) const
+{
+    file_data.Clear();
+
+    const PackedArchive* archive = nullptr;
+    const ArchiveEntry* entry = _FindEntry(filename, &archive);
+    if (entry) {
+        const uint8_t* data = archive->GetEntryData(*entry);
+
+        // Uncompressed entries are read in place.
+        if ((entry->flags & ARCHIVE_ENTRY_COMPRESSED) == 0) {
+            file_data._data = data;
+            file_data._size = entry->size;
+            return true;
+        }
+
+        file_data._buffer.resize(entry->size > 0 ? entry->size : 1);
+        uLongf size = entry->size;
+        if (uncompress(&file_data._buffer[0], &size, data, entry->stored_size) != Z_OK
+                || size != entry->size) {
+            PRINT_WARNING << "Couldn't uncompress the file: " << filename
+                          << " from archive: " << archive->GetFilename() << std::endl;
+            file_data.Clear();
+            return false;
+        }
+        file_data._data = &file_data._buffer[0];
+        file_data._size = entry->size;
+        return true;
+    }
+
+    std::ifstream file(filename.c_str(), std::ifstream::binary);
+    if (!file.is_open())
+        return false;
+
+    file.seekg(0, std::ifstream::end);
+    std::streamoff file_size = file.tellg();
+    file.seekg(0, std::ifstream::beg);
+    if (file_size < 0)
+        return false;
+
+    file_data._buffer.resize(file_size > 0 ? static_cast<size_t>(file_size) : 1);
+    if (file_size > 0 && !file.read(reinterpret_cast<char*>(&file_data._buffer[0]), file_size)) {
+        PRINT_WARNING << "Couldn't read the file: " << filename << std::endl;
+        file_data.Clear();
+        return false;
+    }
+    file_data._data = &file_data._buffer[0];
+    file_data._size = static_cast<size_t>(file_size);
+    return true;
+}
+
+SDL_RWops* VirtualFileSystem::OpenRWops(const std::string& filename, FileData& file_data) const
+{
+    // The files out of the archives are streamed from the disk as before.
+    if (!IsInArchive(filename))
+        return SDL_RWFromFile(filename.c_str(), "rb");
+
+    if (!ReadFile(filename, file_data))
+        return nullptr;
+    return SDL_RWFromConstMem(file_data.GetData(), static_cast<int>(file_data.GetSize()));
+}
+
+int VirtualFileSystem::LoadScript(lua_State* lua_state, const std::string& filename) const
+{
+    FileData file_data;
+    if (!ReadFile(filename, file_data)) {
+        lua_pushfstring(lua_state, "cannot open %s", filename.c_str());
+        return LUA_ERRFILE;
+    }
+
+    // The '@' prefix tells Lua the chunk name is a filename, for the error messages.
+    std::string chunk_name = "@" + filename;
+    return luaL_loadbuffer(lua_state, reinterpret_cast<const char*>(file_data.GetData()),
+                           file_data.GetSize(), chunk_name.c_str());
+}
+
+void VirtualFileSystem::BindScriptLoaders(lua_State* lua_state) const
+{
+    lua_register(lua_state, "loadfile", _LuaLoadFile);
+    lua_register(lua_state, "dofile", _LuaDoFile);
+}
+
+std::string VirtualFileSystem::NormalizePath(const std::string& filename)
+{
+    std::string path = filename;
+    for (uint32_t i = 0; i < path.size(); ++i) {
+        if (path[i] == '\\')
+            path[i] = '/';
+    }
+
+    while (path.compare(0, 2, "./") == 0)
+        path.erase(0, 2);
+    return path;
+}
+
+const ArchiveEntry* VirtualFileSystem::_FindEntry(const std::string& filename,
+                                                  const PackedArchive** archive) const
+{
+    if (_archives.empty())
+        return nullptr;
+
+    std::string path = NormalizePath(filename);
+
+    // The last mounted archives override the previous ones.
+    for (uint32_t i = _archives.size(); i > 0; --i) {
+        const ArchiveEntry* entry = _archives[i - 1]->FindEntry(path);
+        if (entry) {
+            *archive = _archives[i - 1];
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace vt_system
@@ -0,0 +1,272 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    virtual_file_system.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the virtual file system and the packed data archives.
+***
+*** The game data files can be packed into a single archive using the
+*** tools/pack_data.py script. The archive is memory-mapped once, and the
+*** uncompressed entries are then read in place, without any copy.
+*** The files not found in the mounted archives are read from the disk.
+***
+*** The Lua scripts are never packed: ReadScriptDescriptor::OpenFile(), from the
+*** utils submodule, opens them with luaL_loadfile(), so they must stay loose.
+***
+*** Archive format (little endian):
+*** - Header: char[4] "VTPK", uint32 version, uint32 entries count, uint32 index size.
+*** - Index, one per entry: uint64 data offset, uint32 stored size, uint32 size,
+***   uint32 flags, uint16 path length, char[path length] path.
+*** - The entries data, each aligned on ARCHIVE_DATA_ALIGNMENT bytes.
+*** ***************************************************************************/
+
+#ifndef __VIRTUAL_FILE_SYSTEM_HEADER__
+#define __VIRTUAL_FILE_SYSTEM_HEADER__
+
+#include "utils/singleton.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+struct SDL_RWops;
+struct lua_State;
+
+namespace vt_system
+{
+
+class VirtualFileSystem;
+
+//! \brief The singleton pointer for the virtual file system.
+extern VirtualFileSystem* FileSystemManager;
+
+//! \brief The default data archive name, mounted at startup when present.
+const std::string DEFAULT_DATA_ARCHIVE = "data.vtpk";
+
+//! \brief The archive format version handled.
+const uint32_t ARCHIVE_VERSION = 1;
+
+//! \brief The entries data alignment, in bytes.
+const uint32_t ARCHIVE_DATA_ALIGNMENT = 16;
+
+//! \brief The archive entry is compressed using zlib.
+const uint32_t ARCHIVE_ENTRY_COMPRESSED = 0x1;
+
+/** ****************************************************************************
+*** \brief The content of a file read through the virtual file system.
+***
+*** The data either points directly into a memory-mapped archive or into
+*** the object own buffer, when the file was compressed or read from the disk.
+*** ***************************************************************************/
+class FileData
+{
+    friend class VirtualFileSystem;
+
+public:
+    FileData():
+        _data(nullptr),
+        _size(0)
+    {}
+
+    const uint8_t* GetData() const {
+        return _data;
+    }
+
+    size_t GetSize() const {
+        return _size;
+    }
+
+    //! \brief Tells whether the data was copied, rather than read in place from an archive.
+    bool IsCopy() const {
+        return !_buffer.empty();
+    }
+
+    void Clear() {
+        _data = nullptr;
+        _size = 0;
+        _buffer.clear();
+    }
+
+private:
+    //! \brief The file data.
+    const uint8_t* _data;
+
+    //! \brief The file size in bytes.
+    size_t _size;
+
+    //! \brief The buffer holding the data, when not read in place.
+    std::vector<uint8_t> _buffer;
+
+    FileData(const FileData&) = delete;
+    FileData& operator=(const FileData&) = delete;
+};
+
+namespace private_system
+{
+
+//! \brief An archive index entry.
+struct ArchiveEntry {
+    //! \brief The data offset from the archive start.
+    uint64_t offset;
+
+    //! \brief The data size in the archive.
+    uint32_t stored_size;
+
+    //! \brief The actual file size.
+    uint32_t size;
+
+    //! \brief The entry flags, e.g. ARCHIVE_ENTRY_COMPRESSED.
+    uint32_t flags;
+};
+
+/** ****************************************************************************
+*** \brief A memory-mapped packed archive.
+***
+*** When the archive can't be memory-mapped, it is read in memory as a whole.
+*** ***************************************************************************/
+class PackedArchive
+{
+public:
+    PackedArchive();
+
+    ~PackedArchive();
+
+    //! \brief Maps the archive and reads its index. Returns false if the archive is invalid.
+    bool Open(const std::string& filename);
+
+    void Close();
+
+    //! \brief Returns the entry of the given path, or nullptr.
+    const ArchiveEntry* FindEntry(const std::string& path) const;
+
+    //! \brief Returns the entry data start.
+    const uint8_t* GetEntryData(const ArchiveEntry& entry) const {
+        return _data + entry.offset;
+    }
+
+    const std::string& GetFilename() const {
+        return _filename;
+    }
+
+    uint32_t GetNumberEntries() const {
+        return static_cast<uint32_t>(_entries.size());
+    }
+
+private:
+    std::string _filename;
+
+    //! \brief The archive content.
+    const uint8_t* _data;
+
+    //! \brief The archive size in bytes.
+    uint64_t _size;
+
+    //! \brief Whether the data is memory-mapped, or held in _buffer.
+    bool _mapped;
+
+    //! \brief The archive content when it couldn't be memory-mapped.
+    std::vector<uint8_t> _buffer;
+
+#ifdef _WIN32
+    //! \brief The Windows file and mapping handles.
+    void* _file_handle;
+    void* _mapping_handle;
+#endif
+
+    //! \brief The index, by normalized path.
+    std::map<std::string, ArchiveEntry> _entries;
+
+    //! \brief Reads the archive index.
+    bool _ReadIndex();
+
+    PackedArchive(const PackedArchive&) = delete;
+    PackedArchive& operator=(const PackedArchive&) = delete;
+};
+
+} // namespace private_system
+
+/** ****************************************************************************
+*** \brief Reads the game data files from the mounted archives, or the disk.
+***
+*** The archives are searched in the reverse order they were mounted, so that
+*** a later archive (e.g. a patch) overrides the previous ones.
+***
+*** \note This class is a singleton.
+*** ***************************************************************************/
+class VirtualFileSystem : public vt_utils::Singleton<VirtualFileSystem>
+{
+    friend class vt_utils::Singleton<VirtualFileSystem>;
+
+public:
+    ~VirtualFileSystem();
+
+    bool SingletonInitialize() {
+        return true;
+    }
+
+    /** \brief Mounts a packed archive.
+    *** \return false if the archive couldn't be opened or is invalid.
+    **/
+    bool MountArchive(const std::string& filename);
+
+    //! \brief Unmounts all the archives. The data read in place from them becomes invalid.
+    void UnmountArchives();
+
+    //! \brief Returns the number of mounted archives.
+    uint32_t GetNumberArchives() const {
+        return static_cast<uint32_t>(_archives.size());
+    }
+
+    //! \brief Tells whether the file exists in an archive or on the disk.
+    bool DoesFileExist(const std::string& filename) const;
+
+    //! \brief Tells whether the file exists in a mounted archive.
+    bool IsInArchive(const std::string& filename) const;
+
+    /** \brief Reads a whole file.
+    *** \param file_data Filled with the file content. Uncompressed archive entries are read in place.
+    *** \return false if the file couldn't be found or read.
+    **/
+    bool ReadFile(const std::string& filename, FileData& file_data) const;
+
+    /** \brief Opens a SDL read stream on a file, for the SDL based loaders.
+    *** \param file_data Keeps the file content of archive entries. It must outlive the stream.
+    *** \return the stream, or nullptr if the file couldn't be opened.
+    **/
+    SDL_RWops* OpenRWops(const std::string& filename, FileData& file_data) const;
+
+    /** \brief Loads a Lua chunk from a file, the same way luaL_loadfile() does.
+    *** \return The Lua status code: 0 on success, with the chunk pushed on the stack.
+    **/
+    int LoadScript(lua_State* lua_state, const std::string& filename) const;
+
+    /** \brief Replaces the Lua 'loadfile' and 'dofile' functions so that they
+    *** read the scripts through the virtual file system.
+    **/
+    void BindScriptLoaders(lua_State* lua_state) const;
+
+    //! \brief Returns the archive path of a filename: e.g. "./data\a.png" -> "data/a.png"
+    static std::string NormalizePath(const std::string& filename);
+
+private:
+    VirtualFileSystem() {}
+
+    //! \brief The mounted archives, in mount order.
+    std::vector<private_system::PackedArchive*> _archives;
+
+    //! \brief Returns the archive entry of a file, and its archive.
+    const private_system::ArchiveEntry* _FindEntry(const std::string& filename,
+                                                   const private_system::PackedArchive** archive) const;
+};
+
+} // namespace vt_system
+
+#endif // __VIRTUAL_FILE_SYSTEM_HEADER__
@@ -32,6 +32,7 @@
 #include "engine/mode_manager.h"
 #include "engine/video/video.h"
 #include "engine/system.h"
+#include "engine/virtual_file_system.h"
 
 #include "common/global/global.h"
 #include "common/gui/gui.h"
@@ -344,6 +345,7 @@ static void InitializeEngine()
     }
 
     // Create and initialize singleton class managers
+    FileSystemManager = VirtualFileSystem::SingletonCreate();
     AudioManager = AudioEngine::SingletonCreate();
     InputManager = InputEngine::SingletonCreate();
     ScriptManager = ScriptEngine::SingletonCreate();
@@ -353,62 +355,151 @@ static void InitializeEngine()
     GUIManager = GUISystem::SingletonCreate();
     GlobalManager = GameGlobal::SingletonCreate();
 
-    if(!VideoManager->SingletonInitialize()) {
-        throw Exception("ERROR: unable to initialize VideoManager",
-                        __FILE__, __LINE__, __FUNCTION__);
-    }
+    // The startup is split into phases: The ones using OpenGL, OpenAL or the Lua state
+    // are run in order on the main thread, while the data files needed next are read
+    // by worker threads to have them in the system cache once actually loaded.
+    StartupSequence& startup = SystemManager->GetStartupSequence();
+
+    startup.AddPhase("prefetch_fonts", []() {
+        return StartupSequence::PrefetchDirectory("data/fonts", ".ttf");
+    }, {}, STARTUP_PHASE_WORKER);
+
+    startup.AddPhase("prefetch_gui", []() {
+        StartupSequence::PrefetchDirectory("data/gui/menus", ".png");
+        return StartupSequence::PrefetchDirectory("data/boot_menu", ".png");
+    }, {}, STARTUP_PHASE_WORKER);
+
+    startup.AddPhase("prefetch_global_data", []() {
+        StartupSequence::PrefetchDirectory("data/inventory", ".lua");
+        StartupSequence::PrefetchDirectory("data/inventory", ".png");
+        StartupSequence::PrefetchDirectory("data/skills", ".lua");
+        StartupSequence::PrefetchDirectory("data/entities", ".lua");
+        return StartupSequence::PrefetchDirectory("data/config", ".lua");
+    }, {}, STARTUP_PHASE_WORKER);
+
+    startup.AddPhase("file_system", []() {
+        // The data archive is optional, the files are read from the disk otherwise.
+        // The scripts aren't part of it and are always read from the disk.
+        if(vt_utils::DoesFileExist(DEFAULT_DATA_ARCHIVE)
+                && !FileSystemManager->MountArchive(DEFAULT_DATA_ARCHIVE))
+            PRINT_WARNING << "Invalid data archive, the data files will be read from the disk." << std::endl;
+        return true;
+    });
+
+    startup.AddPhase("video", []() {
+        if(!VideoManager->SingletonInitialize()) {
+            throw Exception("ERROR: unable to initialize VideoManager",
+                            __FILE__, __LINE__, __FUNCTION__);
+        }
+        return true;
+    }, { "file_system" });
 
-    if(!AudioManager->SingletonInitialize()) {
-        throw Exception("ERROR: unable to initialize AudioManager",
-                        __FILE__, __LINE__, __FUNCTION__);
-    }
+    startup.AddPhase("audio", []() {
+        if(!AudioManager->SingletonInitialize()) {
+            throw Exception("ERROR: unable to initialize AudioManager",
+                            __FILE__, __LINE__, __FUNCTION__);
+        }
+        return true;
+    }, { "file_system" });
 
-    if(!ScriptManager->SingletonInitialize()) {
-        throw Exception("ERROR: unable to initialize ScriptManager",
-                        __FILE__, __LINE__, __FUNCTION__);
-    }
+    startup.AddPhase("script", []() {
+        if(!ScriptManager->SingletonInitialize()) {
+            throw Exception("ERROR: unable to initialize ScriptManager",
+                            __FILE__, __LINE__, __FUNCTION__);
+        }
 
-    vt_defs::BindEngineCode();
-    vt_defs::BindCommonCode();
-    vt_defs::BindModeCode();
+        vt_defs::BindEngineCode();
+        vt_defs::BindCommonCode();
+        vt_defs::BindModeCode();
 
-    if(!SystemManager->SingletonInitialize()) {
-        throw Exception("ERROR: unable to initialize SystemManager",
-                        __FILE__, __LINE__, __FUNCTION__);
-    }
-    if(!InputManager->SingletonInitialize()) {
-        throw Exception("ERROR: unable to initialize InputManager",
-                        __FILE__, __LINE__, __FUNCTION__);
-    }
-    if(!ModeManager->SingletonInitialize()) {
-        throw Exception("ERROR: unable to initialize ModeManager",
-                        __FILE__, __LINE__, __FUNCTION__);
-    }
+        FileSystemManager->BindScriptLoaders(ScriptManager->GetGlobalState());
+        return true;
+    }, { "video", "audio" });
 
-    // Load all the settings from lua. This includes some engine configuration settings.
-    if(!LoadSettings())
-        throw Exception("ERROR: Unable to load settings file",
-                        __FILE__, __LINE__, __FUNCTION__);
+    startup.AddPhase("system", []() {
+        if(!SystemManager->SingletonInitialize()) {
+            throw Exception("ERROR: unable to initialize SystemManager",
+                            __FILE__, __LINE__, __FUNCTION__);
+        }
+        if(!InputManager->SingletonInitialize()) {
+            throw Exception("ERROR: unable to initialize InputManager",
+                            __FILE__, __LINE__, __FUNCTION__);
+        }
+        if(!ModeManager->SingletonInitialize()) {
+            throw Exception("ERROR: unable to initialize ModeManager",
+                            __FILE__, __LINE__, __FUNCTION__);
+        }
+        return true;
+    }, { "script" });
 
-    // Apply engine configuration settings with delayed initialization calls to the managers
-    InputManager->InitializeJoysticks();
+    startup.AddPhase("settings", []() {
+        // Load all the settings from lua. This includes some engine configuration settings.
+        if(!LoadSettings())
+            throw Exception("ERROR: Unable to load settings file",
+                            __FILE__, __LINE__, __FUNCTION__);
 
-    if(!VideoManager->FinalizeInitialization())
-        throw Exception("ERROR: Unable to apply video settings",
-                        __FILE__, __LINE__, __FUNCTION__);
+        // Load the optional memory budgets used by the debug memory report.
+        if(!SystemManager->GetMemoryAccounting().LoadBudgets("data/config/memory_budgets.lua"))
+            PRINT_WARNING << "Unable to load the memory budgets, they will be ignored." << std::endl;
 
-    // Loads the GUI skins.
-    LoadGUIThemes("data/config/themes.lua");
+        // Apply engine configuration settings with delayed initialization calls to the managers
+        InputManager->InitializeJoysticks();
 
-    // NOTE: This function call should have its argument set to false for release builds
-    GUIManager->DEBUG_EnableGUIOutlines(false);
+        if(!VideoManager->FinalizeInitialization())
+            throw Exception("ERROR: Unable to apply video settings",
+                            __FILE__, __LINE__, __FUNCTION__);
+        return true;
+    }, { "system" });
 
-    // Loads needed game text styles (fonts + colors + shadows)
-    if (!TextManager->LoadFonts(SystemManager->GetLanguageLocale()))
-        exit(EXIT_FAILURE);
+    startup.AddPhase("gui", []() {
+        // Loads the GUI skins.
+        LoadGUIThemes("data/config/themes.lua");
+
+        // NOTE: This function call should have its argument set to false for release builds
+        GUIManager->DEBUG_EnableGUIOutlines(false);
+
+        // Loads needed game text styles (fonts + colors + shadows)
+        if (!TextManager->LoadFonts(SystemManager->GetLanguageLocale()))
+            exit(EXIT_FAILURE);
 
-    // Loads potential emotes
-    GlobalManager->LoadEmotes("data/entities/emotes.lua");
+        // Loads potential emotes
+        GlobalManager->LoadEmotes("data/entities/emotes.lua");
+
+        if(!GUIManager->SingletonInitialize()) {
+            throw Exception("ERROR: unable to initialize GUIManager",
+                            __FILE__, __LINE__, __FUNCTION__);
+        }
+        return true;
+    }, { "settings" });
+
+    // This loads the game global script, once everything is ready,
+    // and will permit to load skills, items and other translatable strings
+    // using the correct settings language.
+    // It is deferred and split into steps, run one per frame, so that the boot intro
+    // keeps being animated while it is loading.
+    const char* global_step_names[GLOBAL_INIT_TOTAL] = {
+        "global_media", "global_battle_media", "global_inventory",
+        "global_skills", "global_entities", "global_config"
+    };
+    std::string previous_global_step = "gui";
+    for(uint32_t i = 0; i < GLOBAL_INIT_TOTAL; ++i) {
+        GLOBAL_INIT_STEP step = static_cast<GLOBAL_INIT_STEP>(i);
+        startup.AddPhase(global_step_names[i], [step]() {
+            if(!GlobalManager->InitializeStep(step))
+                throw Exception("ERROR: unable to initialize GlobalManager",
+                                __FILE__, __LINE__, __FUNCTION__);
+            return true;
+        }, { previous_global_step }, STARTUP_PHASE_DEFERRED);
+        previous_global_step = global_step_names[i];
+    }
+
+    if(!startup.Run())
+        throw Exception("ERROR: unable to run the startup sequence",
+                        __FILE__, __LINE__, __FUNCTION__);
+
+    // From now on, the Lua garbage is collected from the main loop.
+    SystemManager->GetScriptCollector().Initialize(ScriptManager->GetGlobalState());
+    SystemManager->GetScriptProfiler().Initialize(ScriptManager->GetGlobalState());
 
     // Hide the mouse cursor since we don't use or acknowledge mouse input from the user
     SDL_ShowCursor(SDL_DISABLE);
@@ -420,18 +511,6 @@ static void InitializeEngine()
     SDL_EventState(SDL_SYSWMEVENT, SDL_IGNORE);
     SDL_EventState(SDL_USEREVENT, SDL_IGNORE);
 
-    if(!GUIManager->SingletonInitialize()) {
-        throw Exception("ERROR: unable to initialize GUIManager",
-                        __FILE__, __LINE__, __FUNCTION__);
-    }
-
-    // This loads the game global script, once everything is ready,
-    // and will permit to load skills, items and other translatable strings
-    // using the correct settings language.
-    if(!GlobalManager->SingletonInitialize())
-        throw Exception("ERROR: unable to initialize GlobalManager",
-                        __FILE__, __LINE__, __FUNCTION__);
-
     SystemManager->InitializeTimers();
 }
 
@@ -556,6 +635,11 @@ int main(int argc, char* argv[])
     uint32_t update_tick = SDL_GetTicks();
     uint32_t next_update_tick = update_tick;
 
+    // The frame time, in microseconds, and the last game update duration,
+    // used to give the time left in the frame to the Lua garbage collector.
+    const uint64_t FRAME_TIME = 1000000 / UPDATES_PER_SECOND;
+    uint64_t last_update_time = 0;
+
     try {
         bool cpu_gentle_update_mode = true;
 
@@ -581,36 +665,82 @@ int main(int argc, char* argv[])
             // Render capped at UPDATES_PER_SECOND
             // if the update mode is gentle with the CPU(s).
             if (!cpu_gentle_update_mode || update_tick > next_update_tick) {
+                uint64_t frame_start = FrameTelemetry::GetMicroseconds();
 
-                // Clear the primary render target.
-                VideoManager->Clear();
+                {
+                    TelemetryScope draw_scope(TELEMETRY_DRAW_TIME);
 
-                // Draw the game.
-                ModeManager->Draw();
-                ModeManager->DrawEffects();
-                ModeManager->DrawPostEffects();
-                VideoManager->DrawFadeEffect();
-                VideoManager->DrawDebugInfo();
+                    // Clear the primary render target.
+                    VideoManager->Clear();
 
-                // Swap the buffers once the draw operations are done.
-                SDL_GL_SwapWindow(sdl_window);
+                    // Draw the game.
+                    ModeManager->Draw();
+                    ModeManager->DrawEffects();
+                    ModeManager->DrawPostEffects();
+                    VideoManager->DrawFadeEffect();
+                    VideoManager->DrawDebugInfo();
+                }
+
+                // Collect the Lua garbage while the GPU is busy drawing,
+                // the game update time being counted as already spent.
+                uint64_t frame_time = FrameTelemetry::GetMicroseconds() - frame_start + last_update_time;
+                SystemManager->GetScriptCollector().Step(frame_time < FRAME_TIME ?
+                                                         static_cast<uint32_t>(FRAME_TIME - frame_time) : 0);
+
+                {
+                    // The swap waits for the vertical synchronization, so it isn't counted as draw time.
+                    TelemetryScope swap_scope(TELEMETRY_SWAP_TIME);
+
+                    // Swap the buffers once the draw operations are done.
+                    SDL_GL_SwapWindow(sdl_window);
+                }
+
+                // Run the deferred startup phases once the boot mode has been drawn.
+                if (!SystemManager->IsStartupDone() &&
+                        ModeManager->GetGameType() != MODE_MANAGER_DUMMY_MODE) {
+                    if (!SystemManager->GetStartupSequence().UpdateDeferred())
+                        throw Exception("ERROR: a deferred startup phase failed",
+                                        __FILE__, __LINE__, __FUNCTION__);
+
+                    // Collect the garbage left by the data loading.
+                    if (SystemManager->IsStartupDone())
+                        SystemManager->GetScriptCollector().FullCollect();
+                }
 
                 // Update the game logic
 
                 // Update timers for correct time-based movement operation
                 SystemManager->UpdateTimers();
+                uint64_t update_start = FrameTelemetry::GetMicroseconds();
 
-                // Process all new events
-                InputManager->EventHandler();
+                {
+                    TelemetryScope update_scope(TELEMETRY_UPDATE_TIME);
 
-                // Update video
-                VideoManager->Update();
+                    // Process all new events
+                    InputManager->EventHandler();
 
-                // Update any streaming audio sources
-                AudioManager->Update();
+                    // Update video
+                    VideoManager->Update();
+                }
+
+                {
+                    TelemetryScope audio_scope(TELEMETRY_AUDIO_TIME);
+
+                    // Update any streaming audio sources
+                    AudioManager->Update();
+                }
 
-                // Update the game status
-                ModeManager->Update();
+                {
+                    TelemetryScope update_scope(TELEMETRY_UPDATE_TIME);
+
+                    // Update the game status
+                    ModeManager->Update();
+                }
+                last_update_time = FrameTelemetry::GetMicroseconds() - update_start;
+
+                // Store the frame telemetry sample, if recording.
+                SystemManager->GetTelemetry().EndFrame(SystemManager->GetUpdateTime(),
+                                                       ModeManager->GetGameType());
 
                 // Wait for the next update.
                 next_update_tick += SKIP_UPDATE_TICKS;
@@ -629,6 +759,18 @@ int main(int argc, char* argv[])
     // NOTE: Even if the singleton objects do not exist when this function is called, invoking the
     // static Destroy() singleton function will do no harm (it checks that the object exists before deleting it).
 
+    // Write the recorded telemetry samples, if any.
+    if (SystemManager && SystemManager->GetTelemetry().IsEnabled()) {
+        SystemManager->GetTelemetry().StopStreaming();
+        SystemManager->GetTelemetry().DumpToUserDataPath();
+    }
+
+    // Write the scripts profile, when profiling.
+    if (SystemManager && SystemManager->GetScriptProfiler().IsEnabled()) {
+        SystemManager->GetScriptProfiler().SetEnabled(false);
+        SystemManager->GetScriptProfiler().DumpToUserDataPath();
+    }
+
     // Delete the mode manager first so that all game modes free their resources
     ModeEngine::SingletonDestroy();
 
@@ -645,6 +787,8 @@ int main(int argc, char* argv[])
     // Do it last since all luabind objects must be freed
     // before closing the lua state.
     ScriptEngine::SingletonDestroy();
+    // The archives data may be used until then.
+    VirtualFileSystem::SingletonDestroy();
 
     // Once finished with OpenGL functions, the SDL_GLContext can be deleted.
     SDL_GL_DeleteContext(glcontext);
@@ -78,6 +78,26 @@ bool ParseProgramOptions(int32_t &return_code, int32_t argc, char* argv[])
             i++;
         } else if(options[i] == "--disable-audio") {
             vt_audio::AUDIO_ENABLE = false;
+        } else if(options[i] == "--telemetry") {
+            if((i + 1) >= options.size()) {
+                std::cerr << "Option " << options[i] << " requires an argument." << std::endl;
+                PrintUsage();
+                return_code = 1;
+                return false;
+            }
+            EnableTelemetry(atoi(options[i + 1].c_str()));
+            i++;
+        } else if(options[i] == "--lua-gc-budget") {
+            if((i + 1) >= options.size()) {
+                std::cerr << "Option " << options[i] << " requires an argument." << std::endl;
+                PrintUsage();
+                return_code = 1;
+                return false;
+            }
+            SetScriptCollectorBudget(static_cast<float>(atof(options[i + 1].c_str())));
+            i++;
+        } else if(options[i] == "--profile-scripts") {
+            vt_system::SCRIPT_PROFILER_ENABLE = true;
         } else if(options[i] == "-h" || options[i] == "--help") {
             PrintUsage();
             return_code = 0;
@@ -152,7 +172,15 @@ void PrintUsage()
             << "                       utils, video" << std::endl
             << "  --disable-audio   :: disables loading and playing audio" << std::endl
             << "  --help/-h         :: prints this help menu" << std::endl
+            << "  --telemetry <n>   :: records per-frame timings and counters, dumped in the" << std::endl
+            << "                       user data folder on exit. When <n> > 0, the samples" << std::endl
+            << "                       are also streamed to telemetry.csv every <n> frames" << std::endl
             << "  --info/-i         :: prints information about the user's system" << std::endl
+            << "  --lua-gc-budget <ms> :: the time given to the Lua garbage collector each" << std::endl
+            << "                       frame (default: 1). A negative value lets Lua collect" << std::endl
+            << "                       whenever it needs to" << std::endl
+            << "  --profile-scripts :: profiles the Lua scripts, the report being written" << std::endl
+            << "                       in the user data folder on exit" << std::endl
             << "  --reset/-r        :: resets game configuration to use default settings" << std::endl;
 }
 
@@ -363,4 +391,18 @@ bool EnableDebugging(const std::string &vars)
     return true;
 } // bool EnableDebugging(string vars)
 
+void EnableTelemetry(int32_t frames_interval)
+{
+    // The options are parsed before the engine creation:
+    // the system engine will start the recording once initialized.
+    vt_system::TELEMETRY_ENABLE = true;
+    vt_system::TELEMETRY_STREAM_INTERVAL = frames_interval > 0 ? static_cast<uint32_t>(frames_interval) : 0;
+}
+
+void SetScriptCollectorBudget(float budget)
+{
+    // Applied once the script engine is initialized.
+    vt_system::SCRIPT_GC_BUDGET = budget;
+}
+
 } // namespace vt_main
@@ -62,6 +62,17 @@ bool ResetSettings();
 **/
 bool EnableDebugging(const std::string& vars);
 
+/** \brief Enables the per-frame telemetry recording.
+*** \param frames_interval The number of frames between two writes of the samples
+*** in the telemetry stream file, or 0 to only dump the samples on exit.
+**/
+void EnableTelemetry(int32_t frames_interval);
+
+/** \brief Sets the time given to the Lua garbage collector each frame.
+*** \param budget The time in milliseconds, or a negative value to keep the Lua automatic collection.
+**/
+void SetScriptCollectorBudget(float budget);
+
 } // namespace vt_main
 
 #endif // __MAIN_OPTIONS_HEADER__
@@ -491,6 +491,10 @@ void BattleMode::AddEnemy(uint32_t new_enemy_id, float position_x, float positio
 
     BattleEnemy* new_battle_enemy = new BattleEnemy(new_enemy_id);
 
+    // Collect the garbage of the enemies scripts as they are loaded.
+    if (_state == BATTLE_STATE_INVALID)
+        SystemManager->GetScriptCollector().LoadStep();
+
     // Compute a position when needed.
     if (position_x == 0.0f && position_y == 0.0f) {
         uint32_t default_pos_id = _enemy_actors.size();
@@ -771,6 +775,7 @@ void BattleMode::_Initialize()
             new_actor->ChangeState(ACTOR_STATE_DEAD);
     }
     _command_supervisor->ConstructMenus();
+    SystemManager->GetScriptCollector().LoadStep();
 
     // Determine the origin position for all characters and enemies
     _DetermineActorLocations();
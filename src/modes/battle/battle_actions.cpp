@@ -128,6 +128,7 @@ bool SkillAction::ShouldShowSkillNotice() const
 void SkillAction::_InitAnimationScript()
 {
     try {
+        ScriptProfilerScope profiler_scope("battle_skill_init");
         luabind::call_function<void>(_init_function, _actor, _target, _skill);
     } catch(const luabind::error &err) {
         ScriptManager->HandleLuaError(err);
@@ -174,6 +175,7 @@ bool SkillAction::Update()
         return true;
 
     try {
+        ScriptProfilerScope profiler_scope("battle_skill_update");
         return luabind::call_function<bool>(_update_function);
     } catch(const luabind::error &err) {
         ScriptManager->HandleLuaError(err);
@@ -327,6 +329,7 @@ bool ItemAction::Update()
         return true;
 
     try {
+        ScriptProfilerScope profiler_scope("battle_item_update");
         return luabind::call_function<bool>(_update_function);
     } catch(const luabind::error& err) {
         ScriptManager->HandleLuaError(err);
@@ -364,6 +367,7 @@ bool ItemAction::Execute()
 
     bool ret = false;
     try {
+        ScriptProfilerScope profiler_scope("battle_item_execute");
         ret = luabind::call_function<bool>(script_function, _actor, _target);
     } catch(const luabind::error &err) {
         ScriptManager->HandleLuaError(err);
@@ -427,6 +431,7 @@ void ItemAction::_InitAnimationScript()
 {
     try {
         // N.B: _battle_item is a shared_ptr, but we need the actual pointer for luabind.
+        ScriptProfilerScope profiler_scope("battle_item_init");
         luabind::call_function<void>(_init_function, _actor, _target, _battle_item.get());
     } catch(const luabind::error& err) {
         ScriptManager->HandleLuaError(err);
@@ -212,6 +212,7 @@ void BattleActor::ChangeState(ACTOR_STATE new_state)
         // If an AI is used, it will change itself the actor state.
         if (_ai_decide_action.is_valid()) {
             try {
+                ScriptProfilerScope profiler_scope("battle_ai_decide");
                 luabind::call_function<void>(_ai_decide_action, BattleMode::CurrentInstance(), this);
             } catch(const luabind::error &e) {
                 PRINT_ERROR << "Error while triggering DecideAction() function of actor id: " << _global_actor->GetID() << std::endl;
@@ -275,6 +276,7 @@ void BattleActor::ChangeState(ACTOR_STATE new_state)
         // Init the death animation script when valid.
         if (_death_init.is_valid()) {
             try {
+                ScriptProfilerScope profiler_scope("battle_death_init");
                 luabind::call_function<void>(_death_init, BattleMode::CurrentInstance(), this);
             } catch(const luabind::error &e) {
                 PRINT_ERROR << "Error while triggering Initialize() function of actor id: " << _global_actor->GetID() << std::endl;
@@ -577,6 +579,7 @@ void BattleActor::Update()
         if (_death_init.is_valid() && _death_update.is_valid()) {
             // Change the state when the animation has finished.
             try {
+                ScriptProfilerScope profiler_scope("battle_death_update");
                 if (luabind::call_function<bool>(_death_update))
                     ChangeState(ACTOR_STATE_DEAD);
             } catch(const luabind::error &e) {
@@ -1311,6 +1314,7 @@ void BattleCharacter::DrawSprite()
 
     if(_state == ACTOR_STATE_DYING) {
         try {
+            ScriptProfilerScope profiler_scope("battle_death_draw");
             if (_death_draw_on_sprite.is_valid())
                 luabind::call_function<void>(_death_draw_on_sprite);
         } catch(const luabind::error &e) {
@@ -1601,6 +1605,7 @@ void BattleEnemy::ChangeState(ACTOR_STATE new_state)
         // Trigger the death sequence if it is valid
         if (_death_init.is_valid()) {
             try {
+                ScriptProfilerScope profiler_scope("battle_death_init");
                 luabind::call_function<void>(_death_init, BattleMode::CurrentInstance(), this);
             } catch(const luabind::error &e) {
                 PRINT_ERROR << "Error while triggering Initialize() function of enemy id: " << _global_actor->GetID() << std::endl;
@@ -1729,6 +1734,7 @@ void BattleEnemy::DrawSprite()
         _sprite_animations->at(GLOBAL_ENEMY_HURT_HEAVILY).Draw(Color(1.0f, 1.0f, 1.0f, _sprite_alpha));
 
         try {
+            ScriptProfilerScope profiler_scope("battle_death_draw");
             if (_death_draw_on_sprite.is_valid())
                 luabind::call_function<void>(_death_draw_on_sprite);
         } catch(const luabind::error &e) {
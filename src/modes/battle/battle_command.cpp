@@ -365,9 +365,10 @@ void ItemCommand::ResetItemList()
 {
     _battle_items.clear();
 
-    auto inv_items = GlobalManager->GetInventoryItems();
-    for (uint32_t i = 0; i < inv_items->size(); ++i) {
-        std::shared_ptr<GlobalItem> global_item = inv_items->at(i);
+    const std::vector<std::shared_ptr<GlobalObject>>& inv_items =
+        GlobalManager->GetInventory().GetView(ITEM_ITEM, INVENTORY_SORT_ID);
+    for (uint32_t i = 0; i < inv_items.size(); ++i) {
+        std::shared_ptr<GlobalItem> global_item = std::static_pointer_cast<GlobalItem>(inv_items[i]);
 
         // Only add non key and valid items as items available at battle start.
         if (global_item->GetCount() == 0)
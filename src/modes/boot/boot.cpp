@@ -167,6 +167,10 @@ void BootMode::Update()
     // Update the game mode generic members.
     GameMode::Update();
 
+    // Keep the intro while the game global data is still being loaded.
+    if(_boot_state != BOOT_STATE_INTRO && !SystemManager->IsStartupDone())
+        _boot_state = BOOT_STATE_INTRO;
+
     if(_exiting_to_new_game) {
         // When the fade out is done, we start a new game.
         if (!VideoManager->IsFading() && _new_game_called == false) {
@@ -380,12 +384,10 @@ void BootMode::DrawPostEffects()
 uint32_t BootMode::_GetNbSavesAvailable()
 {
     uint32_t savesAvailable = 0;
-    std::string data_path = GetUserDataPath();
     uint32_t max_slot_id = SystemManager->GetGameSaveSlots();
     for(uint32_t id = 0; id < max_slot_id; ++id) {
-        std::ostringstream f;
-        f << data_path + "saved_game_" << id << ".lua";
-        const std::string& filename = f.str();
+        // Either a binary save or a former Lua one.
+        const std::string filename = FindSaveFilename(id);
 
         if(DoesFileExist(filename)) {
             ++savesAvailable;
@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_collision_bitmap.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the packed map collision grid.
+*** ***************************************************************************/
+
+#include "modes/map/map_collision_bitmap.h"
+
+#include <algorithm>
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief The maximum distance to a wall kept.
+static const uint32_t MAX_WALL_DISTANCE = 255;
+
+void CollisionBitmap::Initialize(const std::vector<std::vector<uint32_t> >& collision_grid)
+{
+    _num_grid_y_axis = collision_grid.size();
+    _num_grid_x_axis = collision_grid.empty() ? 0 : collision_grid[0].size();
+    _row_words = (_num_grid_x_axis + 31) / 32;
+    _changed_elements.clear();
+
+    _bits.assign(_row_words * _num_grid_y_axis, 0);
+    for(uint32_t y = 0; y < _num_grid_y_axis; ++y) {
+        for(uint32_t x = 0; x < _num_grid_x_axis && x < collision_grid[y].size(); ++x) {
+            if(collision_grid[y][x] > 0)
+                _bits[y * _row_words + (x >> 5)] |= (1u << (x & 31));
+        }
+    }
+
+    // The summed-area table
+    uint32_t width = _num_grid_x_axis + 1;
+    _wall_sums.assign(width * (_num_grid_y_axis + 1), 0);
+    for(uint32_t y = 0; y < _num_grid_y_axis; ++y) {
+        uint32_t row_sum = 0;
+        for(uint32_t x = 0; x < _num_grid_x_axis; ++x) {
+            row_sum += IsWall(x, y) ? 1 : 0;
+            _wall_sums[(y + 1) * width + x + 1] = _wall_sums[y * width + x + 1] + row_sum;
+        }
+    }
+
+    // The distance field, with a forward and a backward pass over the grid.
+    _wall_distances.assign(_num_grid_x_axis * _num_grid_y_axis, 0);
+    for(uint32_t y = 0; y < _num_grid_y_axis; ++y) {
+        for(uint32_t x = 0; x < _num_grid_x_axis; ++x) {
+            if(IsWall(x, y))
+                continue;
+
+            // The outside of the map is a wall.
+            uint32_t distance = 1;
+            if(x > 0 && y > 0) {
+                distance = MAX_WALL_DISTANCE;
+                distance = std::min<uint32_t>(distance, _wall_distances[y * _num_grid_x_axis + x - 1] + 1);
+                distance = std::min<uint32_t>(distance, _wall_distances[(y - 1) * _num_grid_x_axis + x - 1] + 1);
+                distance = std::min<uint32_t>(distance, _wall_distances[(y - 1) * _num_grid_x_axis + x] + 1);
+                if(x + 1 < _num_grid_x_axis)
+                    distance = std::min<uint32_t>(distance, _wall_distances[(y - 1) * _num_grid_x_axis + x + 1] + 1);
+            }
+            _wall_distances[y * _num_grid_x_axis + x] = static_cast<uint8_t>(distance);
+        }
+    }
+    for(uint32_t y = _num_grid_y_axis; y-- > 0;) {
+        for(uint32_t x = _num_grid_x_axis; x-- > 0;) {
+            uint32_t distance = _wall_distances[y * _num_grid_x_axis + x];
+            if(distance == 0)
+                continue;
+
+            if(x + 1 >= _num_grid_x_axis || y + 1 >= _num_grid_y_axis) {
+                distance = 1;
+            }
+            else {
+                distance = std::min<uint32_t>(distance, _wall_distances[y * _num_grid_x_axis + x + 1] + 1);
+                distance = std::min<uint32_t>(distance, _wall_distances[(y + 1) * _num_grid_x_axis + x + 1] + 1);
+                distance = std::min<uint32_t>(distance, _wall_distances[(y + 1) * _num_grid_x_axis + x] + 1);
+                if(x > 0)
+                    distance = std::min<uint32_t>(distance, _wall_distances[(y + 1) * _num_grid_x_axis + x - 1] + 1);
+            }
+            _wall_distances[y * _num_grid_x_axis + x] = static_cast<uint8_t>(distance);
+        }
+    }
+}
+
+bool CollisionBitmap::HasWall(uint32_t left, uint32_t top, uint32_t right, uint32_t bottom) const
+{
+    int32_t wall_count = _GetLoadedWallCount(left, top, right, bottom);
+
+    // Count the changed elements in the rectangle, that aren't as loaded anymore.
+    for(uint32_t i = 0; i < _changed_elements.size(); ++i) {
+        uint32_t x = _changed_elements[i] % _num_grid_x_axis;
+        uint32_t y = _changed_elements[i] / _num_grid_x_axis;
+        if(x < left || x > right || y < top || y > bottom)
+            continue;
+        wall_count += IsWall(x, y) ? 1 : -1;
+    }
+
+    return wall_count > 0;
+}
+
+uint8_t CollisionBitmap::GetWallDistance(uint32_t x, uint32_t y) const
+{
+    uint32_t distance = _wall_distances[y * _num_grid_x_axis + x];
+
+    // The walls added since loaded may be nearer. The removed ones are simply ignored.
+    for(uint32_t i = 0; i < _changed_elements.size(); ++i) {
+        uint32_t wall_x = _changed_elements[i] % _num_grid_x_axis;
+        uint32_t wall_y = _changed_elements[i] / _num_grid_x_axis;
+        if(!IsWall(wall_x, wall_y))
+            continue;
+
+        uint32_t x_delta = (wall_x > x) ? wall_x - x : x - wall_x;
+        uint32_t y_delta = (wall_y > y) ? wall_y - y : y - wall_y;
+        distance = std::min(distance, std::max(x_delta, y_delta));
+    }
+
+    return static_cast<uint8_t>(distance);
+}
+
+bool CollisionBitmap::SetWall(uint32_t x, uint32_t y, bool wall)
+{
+    if(x >= _num_grid_x_axis || y >= _num_grid_y_axis)
+        return false;
+
+    if(IsWall(x, y) == wall)
+        return true;
+
+    uint32_t& word = _bits[y * _row_words + (x >> 5)];
+    if(wall)
+        word |= (1u << (x & 31));
+    else
+        word &= ~(1u << (x & 31));
+
+    // Keep track of the element while it isn't as loaded.
+    uint32_t index = y * _num_grid_x_axis + x;
+    bool loaded_wall = (_GetLoadedWallCount(x, y, x, y) > 0);
+    std::vector<uint32_t>::iterator it = std::find(_changed_elements.begin(), _changed_elements.end(), index);
+    if(wall != loaded_wall && it == _changed_elements.end())
+        _changed_elements.push_back(index);
+    else if(wall == loaded_wall && it != _changed_elements.end())
+        _changed_elements.erase(it);
+
+    return true;
+}
+
+} // namespace private_map
+
+} // namespace vt_map
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_collision_bitmap.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the packed map collision grid.
+*** ***************************************************************************/
+
+#ifndef __MAP_COLLISION_BITMAP_HEADER__
+#define __MAP_COLLISION_BITMAP_HEADER__
+
+#include <vector>
+#include <cstdint>
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+/** ****************************************************************************
+*** \brief The map collision grid walls, packed one bit per element.
+***
+*** Along with the bits, the number of walls above and to the left of each
+*** element is kept (a summed-area table), so that whether a rectangle of
+*** elements holds any wall is known with four lookups, and the distance from
+*** each element to the nearest wall is kept as well.
+***
+*** Both are computed once from the loaded collision grid. The elements changed
+*** afterwards are kept in a small list, taken in account by every query.
+*** ***************************************************************************/
+class CollisionBitmap
+{
+public:
+    CollisionBitmap() :
+        _num_grid_x_axis(0),
+        _num_grid_y_axis(0),
+        _row_words(0)
+    {}
+
+    //! \brief Packs the collision grid, where any value above 0 is a wall.
+    void Initialize(const std::vector<std::vector<uint32_t> >& collision_grid);
+
+    //! \brief Tells whether the given element is a wall. It must be within the grid.
+    bool IsWall(uint32_t x, uint32_t y) const {
+        return (_bits[y * _row_words + (x >> 5)] >> (x & 31)) & 1;
+    }
+
+    /** \brief Tells whether any element of the given rectangle is a wall.
+    *** The bounds are included, and must be within the grid.
+    **/
+    bool HasWall(uint32_t left, uint32_t top, uint32_t right, uint32_t bottom) const;
+
+    /** \brief Returns the number of elements to go through to reach the nearest wall,
+    *** diagonally or not, the outside of the map being a wall: 1 for the elements next
+    *** to a wall, and 0 for the walls. It is capped to 255.
+    **/
+    uint8_t GetWallDistance(uint32_t x, uint32_t y) const;
+
+    //! \brief Returns the bits, row after row, each row starting on a new 32 bits word.
+    const std::vector<uint32_t>& GetBits() const {
+        return _bits;
+    }
+
+    //! \brief Returns the number of 32 bits words per row.
+    uint32_t GetRowWords() const {
+        return _row_words;
+    }
+
+    /** \brief Changes whether an element is a wall.
+    *** \return false if the element is out of the grid.
+    **/
+    bool SetWall(uint32_t x, uint32_t y, bool wall);
+
+private:
+    uint32_t _num_grid_x_axis;
+    uint32_t _num_grid_y_axis;
+
+    //! \brief The number of 32 bits words per row.
+    uint32_t _row_words;
+
+    //! \brief One bit per element, set for the walls.
+    std::vector<uint32_t> _bits;
+
+    /** \brief The number of loaded walls above and to the left of each element,
+    *** with an extra row and column of zeros on top and on the left.
+    **/
+    std::vector<uint32_t> _wall_sums;
+
+    //! \brief The distance of each element to the nearest loaded wall.
+    std::vector<uint8_t> _wall_distances;
+
+    //! \brief The indices of the elements changed since loaded.
+    std::vector<uint32_t> _changed_elements;
+
+    //! \brief Returns the number of loaded walls in the given rectangle, bounds included.
+    uint32_t _GetLoadedWallCount(uint32_t left, uint32_t top, uint32_t right, uint32_t bottom) const {
+        uint32_t width = _num_grid_x_axis + 1;
+        return _wall_sums[(bottom + 1) * width + right + 1] - _wall_sums[top * width + right + 1]
+               - _wall_sums[(bottom + 1) * width + left] + _wall_sums[top * width + left];
+    }
+};
+
+} // namespace private_map
+
+} // namespace vt_map
+
+#endif // __MAP_COLLISION_BITMAP_HEADER__
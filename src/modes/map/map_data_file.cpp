@@ -0,0 +1,255 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_data_file.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the compiled map data files.
+*** ***************************************************************************/
+
+#include "modes/map/map_data_file.h"
+
+#include "modes/map/map_utils.h"
+#include "modes/map/map_path_hierarchy.h"
+
+#include "engine/binary_utils.h"
+
+#include <SDL2/SDL_endian.h>
+
+#include <zlib.h>
+
+#include <cstring>
+
+using namespace vt_system;
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief The compiled map data header size, in bytes.
+const uint32_t MAP_DATA_HEADER_SIZE = 48;
+
+//! \brief Returns the offset aligned on 4 bytes.
+static size_t _Align(size_t offset)
+{
+    return (offset + 3) & ~static_cast<size_t>(3);
+}
+
+MapDataFile::MapDataFile():
+    _num_tile_cols(0),
+    _num_tile_rows(0),
+    _num_grid_cols(0),
+    _num_grid_rows(0),
+    _collision_bitmap(nullptr),
+    _collision_row_size(0)
+{}
+
+MapDataFile::~MapDataFile()
+{
+    _ClearCollisions();
+}
+
+bool MapDataFile::Open(const std::string& filename, const std::string& source_filename)
+{
+    Close();
+
+    if (!FileSystemManager->DoesFileExist(filename))
+        return false;
+
+    if (!FileSystemManager->ReadFile(filename, _file_data)
+            || _file_data.GetSize() < MAP_DATA_HEADER_SIZE
+            || memcmp(_file_data.GetData(), "VTMP", 4) != 0) {
+        PRINT_WARNING << "Invalid compiled map data file: " << filename << std::endl;
+        Close();
+        return false;
+    }
+
+    const uint8_t* header = _file_data.GetData();
+    uint32_t version = ReadUInt32(header + 4);
+    if (version != MAP_DATA_VERSION) {
+        IF_PRINT_WARNING(MAP_DEBUG) << "Unsupported compiled map data version " << version
+                                    << " in: " << filename << std::endl;
+        Close();
+        return false;
+    }
+
+    // The compiled file is ignored once the Lua file has been edited.
+    if (FileSystemManager->DoesFileExist(source_filename)) {
+        FileData source;
+        if (!FileSystemManager->ReadFile(source_filename, source)
+                || source.GetSize() != ReadUInt32(header + 12)
+                || ComputeHash(source.GetData(), source.GetSize()) != ReadUInt64(header + 16)) {
+            IF_PRINT_WARNING(MAP_DEBUG) << "Outdated compiled map data file: " << filename
+                                        << ", loading: " << source_filename << std::endl;
+            Close();
+            return false;
+        }
+    }
+
+    uint32_t flags = ReadUInt32(header + 8);
+    _num_tile_cols = ReadUInt16(header + 24);
+    _num_tile_rows = ReadUInt16(header + 26);
+    _num_grid_cols = ReadUInt16(header + 28);
+    _num_grid_rows = ReadUInt16(header + 30);
+    uint32_t number_tilesets = ReadUInt32(header + 32);
+    uint32_t number_layers = ReadUInt32(header + 36);
+    uint32_t body_size = ReadUInt32(header + 40);
+    uint32_t uncompressed_size = ReadUInt32(header + 44);
+
+    if (MAP_DATA_HEADER_SIZE + static_cast<size_t>(body_size) > _file_data.GetSize()) {
+        PRINT_WARNING << "Truncated compiled map data file: " << filename << std::endl;
+        Close();
+        return false;
+    }
+
+    const uint8_t* body = header + MAP_DATA_HEADER_SIZE;
+    size_t size = body_size;
+    if (flags & MAP_DATA_COMPRESSED) {
+        _body_buffer.resize(uncompressed_size);
+        uLongf destination_size = static_cast<uLongf>(uncompressed_size);
+        if (uncompress(&_body_buffer[0], &destination_size, body, static_cast<uLong>(body_size)) != Z_OK
+                || destination_size != uncompressed_size) {
+            PRINT_WARNING << "Couldn't uncompress the map data file: " << filename << std::endl;
+            Close();
+            return false;
+        }
+        body = &_body_buffer[0];
+        size = uncompressed_size;
+    }
+
+    if (!_ReadBody(body, size, number_tilesets, number_layers)) {
+        PRINT_WARNING << "Truncated compiled map data file: " << filename << std::endl;
+        Close();
+        return false;
+    }
+
+    _filename = filename;
+    return true;
+}
+
+void MapDataFile::Close()
+{
+    _filename.clear();
+    _file_data.Clear();
+    _body_buffer.clear();
+    _num_tile_cols = 0;
+    _num_tile_rows = 0;
+    _num_grid_cols = 0;
+    _num_grid_rows = 0;
+    _tileset_filenames.clear();
+    _collision_bitmap = nullptr;
+    _collision_row_size = 0;
+    _layer_types.clear();
+    _layer_tiles.clear();
+    _ClearCollisions();
+}
+
+std::string MapDataFile::GetCompiledFilename(const std::string& map_data_filename)
+{
+    size_t extension = map_data_filename.rfind(".lua");
+    if (extension == std::string::npos || extension + 4 != map_data_filename.size())
+        return map_data_filename + MAP_DATA_EXTENSION;
+    return map_data_filename.substr(0, extension) + MAP_DATA_EXTENSION;
+}
+
+void MapDataFile::ReadCollisionRow(uint16_t y, std::vector<uint32_t>& row) const
+{
+    row.resize(_num_grid_cols);
+    const uint8_t* bits = _collision_bitmap + static_cast<size_t>(y) * _collision_row_size;
+    for (uint16_t x = 0; x < _num_grid_cols; ++x)
+        row[x] = (bits[x >> 3] >> (x & 7)) & 1;
+}
+
+void MapDataFile::ReadLayerRow(uint32_t layer_id, uint16_t y, std::vector<int16_t>& row) const
+{
+    row.resize(_num_tile_cols);
+    if (_num_tile_cols == 0)
+        return;
+
+    const uint8_t* tiles = _layer_tiles[layer_id] + static_cast<size_t>(y) * _num_tile_cols * sizeof(int16_t);
+    memcpy(&row[0], tiles, _num_tile_cols * sizeof(int16_t));
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+    for (uint16_t x = 0; x < _num_tile_cols; ++x)
+        row[x] = static_cast<int16_t>(SDL_SwapLE16(static_cast<uint16_t>(row[x])));
+#endif
+}
+
+bool MapDataFile::_ReadBody(const uint8_t* body, size_t body_size, uint32_t number_tilesets, uint32_t number_layers)
+{
+    size_t offset = 0;
+
+    for (uint32_t i = 0; i < number_tilesets; ++i) {
+        if (offset + 2 > body_size)
+            return false;
+        uint16_t length = ReadUInt16(body + offset);
+        offset += 2;
+        if (offset + length > body_size)
+            return false;
+        _tileset_filenames.push_back(std::string(reinterpret_cast<const char*>(body + offset), length));
+        offset += length;
+    }
+    offset = _Align(offset);
+
+    _collision_row_size = (_num_grid_cols + 7) / 8;
+    _collision_bitmap = body + offset;
+    offset = _Align(offset + static_cast<size_t>(_collision_row_size) * _num_grid_rows);
+    if (offset > body_size)
+        return false;
+
+    size_t layer_size = static_cast<size_t>(_num_tile_cols) * _num_tile_rows * sizeof(int16_t);
+    for (uint32_t i = 0; i < number_layers; ++i) {
+        if (offset + 4 + layer_size > body_size)
+            return false;
+        _layer_types.push_back(ReadUInt32(body + offset));
+        _layer_tiles.push_back(body + offset + 4);
+        offset = _Align(offset + 4 + layer_size);
+    }
+    return true;
+}
+
+void MapDataFile::BuildCollisions(const std::vector<std::pair<float, float> >& collision_sizes)
+{
+    _ClearCollisions();
+
+    _collision_grid.resize(_num_grid_rows);
+    for(uint16_t y = 0; y < _num_grid_rows; ++y)
+        ReadCollisionRow(y, _collision_grid[y]);
+    _walls.Initialize(_collision_grid);
+
+    for(uint32_t i = 0; i < collision_sizes.size(); ++i) {
+        PathHierarchy*& hierarchy = _hierarchies[collision_sizes[i]];
+        if(!hierarchy)
+            hierarchy = new PathHierarchy(_walls, _num_grid_cols, _num_grid_rows,
+                                          collision_sizes[i].first, collision_sizes[i].second);
+    }
+}
+
+void MapDataFile::TakeCollisions(std::vector<std::vector<uint32_t> >& collision_grid, CollisionBitmap& walls,
+                                 std::map<std::pair<float, float>, PathHierarchy*>& hierarchies)
+{
+    collision_grid.swap(_collision_grid);
+    std::swap(walls, _walls);
+    hierarchies.swap(_hierarchies);
+    _ClearCollisions();
+}
+
+void MapDataFile::_ClearCollisions()
+{
+    for(std::map<std::pair<float, float>, PathHierarchy*>::iterator it = _hierarchies.begin(); it != _hierarchies.end(); ++it)
+        delete it->second;
+    _hierarchies.clear();
+    _collision_grid.clear();
+    _walls = CollisionBitmap();
+}
+
+} // namespace private_map
+
+} // namespace vt_map
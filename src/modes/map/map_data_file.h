@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_data_file.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the compiled map data files.
+***
+*** The map data Lua files (e.g. data/story/.../xxx_map.lua) can be compiled
+*** into a binary file next to them (xxx_map.vtmap) using tools/compile_maps.py.
+*** The binary file is read through the virtual file system, in place when
+*** possible, and is only used when it matches the Lua file it was compiled
+*** from. The Lua file remains the one to edit, and is loaded otherwise.
+***
+*** File format (little endian):
+*** - Header: char[4] "VTMP", uint32 version, uint32 flags, uint32 source size,
+***   uint64 source hash (see vt_system::ComputeHash()),
+***   uint16 tile columns, uint16 tile rows, uint16 grid columns, uint16 grid rows,
+***   uint32 tilesets count, uint32 layers count, uint32 body size, uint32 uncompressed body size.
+*** - Body, zlib compressed when MAP_DATA_COMPRESSED is set:
+***   - The tileset filenames: uint16 length, char[length] filename, each.
+***   - The collision grid bitmap: one bit per cell, (grid columns + 7) / 8 bytes per row.
+***   - The layers: uint32 layer type, int16 tiles[tile rows][tile columns], each.
+***   Each of these parts is aligned on 4 bytes.
+*** ***************************************************************************/
+
+#ifndef __MAP_DATA_FILE_HEADER__
+#define __MAP_DATA_FILE_HEADER__
+
+#include "modes/map/map_collision_bitmap.h"
+
+#include "engine/virtual_file_system.h"
+
+#include <map>
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief The compiled map data files extension.
+const std::string MAP_DATA_EXTENSION = ".vtmap";
+
+//! \brief The compiled map data format version handled.
+const uint32_t MAP_DATA_VERSION = 1;
+
+//! \brief The compiled map data body is compressed using zlib.
+const uint32_t MAP_DATA_COMPRESSED = 0x1;
+
+class PathHierarchy;
+
+/** ****************************************************************************
+*** \brief A compiled map data file, holding the tile layers and the collision grid.
+***
+*** When the map is loaded in the background, the collision grid, its walls
+*** bitmap and the path hierarchies are built on the map loader worker thread
+*** as well, and handed over to the map objects along with the file.
+*** ***************************************************************************/
+class MapDataFile
+{
+public:
+    MapDataFile();
+
+    //! \brief Frees the path hierarchies not taken.
+    ~MapDataFile();
+
+    /** \brief Opens a compiled map data file.
+    *** \param filename The compiled file to open.
+    *** \param source_filename The Lua file it was compiled from. When it exists,
+    *** the compiled file is only used if it matches its content.
+    *** \return false if the file doesn't exist, is outdated or invalid.
+    **/
+    bool Open(const std::string& filename, const std::string& source_filename);
+
+    void Close();
+
+    //! \brief Returns the compiled file of a map data file: e.g. "xxx_map.lua" -> "xxx_map.vtmap"
+    static std::string GetCompiledFilename(const std::string& map_data_filename);
+
+    const std::string& GetFilename() const {
+        return _filename;
+    }
+
+    uint16_t GetNumTileCols() const {
+        return _num_tile_cols;
+    }
+
+    uint16_t GetNumTileRows() const {
+        return _num_tile_rows;
+    }
+
+    uint16_t GetNumGridCols() const {
+        return _num_grid_cols;
+    }
+
+    uint16_t GetNumGridRows() const {
+        return _num_grid_rows;
+    }
+
+    const std::vector<std::string>& GetTilesetFilenames() const {
+        return _tileset_filenames;
+    }
+
+    uint32_t GetNumberLayers() const {
+        return static_cast<uint32_t>(_layer_types.size());
+    }
+
+    //! \brief Returns the layer type, as a LAYER_TYPE value.
+    uint32_t GetLayerType(uint32_t layer_id) const {
+        return _layer_types[layer_id];
+    }
+
+    //! \brief Copies a collision grid row: 1 for a blocked cell, 0 otherwise.
+    void ReadCollisionRow(uint16_t y, std::vector<uint32_t>& row) const;
+
+    //! \brief Copies a row of layer tile indices.
+    void ReadLayerRow(uint32_t layer_id, uint16_t y, std::vector<int16_t>& row) const;
+
+    /** \brief Builds the collision grid, its walls bitmap, and the path hierarchies
+    *** of the given sprite collision sizes. Called by the map loader worker thread.
+    **/
+    void BuildCollisions(const std::vector<std::pair<float, float> >& collision_sizes);
+
+    //! \brief Tells whether the collisions were built, and not taken yet.
+    bool AreCollisionsBuilt() const {
+        return !_collision_grid.empty();
+    }
+
+    /** \brief Gives the built collisions away. The caller takes the ownership of the hierarchies,
+    *** given by sprite collision size.
+    **/
+    void TakeCollisions(std::vector<std::vector<uint32_t> >& collision_grid, CollisionBitmap& walls,
+                        std::map<std::pair<float, float>, PathHierarchy*>& hierarchies);
+
+private:
+    std::string _filename;
+
+    //! \brief The file content.
+    vt_system::FileData _file_data;
+
+    //! \brief The uncompressed body, when the body was compressed.
+    std::vector<uint8_t> _body_buffer;
+
+    uint16_t _num_tile_cols;
+    uint16_t _num_tile_rows;
+    uint16_t _num_grid_cols;
+    uint16_t _num_grid_rows;
+
+    std::vector<std::string> _tileset_filenames;
+
+    //! \brief The collision grid bitmap start, and its row size in bytes.
+    const uint8_t* _collision_bitmap;
+    uint32_t _collision_row_size;
+
+    //! \brief The layer types, and their tile indices start.
+    std::vector<uint32_t> _layer_types;
+    std::vector<const uint8_t*> _layer_tiles;
+
+    //! \brief The collisions built by BuildCollisions(), until taken.
+    std::vector<std::vector<uint32_t> > _collision_grid;
+    CollisionBitmap _walls;
+    std::map<std::pair<float, float>, PathHierarchy*> _hierarchies;
+
+    //! \brief Deletes the collisions built, if any.
+    void _ClearCollisions();
+
+    //! \brief Reads the body parts. Returns false if the body is truncated.
+    bool _ReadBody(const uint8_t* body, size_t body_size, uint32_t number_tilesets, uint32_t number_layers);
+
+    MapDataFile(const MapDataFile&) = delete;
+    MapDataFile& operator=(const MapDataFile&) = delete;
+};
+
+} // namespace private_map
+
+} // namespace vt_map
+
+#endif // __MAP_DATA_FILE_HEADER__
@@ -15,6 +15,8 @@
 
 #include "engine/system.h"
 
+#include <algorithm>
+
 namespace vt_map
 {
 
@@ -486,6 +488,20 @@ MapEvent *EventSupervisor::GetEvent(const std::string &event_id) const
         return it->second;
 }
 
+std::vector<std::string> EventSupervisor::GetTransitionMapFilenames() const
+{
+    std::vector<std::string> filenames;
+    for(std::map<std::string, MapEvent *>::const_iterator it = _all_events.begin(); it != _all_events.end(); ++it) {
+        if(it->second->GetEventType() != MAP_TRANSITION_EVENT)
+            continue;
+
+        const std::string& filename = static_cast<MapTransitionEvent *>(it->second)->GetTransitionMapDataFilename();
+        if(std::find(filenames.begin(), filenames.end(), filename) == filenames.end())
+            filenames.push_back(filename);
+    }
+    return filenames;
+}
+
 bool EventSupervisor::_RegisterEvent(MapEvent* new_event)
 {
     if(new_event == nullptr) {
@@ -138,6 +138,9 @@ public:
     bool DoesEventExist(const std::string& event_id) const
     { return !(GetEvent(event_id) == nullptr); }
 
+    //! \brief Returns the data filenames of the maps the transition events lead to, without duplicates.
+    std::vector<std::string> GetTransitionMapFilenames() const;
+
 private:
     //! \brief A container for all map events, where the event's ID serves as the key to the std::map
     std::map<std::string, MapEvent*> _all_events;
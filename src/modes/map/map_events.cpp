@@ -23,6 +23,7 @@
 #include "modes/map/map_dialogues/map_sprite_dialogue.h"
 
 #include "modes/map/map_mode.h"
+#include "modes/map/map_loader.h"
 #include "modes/map/map_sprites/map_sprite.h"
 
 #include "modes/shop/shop.h"
@@ -195,6 +196,13 @@ void MapTransitionEvent::_Start()
 
     VideoManager->_StartTransitionFadeOut(Color::black, MAP_FADE_OUT_TIME);
     _done = false;
+
+    // Load the map data and tileset images in the background while fading out,
+    // along with the path hierarchies of the sprites sizes used on this map.
+    MapMode* map_mode = MapMode::CurrentInstance();
+    std::vector<std::pair<float, float> > collision_sizes;
+    map_mode->GetObjectSupervisor()->GetPathCollisionSizes(collision_sizes);
+    map_mode->GetMapLoader()->LoadMap(_transition_map_data_filename, collision_sizes);
 }
 
 bool MapTransitionEvent::_Update()
@@ -205,10 +213,19 @@ bool MapTransitionEvent::_Update()
     // Only load the map once the fade out is done, since the load time can
     // break the fade smoothness and visible duration.
     if(!_done) {
+        // Wait for the background loading to end, telling it when it takes longer than the fade.
+        MapLoader* map_loader = MapMode::CurrentInstance()->GetMapLoader();
+        if(!map_loader->IsMapLoaded(_transition_map_data_filename)) {
+            VideoManager->_ShowLoadingIndicator(true);
+            return false;
+        }
+        VideoManager->_ShowLoadingIndicator(false);
+
         vt_global::GlobalManager->SetPreviousLocation(_transition_origin);
         MapMode* MM = new MapMode(_transition_map_data_filename,
                                   _transition_map_script_filename,
-                                  MapMode::CurrentInstance()->GetStamina());
+                                  MapMode::CurrentInstance()->GetStamina(), true,
+                                  map_loader->TakeMapData(_transition_map_data_filename));
         ModeManager->Pop();
         ModeManager->Push(MM, false, true);
         _done = true;
@@ -317,6 +334,7 @@ void IfEvent::_Start()
     EventSupervisor* events = MapMode::CurrentInstance()->GetEventSupervisor();
 
     try {
+        ScriptProfilerScope profiler_scope("map_event_check");
         // We had a timer of 100ms her to avoid launching an event within an event
         // for the sake of the engine loop. That time is unnoticeable, anyway.
         if (luabind::call_function<bool>(_check_function)
@@ -375,6 +393,7 @@ void ScriptedEvent::_Start()
         return;
 
     try {
+        ScriptProfilerScope profiler_scope("map_event_start");
         luabind::call_function<void>(_start_function);
     } catch(const luabind::error &e) {
         PRINT_ERROR << "Error while loading ScriptedEvent start function"
@@ -393,6 +412,7 @@ bool ScriptedEvent::_Update()
         return true;
 
     try {
+        ScriptProfilerScope profiler_scope("map_event_update");
         return luabind::call_function<bool>(_update_function);
     } catch(const luabind::error &e) {
         PRINT_ERROR << "Error while loading ScriptedEvent update function"
@@ -482,14 +502,17 @@ ScriptedSpriteEvent* ScriptedSpriteEvent::Create(const std::string& event_id,
 void ScriptedSpriteEvent::_Start()
 {
     SpriteEvent::_Start();
-    if(_start_function.is_valid())
+    if(_start_function.is_valid()) {
+        ScriptProfilerScope profiler_scope("map_sprite_event_start");
         luabind::call_function<void>(_start_function, _sprite);
+    }
 }
 
 bool ScriptedSpriteEvent::_Update()
 {
     bool finished = false;
     if(_update_function.is_valid()) {
+        ScriptProfilerScope profiler_scope("map_sprite_event_update");
         finished = luabind::call_function<bool>(_update_function, _sprite);
     } else {
         finished = true;
@@ -606,6 +629,7 @@ PathMoveSpriteEvent::PathMoveSpriteEvent(const std::string& event_id,
     _last_position(0.0f, 0.0f),
     _current_node_pos(0.0f, 0.0f),
     _current_node(0),
+    _path_request(0),
     _run(run)
 {}
 
@@ -619,6 +643,7 @@ PathMoveSpriteEvent::PathMoveSpriteEvent(const std::string& event_id,
     _last_position(0.0f, 0.0f),
     _current_node_pos(0.0f, 0.0f),
     _current_node(0),
+    _path_request(0),
     _run(run)
 {}
 
@@ -682,25 +707,40 @@ void PathMoveSpriteEvent::_Start()
     }
 
     // If the sprite is at the destination, we don't have to compute anything
+    _path.clear();
     if (_sprite->GetPosition() == _destination)
         return;
 
-    _path = MapMode::CurrentInstance()->GetObjectSupervisor()->FindPath(_sprite,
-                                                                        _destination);
-    if(_path.empty()) {
+    // The path is searched in the background, and the sprite starts moving once it is found.
+    _path_request = MapMode::CurrentInstance()->GetObjectSupervisor()->RequestPath(_sprite,
+                                                                                   _destination);
+    if(_path_request == 0) {
         PRINT_ERROR << "No path to destination (" << _destination.x
                     << ", " << _destination.y << ") for sprite: "
                     << _sprite->GetObjectID() << std::endl;
-        return;
     }
-
-    _current_node_pos = _path[_current_node];
-
-    _sprite->SetMoving(true);
 }
 
 bool PathMoveSpriteEvent::_Update()
 {
+    if(_path_request != 0) {
+        ObjectSupervisor* object_supervisor = MapMode::CurrentInstance()->GetObjectSupervisor();
+        PATH_REQUEST_STATE state = object_supervisor->GetRequestedPath(_path_request, _path);
+        if(state == PATH_REQUEST_PENDING)
+            return false;
+        _path_request = 0;
+
+        if(_path.empty()) {
+            PRINT_ERROR << "No path to destination (" << _destination.x
+                        << ", " << _destination.y << ") for sprite: "
+                        << _sprite->GetObjectID() << std::endl;
+        }
+        else {
+            _current_node_pos = _path[_current_node];
+            _sprite->SetMoving(true);
+        }
+    }
+
     if(_path.empty()) {
         // No path
         Terminate();
@@ -740,6 +780,10 @@ bool PathMoveSpriteEvent::_Update()
 
 void PathMoveSpriteEvent::Terminate()
 {
+    if(_path_request != 0) {
+        MapMode::CurrentInstance()->GetObjectSupervisor()->CancelPathRequest(_path_request);
+        _path_request = 0;
+    }
     _sprite->SetMoving(false);
     SpriteEvent::Terminate();
 }
@@ -432,6 +432,10 @@ public:
                                       const std::string& script_filename,
                                       const std::string& coming_from);
 
+    const std::string& GetTransitionMapDataFilename() const {
+        return _transition_map_data_filename;
+    }
+
 protected:
     //! \brief Begins the transition process by fading out the screen and music
     void _Start() override;
@@ -919,10 +923,13 @@ protected:
     //! \brief Holds the path needed to traverse from source to destination
     Path _path;
 
+    //! \brief The ticket of the path requested to the object supervisor, or 0 once the path is known.
+    uint32_t _path_request;
+
     //! \brief Tells whether the sprite should use the walk or run animation
     bool _run;
 
-    //! \brief Calculates a path for the sprite to move to the destination
+    //! \brief Requests a path for the sprite to move to the destination
     void _Start();
 
     //! \brief Returns true when the sprite has reached the destination
@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_flow_field.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the flow field leading the enemies to the camera.
+*** ***************************************************************************/
+
+#include "modes/map/map_flow_field.h"
+
+#include "modes/map/map_path_hierarchy.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace vt_common;
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief The cost of the places not leading to the target.
+static const uint32_t UNREACHABLE_COST = std::numeric_limits<uint32_t>::max();
+
+//! \brief The highest cost from which the sprites head straight to the target: one diagonal step.
+static const uint32_t STRAIGHT_CHASE_COST = 14;
+
+//! \brief The relative coordinates of the eight adjacent elements, lateral ones first.
+static const int32_t ADJACENT_NODES[8][2] = {
+    { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 },
+    { -1, -1 }, { -1, 1 }, { 1, -1 }, { 1, 1 }
+};
+
+ChaseFlowField::ChaseFlowField(const PathHierarchy* hierarchy) :
+    _hierarchy(hierarchy),
+    _target_x(-1),
+    _target_y(-1),
+    _left(0),
+    _top(0),
+    _width(0),
+    _height(0)
+{}
+
+void ChaseFlowField::SetTarget(const Position2D& target)
+{
+    int32_t target_x = static_cast<int32_t>(target.x);
+    int32_t target_y = static_cast<int32_t>(target.y);
+    if(target_x == _target_x && target_y == _target_y)
+        return;
+
+    _target_x = target_x;
+    _target_y = target_y;
+
+    // Cover the area where the hostile enemies are updated.
+    int32_t half_width = static_cast<int32_t>(SCREEN_GRID_X_LENGTH) + 1;
+    int32_t half_height = static_cast<int32_t>(SCREEN_GRID_Y_LENGTH) + 1;
+    _left = target_x - half_width;
+    _top = target_y - half_height;
+    _width = 2 * half_width + 1;
+    _height = 2 * half_height + 1;
+    _costs.assign(_width * _height, UNREACHABLE_COST);
+
+    // Dijkstra's algorithm from the target, the open nodes being ordered by cost only.
+    _open_nodes.clear();
+    _costs[(target_y - _top) * _width + target_x - _left] = 0;
+    _open_nodes.push_back(PathOpenNode((target_y - _top) * _width + target_x - _left, 0, 0));
+    while(!_open_nodes.empty()) {
+        std::pop_heap(_open_nodes.begin(), _open_nodes.end());
+        PathOpenNode best_node = _open_nodes.back();
+        _open_nodes.pop_back();
+
+        if(best_node.g_score > _costs[best_node.index])
+            continue;
+
+        int32_t best_x = _left + best_node.index % _width;
+        int32_t best_y = _top + best_node.index / _width;
+        for(uint32_t i = 0; i < 8; ++i) {
+            int32_t node_x = best_x + ADJACENT_NODES[i][0];
+            int32_t node_y = best_y + ADJACENT_NODES[i][1];
+            if(node_x < _left || node_x >= _left + _width || node_y < _top || node_y >= _top + _height)
+                continue;
+
+            if(node_x < 0 || node_y < 0 || !_hierarchy->IsWalkable(node_x, node_y))
+                continue;
+
+            // Don't cut the walls corners.
+            if(i >= 4 && (!_hierarchy->IsWalkable(best_x, node_y) || !_hierarchy->IsWalkable(node_x, best_y)))
+                continue;
+
+            uint32_t cost = best_node.g_score + ((i < 4) ? 10 : 14);
+            uint32_t index = (node_y - _top) * _width + node_x - _left;
+            if(cost >= _costs[index])
+                continue;
+
+            _costs[index] = cost;
+            _open_nodes.push_back(PathOpenNode(index, cost, 0));
+            std::push_heap(_open_nodes.begin(), _open_nodes.end());
+        }
+    }
+}
+
+bool ChaseFlowField::GetNextPosition(const Position2D& position, Position2D& next_position) const
+{
+    int32_t x = static_cast<int32_t>(position.x);
+    int32_t y = static_cast<int32_t>(position.y);
+    if(x < _left || x >= _left + _width || y < _top || y >= _top + _height)
+        return false;
+
+    uint32_t cost = _GetCost(x, y);
+    if(cost <= STRAIGHT_CHASE_COST)
+        return false;
+
+    // Head to the neighbour element of lowest cost. A sprite standing against a wall
+    // may be on an unreachable element: any reachable neighbour will then do.
+    uint32_t best_cost = cost;
+    for(uint32_t i = 0; i < 8; ++i) {
+        int32_t node_x = x + ADJACENT_NODES[i][0];
+        int32_t node_y = y + ADJACENT_NODES[i][1];
+        uint32_t node_cost = _GetCost(node_x, node_y);
+        if(node_cost >= best_cost)
+            continue;
+
+        if(i >= 4 && (_GetCost(x, node_y) == UNREACHABLE_COST || _GetCost(node_x, y) == UNREACHABLE_COST))
+            continue;
+
+        best_cost = node_cost;
+        next_position.x = static_cast<float>(node_x) + 0.5f;
+        next_position.y = static_cast<float>(node_y) + 0.5f;
+    }
+
+    return best_cost < cost;
+}
+
+uint32_t ChaseFlowField::_GetCost(int32_t x, int32_t y) const
+{
+    if(x < _left || x >= _left + _width || y < _top || y >= _top + _height)
+        return UNREACHABLE_COST;
+    return _costs[(y - _top) * _width + x - _left];
+}
+
+} // namespace private_map
+
+} // namespace vt_map
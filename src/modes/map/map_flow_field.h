@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_flow_field.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the flow field leading the enemies to the camera.
+***
+*** Rather than each hostile enemy heading straight to the camera sprite, and
+*** getting stuck against the walls in between, the cost of the shortest way
+*** to the camera is computed once for every collision grid element around it.
+*** Each enemy then simply heads to its neighbour element of lowest cost.
+*** ***************************************************************************/
+
+#ifndef __MAP_FLOW_FIELD_HEADER__
+#define __MAP_FLOW_FIELD_HEADER__
+
+#include "modes/map/map_utils.h"
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+class PathHierarchy;
+
+/** ****************************************************************************
+*** \brief The cost of the shortest way to a target, around it.
+***
+*** The costs are computed with Dijkstra's algorithm over the walkable places
+*** of a path hierarchy, and thus for the collision size it was built for.
+*** Only the collision grid walls are taken in account. The field covers the
+*** area where the enemies are updated, and is only computed again when the
+*** target changes of collision grid element.
+*** ***************************************************************************/
+class ChaseFlowField
+{
+public:
+    //! \param hierarchy Tells where the sprites can walk. It must outlive the field.
+    explicit ChaseFlowField(const PathHierarchy* hierarchy);
+
+    //! \brief Computes the field again if the target changed of collision grid element.
+    void SetTarget(const vt_common::Position2D& target);
+
+    /** \brief Gives the middle of the neighbour collision grid element leading to the target.
+    *** \return false when the position is out of the field, can't reach the target,
+    *** or is close enough to head straight to it.
+    **/
+    bool GetNextPosition(const vt_common::Position2D& position, vt_common::Position2D& next_position) const;
+
+private:
+    const PathHierarchy* _hierarchy;
+
+    //! \brief The collision grid element of the target, or -1 when not computed yet.
+    int32_t _target_x;
+    int32_t _target_y;
+
+    //! \brief The area covered by the field, in collision grid elements.
+    int32_t _left;
+    int32_t _top;
+    int32_t _width;
+    int32_t _height;
+
+    //! \brief The cost to the target of each element of the area, row after row.
+    std::vector<uint32_t> _costs;
+
+    //! \brief The elements waiting to be explored, kept to avoid reallocating them.
+    std::vector<PathOpenNode> _open_nodes;
+
+    //! \brief Returns the cost of an element, or the maximum value when out of the field or unreachable.
+    uint32_t _GetCost(int32_t x, int32_t y) const;
+};
+
+} // namespace private_map
+
+} // namespace vt_map
+
+#endif // __MAP_FLOW_FIELD_HEADER__
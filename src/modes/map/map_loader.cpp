@@ -0,0 +1,298 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_loader.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the map background loading.
+*** ***************************************************************************/
+
+#include "modes/map/map_loader.h"
+
+#include "modes/map/map_data_file.h"
+#include "modes/map/map_utils.h"
+
+#include "engine/video/texture_controller.h"
+#include "script/script_read.h"
+
+using namespace vt_script;
+using namespace vt_video;
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+MapLoader::MapLoader() :
+    _thread(nullptr),
+    _thread_failed(false),
+    _mutex(nullptr),
+    _condition(nullptr),
+    _stop_worker(false)
+{
+}
+
+MapLoader::~MapLoader()
+{
+    if(_thread) {
+        SDL_LockMutex(_mutex);
+        _stop_worker = true;
+        SDL_CondBroadcast(_condition);
+        SDL_UnlockMutex(_mutex);
+
+        SDL_WaitThread(_thread, nullptr);
+        _thread = nullptr;
+    }
+
+    for(std::map<std::string, MapLoadJob*>::iterator it = _jobs.begin(); it != _jobs.end(); ++it) {
+        delete it->second->map_data;
+        delete it->second;
+    }
+    _jobs.clear();
+    _queued_maps.clear();
+    _queued_images.clear();
+    _queued_collisions.clear();
+
+    if(_condition)
+        SDL_DestroyCond(_condition);
+    if(_mutex)
+        SDL_DestroyMutex(_mutex);
+}
+
+void MapLoader::PrefetchMap(const std::string& data_filename)
+{
+    if(!_StartWorker())
+        return;
+
+    SDL_LockMutex(_mutex);
+    _GetJob(data_filename);
+    SDL_UnlockMutex(_mutex);
+}
+
+void MapLoader::LoadMap(const std::string& data_filename,
+                        const std::vector<std::pair<float, float> >& collision_sizes)
+{
+    if(!_StartWorker())
+        return;
+
+    SDL_LockMutex(_mutex);
+    MapLoadJob* job = _GetJob(data_filename);
+    job->load_images = true;
+    job->collision_sizes = collision_sizes;
+
+    // The map the player is going to is read before the prefetched ones.
+    if(job->state == MAP_LOAD_QUEUED) {
+        for(std::deque<MapLoadJob*>::iterator it = _queued_maps.begin(); it != _queued_maps.end(); ++it) {
+            if(*it == job) {
+                _queued_maps.erase(it);
+                break;
+            }
+        }
+        _queued_maps.push_front(job);
+    }
+    SDL_UnlockMutex(_mutex);
+}
+
+bool MapLoader::IsMapLoaded(const std::string& data_filename)
+{
+    if(!_thread)
+        return true;
+
+    SDL_LockMutex(_mutex);
+    std::map<std::string, MapLoadJob*>::const_iterator it = _jobs.find(data_filename);
+    bool loaded = (it == _jobs.end() || it->second->state == MAP_LOAD_DONE
+                   || (it->second->state == MAP_LOAD_DATA_READ && !it->second->load_images));
+    SDL_UnlockMutex(_mutex);
+    return loaded;
+}
+
+MapDataFile* MapLoader::TakeMapData(const std::string& data_filename)
+{
+    if(!_thread)
+        return nullptr;
+
+    MapDataFile* map_data = nullptr;
+
+    SDL_LockMutex(_mutex);
+    std::map<std::string, MapLoadJob*>::iterator it = _jobs.find(data_filename);
+    // The worker thread no longer uses the job once done, or once its data is read
+    // when the images aren't decoded.
+    if(it != _jobs.end() && (it->second->state == MAP_LOAD_DONE
+                             || (it->second->state == MAP_LOAD_DATA_READ && !it->second->load_images))) {
+        map_data = it->second->map_data;
+        delete it->second;
+        _jobs.erase(it);
+    }
+    SDL_UnlockMutex(_mutex);
+
+    return map_data;
+}
+
+void MapLoader::Update()
+{
+    if(!_thread)
+        return;
+
+    // Only the main thread changes the state of the read maps, so they can be read out of the lock.
+    std::vector<MapLoadJob*> read_jobs;
+    SDL_LockMutex(_mutex);
+    for(std::map<std::string, MapLoadJob*>::iterator it = _jobs.begin(); it != _jobs.end(); ++it) {
+        if(it->second->state == MAP_LOAD_DATA_READ && it->second->load_images)
+            read_jobs.push_back(it->second);
+    }
+    SDL_UnlockMutex(_mutex);
+
+    for(uint32_t i = 0; i < read_jobs.size(); ++i) {
+        MapLoadJob* job = read_jobs[i];
+
+        // The Lua maps are loaded from their script, on the main thread.
+        std::vector<std::string> image_filenames;
+        if(job->map_data) {
+            const std::vector<std::string>& tileset_filenames = job->map_data->GetTilesetFilenames();
+            for(uint32_t j = 0; j < tileset_filenames.size(); ++j) {
+                const std::string& image_filename = _GetTilesetImage(tileset_filenames[j]);
+                if(!image_filename.empty())
+                    image_filenames.push_back(image_filename);
+            }
+        }
+
+        SDL_LockMutex(_mutex);
+        for(uint32_t j = 0; j < image_filenames.size(); ++j)
+            _queued_images.push_back(ImageLoadJob(job, image_filenames[j]));
+        job->pending_tasks = image_filenames.size();
+        if(job->map_data) {
+            _queued_collisions.push_back(job);
+            ++job->pending_tasks;
+        }
+        job->state = (job->pending_tasks == 0) ? MAP_LOAD_DONE : MAP_LOAD_DECODING;
+        SDL_CondBroadcast(_condition);
+        SDL_UnlockMutex(_mutex);
+    }
+}
+
+bool MapLoader::_StartWorker()
+{
+    if(_thread)
+        return true;
+    if(_thread_failed)
+        return false;
+
+    _mutex = SDL_CreateMutex();
+    _condition = SDL_CreateCond();
+    if(_mutex && _condition)
+        _thread = SDL_CreateThread(_RunWorker, "MapLoader", this);
+
+    if(!_thread) {
+        IF_PRINT_WARNING(MAP_DEBUG) << "Couldn't create the map loading thread: " << SDL_GetError() << std::endl;
+        _thread_failed = true;
+        return false;
+    }
+    return true;
+}
+
+MapLoader::MapLoadJob* MapLoader::_GetJob(const std::string& data_filename)
+{
+    std::map<std::string, MapLoadJob*>::iterator it = _jobs.find(data_filename);
+    if(it != _jobs.end())
+        return it->second;
+
+    MapLoadJob* job = new MapLoadJob();
+    job->data_filename = data_filename;
+    _jobs[data_filename] = job;
+    _queued_maps.push_back(job);
+    SDL_CondBroadcast(_condition);
+    return job;
+}
+
+const std::string& MapLoader::_GetTilesetImage(const std::string& tileset_filename)
+{
+    std::map<std::string, std::string>::iterator it = _tileset_images.find(tileset_filename);
+    if(it != _tileset_images.end())
+        return it->second;
+
+    std::string& image_filename = _tileset_images[tileset_filename];
+
+    ReadScriptDescriptor tileset_script;
+    if(!tileset_script.OpenFile(tileset_filename))
+        return image_filename;
+
+    if(tileset_script.OpenTable("tileset")) {
+        image_filename = tileset_script.ReadString("image");
+        tileset_script.CloseTable();
+    }
+    tileset_script.CloseFile();
+
+    return image_filename;
+}
+
+int MapLoader::_RunWorker(void* data)
+{
+    MapLoader* loader = static_cast<MapLoader*>(data);
+
+    SDL_LockMutex(loader->_mutex);
+    while(!loader->_stop_worker) {
+        // The images of a map being loaded are decoded before reading the prefetched maps.
+        if(!loader->_queued_images.empty()) {
+            ImageLoadJob image = loader->_queued_images.front();
+            loader->_queued_images.pop_front();
+            SDL_UnlockMutex(loader->_mutex);
+
+            // An image which couldn't be decoded is simply loaded again by the map.
+            TextureManager->PreloadImage(image.filename);
+
+            SDL_LockMutex(loader->_mutex);
+            if(--image.job->pending_tasks == 0)
+                image.job->state = MAP_LOAD_DONE;
+            continue;
+        }
+
+        if(!loader->_queued_collisions.empty()) {
+            MapLoadJob* job = loader->_queued_collisions.front();
+            loader->_queued_collisions.pop_front();
+            std::vector<std::pair<float, float> > collision_sizes = job->collision_sizes;
+            SDL_UnlockMutex(loader->_mutex);
+
+            // The main thread doesn't use the map data until the job is done.
+            job->map_data->BuildCollisions(collision_sizes);
+
+            SDL_LockMutex(loader->_mutex);
+            if(--job->pending_tasks == 0)
+                job->state = MAP_LOAD_DONE;
+            continue;
+        }
+
+        if(loader->_queued_maps.empty()) {
+            SDL_CondWait(loader->_condition, loader->_mutex);
+            continue;
+        }
+
+        MapLoadJob* job = loader->_queued_maps.front();
+        loader->_queued_maps.pop_front();
+        job->state = MAP_LOAD_READING;
+        SDL_UnlockMutex(loader->_mutex);
+
+        // The job map data is only used by this thread while being read.
+        MapDataFile* map_data = new MapDataFile();
+        if(!map_data->Open(MapDataFile::GetCompiledFilename(job->data_filename), job->data_filename)) {
+            delete map_data;
+            map_data = nullptr;
+        }
+
+        SDL_LockMutex(loader->_mutex);
+        job->map_data = map_data;
+        job->state = MAP_LOAD_DATA_READ;
+    }
+    SDL_UnlockMutex(loader->_mutex);
+    return 0;
+}
+
+} // namespace private_map
+
+} // namespace vt_map
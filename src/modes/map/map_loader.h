@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_loader.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the map background loading.
+***
+*** Loading a map is split in two stages. The background stage, done on a
+*** worker thread, reads and uncompresses the compiled map data file, decodes
+*** the tileset images, and builds the collision grid, its walls bitmap and the
+*** path hierarchies. The main thread stage is the map mode construction
+*** itself, which creates the Lua objects, takes the collisions over and
+*** uploads the already decoded images into the texture sheets.
+*** ***************************************************************************/
+
+#ifndef __MAP_LOADER_HEADER__
+#define __MAP_LOADER_HEADER__
+
+#include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_mutex.h>
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+class MapDataFile;
+
+//! \brief The background loading state of a map.
+enum MAP_LOAD_STATE {
+    MAP_LOAD_QUEUED    = 0, //!< Waiting for the worker thread.
+    MAP_LOAD_READING   = 1, //!< The map data file is being read.
+    MAP_LOAD_DATA_READ = 2, //!< The map data file is read, or couldn't be.
+    MAP_LOAD_DECODING  = 3, //!< The tileset images are being decoded.
+    MAP_LOAD_DONE      = 4
+};
+
+/** ****************************************************************************
+*** \brief Loads the data of the maps the player may go to on a worker thread.
+***
+*** The maps reachable through the current map transition events are only
+*** prefetched: their compiled map data file is read ahead of time, which is
+*** cheap to keep. When a transition starts, its map is loaded: the tileset
+*** images are then decoded and the collisions built as well, and the
+*** transition waits for them before constructing the map mode.
+***
+*** The sprites collision sizes are only known once the map script created
+*** them, so the path hierarchies built are those of the sizes used on the
+*** current map. The other ones are built on the main thread as before.
+***
+*** The tileset definition files are Lua scripts, which can only be read on the
+*** main thread. They are read in Update(), once the map data file is known.
+*** ***************************************************************************/
+class MapLoader
+{
+public:
+    MapLoader();
+
+    //! \brief Stops the worker thread, and frees the map data not taken.
+    ~MapLoader();
+
+    //! \brief Reads the map data file in the background, in case the player goes there.
+    void PrefetchMap(const std::string& data_filename);
+
+    /** \brief Reads the map data file, decodes the tileset images and builds the collisions in the background.
+    *** \param collision_sizes The sprite collision sizes to build the path hierarchies of.
+    **/
+    void LoadMap(const std::string& data_filename, const std::vector<std::pair<float, float> >& collision_sizes);
+
+    /** \brief Tells whether the map requested with LoadMap() is ready to be constructed.
+    *** It is always the case when the map can't be loaded in the background.
+    **/
+    bool IsMapLoaded(const std::string& data_filename);
+
+    /** \brief Gives the map data file read in the background, and forgets the map.
+    *** \return The map data file, to be deleted by the caller,
+    *** or nullptr if it isn't read yet or isn't compiled.
+    **/
+    MapDataFile* TakeMapData(const std::string& data_filename);
+
+    //! \brief Queues the tileset images and the collisions of the maps being loaded once their data file is read.
+    void Update();
+
+private:
+    //! \brief A map loaded or prefetched.
+    struct MapLoadJob {
+        MapLoadJob() :
+            state(MAP_LOAD_QUEUED),
+            load_images(false),
+            map_data(nullptr),
+            pending_tasks(0)
+        {}
+
+        std::string data_filename;
+        MAP_LOAD_STATE state;
+
+        //! \brief Whether the tileset images are decoded and the collisions built as well.
+        bool load_images;
+
+        //! \brief The sprite collision sizes to build the path hierarchies of.
+        std::vector<std::pair<float, float> > collision_sizes;
+
+        //! \brief The map data file read, or nullptr if the map isn't compiled.
+        MapDataFile* map_data;
+
+        //! \brief The number of tileset images still to be decoded, and collisions to be built.
+        uint32_t pending_tasks;
+    };
+
+    //! \brief A tileset image to decode, with the map it is decoded for.
+    struct ImageLoadJob {
+        ImageLoadJob(MapLoadJob* job_, const std::string& filename_) :
+            job(job_),
+            filename(filename_)
+        {}
+
+        MapLoadJob* job;
+        std::string filename;
+    };
+
+    SDL_Thread* _thread;
+
+    //! \brief Set once the worker thread couldn't be started. The maps are then loaded as before.
+    bool _thread_failed;
+
+    //! \brief The tileset images filenames, by tileset definition file.
+    std::map<std::string, std::string> _tileset_images;
+
+    //! \brief Protects the members below, shared with the worker thread.
+    SDL_mutex* _mutex;
+
+    //! \brief Signaled when a job is queued, or when the worker has to stop.
+    SDL_cond* _condition;
+
+    //! \brief Every map loaded or prefetched, by data filename.
+    std::map<std::string, MapLoadJob*> _jobs;
+
+    //! \brief The maps whose data file is waiting for the worker thread.
+    std::deque<MapLoadJob*> _queued_maps;
+
+    //! \brief The tileset images waiting for the worker thread. They are decoded first.
+    std::deque<ImageLoadJob> _queued_images;
+
+    //! \brief The maps whose collisions are waiting for the worker thread, once their images are decoded.
+    std::deque<MapLoadJob*> _queued_collisions;
+
+    bool _stop_worker;
+
+    //! \brief Starts the worker thread, the first time a map is requested.
+    bool _StartWorker();
+
+    //! \brief Returns the map job, creating and queuing it when needed. The mutex must be locked.
+    MapLoadJob* _GetJob(const std::string& data_filename);
+
+    /** \brief Returns the image filename of a tileset definition file, read only once.
+    *** \return An empty string if the tileset file is invalid.
+    **/
+    const std::string& _GetTilesetImage(const std::string& tileset_filename);
+
+    //! \brief The worker thread function.
+    static int _RunWorker(void* data);
+};
+
+} // namespace private_map
+
+} // namespace vt_map
+
+#endif // __MAP_LOADER_HEADER__
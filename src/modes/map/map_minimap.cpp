@@ -15,15 +15,24 @@
 #include "modes/map/map_sprites/map_virtual_sprite.h"
 
 #include "engine/video/video.h"
+#include "engine/virtual_file_system.h"
+#include "engine/binary_utils.h"
+#include "common/app_settings.h"
 #include "common/gui/menu_window.h"
 
+#include "utils/utils_files.h"
+
 // Used for the collision to XPM dev function
 #ifdef DEBUG_FEATURES
 #include "script/script_write.h"
 #endif
 
-#include <SDL2/SDL_image.h>
-#include <SDL2/SDL_endian.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 
 using namespace vt_common;
 
@@ -45,57 +54,109 @@ const float MINIMAP_POS_X = 775.0f;
 //! \brief The Y value for the minimap's position.
 const float MINIMAP_POS_Y = 545.0f;
 
-//! \brief Allows for scoped-based control of SDL Surfaces.
-struct SDLSurfaceController {
-    SDL_Surface* _surface;
+//! \brief The white noise image drawn on the collisions.
+const std::string MINIMAP_NOISE_FILENAME = "data/gui/map/minimap_collision.png";
 
-    explicit SDLSurfaceController(const char *str) :
-        _surface(IMG_Load(str))
-    {
-        if (!_surface)
-            PRINT_ERROR << "Couldn't create the white noise image for the collision map: " << SDL_GetError() << std::endl;
-    }
+/** \brief The procedural minimaps cache folder, in the user data folder.
+*** Cache file format (little endian): char[4] "VTMM", uint32 version, uint64 collisions hash,
+*** uint32 width, uint32 height, uint32 compressed size, then the zlib compressed RGBA pixels.
+**/
+const std::string MINIMAP_CACHE_DIRECTORY = "minimap_cache/";
 
-    ~SDLSurfaceController()
-    {
-        if (_surface)
-            SDL_FreeSurface(_surface);
-    }
+//! \brief The minimap cache format version handled.
+const uint32_t MINIMAP_CACHE_VERSION = 1;
 
-private:
-    //! \brief The copy constructor and assignment operator are hidden by design
-    //! to cause compilation errors when attempting to copy or assign this class.
-    SDLSurfaceController(const SDLSurfaceController&)
-    {
-        throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+//! \brief The minimap cache header size, in bytes.
+const uint32_t MINIMAP_CACHE_HEADER_SIZE = 28;
+
+//! \brief Returns the minimap cache file of a map, e.g. "data/a/b.lua" -> "<user data>/minimap_cache/data.a.b.vtmm"
+static std::string _GetMinimapCacheFilename(const std::string& map_script_filename)
+{
+    std::string cache_filename = map_script_filename;
+    for (uint32_t i = 0; i < cache_filename.size(); ++i) {
+        if (cache_filename[i] == '/' || cache_filename[i] == '\\')
+            cache_filename[i] = '.';
     }
-    SDLSurfaceController& operator=(const SDLSurfaceController&)
-    {
-        throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
-        return *this;
+    if (cache_filename.size() > 4 && cache_filename.compare(cache_filename.size() - 4, 4, ".lua") == 0)
+        cache_filename.erase(cache_filename.size() - 4);
+
+    return vt_common::GetUserDataPath() + MINIMAP_CACHE_DIRECTORY + cache_filename + ".vtmm";
+}
+
+/** \brief Loads the minimap pixels from the cache file, when made from the same collisions.
+*** \param image Already sized, and filled with the cached pixels.
+**/
+static bool _LoadMinimapCache(const std::string& filename, uint64_t hash,
+                              vt_video::private_video::ImageMemory& image)
+{
+    if (!vt_utils::DoesFileExist(filename))
+        return false;
+
+    vt_system::FileData file_data;
+    if (!vt_system::FileSystemManager->ReadFile(filename, file_data)
+            || file_data.GetSize() < MINIMAP_CACHE_HEADER_SIZE
+            || memcmp(file_data.GetData(), "VTMM", 4) != 0)
+        return false;
+
+    const uint8_t* header = file_data.GetData();
+    uint32_t compressed_size = vt_system::ReadUInt32(header + 24);
+
+    // The cache is made again whenever the map collisions change.
+    if (vt_system::ReadUInt32(header + 4) != MINIMAP_CACHE_VERSION || vt_system::ReadUInt64(header + 8) != hash
+            || vt_system::ReadUInt32(header + 16) != image.GetWidth()
+            || vt_system::ReadUInt32(header + 20) != image.GetHeight()
+            || MINIMAP_CACHE_HEADER_SIZE + static_cast<size_t>(compressed_size) > file_data.GetSize())
+        return false;
+
+    uLongf size = static_cast<uLongf>(image.GetSize2D() * image.GetBytesPerPixel());
+    if (uncompress(image.GetPixels(), &size, header + MINIMAP_CACHE_HEADER_SIZE,
+                   static_cast<uLong>(compressed_size)) != Z_OK
+            || size != image.GetSize2D() * image.GetBytesPerPixel()) {
+        IF_PRINT_WARNING(MAP_DEBUG) << "Invalid minimap cache file: " << filename << std::endl;
+        return false;
     }
-};
+    return true;
+}
 
-//! \brief A helper function to prepare a SDL_Surface.
-static bool _PrepareSurface(SDL_Surface* temp_surface)
+//! \brief Writes the minimap pixels in the cache file. The file is first written aside, then renamed.
+static bool _SaveMinimapCache(const std::string& filename, uint64_t hash,
+                              const vt_video::private_video::ImageMemory& image)
 {
-    // A white noise texture.
-    const SDLSurfaceController WHITE_NOISE("data/gui/map/minimap_collision.png");
-    SDL_Rect r = { 0, 0, 0, 0 };
-
-    // Prepare the surface with the image.  Tile the white noise image onto the surface with full alpha.
-    for(int x = 0; x < temp_surface->w; x += WHITE_NOISE._surface->w) {
-        r.x = x;
-        for(int y = 0; y < temp_surface->h; y += WHITE_NOISE._surface->h) {
-            r.y = y;
-            if(SDL_BlitSurface(WHITE_NOISE._surface, nullptr, temp_surface, &r)) {
-                PRINT_ERROR << "Couldn't fill a rect on temp_surface: " << SDL_GetError() << std::endl;
-                return false;
-            }
-        }
+    std::string directory = vt_common::GetUserDataPath() + MINIMAP_CACHE_DIRECTORY;
+    if (!vt_utils::DoesFileExist(directory))
+        vt_utils::MakeDirectory(directory);
+
+    uLong pixels_size = static_cast<uLong>(image.GetSize2D() * image.GetBytesPerPixel());
+    uLongf compressed_size = compressBound(pixels_size);
+    std::vector<uint8_t> buffer(MINIMAP_CACHE_HEADER_SIZE + compressed_size);
+    if (compress(&buffer[MINIMAP_CACHE_HEADER_SIZE], &compressed_size, image.GetPixels(), pixels_size) != Z_OK)
+        return false;
+    buffer.resize(MINIMAP_CACHE_HEADER_SIZE + compressed_size);
+
+    memcpy(&buffer[0], "VTMM", 4);
+    vt_system::WriteUInt32(&buffer[4], MINIMAP_CACHE_VERSION);
+    vt_system::WriteUInt64(&buffer[8], hash);
+    vt_system::WriteUInt32(&buffer[16], image.GetWidth());
+    vt_system::WriteUInt32(&buffer[20], image.GetHeight());
+    vt_system::WriteUInt32(&buffer[24], compressed_size);
+
+    // Write aside first, so that a partially written cache file is never read.
+    std::string temp_filename = filename + ".tmp";
+    std::ofstream file(temp_filename.c_str(), std::ofstream::binary | std::ofstream::trunc);
+    if (!file.is_open()) {
+        IF_PRINT_WARNING(MAP_DEBUG) << "Couldn't write the minimap cache file: " << temp_filename << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&buffer[0]), buffer.size());
+    file.close();
+    if (file.fail()) {
+        std::remove(temp_filename.c_str());
+        return false;
     }
 
-    return true;
+    // Renaming over an existing file fails on some systems.
+    std::remove(filename.c_str());
+    return std::rename(temp_filename.c_str(), filename.c_str()) == 0;
 }
 
 Minimap::Minimap(const std::string& minimap_image_filename) :
@@ -137,80 +198,35 @@ vt_video::StillImage Minimap::_CreateProcedurally()
 {
     ObjectSupervisor *map_object_supervisor = MapMode::CurrentInstance()->GetObjectSupervisor();
 
-    float x, y, width, height;
-    vt_video::VideoManager->GetCurrentViewport(x, y, width, height);
-
-    //create a new SDL surface that is the rendering dimensions we want.
-    SDL_Surface *temp_surface = SDL_CreateRGBSurface(SDL_SWSURFACE,
-                                                     _grid_width * _box_x_length, _grid_height * _box_y_length, 32,
-#if SDL_BYTEORDER == SDL_BIG_ENDIAN
-                                                     0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff);
-#else
-                                                     0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000);
-#endif
+    // The collisions are packed one bit per grid element, the same bits giving the same minimap.
+    std::vector<uint32_t> collision_bits;
+    uint32_t row_words = map_object_supervisor->GetStaticCollisionBits(collision_bits);
+    uint64_t hash = vt_system::ComputeHash(
+        collision_bits.empty() ? nullptr : reinterpret_cast<const uint8_t*>(&collision_bits[0]),
+        collision_bits.size() * sizeof(uint32_t));
 
-    if(!temp_surface) {
-        PRINT_ERROR << "Couldn't create temp_surface for collision map: " << SDL_GetError() << std::endl;
-        MapMode::CurrentInstance()->ShowMinimap(false);
-        return vt_video::StillImage();
+    vt_video::private_video::ImageMemory minimap_pixels;
+    try {
+        minimap_pixels.Resize(_grid_width * _box_x_length, _grid_height * _box_y_length, false);
     }
-
-    //set the basic rect information
-    SDL_Rect r;
-    r.w = _box_x_length;
-    r.h = _box_y_length;
-    r.x = r.y = 0;
-
-    //very simple. Just go through the entire grid, checking the visible-character's
-    //context against the map-grid's collision context. if this is NOT a colidable location
-    //fill that square in with a full alpha block
-    //note that the ordering needs to be transposed for drawing
-    if (!_PrepareSurface(temp_surface)) {
-        SDL_FreeSurface(temp_surface);
+    catch(std::exception& e) {
+        PRINT_ERROR << "Couldn't allocate the collision map pixels: " << e.what() << std::endl;
         MapMode::CurrentInstance()->ShowMinimap(false);
         return vt_video::StillImage();
     }
 
-    for(uint32_t row = 0; row < _grid_width; ++row)
-    {
-        r.y = 0;
-        for(uint32_t col = 0; col < _grid_height; ++col)
-        {
-            if(!map_object_supervisor->IsStaticCollision(row, col))
-            {
-
-                if(SDL_FillRect(temp_surface, &r, SDL_MapRGBA(temp_surface->format, 0x00, 0x00, 0x00, 0x00)))
-                {
-                    PRINT_ERROR << "Couldn't fill a rect on temp_surface: " << SDL_GetError() << std::endl;
-                    SDL_FreeSurface(temp_surface);
-                    return vt_video::StillImage();
-                }
-
-            }
-            r.y += _box_y_length;
+    std::string cache_filename = _GetMinimapCacheFilename(MapMode::CurrentInstance()->GetMapScriptFilename());
+    if (!_LoadMinimapCache(cache_filename, hash, minimap_pixels)) {
+        if (!_DrawCollisions(minimap_pixels, collision_bits, row_words)) {
+            MapMode::CurrentInstance()->ShowMinimap(false);
+            return vt_video::StillImage();
         }
-        r.x += _box_x_length;
-    }
-
-    //TEST: flush the SDL surface. This forces any pending writes onto the surface to complete
-    //SDL_UpdateRect(temp_surface, 0, 0, 0, 0);
-
-    if (!temp_surface) {
-        MapMode::CurrentInstance()->ShowMinimap(false);
-        return vt_video::StillImage();
+        _SaveMinimapCache(cache_filename, hash, minimap_pixels);
     }
 
-    SDL_LockSurface(temp_surface);
-
-    // Setup a temporary memory space to copy the SDL data into
-    vt_video::private_video::ImageMemory temp_data(temp_surface);
-
-    SDL_UnlockSurface(temp_surface);
-    // At this point, the screen data is set up. We can get rid of unnecessary data here
-    SDL_FreeSurface(temp_surface);
     // Do the image file creation
     std::string map_name_cmap = MapMode::CurrentInstance()->GetMapScriptFilename() + "_cmap";
-    vt_video::StillImage minimap_image = vt_video::VideoManager->CreateImage(&temp_data, map_name_cmap);
+    vt_video::StillImage minimap_image = vt_video::VideoManager->CreateImage(&minimap_pixels, map_name_cmap);
 
 #ifdef DEBUG_FEATURES
     // Uncomment and compile this to generate XPM minimaps.
@@ -220,6 +236,78 @@ vt_video::StillImage Minimap::_CreateProcedurally()
     return minimap_image;
 }
 
+bool Minimap::_DrawCollisions(vt_video::private_video::ImageMemory& minimap_pixels,
+                              const std::vector<uint32_t>& collision_bits, uint32_t row_words)
+{
+    // A white noise texture, tiled over the collisions.
+    vt_video::private_video::ImageMemory noise;
+    if (!noise.LoadImage(MINIMAP_NOISE_FILENAME) || noise.GetBytesPerPixel() != 4 || noise.GetWidth() == 0) {
+        PRINT_ERROR << "Couldn't load the white noise image for the collision map: " << MINIMAP_NOISE_FILENAME << std::endl;
+        return false;
+    }
+
+    // Blend the noise over a transparent black image, as the former surface blit did.
+    uint8_t* noise_pixels = noise.GetPixels();
+    for (size_t i = 0; i < noise.GetSize2D() * 4; i += 4) {
+        noise_pixels[i] = noise_pixels[i] * noise_pixels[i + 3] / 255;
+        noise_pixels[i + 1] = noise_pixels[i + 1] * noise_pixels[i + 3] / 255;
+        noise_pixels[i + 2] = noise_pixels[i + 2] * noise_pixels[i + 3] / 255;
+    }
+
+    const uint32_t width = minimap_pixels.GetWidth();
+    const uint32_t noise_width = noise.GetWidth();
+    const uint32_t noise_height = noise.GetHeight();
+    const size_t box_bytes = _box_x_length * 4;
+    uint8_t* pixels = minimap_pixels.GetPixels();
+
+    // The walkable elements of a grid row, as pairs of first element and length.
+    std::vector<uint32_t> walkable_runs;
+
+    for (uint32_t y = 0; y < _grid_height; ++y) {
+        const uint32_t* row = &collision_bits[y * row_words];
+
+        // Find the walkable runs, skipping 32 elements at once when the whole word is the same.
+        walkable_runs.clear();
+        uint32_t x = 0;
+        while (x < _grid_width) {
+            if ((x & 31) == 0 && row[x >> 5] == 0xffffffff) {
+                x += 32;
+                continue;
+            }
+            if ((row[x >> 5] >> (x & 31)) & 1) {
+                ++x;
+                continue;
+            }
+
+            uint32_t first = x;
+            while (x < _grid_width) {
+                if ((x & 31) == 0 && row[x >> 5] == 0)
+                    x += 32;
+                else if ((row[x >> 5] >> (x & 31)) & 1)
+                    break;
+                else
+                    ++x;
+            }
+            x = std::min(x, _grid_width);
+            walkable_runs.push_back(first);
+            walkable_runs.push_back(x - first);
+        }
+
+        // Tile the noise over the whole lines, then clear the walkable runs.
+        for (uint32_t line = y * _box_y_length; line < (y + 1) * _box_y_length; ++line) {
+            uint8_t* line_pixels = pixels + static_cast<size_t>(line) * width * 4;
+            const uint8_t* noise_line = noise_pixels + static_cast<size_t>(line % noise_height) * noise_width * 4;
+            for (uint32_t px = 0; px < width; px += noise_width)
+                memcpy(line_pixels + static_cast<size_t>(px) * 4, noise_line, std::min(noise_width, width - px) * 4);
+
+            for (uint32_t i = 0; i < walkable_runs.size(); i += 2)
+                memset(line_pixels + walkable_runs[i] * box_bytes, 0, walkable_runs[i + 1] * box_bytes);
+        }
+    }
+
+    return true;
+}
+
 void Minimap::Draw()
 {
     if (_current_position.x <= -1.0f)
@@ -94,9 +94,18 @@ private:
     //! \brief specifies the additive alpha we get from the map class
     float _map_alpha_scale;
 
-    //! \brief creates the procedural collision minimap image
+    /** \brief creates the procedural collision minimap image,
+    *** or loads it from the cache when the map collisions didn't change.
+    **/
     vt_video::StillImage _CreateProcedurally();
 
+    /** \brief Draws the white noise over the static collisions of the minimap pixels,
+    *** leaving the walkable elements transparent.
+    *** \param collision_bits The packed static collisions, see ObjectSupervisor::GetStaticCollisionBits().
+    **/
+    bool _DrawCollisions(vt_video::private_video::ImageMemory& minimap_pixels,
+                         const std::vector<uint32_t>& collision_bits, uint32_t row_words);
+
 #ifdef DEBUG_FEATURES
     //! \brief Writes a XPM file with the minimap equivalient in it.
     //! It is used to easily have a base to create nicer minimaps.
@@ -29,6 +29,8 @@
 #include "modes/map/map_sprites/map_enemy_sprite.h"
 #include "modes/map/map_zones.h"
 #include "modes/map/map_tiles.h"
+#include "modes/map/map_data_file.h"
+#include "modes/map/map_loader.h"
 
 #include "modes/map/map_location.h"
 
@@ -78,7 +80,7 @@ MapMode *MapMode::_current_instance = nullptr;
 // ****************************************************************************
 
 MapMode::MapMode(const std::string& data_filename, const std::string& script_filename,
-                 uint32_t stamina, bool permit_autosave) :
+                 uint32_t stamina, bool permit_autosave, MapDataFile* map_data) :
     GameMode(MODE_MANAGER_MAP_MODE),
     _activated(false),
     _map_data_filename(data_filename),
@@ -89,6 +91,8 @@ MapMode::MapMode(const std::string& data_filename, const std::string& script_fil
     _dialogue_supervisor(nullptr),
     _treasure_supervisor(nullptr),
     _escape_supervisor(nullptr),
+    _map_loader(nullptr),
+    _preloaded_map_data(map_data),
     _camera_x_in_map_corner(false),
     _camera_y_in_map_corner(false),
     _camera(nullptr),
@@ -122,6 +126,7 @@ MapMode::MapMode(const std::string& data_filename, const std::string& script_fil
     _dialogue_supervisor = new MapDialogueSupervisor();
     _treasure_supervisor = new TreasureSupervisor();
     _escape_supervisor = new EscapeSupervisor();
+    _map_loader = new MapLoader();
 
     _intro_timer.Initialize(4000, 0);
     _intro_timer.EnableAutoUpdate(this);
@@ -160,7 +165,8 @@ MapMode::MapMode(const std::string& data_filename, const std::string& script_fil
     _debug_camera_position.SetStyle(TextStyle("title22", Color::white, VIDEO_TEXT_SHADOW_DARK));
 
     if (_auto_save_enabled && permit_autosave) {
-        GlobalManager->AutoSave(_map_data_filename, _map_script_filename, _run_stamina,
+        GlobalManager->AutoSave(_map_data_filename, _map_script_filename,
+                                _map_name, _map_image.GetFilename(), _run_stamina,
                                 _camera != nullptr ? _camera->GetXPosition() : 0,
                                 _camera != nullptr ? _camera->GetYPosition() : 0);
     }
@@ -177,6 +183,8 @@ MapMode::~MapMode()
     delete(_dialogue_supervisor);
     delete(_treasure_supervisor);
     delete(_escape_supervisor);
+    delete(_map_loader);
+    delete(_preloaded_map_data);
     if(_minimap) delete _minimap;
 
     // Remove the reference to the luabind object
@@ -236,6 +244,9 @@ void MapMode::Reset()
 
     _intro_timer.Run();
 
+    // Group the frame telemetry samples by map.
+    SystemManager->GetTelemetry().SetContext(_map_data_filename);
+
     // Reset potential map scripts
     GetScriptSupervisor().Reset();
 
@@ -247,6 +258,17 @@ void MapMode::Reset()
         _object_supervisor->ReloadVisiblePartyMember();
 }
 
+void MapMode::DEBUG_ReportMemoryUsage(vt_system::MemoryAccounting& accounting)
+{
+    _object_supervisor->DEBUG_ReportMemoryUsage(accounting, _map_data_filename);
+    GameMode::DEBUG_ReportMemoryUsage(accounting);
+}
+
+void MapMode::DEBUG_BenchmarkCollisions(uint32_t iterations)
+{
+    _object_supervisor->DEBUG_BenchmarkCollisions(iterations);
+}
+
 void MapMode::_InitResources()
 {
     // Load the miscellaneous map graphics.
@@ -351,13 +373,19 @@ void MapMode::Update()
     _dialogue_icon.Update();
 
     // Call the map script's update function
-    if(_update_function.is_valid())
+    if(_update_function.is_valid()) {
+        TelemetryScope lua_scope(TELEMETRY_LUA_TIME);
+        ScriptProfilerScope profiler_scope("map_update");
         luabind::call_function<void>(_update_function);
+    }
+
+    _map_loader->Update();
 
     // Update all animated tile images
     _tile_supervisor->Update();
     _object_supervisor->Update();
-    _object_supervisor->SortObjects();
+    SystemManager->GetTelemetry().SetValue(TELEMETRY_MAP_OBJECTS,
+                                           _object_supervisor->GetNumberObjects());
 
     switch(CurrentState()) {
     case STATE_SCENE:
@@ -510,6 +538,11 @@ void MapMode::DeleteMapObject(private_map::MapObject* object)
     _object_supervisor->DeleteObject(object);
 }
 
+void MapMode::SetMapCollision(uint32_t x, uint32_t y, bool collision)
+{
+    _object_supervisor->SetMapCollision(x, y, collision);
+}
+
 void MapMode::SetCamera(private_map::VirtualSprite *sprite, uint32_t duration)
 {
     if(_camera == sprite) {
@@ -628,41 +661,12 @@ uint16_t MapMode::GetMapHeight() const
 bool MapMode::_Load()
 {
     // Map data
-    // Clear out all old map data if existing.
-    ScriptManager->DropGlobalTable("map_data");
-
-    // Open map script file and read in the basic map properties and tile definitions
-    if(!_map_script.OpenFile(_map_data_filename)) {
-        PRINT_ERROR << "Couldn't open map data file: "
-                    << _map_data_filename << std::endl;
+    if(!_LoadMapData())
         return false;
-    }
 
-    if(!_map_script.OpenTable("map_data")) {
-        PRINT_ERROR << "Couldn't open table 'map_data' in: "
-                    << _map_data_filename << std::endl;
-        _map_script.CloseFile();
-        return false;
-    }
-
-    // Loads the collision grid
-    if(!_object_supervisor->Load(_map_script)) {
-        PRINT_ERROR << "Failed to load the collision grid from: "
-            << _map_data_filename << std::endl;
-        _map_script.CloseFile();
-        return false;
-    }
-
-    // Instruct the supervisor classes to perform their portion of the load operation
-    if(!_tile_supervisor->Load(_map_script)) {
-        PRINT_ERROR << "Failed to load the tile data from: "
-            << _map_data_filename << std::endl;
-        _map_script.CloseFile();
-        return false;
-    }
-
-    _map_script.CloseAllTables();
-    _map_script.CloseFile(); // Free the map data file once everyhting is loaded
+    // Collect the garbage as the map is loading, the Lua map data being big.
+    ScriptCollector& script_collector = SystemManager->GetScriptCollector();
+    script_collector.LoadStep();
 
     // Map script
 
@@ -694,6 +698,7 @@ bool MapMode::_Load()
     // Test for empty strings to never trigger the default gettext msg string
     // which contains translation info.
     std::string map_hud_name = _map_script.ReadString("map_name");
+    _map_name = map_hud_name;
     _map_hud_name.SetText(map_hud_name.empty() ? ustring() : UTranslate(map_hud_name),
                           TextStyle("map_title"));
     std::string map_hud_subname = _map_script.ReadString("map_subname");
@@ -720,6 +725,7 @@ bool MapMode::_Load()
     bool loading_succeeded = true;
     if(function.is_valid()) {
         try {
+            ScriptProfilerScope profiler_scope("map_load");
             luabind::call_function<void>(function, this);
         } catch(const luabind::error &e) {
             ScriptManager->HandleLuaError(e);
@@ -741,6 +747,16 @@ bool MapMode::_Load()
         _map_script.CloseFile();
         return false;
     }
+    script_collector.LoadStep();
+
+    _object_supervisor->PreparePathHierarchies();
+
+    // Read the data of the maps the player may go to next in the background.
+    std::vector<std::string> transition_maps = _event_supervisor->GetTransitionMapFilenames();
+    for(uint32_t i = 0; i < transition_maps.size(); ++i) {
+        if(transition_maps[i] != _map_data_filename)
+            _map_loader->PrefetchMap(transition_maps[i]);
+    }
 
     _update_function = _map_script.ReadFunctionPointer("Update");
 
@@ -754,6 +770,77 @@ bool MapMode::_Load()
     return true;
 } // bool MapMode::_Load()
 
+bool MapMode::_LoadMapData()
+{
+    // Use the compiled map data when it is up to date, the Lua file being the one edited.
+    // It may already have been read in the background.
+    if(_preloaded_map_data == nullptr) {
+        _preloaded_map_data = new MapDataFile();
+        if(!_preloaded_map_data->Open(MapDataFile::GetCompiledFilename(_map_data_filename), _map_data_filename)) {
+            delete _preloaded_map_data;
+            _preloaded_map_data = nullptr;
+        }
+    }
+
+    if(_preloaded_map_data != nullptr) {
+        bool loaded = true;
+        if(!_object_supervisor->Load(*_preloaded_map_data)) {
+            PRINT_ERROR << "Failed to load the collision grid from: "
+                << _preloaded_map_data->GetFilename() << std::endl;
+            loaded = false;
+        } else if(!_tile_supervisor->Load(*_preloaded_map_data)) {
+            PRINT_ERROR << "Failed to load the tile data from: "
+                << _preloaded_map_data->GetFilename() << std::endl;
+            loaded = false;
+        }
+
+        delete _preloaded_map_data;
+        _preloaded_map_data = nullptr;
+
+        // Free the tileset images decoded in the background but already in the texture sheets.
+        TextureManager->ClearPreloadedImages();
+        return loaded;
+    }
+
+    // Clear out all old map data if existing.
+    ScriptManager->DropGlobalTable("map_data");
+
+    // Open map script file and read in the basic map properties and tile definitions
+    if(!_map_script.OpenFile(_map_data_filename)) {
+        PRINT_ERROR << "Couldn't open map data file: "
+                    << _map_data_filename << std::endl;
+        return false;
+    }
+
+    if(!_map_script.OpenTable("map_data")) {
+        PRINT_ERROR << "Couldn't open table 'map_data' in: "
+                    << _map_data_filename << std::endl;
+        _map_script.CloseFile();
+        return false;
+    }
+
+    // Loads the collision grid
+    if(!_object_supervisor->Load(_map_script)) {
+        PRINT_ERROR << "Failed to load the collision grid from: "
+            << _map_data_filename << std::endl;
+        _map_script.CloseFile();
+        return false;
+    }
+
+    // Instruct the supervisor classes to perform their portion of the load operation
+    if(!_tile_supervisor->Load(_map_script)) {
+        PRINT_ERROR << "Failed to load the tile data from: "
+            << _map_data_filename << std::endl;
+        _map_script.CloseFile();
+        return false;
+    }
+
+    _map_script.CloseAllTables();
+    _map_script.CloseFile(); // Free the map data file once everyhting is loaded
+
+    return true;
+} // bool MapMode::_LoadMapData()
+
 void MapMode::_CreateMinimap()
 {
     if(_minimap) {
@@ -1154,6 +1241,10 @@ void MapMode::_DrawDebugGrid()
 
 void MapMode::_DrawMapLayers()
 {
+    // Sort the objects once the events and the map script moved them,
+    // as only the visible ones are then found and drawn.
+    _object_supervisor->SortObjects();
+
     VideoManager->PushState();
     VideoManager->SetStandardCoordSys();
 
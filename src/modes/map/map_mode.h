@@ -72,6 +72,8 @@ class TileSupervisor;
 class TreasureObject;
 class TreasureSupervisor;
 class EscapeSupervisor;
+class MapDataFile;
+class MapLoader;
 struct MapLocation;
 } // namespace private_map
 
@@ -118,9 +120,11 @@ public:
     //! \param script_filename The name of the Lua file that retains all data about script to load
     //! \param stamina The amount of stamina the map character sprite will start with.
     //! \param permit_autosave Whether an autosave can happen at map load time.
-    //! \note the last parameter is usually set to carry the current stamina value from one map to another.
+    //! \param map_data The map data file already read in the background, if any. The map mode takes its ownership.
+    //! \note the stamina parameter is usually set to carry the current stamina value from one map to another.
     MapMode(const std::string &data_filename, const std::string& script_filename,
-            uint32_t stamina = STAMINA_FULL, bool permit_autosave = true);
+            uint32_t stamina = STAMINA_FULL, bool permit_autosave = true,
+            private_map::MapDataFile* map_data = nullptr);
 
     ~MapMode();
 
@@ -140,6 +144,12 @@ public:
     //! \brief The highest level draw function for stuff unaffected by light and fade effects.
     void DrawPostEffects();
 
+    //! \brief Reports the map objects memory usage along with the game mode one.
+    void DEBUG_ReportMemoryUsage(vt_system::MemoryAccounting& accounting);
+
+    //! \brief Times the map sprites collision detection. See ObjectSupervisor::DEBUG_BenchmarkCollisions().
+    void DEBUG_BenchmarkCollisions(uint32_t iterations);
+
     // The methods below this line are not intended to be used outside of the map code
 
     //! \brief Empties the state stack and places an invalid state on top
@@ -161,6 +171,9 @@ public:
     //! \brief Removes an object from memory
     void DeleteMapObject(private_map::MapObject* obj);
 
+    //! \brief Changes whether a collision grid element is a wall. See ObjectSupervisor::SetMapCollision().
+    void SetMapCollision(uint32_t x, uint32_t y, bool collision);
+
     //! \brief Vectors containing the save points animations (when the character is in or not).
     std::vector<vt_video::AnimatedImage> active_save_point_animations;
     std::vector<vt_video::AnimatedImage> inactive_save_point_animations;
@@ -179,6 +192,11 @@ public:
         return _map_hud_name.GetString();
     }
 
+    //! \brief The untranslated map hud name, as written in the save files.
+    const std::string& GetMapName() const {
+        return _map_name;
+    }
+
     uint32_t GetStamina() const {
         return _run_stamina;
     }
@@ -245,6 +263,10 @@ public:
         return _escape_supervisor;
     }
 
+    private_map::MapLoader* GetMapLoader() const {
+        return _map_loader;
+    }
+
     const private_map::MapFrame& GetMapFrame() const {
         return _map_frame;
     }
@@ -489,6 +511,9 @@ private:
     vt_video::TextImage _map_hud_name;
     vt_video::TextImage _map_hud_subname;
 
+    //! \brief The untranslated map hud name.
+    std::string _map_name;
+
     /** \brief The interface to the file which contains all the map's stored data and subroutines.
     *** This class generally performs a large amount of communication with this script continuously.
     *** The script remains open for as long as the MapMode object exists.
@@ -515,6 +540,12 @@ private:
     //! \brief Handles escape map sub-menu.
     private_map::EscapeSupervisor* _escape_supervisor;
 
+    //! \brief Loads the maps the player may go to in the background.
+    private_map::MapLoader* _map_loader;
+
+    //! \brief The map data file read in the background, until loaded.
+    private_map::MapDataFile* _preloaded_map_data;
+
     /** \brief A script function which assists with the MapMode#Update method
     *** This function implements any custom update code that the specific map needs to be performed.
     *** The most common operation that this script function performs is to check for trigger conditions
@@ -660,6 +691,9 @@ private:
     //! \brief Loads all map data contained in the Lua file that defines the map
     bool _Load();
 
+    //! \brief Loads the collision grid and the tile layers, from the compiled map data file when up to date.
+    bool _LoadMapData();
+
     /** Triggers the minimap creation either by trying to load the minimap file given.
     *** Or by creating a minimap procedurally.
     **/
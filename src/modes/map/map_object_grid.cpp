@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_object_grid.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the map objects spatial index.
+*** ***************************************************************************/
+
+#include "modes/map/map_object_grid.h"
+
+#include "modes/map/map_objects/map_object.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace vt_common;
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+MapObjectGrid::MapObjectGrid():
+    _num_cells_x(0),
+    _num_cells_y(0),
+    _query_id(0)
+{}
+
+void MapObjectGrid::Initialize(uint32_t num_grid_x_axis, uint32_t num_grid_y_axis)
+{
+    // Keep the indexed objects, to add them back.
+    std::vector<MapObject*> objects;
+    for (uint32_t i = 0; i < _cells.size(); ++i) {
+        for (uint32_t j = 0; j < _cells[i].size(); ++j) {
+            MapObject* object = _cells[i][j];
+            if (_object_cells[object->GetObjectID()].IsValid()) {
+                _object_cells[object->GetObjectID()] = CellRange();
+                objects.push_back(object);
+            }
+        }
+    }
+
+    _num_cells_x = std::max<uint32_t>(1, (num_grid_x_axis + MAP_OBJECT_GRID_CELL_SIZE - 1) / MAP_OBJECT_GRID_CELL_SIZE);
+    _num_cells_y = std::max<uint32_t>(1, (num_grid_y_axis + MAP_OBJECT_GRID_CELL_SIZE - 1) / MAP_OBJECT_GRID_CELL_SIZE);
+    _cells.clear();
+    _cells.resize(_num_cells_x * _num_cells_y);
+
+    for (uint32_t i = 0; i < objects.size(); ++i)
+        UpdateObject(objects[i]);
+}
+
+void MapObjectGrid::UpdateObject(MapObject* object)
+{
+    if (!object || object->GetObjectID() <= 0)
+        return;
+
+    // Not initialized yet, the objects will be indexed then.
+    if (_cells.empty())
+        Initialize(0, 0);
+
+    uint32_t object_id = static_cast<uint32_t>(object->GetObjectID());
+    if (object_id >= _object_cells.size()) {
+        _object_cells.resize(object_id + 1);
+        _object_queries.resize(object_id + 1, 0);
+    }
+
+    CellRange range = _GetCellRange(object->GetGridCollisionRectangle());
+    CellRange& previous_range = _object_cells[object_id];
+    if (range == previous_range)
+        return;
+
+    if (previous_range.IsValid())
+        _RemoveFromCells(object, previous_range);
+    _AddToCells(object, range);
+    previous_range = range;
+}
+
+void MapObjectGrid::RemoveObject(MapObject* object)
+{
+    if (!object || object->GetObjectID() <= 0)
+        return;
+
+    uint32_t object_id = static_cast<uint32_t>(object->GetObjectID());
+    if (object_id >= _object_cells.size() || !_object_cells[object_id].IsValid())
+        return;
+
+    _RemoveFromCells(object, _object_cells[object_id]);
+    _object_cells[object_id] = CellRange();
+}
+
+void MapObjectGrid::GetObjects(const Rectangle2D& rect, std::vector<MapObject*>& objects)
+{
+    if (_cells.empty())
+        return;
+
+    // Start a new query. The objects appended by the previous ones are skipped
+    // only if they have the same query id, so reset them all when it wraps around.
+    if (++_query_id == 0) {
+        std::fill(_object_queries.begin(), _object_queries.end(), 0);
+        _query_id = 1;
+    }
+
+    CellRange range = _GetCellRange(rect);
+    for (int32_t y = range.top; y <= range.bottom; ++y) {
+        for (int32_t x = range.left; x <= range.right; ++x) {
+            const std::vector<MapObject*>& cell = _cells[y * _num_cells_x + x];
+            for (uint32_t i = 0; i < cell.size(); ++i) {
+                uint32_t& object_query = _object_queries[cell[i]->GetObjectID()];
+                if (object_query == _query_id)
+                    continue;
+                object_query = _query_id;
+                objects.push_back(cell[i]);
+            }
+        }
+    }
+}
+
+void MapObjectGrid::Clear()
+{
+    _num_cells_x = 0;
+    _num_cells_y = 0;
+    _cells.clear();
+    _object_cells.clear();
+    _object_queries.clear();
+    _query_id = 0;
+}
+
+//! \brief Returns the cell index of a coordinate, clamped to the given maximum index.
+static int32_t _GetCellIndex(float coordinate, uint32_t max_index)
+{
+    float index = std::floor(coordinate / static_cast<float>(MAP_OBJECT_GRID_CELL_SIZE));
+    return static_cast<int32_t>(std::min(static_cast<float>(max_index), std::max(0.0f, index)));
+}
+
+MapObjectGrid::CellRange MapObjectGrid::_GetCellRange(const Rectangle2D& rect) const
+{
+    CellRange range;
+    range.left = _GetCellIndex(rect.left, _num_cells_x - 1);
+    range.right = _GetCellIndex(rect.right, _num_cells_x - 1);
+    range.top = _GetCellIndex(rect.top, _num_cells_y - 1);
+    range.bottom = _GetCellIndex(rect.bottom, _num_cells_y - 1);
+    return range;
+}
+
+void MapObjectGrid::_AddToCells(MapObject* object, const CellRange& range)
+{
+    for (int32_t y = range.top; y <= range.bottom; ++y) {
+        for (int32_t x = range.left; x <= range.right; ++x)
+            _cells[y * _num_cells_x + x].push_back(object);
+    }
+}
+
+void MapObjectGrid::_RemoveFromCells(MapObject* object, const CellRange& range)
+{
+    for (int32_t y = range.top; y <= range.bottom; ++y) {
+        for (int32_t x = range.left; x <= range.right; ++x) {
+            std::vector<MapObject*>& cell = _cells[y * _num_cells_x + x];
+            std::vector<MapObject*>::iterator it = std::find(cell.begin(), cell.end(), object);
+            if (it == cell.end())
+                continue;
+            // The cells order doesn't matter.
+            *it = cell.back();
+            cell.pop_back();
+        }
+    }
+}
+
+} // namespace private_map
+
+} // namespace vt_map
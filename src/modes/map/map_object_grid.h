@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_object_grid.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the map objects spatial index.
+***
+*** The map is split into square cells of a few collision grid elements, each
+*** listing the objects whose collision rectangle overlaps it. The collision
+*** and interaction searches then only test the objects of the cells around
+*** the searched area, instead of every object of the draw layer.
+*** ***************************************************************************/
+
+#ifndef __MAP_OBJECT_GRID_HEADER__
+#define __MAP_OBJECT_GRID_HEADER__
+
+#include "common/rectangle_2d.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+class MapObject;
+
+//! \brief The size of the object grid cells, in collision grid elements.
+const uint32_t MAP_OBJECT_GRID_CELL_SIZE = 4;
+
+/** ****************************************************************************
+*** \brief A uniform grid indexing the map objects of a draw layer by collision rectangle.
+***
+*** The objects are moved within the grid by the object supervisor each time
+*** their position or collision size changes. Only the cells an object leaves
+*** or enters are updated.
+*** ***************************************************************************/
+class MapObjectGrid
+{
+public:
+    MapObjectGrid();
+
+    /** \brief Sets the size of the indexed area, in collision grid elements.
+    *** The objects already in the grid are indexed again.
+    *** The objects outside of the area are kept in the border cells.
+    **/
+    void Initialize(uint32_t num_grid_x_axis, uint32_t num_grid_y_axis);
+
+    //! \brief Adds the object to the grid, or moves it according to its current collision rectangle.
+    void UpdateObject(MapObject* object);
+
+    void RemoveObject(MapObject* object);
+
+    /** \brief Appends to the given vector the objects that may intersect with the given rectangle.
+    *** Each object is only appended once, but their collision rectangle still has to be checked.
+    **/
+    void GetObjects(const vt_common::Rectangle2D& rect, std::vector<MapObject*>& objects);
+
+    void Clear();
+
+private:
+    //! \brief The range of cells covered by an object, bounds included.
+    struct CellRange {
+        CellRange():
+            left(0),
+            top(0),
+            right(-1),
+            bottom(-1)
+        {}
+
+        bool IsValid() const {
+            return right >= left && bottom >= top;
+        }
+
+        bool operator==(const CellRange& range) const {
+            return left == range.left && top == range.top && right == range.right && bottom == range.bottom;
+        }
+
+        int32_t left;
+        int32_t top;
+        int32_t right;
+        int32_t bottom;
+    };
+
+    //! \brief The number of cells on each axis.
+    uint32_t _num_cells_x;
+    uint32_t _num_cells_y;
+
+    //! \brief The objects overlapping each cell, row after row.
+    std::vector<std::vector<MapObject*> > _cells;
+
+    //! \brief The cells covered by each indexed object, by object id. Invalid when not indexed.
+    std::vector<CellRange> _object_cells;
+
+    /** \brief The last query each object was appended by, by object id,
+    *** used to append the objects covering several cells only once.
+    **/
+    std::vector<uint32_t> _object_queries;
+    uint32_t _query_id;
+
+    //! \brief Returns the range of cells covered by the given rectangle, clamped to the grid.
+    CellRange _GetCellRange(const vt_common::Rectangle2D& rect) const;
+
+    void _AddToCells(MapObject* object, const CellRange& range);
+    void _RemoveFromCells(MapObject* object, const CellRange& range);
+};
+
+} // namespace private_map
+
+} // namespace vt_map
+
+#endif // __MAP_OBJECT_GRID_HEADER__
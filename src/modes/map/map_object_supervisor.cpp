@@ -18,14 +18,24 @@
 #include "modes/map/map_objects/map_escape_point.h"
 #include "modes/map/map_objects/map_sound.h"
 #include "modes/map/map_objects/map_treasure.h"
+#include "modes/map/map_objects/map_trigger.h"
+#include "modes/map/map_objects/map_particle.h"
 
 #include "modes/map/map_sprites/map_enemy_sprite.h"
 #include "modes/map/map_zones.h"
+#include "modes/map/map_data_file.h"
+#include "modes/map/map_flow_field.h"
 
 #include "common/global/global.h"
 
+#include "engine/memory_accounting.h"
+#include "engine/system.h"
+#include "engine/telemetry.h"
+
 #include "utils/utils_numeric.h"
 
+#include <cmath>
+
 using namespace vt_common;
 
 namespace vt_map
@@ -34,11 +44,20 @@ namespace vt_map
 namespace private_map
 {
 
+//! \brief The number of groups the distant objects are split into, each one being updated every that many frames.
+const uint32_t DISTANT_OBJECTS_UPDATE_INTERVAL = 4;
+
+//! \brief How far from the screen edges, in collision grid elements, the objects are considered distant.
+const float DISTANT_OBJECTS_MARGIN = HALF_SCREEN_GRID_X_LENGTH;
+
 ObjectSupervisor::ObjectSupervisor() :
     _num_grid_x_axis(0),
     _num_grid_y_axis(0),
     _last_id(1), //! Every object Id must be > 0 since 0 is reserved for speakerless dialogues.
-    _visible_party_member(nullptr)
+    _visible_party_member(nullptr),
+    _object_grids_enabled(true),
+    _update_frame(0),
+    _distant_update_times(DISTANT_OBJECTS_UPDATE_INTERVAL, 0)
 {}
 
 ObjectSupervisor::~ObjectSupervisor()
@@ -51,6 +70,8 @@ ObjectSupervisor::~ObjectSupervisor()
     for(uint32_t i = 0; i < _zones.size(); ++i) {
         delete(_zones[i]);
     }
+
+    _ClearChaseFlowFields();
 }
 
 MapObject* ObjectSupervisor::GetObject(uint32_t object_id)
@@ -105,8 +126,10 @@ void ObjectSupervisor::RegisterObject(MapObject* object)
         break;
     case NO_LAYER_OBJECT:
     default: // Nothing to do. the object is registered in all objects only.
-        break;
+        return;
     }
+
+    UpdateObjectGrid(object);
 }
 
 void ObjectSupervisor::AddAmbientSound(SoundObject* object)
@@ -183,6 +206,9 @@ void ObjectSupervisor::DeleteObject(MapObject* object)
         }
     }
 
+    if (object->GetObjectDrawLayer() != NO_LAYER_OBJECT)
+        _GetObjectGridFromDrawLayer(object->GetObjectDrawLayer()).RemoveObject(object);
+
     std::vector<MapObject*>::iterator it;
     std::vector<MapObject*>::iterator it_end;
     std::vector<MapObject*>* to_iterate = nullptr;
@@ -223,12 +249,67 @@ void ObjectSupervisor::DeleteObject(MapObject* object)
     delete object;
 }
 
+void ObjectSupervisor::UpdateObjectGrid(MapObject* object)
+{
+    // The objects without layer are never collided with.
+    if (!object || object->GetObjectDrawLayer() == NO_LAYER_OBJECT)
+        return;
+
+    _GetObjectGridFromDrawLayer(object->GetObjectDrawLayer()).UpdateObject(object);
+}
+
+//! \brief The ratio of moved objects above which a draw layer is fully sorted again.
+const uint32_t FULL_SORT_OBJECTS_RATIO = 8;
+
+//! \brief Sorts the layer objects by y position, and returns the number of moved ones.
+//! The extents the objects images reach above and below their position are also given.
+static uint32_t _SortLayerObjects(std::vector<MapObject*>& objects, float& extent_above, float& extent_below)
+{
+    uint32_t dirty_objects = 0;
+    extent_above = 0.0f;
+    extent_below = 0.0f;
+    for(uint32_t i = 0; i < objects.size(); ++i) {
+        MapObject* object = objects[i];
+        if(object->IsDrawOrderDirty()) {
+            ++dirty_objects;
+            object->ClearDrawOrderDirty();
+        }
+
+        Rectangle2D image_rect = object->GetGridImageRectangle();
+        extent_above = std::max(extent_above, object->GetYPosition() - image_rect.top);
+        extent_below = std::max(extent_below, image_rect.bottom - object->GetYPosition());
+    }
+
+    if(dirty_objects == 0)
+        return 0;
+
+    if(dirty_objects * FULL_SORT_OBJECTS_RATIO > objects.size()) {
+        std::sort(objects.begin(), objects.end(), MapObject_Ptr_Less());
+        return dirty_objects;
+    }
+
+    // Only a few objects moved, usually by a bit: put them back in place with an insertion sort.
+    MapObject_Ptr_Less less;
+    for(uint32_t i = 1; i < objects.size(); ++i) {
+        MapObject* object = objects[i];
+        uint32_t j = i;
+        for(; j > 0 && less(object, objects[j - 1]); --j)
+            objects[j] = objects[j - 1];
+        objects[j] = object;
+    }
+    return dirty_objects;
+}
+
 void ObjectSupervisor::SortObjects()
 {
-    std::sort(_flat_ground_objects.begin(), _flat_ground_objects.end(), MapObject_Ptr_Less());
-    std::sort(_ground_objects.begin(), _ground_objects.end(), MapObject_Ptr_Less());
-    std::sort(_pass_objects.begin(), _pass_objects.end(), MapObject_Ptr_Less());
-    std::sort(_sky_objects.begin(), _sky_objects.end(), MapObject_Ptr_Less());
+    vt_system::TelemetryScope sort_scope(vt_system::TELEMETRY_MAP_SORT_TIME);
+
+    uint32_t sorted_objects = _SortLayerObjects(_flat_ground_objects, _flat_ground_image_extents.above,
+                                                _flat_ground_image_extents.below);
+    sorted_objects += _SortLayerObjects(_ground_objects, _ground_image_extents.above, _ground_image_extents.below);
+    sorted_objects += _SortLayerObjects(_pass_objects, _pass_image_extents.above, _pass_image_extents.below);
+    sorted_objects += _SortLayerObjects(_sky_objects, _sky_image_extents.above, _sky_image_extents.below);
+    vt_system::SystemManager->GetTelemetry().SetValue(vt_system::TELEMETRY_MAP_SORTED_OBJECTS, sorted_objects);
 }
 
 bool ObjectSupervisor::Load(vt_script::ReadScriptDescriptor &map_file)
@@ -247,23 +328,63 @@ bool ObjectSupervisor::Load(vt_script::ReadScriptDescriptor &map_file)
     }
     map_file.CloseTable();
     _num_grid_x_axis = _collision_grid[0].size();
+
+    _collision_bitmap.Initialize(_collision_grid);
+    _InitializeObjectGrids();
+    return true;
+}
+
+bool ObjectSupervisor::Load(MapDataFile &map_data)
+{
+    if(map_data.GetNumGridRows() == 0 || map_data.GetNumGridCols() == 0) {
+        PRINT_ERROR << "No map grid found in map file: " << map_data.GetFilename() << std::endl;
+        return false;
+    }
+
+    _num_grid_y_axis = map_data.GetNumGridRows();
+    _num_grid_x_axis = map_data.GetNumGridCols();
+
+    // Take the collisions over when the map loader built them in the background.
+    std::map<std::pair<float, float>, PathHierarchy*> hierarchies;
+    if(map_data.AreCollisionsBuilt()) {
+        map_data.TakeCollisions(_collision_grid, _collision_bitmap, hierarchies);
+    }
+    else {
+        _collision_grid.resize(_num_grid_y_axis);
+        for(uint16_t y = 0; y < _num_grid_y_axis; ++y)
+            map_data.ReadCollisionRow(y, _collision_grid[y]);
+        _collision_bitmap.Initialize(_collision_grid);
+    }
+
+    _InitializeObjectGrids();
+    _path_finder.AddHierarchies(hierarchies);
     return true;
 }
 
 void ObjectSupervisor::Update()
 {
-    for(uint32_t i = 0; i < _flat_ground_objects.size(); ++i)
-        _flat_ground_objects[i]->Update();
-    for(uint32_t i = 0; i < _ground_objects.size(); ++i)
-        _ground_objects[i]->Update();
+    // Deliver the paths found since the last frame. The chase flow fields are
+    // computed again once the hierarchies take the changed walls in account.
+    if(_path_finder.Update())
+        _ClearChaseFlowFields();
+
+    // Count the time elapsed for each group of distant objects, and start a new frame.
+    uint32_t update_time = vt_system::SystemManager->GetUpdateTime();
+    for(uint32_t i = 0; i < _distant_update_times.size(); ++i)
+        _distant_update_times[i] += update_time;
+    ++_update_frame;
+
+    _UpdateLayerObjects(_flat_ground_objects);
+    _UpdateLayerObjects(_ground_objects);
 
     // Update map points animation and activeness.
     _UpdateMapPoints();
 
-    for(uint32_t i = 0; i < _pass_objects.size(); ++i)
-        _pass_objects[i]->Update();
-    for(uint32_t i = 0; i < _sky_objects.size(); ++i)
-        _sky_objects[i]->Update();
+    _UpdateLayerObjects(_pass_objects);
+    _UpdateLayerObjects(_sky_objects);
+
+    // The distant objects updated this frame start counting their time again.
+    _distant_update_times[_update_frame % _distant_update_times.size()] = 0;
     for(uint32_t i = 0; i < _halos.size(); ++i)
         _halos[i]->Update();
     for(uint32_t i = 0; i < _lights.size(); ++i)
@@ -286,14 +407,20 @@ void ObjectSupervisor::DrawMapPoints()
 
 void ObjectSupervisor::DrawFlatGroundObjects()
 {
-    for(uint32_t i = 0; i < _flat_ground_objects.size(); ++i) {
+    uint32_t first = 0;
+    uint32_t last = 0;
+    _GetVisibleObjects(_flat_ground_objects, _flat_ground_image_extents, first, last);
+    for(uint32_t i = first; i < last; ++i) {
         _flat_ground_objects[i]->Draw();
     }
 }
 
 void ObjectSupervisor::DrawGroundObjects(const bool second_pass)
 {
-    for(uint32_t i = 0; i < _ground_objects.size(); i++) {
+    uint32_t first = 0;
+    uint32_t last = 0;
+    _GetVisibleObjects(_ground_objects, _ground_image_extents, first, last);
+    for(uint32_t i = first; i < last; i++) {
         if(_ground_objects[i]->IsDrawOnSecondPass() == second_pass) {
             _ground_objects[i]->Draw();
         }
@@ -302,18 +429,73 @@ void ObjectSupervisor::DrawGroundObjects(const bool second_pass)
 
 void ObjectSupervisor::DrawPassObjects()
 {
-    for(uint32_t i = 0; i < _pass_objects.size(); i++) {
+    uint32_t first = 0;
+    uint32_t last = 0;
+    _GetVisibleObjects(_pass_objects, _pass_image_extents, first, last);
+    for(uint32_t i = first; i < last; i++) {
         _pass_objects[i]->Draw();
     }
 }
 
 void ObjectSupervisor::DrawSkyObjects()
 {
-    for(uint32_t i = 0; i < _sky_objects.size(); i++) {
+    uint32_t first = 0;
+    uint32_t last = 0;
+    _GetVisibleObjects(_sky_objects, _sky_image_extents, first, last);
+    for(uint32_t i = first; i < last; i++) {
         _sky_objects[i]->Draw();
     }
 }
 
+void ObjectSupervisor::_UpdateLayerObjects(std::vector<MapObject*>& objects)
+{
+    Rectangle2D near_edges = MapMode::CurrentInstance()->GetMapFrame().screen_edges;
+    near_edges.left -= DISTANT_OBJECTS_MARGIN;
+    near_edges.right += DISTANT_OBJECTS_MARGIN;
+    near_edges.top -= DISTANT_OBJECTS_MARGIN;
+    near_edges.bottom += DISTANT_OBJECTS_MARGIN;
+
+    uint32_t update_group = _update_frame % _distant_update_times.size();
+    for(uint32_t i = 0; i < objects.size(); ++i) {
+        MapObject* object = objects[i];
+
+        // Only the plain physical objects are updated less often: the other ones
+        // may be moved or controlled by the map scripts.
+        if(object->GetObjectType() != PHYSICAL_TYPE || object->GetGridImageRectangle().IntersectsWith(near_edges)) {
+            object->Update();
+            continue;
+        }
+
+        if(object->GetObjectID() % _distant_update_times.size() != update_group)
+            continue;
+
+        static_cast<PhysicalObject*>(object)->Update(_distant_update_times[update_group]);
+    }
+}
+
+//! \brief Tells whether the object is above the given y position.
+static bool _IsObjectAbove(const MapObject* object, float y)
+{
+    return object->GetYPosition() < y;
+}
+
+//! \brief Tells whether the given y position is above the object.
+static bool _IsObjectBelow(float y, const MapObject* object)
+{
+    return y < object->GetYPosition();
+}
+
+void ObjectSupervisor::_GetVisibleObjects(const std::vector<MapObject*>& objects, const ImageExtents& extents,
+                                          uint32_t& first, uint32_t& last) const
+{
+    // The objects images only reach the screen from that far above or below it.
+    const Rectangle2D& screen_edges = MapMode::CurrentInstance()->GetMapFrame().screen_edges;
+    first = std::lower_bound(objects.begin(), objects.end(), screen_edges.top - extents.below, _IsObjectAbove)
+            - objects.begin();
+    last = std::upper_bound(objects.begin() + first, objects.end(), screen_edges.bottom + extents.above, _IsObjectBelow)
+           - objects.begin();
+}
+
 void ObjectSupervisor::DrawLights()
 {
     for(uint32_t i = 0; i < _halos.size(); ++i)
@@ -469,6 +651,55 @@ std::vector<MapObject*>& ObjectSupervisor::_GetObjectsFromDrawLayer(MapObjectDra
     }
 }
 
+MapObjectGrid& ObjectSupervisor::_GetObjectGridFromDrawLayer(MapObjectDrawLayer layer)
+{
+    switch(layer)
+    {
+    case FLATGROUND_OBJECT:
+        return _flat_ground_object_grid;
+    default:
+    case GROUND_OBJECT:
+        return _ground_object_grid;
+    case PASS_OBJECT:
+        return _pass_object_grid;
+    case SKY_OBJECT:
+        return _sky_object_grid;
+    }
+}
+
+const std::vector<MapObject*>& ObjectSupervisor::_GetObjectsAround(MapObjectDrawLayer layer, const Rectangle2D& rect)
+{
+    if (!_object_grids_enabled)
+        return _GetObjectsFromDrawLayer(layer);
+
+    _objects_around.clear();
+    _GetObjectGridFromDrawLayer(layer).GetObjects(rect, _objects_around);
+
+    // Keep the draw order, as when going through the whole layer.
+    std::sort(_objects_around.begin(), _objects_around.end(), MapObject_Ptr_Less());
+    return _objects_around;
+}
+
+void ObjectSupervisor::_InitializeObjectGrids()
+{
+    _flat_ground_object_grid.Initialize(_num_grid_x_axis, _num_grid_y_axis);
+    _ground_object_grid.Initialize(_num_grid_x_axis, _num_grid_y_axis);
+    _pass_object_grid.Initialize(_num_grid_x_axis, _num_grid_y_axis);
+    _sky_object_grid.Initialize(_num_grid_x_axis, _num_grid_y_axis);
+
+    // The path finder works on a copy of the collision walls
+    _ClearChaseFlowFields();
+    _path_finder.Initialize(_collision_bitmap, _num_grid_x_axis, _num_grid_y_axis);
+}
+
+void ObjectSupervisor::_ClearChaseFlowFields()
+{
+    std::map<const PathHierarchy*, ChaseFlowField*>::iterator it = _chase_flow_fields.begin();
+    for(; it != _chase_flow_fields.end(); ++it)
+        delete it->second;
+    _chase_flow_fields.clear();
+}
+
 MapObject *ObjectSupervisor::FindNearestInteractionObject(const VirtualSprite *sprite, float search_distance)
 {
     if(!sprite)
@@ -497,10 +728,10 @@ MapObject *ObjectSupervisor::FindNearestInteractionObject(const VirtualSprite *s
 
     // A vector to hold objects which are inside the search area (either partially or fully)
     std::vector<MapObject *> valid_objects;
-    // A pointer to the vector of objects to search
-    std::vector<MapObject *>* search_vector = &_GetObjectsFromDrawLayer(sprite->GetObjectDrawLayer());
+    // Only the objects around the search area are searched
+    const std::vector<MapObject *>& search_vector = _GetObjectsAround(sprite->GetObjectDrawLayer(), search_area);
 
-    for(std::vector<MapObject *>::iterator it = (*search_vector).begin(); it != (*search_vector).end(); ++it) {
+    for(std::vector<MapObject *>::const_iterator it = search_vector.begin(); it != search_vector.end(); ++it) {
         if(*it == sprite)  // Don't allow the sprite itself to be considered in the search
             continue;
 
@@ -633,20 +864,17 @@ COLLISION_TYPE ObjectSupervisor::DetectCollision(MapObject* object,
     if(object->GetObjectDrawLayer() != vt_map::SKY_OBJECT && object->GetCollisionMask() & WALL_COLLISION) {
         // Determine if the object's collision rectangle overlaps any unwalkable tiles
         // Note that because the sprite's collision rectangle was previously determined to be within the map bounds,
-        // the map grid tile indeces referenced in this loop are all valid entries and do not need to be checked for out-of-bounds conditions
-        for(uint32_t y = static_cast<uint32_t>(sprite_rect.top); y <= static_cast<uint32_t>(sprite_rect.bottom); ++y) {
-            for(uint32_t x = static_cast<uint32_t>(sprite_rect.left); x <= static_cast<uint32_t>(sprite_rect.right); ++x) {
-                // Checks the collision grid at the row-column at the object's current context
-                if(_collision_grid[y][x] > 0)
-                    return WALL_COLLISION;
-            }
-        }
+        // the map grid tile indeces referenced here are all valid entries and do not need to be checked for out-of-bounds conditions
+        if(_collision_bitmap.HasWall(static_cast<uint32_t>(sprite_rect.left), static_cast<uint32_t>(sprite_rect.top),
+                                     static_cast<uint32_t>(sprite_rect.right), static_cast<uint32_t>(sprite_rect.bottom)))
+            return WALL_COLLISION;
     }
 
-    std::vector<MapObject *>* objects = &_GetObjectsFromDrawLayer(object->GetObjectDrawLayer());
+    // Only the objects around the collision rectangle are tested
+    const std::vector<MapObject *>& objects = _GetObjectsAround(object->GetObjectDrawLayer(), sprite_rect);
 
     std::vector<vt_map::private_map::MapObject *>::const_iterator it, it_end;
-    for(it = objects->begin(), it_end = objects->end(); it != it_end; ++it) {
+    for(it = objects.begin(), it_end = objects.end(); it != it_end; ++it) {
         MapObject *collision_object = *it;
         // Check if the object exists and has the no_collision property enabled
         if(!collision_object || collision_object->GetCollisionMask() == NO_COLLISION)
@@ -676,182 +904,136 @@ COLLISION_TYPE ObjectSupervisor::DetectCollision(MapObject* object,
     return NO_COLLISION;
 }
 
-Path ObjectSupervisor::FindPath(VirtualSprite *sprite, const Position2D& destination, uint32_t max_cost)
+//! \brief Tests the path positions with the object supervisor collision detection.
+class SpritePathCollisionTest : public PathCollisionTest
 {
-    // NOTE: Refer to the implementation of the A* algorithm to understand
-    // what all these lists and score values are for.
-    static const uint32_t basic_gcost = 10;
+public:
+    SpritePathCollisionTest(ObjectSupervisor* object_supervisor, VirtualSprite* sprite) :
+        _object_supervisor(object_supervisor),
+        _sprite(sprite)
+    {}
 
-    // NOTE(bis): On the outer scope, we'll use float based positions,
-    // but we still use integer positions for path finding.
-    Path path;
+    COLLISION_TYPE DetectCollision(float x, float y)
+    {
+        return _object_supervisor->DetectCollision(_sprite, x, y);
+    }
 
-    if(!MapMode::CurrentInstance()->GetObjectSupervisor()->IsWithinMapBounds(sprite)) {
+private:
+    ObjectSupervisor* _object_supervisor;
+    VirtualSprite* _sprite;
+};
+
+bool ObjectSupervisor::_IsPathSearchValid(VirtualSprite *sprite, const Position2D& destination)
+{
+    if(!IsWithinMapBounds(sprite)) {
         IF_PRINT_WARNING(MAP_DEBUG) << "Sprite position is invalid" << std::endl;
-        return path;
+        return false;
     }
 
     // Return when the destination is unreachable
     if(DetectCollision(sprite, destination.x, destination.y) == WALL_COLLISION)
-        return path;
+        return false;
 
-    if(!MapMode::CurrentInstance()->GetObjectSupervisor()->IsWithinMapBounds(destination.x, destination.y)) {
+    if(!IsWithinMapBounds(destination.x, destination.y)) {
         IF_PRINT_WARNING(MAP_DEBUG) << "Invalid destination coordinates" << std::endl;
-        return path;
+        return false;
     }
 
-    // The starting node of this path discovery
-    PathNode source_node(static_cast<int16_t>(sprite->GetXPosition()), static_cast<int16_t>(sprite->GetYPosition()));
-    // The ending node.
-    PathNode dest(static_cast<int16_t>(destination.x), static_cast<int16_t>(destination.y));
-
     // Check that the source node is not the same as the destination node
-    if(source_node == dest) {
+    if(static_cast<int32_t>(sprite->GetXPosition()) == static_cast<int32_t>(destination.x)
+            && static_cast<int32_t>(sprite->GetYPosition()) == static_cast<int32_t>(destination.y)) {
         PRINT_ERROR << "source node coordinates are the same as the destination" << std::endl;
-        // return an empty path.
-        return path;
+        return false;
     }
 
-    std::vector<PathNode> open_list;
-    std::vector<PathNode> closed_list;
-
-    // The current "best node"
-    PathNode best_node;
-    // Used to hold the eight adjacent nodes
-    PathNode nodes[8];
-
-    // Temporary delta variables used in calculation of a node's heuristic (h score)
-    uint32_t x_delta, y_delta;
-    // The number to add to a node's g_score, depending on whether it is a lateral or diagonal movement
-    int16_t g_add;
+    return true;
+}
 
-    open_list.push_back(source_node);
+Path ObjectSupervisor::FindPath(VirtualSprite *sprite, const Position2D& destination, uint32_t max_cost)
+{
+    Path path;
+    if(!_IsPathSearchValid(sprite, destination))
+        return path;
 
-    // We will try to keep the original offset all along.
-    float offset_x = vt_utils::GetFloatFraction(destination.x);
-    float offset_y = vt_utils::GetFloatFraction(destination.y);
+    const PathHierarchy* hierarchy = nullptr;
+    if(sprite->GetObjectDrawLayer() != SKY_OBJECT && (sprite->GetCollisionMask() & WALL_COLLISION))
+        hierarchy = _path_finder.GetHierarchy(sprite->GetCollGridHalfWidth(), sprite->GetCollGridHeight());
 
-    while(open_list.empty() == false) {
-        sort(open_list.begin(), open_list.end());
-        best_node = open_list.back();
-        open_list.pop_back();
-        closed_list.push_back(best_node);
+    SpritePathCollisionTest collision_test(this, sprite);
+    if(!_path_search.FindPath(_num_grid_x_axis, _num_grid_y_axis, sprite->GetPosition(), destination,
+                              max_cost, collision_test, path, hierarchy)) {
+        IF_PRINT_WARNING(MAP_DEBUG) << "could not find path to destination" << std::endl;
+    }
 
-        // Check if destination has been reached, and break out of the loop if so
-        if(best_node == dest)
-            break;
+    return path;
+}
 
-        // Setup the coordinates of the 8 adjacent nodes to the best node
-        nodes[0].tile_x = best_node.tile_x - 1;
-        nodes[0].tile_y = best_node.tile_y;
-        nodes[1].tile_x = best_node.tile_x + 1;
-        nodes[1].tile_y = best_node.tile_y;
-        nodes[2].tile_x = best_node.tile_x;
-        nodes[2].tile_y = best_node.tile_y - 1;
-        nodes[3].tile_x = best_node.tile_x;
-        nodes[3].tile_y = best_node.tile_y + 1;
-        nodes[4].tile_x = best_node.tile_x - 1;
-        nodes[4].tile_y = best_node.tile_y - 1;
-        nodes[5].tile_x = best_node.tile_x - 1;
-        nodes[5].tile_y = best_node.tile_y + 1;
-        nodes[6].tile_x = best_node.tile_x + 1;
-        nodes[6].tile_y = best_node.tile_y - 1;
-        nodes[7].tile_x = best_node.tile_x + 1;
-        nodes[7].tile_y = best_node.tile_y + 1;
-
-        // Check the eight adjacent nodes
-        for(uint8_t i = 0; i < 8; ++i) {
-            // ---------- (A): Check if all tiles are walkable
-            // Don't use 0.0f here for both since errors at the border between
-            // two positions may occure, especially when running.
-            COLLISION_TYPE collision_type = DetectCollision(sprite,
-                                            ((float)nodes[i].tile_x) + offset_x,
-                                            ((float)nodes[i].tile_y) + offset_y);
-
-            // Can't go through walls.
-            if(collision_type == WALL_COLLISION)
-                continue;
+uint32_t ObjectSupervisor::RequestPath(VirtualSprite *sprite, const Position2D& destination, uint32_t max_cost)
+{
+    if(!_IsPathSearchValid(sprite, destination))
+        return 0;
 
-            // ---------- (B): If this point has been reached, the node is valid for the sprite to move to
-            // If this is a lateral adjacent node, g_score is +10, otherwise diagonal adjacent node is +14
-            if(i < 4)
-                g_add = basic_gcost;
-            else
-                g_add = basic_gcost + 4;
-
-            // Add some g cost when there is another sprite there,
-            // so the NPC try to get around when possible,
-            // but will still go through it when there are no other choices.
-            if(collision_type == CHARACTER_COLLISION
-                    || collision_type == ENEMY_COLLISION)
-                g_add += basic_gcost * 2;
-
-            // If the path has reached the maximum length requested, we abort the path
-            if (max_cost > 0 && (uint32_t)(best_node.g_score + g_add) >= max_cost * basic_gcost)
-                return path;
-
-            // ---------- (C): Check if the node is already in the closed list
-            if(find(closed_list.begin(), closed_list.end(), nodes[i]) != closed_list.end())
+    PathRequest* request = new PathRequest();
+    request->source = sprite->GetPosition();
+    request->destination = destination;
+    request->max_cost = max_cost;
+    request->coll_grid_half_width = sprite->GetCollGridHalfWidth();
+    request->coll_grid_height = sprite->GetCollGridHeight();
+    request->collision_mask = sprite->GetCollisionMask();
+    request->check_walls = (sprite->GetObjectDrawLayer() != SKY_OBJECT);
+
+    const Rectangle2D& screen_edges = MapMode::CurrentInstance()->GetMapFrame().screen_edges;
+    request->on_screen = request->source.x >= screen_edges.left && request->source.x <= screen_edges.right
+                         && request->source.y >= screen_edges.top && request->source.y <= screen_edges.bottom;
+
+    // Copy the objects the sprite could collide with, as DetectCollision() would find them.
+    if(request->collision_mask != NO_COLLISION) {
+        const std::vector<MapObject*>& objects = _GetObjectsFromDrawLayer(sprite->GetObjectDrawLayer());
+        for(uint32_t i = 0; i < objects.size(); ++i) {
+            MapObject* object = objects[i];
+            if(!object || object == sprite || object->GetCollisionMask() == NO_COLLISION)
                 continue;
 
-            // Set the node's parent and calculate its g_score
-            nodes[i].parent_x = best_node.tile_x;
-            nodes[i].parent_y = best_node.tile_y;
-            nodes[i].g_score = best_node.g_score + g_add;
-
-            // ---------- (D): Check to see if the node is already on the open list and update it if necessary
-            std::vector<PathNode>::iterator iter = std::find(open_list.begin(), open_list.end(), nodes[i]);
-            if(iter != open_list.end()) {
-                // If its G is higher, it means that the path we are on is better, so switch the parent
-                if(iter->g_score > nodes[i].g_score) {
-                    iter->g_score = nodes[i].g_score;
-                    iter->f_score = nodes[i].g_score + iter->h_score;
-                    iter->parent_x = nodes[i].parent_x;
-                    iter->parent_y = nodes[i].parent_y;
-                }
-            }
-            // ---------- (E): Add the new node to the open list
-            else {
-                // Calculate the H and F score of the new node (the heuristic used is diagonal)
-                x_delta = abs(dest.tile_x - nodes[i].tile_x);
-                y_delta = abs(dest.tile_y - nodes[i].tile_y);
-                if(x_delta > y_delta)
-                    nodes[i].h_score = 14 * y_delta + 10 * (x_delta - y_delta);
-                else
-                    nodes[i].h_score = 14 * x_delta + 10 * (y_delta - x_delta);
-
-                nodes[i].f_score = nodes[i].g_score + nodes[i].h_score;
-                open_list.push_back(nodes[i]);
-            }
-        } // for (uint8_t i = 0; i < 8; ++i)
-    } // while (open_list.empty() == false)
-
-    if(open_list.empty()) {
-        IF_PRINT_WARNING(MAP_DEBUG) << "could not find path to destination" << std::endl;
-        return path;
+            COLLISION_TYPE collision = GetCollisionFromObjectType(object);
+            if(request->collision_mask & collision)
+                request->obstacles.push_back(PathObstacle(object->GetGridCollisionRectangle(), collision));
+        }
     }
 
-    // Add the destination node to the vector.
-    path.push_back(destination);
+    return _path_finder.AddRequest(request);
+}
 
-    // Retain the last node parent, and remove it from the closed list
-    int16_t parent_x = best_node.parent_x;
-    int16_t parent_y = best_node.parent_y;
-    closed_list.pop_back();
+void ObjectSupervisor::PreparePathHierarchies()
+{
+    for(uint32_t i = 0; i < _all_objects.size(); ++i) {
+        MapObject* object = _all_objects[i];
+        if(!object)
+            continue;
 
-    // Go backwards through the closed list following the parent nodes to construct the path
-    for(std::vector<PathNode>::iterator iter = closed_list.end() - 1; iter != closed_list.begin(); --iter) {
-        if(iter->tile_y == parent_y && iter->tile_x == parent_x) {
-            Position2D next_pos(((float)iter->tile_x) + offset_x, ((float)iter->tile_y) + offset_y);
-            path.push_back(next_pos);
+        MAP_OBJECT_TYPE type = object->GetObjectType();
+        if(type != VIRTUAL_TYPE && type != SPRITE_TYPE && type != ENEMY_TYPE)
+            continue;
 
-            parent_x = iter->parent_x;
-            parent_y = iter->parent_y;
-        }
+        if(object->GetObjectDrawLayer() == SKY_OBJECT || !(object->GetCollisionMask() & WALL_COLLISION))
+            continue;
+
+        _path_finder.GetHierarchy(object->GetCollGridHalfWidth(), object->GetCollGridHeight());
     }
-    std::reverse(path.begin(), path.end());
+}
 
-    return path;
+bool ObjectSupervisor::GetChaseDestination(VirtualSprite *sprite, const Position2D& target, Position2D& destination)
+{
+    if(!sprite || sprite->GetObjectDrawLayer() == SKY_OBJECT || !(sprite->GetCollisionMask() & WALL_COLLISION))
+        return false;
+
+    const PathHierarchy* hierarchy = _path_finder.GetHierarchy(sprite->GetCollGridHalfWidth(),
+                                                               sprite->GetCollGridHeight());
+    ChaseFlowField*& flow_field = _chase_flow_fields[hierarchy];
+    if(!flow_field)
+        flow_field = new ChaseFlowField(hierarchy);
+
+    flow_field->SetTarget(target);
+    return flow_field->GetNextPosition(sprite->GetPosition(), destination);
 }
 
 void ObjectSupervisor::ReloadVisiblePartyMember()
@@ -901,7 +1083,7 @@ void ObjectSupervisor::DrawCollisionArea(const MapFrame *frame)
             x < static_cast<uint32_t>((frame->tile_x_start + frame->num_draw_x_axis) * 2); ++x) {
 
             // Draw the collision rectangle.
-            if (_collision_grid[y][x] > 0)
+            if (_collision_bitmap.IsWall(x, y))
                 vt_video::VideoManager->DrawRectangle(GRID_LENGTH, GRID_LENGTH,
                                                       vt_video::Color(1.0f, 0.0f, 0.0f, 0.6f));
 
@@ -912,6 +1094,23 @@ void ObjectSupervisor::DrawCollisionArea(const MapFrame *frame)
     } // y
 }
 
+void ObjectSupervisor::SetMapCollision(uint32_t x, uint32_t y, bool collision)
+{
+    if(!_collision_bitmap.SetWall(x, y, collision)) {
+        PRINT_WARNING << "Invalid collision grid element: (" << x << ", " << y << ")" << std::endl;
+        return;
+    }
+    _collision_grid[y][x] = collision ? 1 : 0;
+    _path_finder.SetWall(x, y, collision);
+}
+
+uint32_t ObjectSupervisor::GetWallDistance(float x, float y) const
+{
+    if(!IsWithinMapBounds(x, y))
+        return 0;
+    return _collision_bitmap.GetWallDistance(static_cast<uint32_t>(x), static_cast<uint32_t>(y));
+}
+
 bool ObjectSupervisor::IsStaticCollision(float x, float y)
 {
     if (!IsWithinMapBounds(x, y))
@@ -942,6 +1141,41 @@ bool ObjectSupervisor::IsStaticCollision(float x, float y)
     return false;
 }
 
+uint32_t ObjectSupervisor::GetStaticCollisionBits(std::vector<uint32_t>& bits) const
+{
+    bits = _collision_bitmap.GetBits();
+    uint32_t row_words = _collision_bitmap.GetRowWords();
+    if(_num_grid_x_axis == 0 || _num_grid_y_axis == 0)
+        return row_words;
+
+    // Mark the elements the physical objects cover, rather than testing every object for every element.
+    std::vector<vt_map::private_map::MapObject *>::const_iterator it, it_end;
+    for(it = _ground_objects.begin(), it_end = _ground_objects.end(); it != it_end; ++it) {
+        MapObject *collision_object = *it;
+        if(!collision_object || collision_object->GetCollisionMask() == NO_COLLISION)
+            continue;
+
+        if(collision_object->GetObjectType() != PHYSICAL_TYPE)
+            continue;
+
+        // The rectangle bounds are included, as in IsStaticCollision().
+        Rectangle2D rect = collision_object->GetGridCollisionRectangle();
+        if(rect.right < 0.0f || rect.bottom < 0.0f)
+            continue;
+        uint32_t left = static_cast<uint32_t>(std::max(0.0f, std::ceil(rect.left)));
+        uint32_t top = static_cast<uint32_t>(std::max(0.0f, std::ceil(rect.top)));
+        uint32_t right = std::min(static_cast<uint32_t>(rect.right), static_cast<uint32_t>(_num_grid_x_axis - 1));
+        uint32_t bottom = std::min(static_cast<uint32_t>(rect.bottom), static_cast<uint32_t>(_num_grid_y_axis - 1));
+
+        for(uint32_t y = top; y <= bottom; ++y) {
+            for(uint32_t x = left; x <= right; ++x)
+                bits[y * row_words + (x >> 5)] |= (1u << (x & 31));
+        }
+    }
+
+    return row_words;
+}
+
 void ObjectSupervisor::StopSoundObjects()
 {
     for (uint32_t i = 0; i < _sound_object_highest_volumes.size(); ++i) {
@@ -962,6 +1196,93 @@ void ObjectSupervisor::RestartSoundObjects()
     }
 }
 
+void ObjectSupervisor::DEBUG_ReportMemoryUsage(vt_system::MemoryAccounting& accounting,
+                                               const std::string& map_name) const
+{
+    // The object types, indexed by MAP_OBJECT_TYPE, with their name and size.
+    const uint32_t number_types = SCENERY_TYPE + 1;
+    static const char* type_names[number_types] = {
+        "physical objects", "virtual sprites", "sprites", "enemies", "treasures",
+        "save points", "escape points", "triggers", "halos", "lights",
+        "particle objects", "sound objects", "scenery objects"
+    };
+    static const uint32_t type_sizes[number_types] = {
+        sizeof(PhysicalObject), sizeof(VirtualSprite), sizeof(MapSprite), sizeof(EnemySprite),
+        sizeof(TreasureObject), sizeof(SavePoint), sizeof(EscapePoint), sizeof(TriggerObject),
+        sizeof(Halo), sizeof(Light), sizeof(ParticleObject), sizeof(SoundObject), sizeof(MapObject)
+    };
+
+    uint32_t type_counts[number_types] = { 0 };
+    for (uint32_t i = 0; i < _all_objects.size(); ++i) {
+        if (_all_objects[i] == nullptr)
+            continue;
+        MAP_OBJECT_TYPE type = _all_objects[i]->GetObjectType();
+        if (type >= PHYSICAL_TYPE && type <= SCENERY_TYPE)
+            ++type_counts[type];
+    }
+
+    for (uint32_t i = 0; i < number_types; ++i) {
+        if (type_counts[i] == 0)
+            continue;
+        accounting.Report(vt_system::MEMORY_MAP_OBJECTS, map_name + ": " + type_names[i],
+                          static_cast<uint64_t>(type_counts[i]) * type_sizes[i], type_counts[i]);
+    }
+
+    uint64_t grid_bytes = static_cast<uint64_t>(_num_grid_x_axis) * _num_grid_y_axis * sizeof(uint32_t);
+    accounting.Report(vt_system::MEMORY_MAP_OBJECTS, map_name + ": collision grid", grid_bytes);
+
+    uint32_t frames_count = _sprite_animation_cache.GetFramesCount();
+    accounting.Report(vt_system::MEMORY_MAP_OBJECTS, map_name + ": sprite animation frames",
+                      static_cast<uint64_t>(frames_count) * sizeof(vt_video::StillImage), frames_count);
+}
+
+void ObjectSupervisor::DEBUG_BenchmarkCollisions(uint32_t iterations)
+{
+    std::vector<VirtualSprite*> sprites;
+    for (uint32_t i = 0; i < _all_objects.size(); ++i) {
+        MapObject* object = _all_objects[i];
+        if (object && object->GetObjectDrawLayer() != NO_LAYER_OBJECT
+                && (object->GetType() == SPRITE_TYPE || object->GetType() == ENEMY_TYPE))
+            sprites.push_back(static_cast<VirtualSprite*>(object));
+    }
+
+    // Test each sprite collision around its position, as when moving or searching a path,
+    // first with the object grids, then going through the whole draw layers.
+    static const float offsets[9][2] = {
+        { 0.0f, 0.0f }, { -1.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, -1.0f }, { 0.0f, 1.0f },
+        { -1.0f, -1.0f }, { -1.0f, 1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f }
+    };
+    bool object_grids_enabled = _object_grids_enabled;
+    uint64_t durations[2] = { 0, 0 };
+    uint32_t collisions[2] = { 0, 0 };
+    for (uint32_t pass = 0; pass < 2; ++pass) {
+        _object_grids_enabled = (pass == 0);
+
+        uint64_t start = vt_system::FrameTelemetry::GetMicroseconds();
+        for (uint32_t i = 0; i < iterations; ++i) {
+            for (uint32_t j = 0; j < sprites.size(); ++j) {
+                for (uint32_t k = 0; k < 9; ++k) {
+                    if (DetectCollision(sprites[j], sprites[j]->GetXPosition() + offsets[k][0],
+                                        sprites[j]->GetYPosition() + offsets[k][1]) != NO_COLLISION)
+                        ++collisions[pass];
+                }
+            }
+        }
+        durations[pass] = vt_system::FrameTelemetry::GetMicroseconds() - start;
+    }
+    _object_grids_enabled = object_grids_enabled;
+
+    // Always printed, as the benchmark is only run on request.
+    std::cout << "Collision benchmark: " << sprites.size() << " sprites, "
+              << _all_objects.size() << " objects, " << iterations << " iterations" << std::endl
+              << "  with the object grids: " << durations[0] / 1000 << " ms" << std::endl
+              << "  through the whole layers: " << durations[1] / 1000 << " ms" << std::endl;
+
+    if (collisions[0] != collisions[1])
+        PRINT_WARNING << "The collisions detected differ with the object grids: "
+                      << collisions[0] << " instead of " << collisions[1] << std::endl;
+}
+
 } // namespace private_map
 
 } // namespace vt_map
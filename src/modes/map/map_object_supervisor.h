@@ -12,9 +12,17 @@
 #define __MAP_OBJECT_SUPERVISOR_HEADER__
 
 #include "modes/map/map_objects/map_object.h"
+#include "modes/map/map_object_grid.h"
+#include "modes/map/map_collision_bitmap.h"
+#include "modes/map/map_path_finder.h"
+#include "modes/map/map_sprites/map_sprite_animations.h"
 
 #include "script/script_read.h"
 
+namespace vt_system {
+class MemoryAccounting;
+}
+
 namespace vt_map
 {
 
@@ -26,6 +34,8 @@ class SavePoint;
 class EscapePoint;
 class SoundObject;
 class Light;
+class MapDataFile;
+class ChaseFlowField;
 
 /** ****************************************************************************
 *** \brief A helper class to MapMode responsible for management of all object and sprite data
@@ -79,6 +89,10 @@ public:
     //! \brief Delete an object from memory.
     void DeleteObject(MapObject* object);
 
+    //! \brief Moves the object in the collision searches index of its draw layer.
+    //! This is called by the object whenever its position or collision size changes.
+    void UpdateObjectGrid(MapObject* object);
+
     //! \brief Add sound objects (Done within the sound object constructor)
     void AddAmbientSound(SoundObject* object);
 
@@ -102,7 +116,10 @@ public:
     // Called by the Mazone constructor.
     void AddZone(MapZone* zone);
 
-    //! \brief Sorts objects on all three layers according to their draw order
+    /** \brief Sorts objects on all three layers according to their draw order,
+    *** and finds out how far their images reach to only draw the visible ones.
+    *** \note It must be called right before drawing the objects, once they all moved.
+    **/
     void SortObjects();
 
     /** \brief Loads the collision grid data and saved state of all map objects
@@ -115,6 +132,11 @@ public:
     **/
     bool Load(vt_script::ReadScriptDescriptor &map_file);
 
+    /** \brief Loads the collision grid from a compiled map data file, taking over
+    *** the collisions and path hierarchies built in the background, if any.
+    **/
+    bool Load(MapDataFile &map_data);
+
     //! \brief Updates the state of all map zones and objects
     void Update();
 
@@ -194,7 +216,6 @@ public:
     /** \brief Finds a path from a sprite's current position to a destination
     *** \param sprite A pointer of the sprite to find the path for
     *** \param dest The destination coordinates
-    *** \param path A vector of PathNode objects storing the path
     *** \param max_cost Tells how far a path node can be computed agains the starting path node.
     *** This is used to avoid heavy computations.
     *** If this param is equal to 0, there is no limitation.
@@ -209,6 +230,48 @@ public:
                   const vt_common::Position2D& destination,
                   uint32_t max_cost = 0);
 
+    /** \brief Requests a path, searched on a worker thread, instead of finding it right away.
+    *** The sprite surroundings are copied at once, and the path is searched against them.
+    *** \return The ticket used to retrieve the path with GetRequestedPath(),
+    *** or 0 if the path can't be searched, like when the destination is unreachable.
+    **/
+    uint32_t RequestPath(private_map::VirtualSprite *sprite,
+                         const vt_common::Position2D& destination,
+                         uint32_t max_cost = 0);
+
+    /** \brief Gives a requested path, once found. The ticket is invalid afterwards.
+    *** \return The request state. The path is only set when it was found.
+    **/
+    private_map::PATH_REQUEST_STATE GetRequestedPath(uint32_t ticket, Path& path) {
+        return _path_finder.GetPath(ticket, path);
+    }
+
+    //! \brief Cancels a path request no more needed.
+    void CancelPathRequest(uint32_t ticket) {
+        _path_finder.CancelRequest(ticket);
+    }
+
+    /** \brief Builds the path hierarchies used by the sprites of the map, once they're all loaded,
+    *** so that the first long path search doesn't slow down a frame.
+    **/
+    void PreparePathHierarchies();
+
+    /** \brief Gives the sprite collision sizes of the path hierarchies built,
+    *** so that the next map builds them in the background as well.
+    **/
+    void GetPathCollisionSizes(std::vector<std::pair<float, float> >& collision_sizes) const {
+        _path_finder.GetCollisionSizes(collision_sizes);
+    }
+
+    /** \brief Gives the position a sprite chasing the target should head to, so as to get around the walls.
+    *** The chasing sprites of the same collision size share the way to the target,
+    *** only computed again when the target moves to another collision grid element.
+    *** \return false when the sprite should simply head straight to the target.
+    **/
+    bool GetChaseDestination(private_map::VirtualSprite *sprite,
+                             const vt_common::Position2D& target,
+                             vt_common::Position2D& destination);
+
     /** \brief Tells the object supervisor that the given sprite pointer
     *** is the party member object.
     *** This later permits to refresh the sprite shown based on the battle
@@ -256,10 +319,26 @@ public:
     //! \return whether the location would be a "wall" for the party or not
     bool IsStaticCollision(float x, float y);
 
+    /** \brief Packs the static collisions of the whole collision grid, as told by IsStaticCollision(),
+    *** one bit per element, row after row, each row starting on a new 32 bits word.
+    *** \return The number of 32 bits words per row.
+    **/
+    uint32_t GetStaticCollisionBits(std::vector<uint32_t>& bits) const;
+
     //! \brief checks if the location on the grid has a simple map collision. This is different from
     //! IsStaticCollision, in that it DOES NOT check static objects, but only the collision value for the map
     bool IsMapCollision(uint32_t x, uint32_t y)
-    { return (_collision_grid[y][x] > 0); }
+    { return _collision_bitmap.IsWall(x, y); }
+
+    /** \brief Changes whether a collision grid element is a wall, like when a script opens a passage.
+    *** \note The path finder applies the change once the paths being searched are found.
+    **/
+    void SetMapCollision(uint32_t x, uint32_t y, bool collision);
+
+    /** \brief Returns the number of collision grid elements to go through from the given
+    *** position to reach the nearest wall, or 0 when the position is a wall or out of the map.
+    **/
+    uint32_t GetWallDistance(float x, float y) const;
 
     //! \brief returns a const reference to the ground objects in
     const std::vector<MapObject *>& GetGroundObjects() const
@@ -273,6 +352,23 @@ public:
     //! Used when leaving a battle for instance.
     void RestartSoundObjects();
 
+    //! \brief Returns the animations shared by the map sprites.
+    SpriteAnimationCache& GetSpriteAnimationCache() {
+        return _sprite_animation_cache;
+    }
+
+    /** \brief Reports the memory used by the map objects, per object type, the collision grid
+    *** and the sprites shared animations.
+    *** \param map_name The map name, used to prefix the report entries.
+    **/
+    void DEBUG_ReportMemoryUsage(vt_system::MemoryAccounting& accounting, const std::string& map_name) const;
+
+    /** \brief Times the sprites collision detection around their position, with and without the object grids,
+    *** and prints the results. Used to measure the collision searches cost on crowded maps.
+    *** \param iterations The number of times every sprite collision is tested.
+    **/
+    void DEBUG_BenchmarkCollisions(uint32_t iterations);
+
 private:
     //! \brief Returns the nearest map point. Used by FindNearestObject.
     private_map::MapObject* _FindNearestMapPoint(const VirtualSprite* sprite);
@@ -289,6 +385,22 @@ private:
     //! \brief Returns the MapObject vector corresponding to the draw layer.
     std::vector<MapObject*>& _GetObjectsFromDrawLayer(MapObjectDrawLayer layer);
 
+    //! \brief Returns the object grid corresponding to the draw layer.
+    MapObjectGrid& _GetObjectGridFromDrawLayer(MapObjectDrawLayer layer);
+
+    /** \brief Returns the objects of the draw layer that may intersect with the given rectangle,
+    *** in draw order. The returned vector is only valid until the next call.
+    **/
+    const std::vector<MapObject*>& _GetObjectsAround(MapObjectDrawLayer layer, const vt_common::Rectangle2D& rect);
+
+    /** \brief Sets the object grids size, and starts the path finder,
+    *** once the collision grid and its bitmap are loaded.
+    **/
+    void _InitializeObjectGrids();
+
+    //! \brief Tells whether a path can be searched for the sprite, up to the given destination.
+    bool _IsPathSearchValid(private_map::VirtualSprite *sprite, const vt_common::Position2D& destination);
+
     /** \brief The number of rows and columns in the collision grid
     *** The number of collision grid rows and columns is always equal to twice
     *** that of the number of rows and columns of tiles (stored in the TileManager).
@@ -313,6 +425,21 @@ private:
     **/
     std::vector<std::vector<uint32_t> > _collision_grid;
 
+    //! \brief The collision grid walls, packed for the collision detection.
+    private_map::CollisionBitmap _collision_bitmap;
+
+    //! \brief The path search used by FindPath().
+    private_map::PathSearch _path_search;
+
+    //! \brief Searches the paths requested by the sprites on worker threads.
+    private_map::PathFinder _path_finder;
+
+    //! \brief The ways to the chased target, by path hierarchy and thus sprite collision size.
+    std::map<const private_map::PathHierarchy*, private_map::ChaseFlowField*> _chase_flow_fields;
+
+    //! \brief Deletes the chase flow fields, before their path hierarchies are.
+    void _ClearChaseFlowFields();
+
     /** \brief A map containing pointers to all of the sprites on a map.
     *** This map does not include a pointer to the _virtual_focus object. The
     *** sprite's unique identifier integer is used as the vector key.
@@ -366,6 +493,55 @@ private:
 
     //! \brief Container for all zones used in this map
     std::vector<MapZone *> _zones;
+
+    //! \brief The objects of each draw layer, indexed by collision rectangle.
+    MapObjectGrid _flat_ground_object_grid;
+    MapObjectGrid _ground_object_grid;
+    MapObjectGrid _pass_object_grid;
+    MapObjectGrid _sky_object_grid;
+
+    //! \brief Whether the collision searches use the object grids. Only disabled when benchmarking.
+    bool _object_grids_enabled;
+
+    //! \brief The objects returned by _GetObjectsAround().
+    std::vector<MapObject*> _objects_around;
+
+    //! \brief How far the images of a draw layer objects reach above and below their y position.
+    struct ImageExtents {
+        ImageExtents():
+            above(0.0f),
+            below(0.0f)
+        {}
+
+        float above;
+        float below;
+    };
+
+    //! \brief The image extents of each draw layer, computed when sorting them.
+    ImageExtents _flat_ground_image_extents;
+    ImageExtents _ground_image_extents;
+    ImageExtents _pass_image_extents;
+    ImageExtents _sky_image_extents;
+
+    //! \brief The update frame number, used to update the distant objects less often.
+    uint32_t _update_frame;
+
+    //! \brief The time elapsed since each group of distant objects was last updated.
+    std::vector<uint32_t> _distant_update_times;
+
+    /** \brief Updates the layer objects. The static objects far from the screen
+    *** are only updated once every few frames, by the time elapsed meanwhile.
+    **/
+    void _UpdateLayerObjects(std::vector<MapObject*>& objects);
+
+    /** \brief Gives the range of the layer objects which may be visible on screen,
+    *** the layer being sorted by y position. The last index is excluded.
+    **/
+    void _GetVisibleObjects(const std::vector<MapObject*>& objects, const ImageExtents& extents,
+                            uint32_t& first, uint32_t& last) const;
+
+    //! \brief The sprites standing, walking and running animations loaded on this map.
+    SpriteAnimationCache _sprite_animation_cache;
 }; // class ObjectSupervisor
 
 } // namespace private_map
@@ -50,7 +50,8 @@ MapObject::MapObject(MapObjectDrawLayer layer) :
     _emote_screen_offset(0.0f, 0.0f),
     _emote_time(0),
     _draw_layer(layer),
-    _grayscale(false)
+    _grayscale(false),
+    _draw_order_dirty(true)
 {
     // Generate the object Id at creation time.
     ObjectSupervisor* obj_sup = MapMode::CurrentInstance()->GetObjectSupervisor();
@@ -64,6 +65,11 @@ MapObject::~MapObject()
         delete _interaction_icon;
 }
 
+void MapObject::_UpdateObjectGrid()
+{
+    MapMode::CurrentInstance()->GetObjectSupervisor()->UpdateObjectGrid(this);
+}
+
 void MapObject::Update()
 {
     if (_interaction_icon)
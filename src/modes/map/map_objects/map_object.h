@@ -183,16 +183,23 @@ public:
     **/
     //@{
     void SetPosition(float x, float y) {
+        if(_tile_position.y != y)
+            _draw_order_dirty = true;
         _tile_position.x = x;
         _tile_position.y = y;
+        _UpdateObjectGrid();
     }
 
     void SetXPosition(float x) {
         _tile_position.x = x;
+        _UpdateObjectGrid();
     }
 
     void SetYPosition(float y) {
+        if(_tile_position.y != y)
+            _draw_order_dirty = true;
         _tile_position.y = y;
+        _UpdateObjectGrid();
     }
 
     //! \brief Set the object image half width (in pixels).
@@ -215,12 +222,14 @@ public:
         _coll_pixel_half_width = collision;
         _coll_screen_half_width = collision * MAP_ZOOM_RATIO;
         _coll_grid_half_width = collision / GRID_LENGTH * MAP_ZOOM_RATIO;
+        _UpdateObjectGrid();
     }
 
     void SetCollPixelHeight(float collision) {
         _coll_pixel_height = collision;
         _coll_screen_height = collision * MAP_ZOOM_RATIO;
         _coll_grid_height = collision / GRID_LENGTH * MAP_ZOOM_RATIO;
+        _UpdateObjectGrid();
     }
 
     void SetUpdatable(bool update) {
@@ -240,6 +249,15 @@ public:
         _draw_on_second_pass = pass;
     }
 
+    //! \brief Tells whether the object moved vertically since its draw layer was last sorted.
+    bool IsDrawOrderDirty() const {
+        return _draw_order_dirty;
+    }
+
+    void ClearDrawOrderDirty() {
+        _draw_order_dirty = false;
+    }
+
     //! \brief Tells the draw layer for faster deletion from the object supervisor.
     MapObjectDrawLayer GetObjectDrawLayer() const {
         return _draw_layer;
@@ -417,11 +435,17 @@ protected:
     //! \brief Tells whether the map object sprite and animation should be displayed grayscaled or not.
     bool _grayscale;
 
+    //! \brief Set when the object y position changes, so that its draw layer gets sorted again.
+    bool _draw_order_dirty;
+
     //! \brief Takes care of updating the emote animation and state.
     void _UpdateEmote();
 
     //! \brief Takes care of drawing the emote animation.
     void _DrawEmote();
+
+    //! \brief Moves the object in the collision searches index once its collision rectangle changed.
+    void _UpdateObjectGrid();
 }; // class MapObject
 
 
@@ -48,6 +48,14 @@ void PhysicalObject::Update()
         _animations[_current_animation_id].Update();
 }
 
+void PhysicalObject::Update(uint32_t elapsed_time)
+{
+    if(_interaction_icon)
+        _interaction_icon->Update(elapsed_time);
+    if(!_animations.empty() && _updatable)
+        _animations[_current_animation_id].Update(elapsed_time);
+}
+
 void PhysicalObject::Draw()
 {
     if(_animations.empty() || !MapObject::ShouldDraw())
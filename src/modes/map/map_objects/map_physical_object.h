@@ -44,6 +44,11 @@ public:
     //! \brief Updates the object's current animation.
     virtual void Update() override;
 
+    /** \brief Updates the object's current animation and interaction icon by the given time,
+    *** for the objects not updated every frame.
+    **/
+    void Update(uint32_t elapsed_time);
+
     //! \brief Draws the object to the screen, if it is visible.
     virtual void Draw() override;
 
@@ -0,0 +1,660 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_path_finder.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the map path finding.
+*** ***************************************************************************/
+
+#include "modes/map/map_path_finder.h"
+
+#include "utils/utils_numeric.h"
+#include "utils/utils_common.h"
+
+#include <SDL2/SDL_cpuinfo.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace vt_common;
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+// -----------------------------------------------------------------------------
+// ---------- PathSearch Class Methods
+// -----------------------------------------------------------------------------
+
+//! \brief The maximum cost of the paths searched between two hierarchy way points.
+static const uint32_t PATH_WAY_POINTS_MAX_COST = 4 * PATH_CLUSTER_SIZE;
+
+bool PathSearch::FindPath(uint16_t num_grid_x_axis, uint16_t num_grid_y_axis,
+                          const Position2D& source, const Position2D& destination,
+                          uint32_t max_cost, PathCollisionTest& collision_test, Path& path,
+                          const PathHierarchy* hierarchy)
+{
+    // Search the long paths through the hierarchy first, and on the whole grid when it fails.
+    if(hierarchy && max_cost == 0
+            && (std::abs(source.x - destination.x) >= PATH_HIERARCHY_MIN_DISTANCE
+                || std::abs(source.y - destination.y) >= PATH_HIERARCHY_MIN_DISTANCE)) {
+        if(_FindHierarchicalPath(num_grid_x_axis, num_grid_y_axis, source, destination,
+                                 collision_test, path, *hierarchy))
+            return true;
+    }
+
+    return _FindGridPath(num_grid_x_axis, num_grid_y_axis, source, destination, max_cost, collision_test, path);
+}
+
+bool PathSearch::_FindHierarchicalPath(uint16_t num_grid_x_axis, uint16_t num_grid_y_axis,
+                                       const Position2D& source, const Position2D& destination,
+                                       PathCollisionTest& collision_test, Path& path,
+                                       const PathHierarchy& hierarchy)
+{
+    path.clear();
+    if(!hierarchy.FindWayPoints(source, destination, _way_points))
+        return false;
+
+    // Keep the destination offset all along, as the grid search does.
+    float offset_x = vt_utils::GetFloatFraction(destination.x);
+    float offset_y = vt_utils::GetFloatFraction(destination.y);
+
+    Path part;
+    Position2D part_source = source;
+    for(uint32_t i = 0; i <= _way_points.size(); ++i) {
+        Position2D part_destination = destination;
+        if(i < _way_points.size())
+            part_destination = Position2D(_way_points[i].x + offset_x, _way_points[i].y + offset_y);
+
+        if(static_cast<int32_t>(part_source.x) == static_cast<int32_t>(part_destination.x)
+                && static_cast<int32_t>(part_source.y) == static_cast<int32_t>(part_destination.y))
+            continue;
+
+        // The map objects may block the way between two way points.
+        if(!_FindGridPath(num_grid_x_axis, num_grid_y_axis, part_source, part_destination,
+                          PATH_WAY_POINTS_MAX_COST, collision_test, part)) {
+            path.clear();
+            return false;
+        }
+
+        path.insert(path.end(), part.begin(), part.end());
+        part_source = part_destination;
+    }
+
+    return !path.empty();
+}
+
+bool PathSearch::_FindGridPath(uint16_t num_grid_x_axis, uint16_t num_grid_y_axis,
+                               const Position2D& source, const Position2D& destination,
+                               uint32_t max_cost, PathCollisionTest& collision_test, Path& path)
+{
+    // NOTE: Refer to the implementation of the A* algorithm to understand
+    // what all these lists and score values are for.
+    static const uint32_t basic_gcost = 10;
+
+    path.clear();
+
+    // NOTE(bis): On the outer scope, we'll use float based positions,
+    // but we still use integer positions for path finding.
+    int32_t source_x = static_cast<int32_t>(source.x);
+    int32_t source_y = static_cast<int32_t>(source.y);
+    int32_t dest_x = static_cast<int32_t>(destination.x);
+    int32_t dest_y = static_cast<int32_t>(destination.y);
+
+    // Start a new search: the nodes of the previous ones become invalid.
+    uint32_t num_nodes = static_cast<uint32_t>(num_grid_x_axis) * num_grid_y_axis;
+    if(_nodes.size() != num_nodes) {
+        _nodes.assign(num_nodes, PathNode());
+        _generation = 0;
+    }
+    if(++_generation == 0) {
+        // Reset the nodes generation when it wraps around.
+        _nodes.assign(num_nodes, PathNode());
+        _generation = 1;
+    }
+    _closed_nodes.assign((num_nodes + 31) / 32, 0);
+    _open_nodes.clear();
+
+    // The relative coordinates of the eight adjacent nodes, lateral ones first.
+    static const int32_t adjacent_nodes[8][2] = {
+        { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 },
+        { -1, -1 }, { -1, 1 }, { 1, -1 }, { 1, 1 }
+    };
+
+    uint32_t source_index = source_y * num_grid_x_axis + source_x;
+    uint32_t dest_index = dest_y * num_grid_x_axis + dest_x;
+    PathNode& source_node = _nodes[source_index];
+    source_node.generation = _generation;
+    source_node.g_score = 0;
+    source_node.parent = -1;
+    _open_nodes.push_back(PathOpenNode(source_index, 0, 0));
+
+    // We will try to keep the original offset all along.
+    float offset_x = vt_utils::GetFloatFraction(destination.x);
+    float offset_y = vt_utils::GetFloatFraction(destination.y);
+
+    bool destination_reached = false;
+    while(!_open_nodes.empty()) {
+        // Take the node with the best score
+        std::pop_heap(_open_nodes.begin(), _open_nodes.end());
+        PathOpenNode best_node = _open_nodes.back();
+        _open_nodes.pop_back();
+
+        // Skip the former entries of the nodes whose score was improved since
+        uint32_t& closed_bits = _closed_nodes[best_node.index / 32];
+        uint32_t closed_bit = 1u << (best_node.index % 32);
+        if(closed_bits & closed_bit)
+            continue;
+        closed_bits |= closed_bit;
+
+        // Check if destination has been reached, and break out of the loop if so
+        if(best_node.index == dest_index) {
+            destination_reached = true;
+            break;
+        }
+
+        int32_t best_x = best_node.index % num_grid_x_axis;
+        int32_t best_y = best_node.index / num_grid_x_axis;
+
+        // Check the eight adjacent nodes
+        for(uint8_t i = 0; i < 8; ++i) {
+            int32_t node_x = best_x + adjacent_nodes[i][0];
+            int32_t node_y = best_y + adjacent_nodes[i][1];
+
+            // ---------- (A): Check if all tiles are walkable
+            // Don't use 0.0f here for both since errors at the border between
+            // two positions may occure, especially when running.
+            COLLISION_TYPE collision_type = collision_test.DetectCollision(static_cast<float>(node_x) + offset_x,
+                                                                           static_cast<float>(node_y) + offset_y);
+
+            // Can't go through walls, nor out of the map.
+            if(collision_type == WALL_COLLISION || node_x < 0 || node_y < 0
+                    || node_x >= num_grid_x_axis || node_y >= num_grid_y_axis)
+                continue;
+
+            // ---------- (B): If this point has been reached, the node is valid for the sprite to move to
+            // If this is a lateral adjacent node, g_score is +10, otherwise diagonal adjacent node is +14
+            uint32_t g_add = (i < 4) ? basic_gcost : basic_gcost + 4;
+
+            // Add some g cost when there is another sprite there,
+            // so the NPC try to get around when possible,
+            // but will still go through it when there are no other choices.
+            if(collision_type == CHARACTER_COLLISION
+                    || collision_type == ENEMY_COLLISION)
+                g_add += basic_gcost * 2;
+
+            // If the path has reached the maximum length requested, we abort the path
+            if (max_cost > 0 && best_node.g_score + g_add >= max_cost * basic_gcost)
+                return false;
+
+            // ---------- (C): Check if the node has already been explored
+            uint32_t node_index = node_y * num_grid_x_axis + node_x;
+            if(_closed_nodes[node_index / 32] & (1u << (node_index % 32)))
+                continue;
+
+            uint32_t g_score = best_node.g_score + g_add;
+            PathNode& node = _nodes[node_index];
+
+            // ---------- (D): Check to see if the node is already waiting to be explored,
+            // and keep it as is unless the path we are on is better.
+            if(node.generation == _generation && node.g_score <= g_score)
+                continue;
+
+            // ---------- (E): Add the node, or its better score, to the open nodes
+            // Calculate the H score of the node (the heuristic used is diagonal)
+            uint32_t x_delta = std::abs(dest_x - node_x);
+            uint32_t y_delta = std::abs(dest_y - node_y);
+            uint32_t h_score;
+            if(x_delta > y_delta)
+                h_score = 14 * y_delta + 10 * (x_delta - y_delta);
+            else
+                h_score = 14 * x_delta + 10 * (y_delta - x_delta);
+
+            node.generation = _generation;
+            node.g_score = g_score;
+            node.parent = best_node.index;
+            _open_nodes.push_back(PathOpenNode(node_index, g_score, h_score));
+            std::push_heap(_open_nodes.begin(), _open_nodes.end());
+        } // for (uint8_t i = 0; i < 8; ++i)
+    } // while (!_open_nodes.empty())
+
+    if(!destination_reached)
+        return false;
+
+    // Add the destination node to the vector.
+    path.push_back(destination);
+
+    // Go backwards from the destination parent following the parent nodes to construct the path,
+    // the source node excluded.
+    for(int32_t index = _nodes[dest_index].parent; index >= 0 && static_cast<uint32_t>(index) != source_index;
+            index = _nodes[index].parent) {
+        Position2D next_pos(static_cast<float>(index % num_grid_x_axis) + offset_x,
+                            static_cast<float>(index / num_grid_x_axis) + offset_y);
+        path.push_back(next_pos);
+    }
+    std::reverse(path.begin(), path.end());
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// ---------- PathFinder Class Methods
+// -----------------------------------------------------------------------------
+
+//! \brief Tests the requested path positions against the collision grid copy and the request obstacles.
+class RequestCollisionTest : public PathCollisionTest
+{
+public:
+    RequestCollisionTest(const PathRequest& request, const CollisionBitmap& walls,
+                         const std::vector<uint8_t>& obstacles,
+                         uint16_t num_grid_x_axis, uint16_t num_grid_y_axis) :
+        _request(request),
+        _walls(walls),
+        _obstacles(obstacles),
+        _num_grid_x_axis(num_grid_x_axis),
+        _num_grid_y_axis(num_grid_y_axis)
+    {}
+
+    COLLISION_TYPE DetectCollision(float x, float y)
+    {
+        // Same as ObjectSupervisor::DetectCollision(), but with a copy of the sprite data.
+        Rectangle2D rect(x - _request.coll_grid_half_width, x + _request.coll_grid_half_width,
+                         y - _request.coll_grid_height, y);
+
+        if(rect.left < 0.0f || rect.right >= static_cast<float>(_num_grid_x_axis) ||
+                rect.top < 0.0f || rect.bottom >= static_cast<float>(_num_grid_y_axis))
+            return WALL_COLLISION;
+
+        if(_request.collision_mask == NO_COLLISION)
+            return NO_COLLISION;
+
+        uint32_t left = static_cast<uint32_t>(rect.left);
+        uint32_t top = static_cast<uint32_t>(rect.top);
+        uint32_t right = static_cast<uint32_t>(rect.right);
+        uint32_t bottom = static_cast<uint32_t>(rect.bottom);
+        if(_request.check_walls && (_request.collision_mask & WALL_COLLISION)
+                && _walls.HasWall(left, top, right, bottom))
+            return WALL_COLLISION;
+
+        uint8_t collisions = NO_COLLISION;
+        if(!_request.obstacles.empty()) {
+            for(uint32_t y = top; y <= bottom; ++y) {
+                for(uint32_t x = left; x <= right; ++x)
+                    collisions |= _obstacles[y * _num_grid_x_axis + x];
+            }
+        }
+
+        if(collisions & WALL_COLLISION)
+            return WALL_COLLISION;
+        if(collisions & CHARACTER_COLLISION)
+            return CHARACTER_COLLISION;
+        if(collisions & ENEMY_COLLISION)
+            return ENEMY_COLLISION;
+        return NO_COLLISION;
+    }
+
+private:
+    const PathRequest& _request;
+    const CollisionBitmap& _walls;
+    const std::vector<uint8_t>& _obstacles;
+    uint16_t _num_grid_x_axis;
+    uint16_t _num_grid_y_axis;
+};
+
+//! \brief Returns the collision grid elements range overlapped by the rectangle, clamped to the grid.
+static void _GetGridRange(const Rectangle2D& rect, uint16_t num_grid_x_axis, uint16_t num_grid_y_axis,
+                          uint32_t& left, uint32_t& top, uint32_t& right, uint32_t& bottom)
+{
+    left = static_cast<uint32_t>(std::max(0.0f, rect.left));
+    top = static_cast<uint32_t>(std::max(0.0f, rect.top));
+    right = std::min<uint32_t>(static_cast<uint32_t>(std::max(0.0f, rect.right)), num_grid_x_axis - 1);
+    bottom = std::min<uint32_t>(static_cast<uint32_t>(std::max(0.0f, rect.bottom)), num_grid_y_axis - 1);
+}
+
+//! \brief Tells whether the first request has to be searched before the second one.
+static bool _IsRequestPrior(const PathRequest* first, const PathRequest* second)
+{
+    return first->on_screen && !second->on_screen;
+}
+
+PathFinder::PathFinder() :
+    _num_grid_x_axis(0),
+    _num_grid_y_axis(0),
+    _last_ticket(0),
+    _mutex(nullptr),
+    _condition(nullptr),
+    _num_searching_requests(0),
+    _stop_workers(false)
+{
+}
+
+PathFinder::~PathFinder()
+{
+    _Clear();
+}
+
+void PathFinder::Initialize(const CollisionBitmap& walls, uint16_t num_grid_x_axis, uint16_t num_grid_y_axis)
+{
+    _Clear();
+
+    _num_grid_x_axis = num_grid_x_axis;
+    _num_grid_y_axis = num_grid_y_axis;
+    _walls = walls;
+
+    // Keep a core for the main thread.
+    int32_t num_threads = std::max(1, std::min(2, SDL_GetCPUCount() - 1));
+
+    _mutex = SDL_CreateMutex();
+    _condition = SDL_CreateCond();
+    _stop_workers = false;
+    for(int32_t i = 0; i < num_threads && _mutex && _condition; ++i) {
+        PathWorker* worker = new PathWorker();
+        worker->path_finder = this;
+        worker->thread = SDL_CreateThread(_RunWorker, "PathFinder", worker);
+        if(!worker->thread) {
+            IF_PRINT_WARNING(MAP_DEBUG) << "Couldn't create a path finding thread: " << SDL_GetError() << std::endl;
+            delete worker;
+            break;
+        }
+        _workers.push_back(worker);
+    }
+
+    // Search the paths on the main thread rather than not at all.
+    if(_workers.empty())
+        _workers.push_back(new PathWorker());
+}
+
+uint32_t PathFinder::AddRequest(PathRequest* request)
+{
+    if(!request)
+        return 0;
+
+    // Never give the 0 ticket, so that it can be used as no request.
+    if(++_last_ticket == 0)
+        ++_last_ticket;
+
+    request->ticket = _last_ticket;
+    request->state = PATH_REQUEST_PENDING;
+    if(request->check_walls && (request->collision_mask & WALL_COLLISION))
+        request->hierarchy = GetHierarchy(request->coll_grid_half_width, request->coll_grid_height);
+    _requests[request->ticket] = request;
+    _pending_requests.push_back(request);
+    return request->ticket;
+}
+
+PATH_REQUEST_STATE PathFinder::GetPath(uint32_t ticket, Path& path)
+{
+    std::map<uint32_t, PathRequest*>::iterator it = _requests.find(ticket);
+    if(it == _requests.end())
+        return PATH_REQUEST_INVALID;
+
+    PathRequest* request = it->second;
+    PATH_REQUEST_STATE state = request->state;
+    if(state == PATH_REQUEST_PENDING)
+        return state;
+
+    path.swap(request->path);
+    _requests.erase(it);
+    delete request;
+    return state;
+}
+
+void PathFinder::CancelRequest(uint32_t ticket)
+{
+    std::map<uint32_t, PathRequest*>::iterator it = _requests.find(ticket);
+    if(it == _requests.end())
+        return;
+
+    PathRequest* request = it->second;
+    _requests.erase(it);
+
+    std::vector<PathRequest*>::iterator pending_it = std::find(_pending_requests.begin(), _pending_requests.end(), request);
+    if(pending_it != _pending_requests.end()) {
+        _pending_requests.erase(pending_it);
+        delete request;
+        return;
+    }
+
+    if(request->state != PATH_REQUEST_PENDING) {
+        delete request;
+        return;
+    }
+
+    // The request is being searched: it will be deleted once delivered.
+    request->cancelled = true;
+}
+
+void PathFinder::SetWall(uint32_t x, uint32_t y, bool wall)
+{
+    if(x >= _num_grid_x_axis || y >= _num_grid_y_axis)
+        return;
+
+    _wall_changes[y * _num_grid_x_axis + x] = wall;
+}
+
+bool PathFinder::Update()
+{
+    // Deliver the searched paths
+    std::vector<PathRequest*> searched_requests;
+    bool workers_idle = true;
+    if(_mutex) {
+        SDL_LockMutex(_mutex);
+        searched_requests.swap(_searched_requests);
+        workers_idle = _queued_requests.empty() && _num_searching_requests == 0;
+        SDL_UnlockMutex(_mutex);
+    }
+
+    for(uint32_t i = 0; i < searched_requests.size(); ++i) {
+        PathRequest* request = searched_requests[i];
+        if(request->cancelled) {
+            delete request;
+            continue;
+        }
+        request->state = request->path.empty() ? PATH_REQUEST_NOT_FOUND : PATH_REQUEST_FOUND;
+    }
+
+    // The walls are only changed while no path is searched, so let the workers finish first.
+    bool walls_changed = false;
+    if(!_wall_changes.empty()) {
+        if(!workers_idle)
+            return false;
+        walls_changed = _ApplyWallChanges();
+    }
+
+    if(_pending_requests.empty() || _workers.empty())
+        return walls_changed;
+
+    // Hand the on screen sprites requests over first, in the order they were made.
+    std::stable_sort(_pending_requests.begin(), _pending_requests.end(), _IsRequestPrior);
+    uint32_t num_requests = std::min<uint32_t>(PATH_REQUESTS_PER_FRAME, _pending_requests.size());
+
+    if(_workers[0]->thread == nullptr) {
+        // No worker thread: search the paths right away.
+        for(uint32_t i = 0; i < num_requests; ++i) {
+            PathRequest* request = _pending_requests[i];
+            _SearchPath(_workers[0], request);
+            request->state = request->path.empty() ? PATH_REQUEST_NOT_FOUND : PATH_REQUEST_FOUND;
+        }
+    }
+    else {
+        SDL_LockMutex(_mutex);
+        _queued_requests.insert(_queued_requests.end(), _pending_requests.begin(),
+                                _pending_requests.begin() + num_requests);
+        SDL_CondBroadcast(_condition);
+        SDL_UnlockMutex(_mutex);
+    }
+
+    _pending_requests.erase(_pending_requests.begin(), _pending_requests.begin() + num_requests);
+    return walls_changed;
+}
+
+const PathHierarchy* PathFinder::GetHierarchy(float coll_grid_half_width, float coll_grid_height)
+{
+    std::pair<float, float> collision_size(coll_grid_half_width, coll_grid_height);
+    std::map<std::pair<float, float>, PathHierarchy*>::const_iterator it = _hierarchies.find(collision_size);
+    if(it != _hierarchies.end())
+        return it->second;
+
+    // Built on the main thread, and only modified while no path is searched.
+    PathHierarchy* hierarchy = new PathHierarchy(_walls, _num_grid_x_axis, _num_grid_y_axis,
+                                                 coll_grid_half_width, coll_grid_height);
+    _hierarchies[collision_size] = hierarchy;
+    return hierarchy;
+}
+
+void PathFinder::AddHierarchies(const std::map<std::pair<float, float>, PathHierarchy*>& hierarchies)
+{
+    std::map<std::pair<float, float>, PathHierarchy*>::const_iterator it = hierarchies.begin();
+    for(; it != hierarchies.end(); ++it) {
+        PathHierarchy*& hierarchy = _hierarchies[it->first];
+        delete hierarchy;
+        hierarchy = it->second;
+    }
+}
+
+void PathFinder::GetCollisionSizes(std::vector<std::pair<float, float> >& collision_sizes) const
+{
+    collision_sizes.clear();
+    std::map<std::pair<float, float>, PathHierarchy*>::const_iterator it = _hierarchies.begin();
+    for(; it != _hierarchies.end(); ++it)
+        collision_sizes.push_back(it->first);
+}
+
+void PathFinder::_Clear()
+{
+    if(_mutex) {
+        SDL_LockMutex(_mutex);
+        _stop_workers = true;
+        SDL_CondBroadcast(_condition);
+        SDL_UnlockMutex(_mutex);
+    }
+
+    for(uint32_t i = 0; i < _workers.size(); ++i) {
+        if(_workers[i]->thread)
+            SDL_WaitThread(_workers[i]->thread, nullptr);
+        delete _workers[i];
+    }
+    _workers.clear();
+
+    // Every request is either still known by its ticket, or cancelled while searched.
+    for(std::map<uint32_t, PathRequest*>::iterator it = _requests.begin(); it != _requests.end(); ++it)
+        delete it->second;
+    _requests.clear();
+    _pending_requests.clear();
+    for(uint32_t i = 0; i < _queued_requests.size(); ++i) {
+        if(_queued_requests[i]->cancelled)
+            delete _queued_requests[i];
+    }
+    _queued_requests.clear();
+    for(uint32_t i = 0; i < _searched_requests.size(); ++i) {
+        if(_searched_requests[i]->cancelled)
+            delete _searched_requests[i];
+    }
+    _searched_requests.clear();
+    _num_searching_requests = 0;
+    _wall_changes.clear();
+
+    for(std::map<std::pair<float, float>, PathHierarchy*>::iterator it = _hierarchies.begin(); it != _hierarchies.end(); ++it)
+        delete it->second;
+    _hierarchies.clear();
+
+    if(_condition) {
+        SDL_DestroyCond(_condition);
+        _condition = nullptr;
+    }
+    if(_mutex) {
+        SDL_DestroyMutex(_mutex);
+        _mutex = nullptr;
+    }
+}
+
+bool PathFinder::_ApplyWallChanges()
+{
+    std::vector<uint32_t> changed_elements;
+    for(std::map<uint32_t, bool>::const_iterator it = _wall_changes.begin(); it != _wall_changes.end(); ++it) {
+        uint32_t x = it->first % _num_grid_x_axis;
+        uint32_t y = it->first / _num_grid_x_axis;
+        if(_walls.IsWall(x, y) == it->second)
+            continue;
+        _walls.SetWall(x, y, it->second);
+        changed_elements.push_back(it->first);
+    }
+    _wall_changes.clear();
+
+    if(changed_elements.empty())
+        return false;
+
+    // Only the clusters around the changed elements are built again.
+    for(std::map<std::pair<float, float>, PathHierarchy*>::iterator it = _hierarchies.begin(); it != _hierarchies.end(); ++it)
+        it->second->UpdateWalls(_walls, changed_elements);
+    return true;
+}
+
+void PathFinder::_SearchPath(PathWorker* worker, PathRequest* request)
+{
+    // Mark the obstacles on the collision grid elements they overlap.
+    std::vector<uint8_t>& obstacles = worker->obstacles;
+    obstacles.resize(static_cast<uint32_t>(_num_grid_x_axis) * _num_grid_y_axis, NO_COLLISION);
+    uint32_t left, top, right, bottom;
+    for(uint32_t i = 0; i < request->obstacles.size(); ++i) {
+        _GetGridRange(request->obstacles[i].rect, _num_grid_x_axis, _num_grid_y_axis, left, top, right, bottom);
+        for(uint32_t y = top; y <= bottom; ++y) {
+            for(uint32_t x = left; x <= right; ++x)
+                obstacles[y * _num_grid_x_axis + x] |= request->obstacles[i].collision;
+        }
+    }
+
+    RequestCollisionTest collision_test(*request, _walls, obstacles, _num_grid_x_axis, _num_grid_y_axis);
+    worker->search.FindPath(_num_grid_x_axis, _num_grid_y_axis, request->source, request->destination,
+                            request->max_cost, collision_test, request->path, request->hierarchy);
+
+    // Clear the obstacles for the next request.
+    for(uint32_t i = 0; i < request->obstacles.size(); ++i) {
+        _GetGridRange(request->obstacles[i].rect, _num_grid_x_axis, _num_grid_y_axis, left, top, right, bottom);
+        for(uint32_t y = top; y <= bottom; ++y) {
+            for(uint32_t x = left; x <= right; ++x)
+                obstacles[y * _num_grid_x_axis + x] = NO_COLLISION;
+        }
+    }
+}
+
+int PathFinder::_RunWorker(void* data)
+{
+    PathWorker* worker = static_cast<PathWorker*>(data);
+    PathFinder* path_finder = worker->path_finder;
+
+    SDL_LockMutex(path_finder->_mutex);
+    while(!path_finder->_stop_workers) {
+        if(path_finder->_queued_requests.empty()) {
+            SDL_CondWait(path_finder->_condition, path_finder->_mutex);
+            continue;
+        }
+
+        PathRequest* request = path_finder->_queued_requests.front();
+        path_finder->_queued_requests.pop_front();
+        ++path_finder->_num_searching_requests;
+        SDL_UnlockMutex(path_finder->_mutex);
+
+        // The request is only used by this thread until it is searched.
+        path_finder->_SearchPath(worker, request);
+
+        SDL_LockMutex(path_finder->_mutex);
+        path_finder->_searched_requests.push_back(request);
+        --path_finder->_num_searching_requests;
+    }
+    SDL_UnlockMutex(path_finder->_mutex);
+    return 0;
+}
+
+} // namespace private_map
+
+} // namespace vt_map
@@ -0,0 +1,332 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_path_finder.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the map path finding.
+***
+*** The paths are searched with the A* algorithm over the collision grid. The
+*** object supervisor searches them right away when asked to, while the path
+*** finder searches the ones requested by the sprites on worker threads, so that
+*** several long searches don't slow down a single frame.
+*** ***************************************************************************/
+
+#ifndef __MAP_PATH_FINDER_HEADER__
+#define __MAP_PATH_FINDER_HEADER__
+
+#include "modes/map/map_utils.h"
+#include "modes/map/map_collision_bitmap.h"
+#include "modes/map/map_path_hierarchy.h"
+
+#include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_mutex.h>
+
+#include <deque>
+#include <map>
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief The maximum number of path requests handed over to the worker threads per frame.
+const uint32_t PATH_REQUESTS_PER_FRAME = 4;
+
+//! \brief The state of a path request, as returned by PathFinder::GetPath().
+enum PATH_REQUEST_STATE {
+    PATH_REQUEST_INVALID   = 0, //!< Unknown or already retrieved request.
+    PATH_REQUEST_PENDING   = 1, //!< The path is still being searched.
+    PATH_REQUEST_FOUND     = 2,
+    PATH_REQUEST_NOT_FOUND = 3
+};
+
+/** ****************************************************************************
+*** \brief Tells the path search which positions the sprite can walk on.
+*** ***************************************************************************/
+class PathCollisionTest
+{
+public:
+    virtual ~PathCollisionTest()
+    {}
+
+    //! \brief Returns the collision the sprite would have at the given position.
+    virtual COLLISION_TYPE DetectCollision(float x, float y) = 0;
+};
+
+/** ****************************************************************************
+*** \brief Finds a path with the A* algorithm.
+***
+*** The search data is kept from one search to another to avoid reallocating it.
+*** ***************************************************************************/
+class PathSearch
+{
+public:
+    PathSearch() :
+        _generation(0)
+    {}
+
+    /** \brief Finds a path from a source to a destination.
+    *** \param num_grid_x_axis, num_grid_y_axis The collision grid size.
+    *** \param source The sprite position.
+    *** \param destination The destination, which must be different from the source.
+    *** \param max_cost Tells how far a path node can be computed agains the starting path node.
+    *** If this param is equal to 0, there is no limitation.
+    *** \param collision_test Tells which positions are walkable.
+    *** \param path Filled with the path nodes, the destination included.
+    *** \param hierarchy The collision grid hierarchy for the sprite collision size, if any.
+    *** The long paths without maximum cost are first searched through it.
+    *** \return false if no path was found.
+    **/
+    bool FindPath(uint16_t num_grid_x_axis, uint16_t num_grid_y_axis,
+                  const vt_common::Position2D& source,
+                  const vt_common::Position2D& destination,
+                  uint32_t max_cost,
+                  PathCollisionTest& collision_test,
+                  Path& path,
+                  const PathHierarchy* hierarchy = nullptr);
+
+private:
+    //! \brief One node per collision grid element, stored row after row.
+    std::vector<PathNode> _nodes;
+
+    //! \brief One bit per collision grid element, set once the node has been explored.
+    std::vector<uint32_t> _closed_nodes;
+
+    //! \brief The nodes waiting to be explored, as a binary heap.
+    std::vector<PathOpenNode> _open_nodes;
+
+    //! \brief The current search generation. See PathNode.
+    uint32_t _generation;
+
+    //! \brief The hierarchy way points, kept to avoid reallocating them.
+    std::vector<vt_common::Position2D> _way_points;
+
+    //! \brief Finds a path on the whole collision grid.
+    bool _FindGridPath(uint16_t num_grid_x_axis, uint16_t num_grid_y_axis,
+                       const vt_common::Position2D& source,
+                       const vt_common::Position2D& destination,
+                       uint32_t max_cost,
+                       PathCollisionTest& collision_test,
+                       Path& path);
+
+    /** \brief Finds the hierarchy way points, then the path between each of them on the collision grid.
+    *** \return false if the hierarchy has no path, or if the map objects block one of its parts.
+    **/
+    bool _FindHierarchicalPath(uint16_t num_grid_x_axis, uint16_t num_grid_y_axis,
+                               const vt_common::Position2D& source,
+                               const vt_common::Position2D& destination,
+                               PathCollisionTest& collision_test,
+                               Path& path,
+                               const PathHierarchy& hierarchy);
+};
+
+//! \brief The collision rectangle and type of an object a requested path must get around.
+struct PathObstacle {
+    PathObstacle(const vt_common::Rectangle2D& rect_, COLLISION_TYPE collision_) :
+        rect(rect_),
+        collision(collision_)
+    {}
+
+    vt_common::Rectangle2D rect;
+    COLLISION_TYPE collision;
+};
+
+/** ****************************************************************************
+*** \brief A path search requested by a sprite.
+***
+*** The request holds a copy of everything the search needs, so that it can be
+*** done on a worker thread while the sprites keep on moving.
+*** ***************************************************************************/
+class PathRequest
+{
+public:
+    PathRequest() :
+        ticket(0),
+        on_screen(false),
+        max_cost(0),
+        coll_grid_half_width(0.0f),
+        coll_grid_height(0.0f),
+        collision_mask(NO_COLLISION),
+        check_walls(true),
+        hierarchy(nullptr),
+        state(PATH_REQUEST_PENDING),
+        cancelled(false)
+    {}
+
+    uint32_t ticket;
+
+    //! \brief Whether the sprite was on screen when requesting the path. Those are searched first.
+    bool on_screen;
+
+    vt_common::Position2D source;
+    vt_common::Position2D destination;
+    uint32_t max_cost;
+
+    //! \brief The sprite collision size and mask.
+    float coll_grid_half_width;
+    float coll_grid_height;
+    uint32_t collision_mask;
+
+    //! \brief Whether the collision grid walls are taken in account. They aren't for sky objects.
+    bool check_walls;
+
+    //! \brief The objects of the sprite draw layer taken in account by its collision mask.
+    std::vector<PathObstacle> obstacles;
+
+    //! \brief The collision grid hierarchy for the sprite collision size, if the walls are checked.
+    const PathHierarchy* hierarchy;
+
+    //! \brief The search result.
+    PATH_REQUEST_STATE state;
+    Path path;
+
+    //! \brief Set when the request was cancelled while searched. Only used by the main thread.
+    bool cancelled;
+};
+
+/** ****************************************************************************
+*** \brief Searches the paths requested by the sprites on worker threads.
+***
+*** The sprites request a path and get a ticket, used to retrieve the path once
+*** found. The requests are handed over to the worker threads at the beginning
+*** of each frame, the on screen sprites ones first and no more than
+*** PATH_REQUESTS_PER_FRAME of them, and the found paths are only delivered
+*** then as well.
+***
+*** The searches are done against a copy of the collision grid, and against
+*** the objects around the sprite as they were when the path was requested.
+*** The changes of the collision grid are applied to the copy and to the
+*** hierarchies in Update(), once no path is being searched anymore.
+*** Those are conservatively marked on the whole collision grid elements they
+*** overlap, so the paths found may get around them a bit more than needed.
+*** ***************************************************************************/
+class PathFinder
+{
+public:
+    PathFinder();
+
+    //! \brief Stops the worker threads, and forgets every request.
+    ~PathFinder();
+
+    //! \brief Copies the map collision walls, and starts the worker threads.
+    void Initialize(const CollisionBitmap& walls, uint16_t num_grid_x_axis, uint16_t num_grid_y_axis);
+
+    /** \brief Takes over the hierarchies built against the walls given to Initialize(),
+    *** by sprite collision size, like those built while the map was loading.
+    **/
+    void AddHierarchies(const std::map<std::pair<float, float>, PathHierarchy*>& hierarchies);
+
+    //! \brief Adds a request, taking its ownership, and returns its ticket.
+    uint32_t AddRequest(PathRequest* request);
+
+    /** \brief Gives the requested path once searched, and then forgets the request.
+    *** \return The request state. The path is only set when found.
+    **/
+    PATH_REQUEST_STATE GetPath(uint32_t ticket, Path& path);
+
+    //! \brief Forgets a request, whether it was searched yet or not.
+    void CancelRequest(uint32_t ticket);
+
+    //! \brief Changes whether a collision grid element is a wall, once no path is being searched.
+    void SetWall(uint32_t x, uint32_t y, bool wall);
+
+    /** \brief Delivers the found paths, and hands the next requests over to the worker threads.
+    *** The collision grid changes are applied first when the worker threads are idle,
+    *** and no request is handed over until they are.
+    *** \return true when collision grid changes were applied, the hierarchies being updated.
+    **/
+    bool Update();
+
+    /** \brief Returns the collision grid hierarchy for the given sprite collision size,
+    *** building it the first time it is asked for.
+    **/
+    const PathHierarchy* GetHierarchy(float coll_grid_half_width, float coll_grid_height);
+
+    //! \brief Gives the sprite collision sizes of the hierarchies built.
+    void GetCollisionSizes(std::vector<std::pair<float, float> >& collision_sizes) const;
+
+private:
+    //! \brief The data of a path searching thread.
+    struct PathWorker {
+        PathWorker() :
+            path_finder(nullptr),
+            thread(nullptr)
+        {}
+
+        PathFinder* path_finder;
+        SDL_Thread* thread;
+        PathSearch search;
+
+        //! \brief The collision types of the request obstacles overlapping each collision grid element.
+        std::vector<uint8_t> obstacles;
+    };
+
+    uint16_t _num_grid_x_axis;
+    uint16_t _num_grid_y_axis;
+
+    //! \brief The collision grid walls. Never modified while a path is searched.
+    CollisionBitmap _walls;
+
+    //! \brief The collision grid changes not applied yet, by element index.
+    std::map<uint32_t, bool> _wall_changes;
+
+    //! \brief The collision grid hierarchies, by sprite collision size.
+    std::map<std::pair<float, float>, PathHierarchy*> _hierarchies;
+
+    //! \brief The last ticket given.
+    uint32_t _last_ticket;
+
+    //! \brief Every request not yet retrieved, by ticket.
+    std::map<uint32_t, PathRequest*> _requests;
+
+    //! \brief The requests not yet handed over to the worker threads.
+    std::vector<PathRequest*> _pending_requests;
+
+    //! \brief The worker threads, or a single one without thread when they couldn't be created.
+    std::vector<PathWorker*> _workers;
+
+    //! \brief Protects the members below, shared with the worker threads.
+    SDL_mutex* _mutex;
+
+    //! \brief Signaled when requests are queued, or when the workers have to stop.
+    SDL_cond* _condition;
+
+    //! \brief The requests waiting for a worker thread.
+    std::deque<PathRequest*> _queued_requests;
+
+    //! \brief The searched requests, waiting to be delivered.
+    std::vector<PathRequest*> _searched_requests;
+
+    //! \brief The number of requests the worker threads are searching.
+    uint32_t _num_searching_requests;
+
+    bool _stop_workers;
+
+    //! \brief Stops the worker threads, and deletes every request.
+    void _Clear();
+
+    /** \brief Applies the collision grid changes to the walls copy and to the hierarchies.
+    *** \return false if none of the changes made a difference.
+    **/
+    bool _ApplyWallChanges();
+
+    //! \brief Searches the request path.
+    void _SearchPath(PathWorker* worker, PathRequest* request);
+
+    //! \brief The worker threads function.
+    static int _RunWorker(void* data);
+};
+
+} // namespace private_map
+
+} // namespace vt_map
+
+#endif // __MAP_PATH_FINDER_HEADER__
@@ -0,0 +1,448 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_path_hierarchy.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the hierarchical path finding.
+*** ***************************************************************************/
+
+#include "modes/map/map_path_hierarchy.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <set>
+
+using namespace vt_common;
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief The cost of unreachable places.
+static const uint32_t UNREACHABLE_COST = std::numeric_limits<uint32_t>::max();
+
+//! \brief Entrances shorter than this get a single node in their middle, the longer ones one at each end.
+static const uint32_t PATH_LONG_ENTRANCE_LENGTH = 6;
+
+//! \brief Returns the diagonal distance heuristic between two collision grid elements, as used by the path search.
+static uint32_t _GetDistanceCost(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    uint32_t x_delta = std::abs(x1 - x2);
+    uint32_t y_delta = std::abs(y1 - y2);
+    if(x_delta > y_delta)
+        return 14 * y_delta + 10 * (x_delta - y_delta);
+    return 14 * x_delta + 10 * (y_delta - x_delta);
+}
+
+PathHierarchy::PathHierarchy(const CollisionBitmap& walls,
+                             uint16_t num_grid_x_axis, uint16_t num_grid_y_axis,
+                             float coll_grid_half_width, float coll_grid_height) :
+    _num_grid_x_axis(num_grid_x_axis),
+    _num_grid_y_axis(num_grid_y_axis),
+    _num_clusters_x((num_grid_x_axis + PATH_CLUSTER_SIZE - 1) / PATH_CLUSTER_SIZE),
+    _num_clusters_y((num_grid_y_axis + PATH_CLUSTER_SIZE - 1) / PATH_CLUSTER_SIZE),
+    _coll_grid_half_width(coll_grid_half_width),
+    _coll_grid_height(coll_grid_height)
+{
+    _walkable.assign(static_cast<uint32_t>(_num_grid_x_axis) * _num_grid_y_axis, 0);
+    for(uint32_t y = 0; y < _num_grid_y_axis; ++y) {
+        for(uint32_t x = 0; x < _num_grid_x_axis; ++x)
+            _walkable[y * _num_grid_x_axis + x] = _ComputeWalkable(walls, x, y) ? 1 : 0;
+    }
+
+    // Find the entrances along the clusters borders.
+    _cluster_nodes.resize(_num_clusters_x * _num_clusters_y);
+    for(uint32_t cluster = 0; cluster < _cluster_nodes.size(); ++cluster) {
+        _AddBorderEntrances(cluster, false);
+        _AddBorderEntrances(cluster, true);
+    }
+
+    // Link the entrances of each cluster with the cost of the shortest path between them.
+    std::vector<uint32_t> costs;
+    for(uint32_t cluster = 0; cluster < _cluster_nodes.size(); ++cluster)
+        _LinkClusterNodes(cluster, costs);
+}
+
+void PathHierarchy::UpdateWalls(const CollisionBitmap& walls, const std::vector<uint32_t>& changed_elements)
+{
+    // Compute again the elements from which the sprite collision rectangle may overlap the changed ones.
+    int32_t margin_x = static_cast<int32_t>(_coll_grid_half_width) + 1;
+    int32_t margin_y = static_cast<int32_t>(_coll_grid_height) + 1;
+    std::set<uint32_t> changed_clusters;
+    for(uint32_t i = 0; i < changed_elements.size(); ++i) {
+        int32_t wall_x = changed_elements[i] % _num_grid_x_axis;
+        int32_t wall_y = changed_elements[i] / _num_grid_x_axis;
+        int32_t left = std::max<int32_t>(0, wall_x - margin_x);
+        int32_t right = std::min<int32_t>(_num_grid_x_axis - 1, wall_x + margin_x);
+        int32_t bottom = std::min<int32_t>(_num_grid_y_axis - 1, wall_y + margin_y);
+        for(int32_t y = wall_y; y <= bottom; ++y) {
+            for(int32_t x = left; x <= right; ++x) {
+                uint8_t walkable = _ComputeWalkable(walls, x, y) ? 1 : 0;
+                uint8_t& element = _walkable[y * _num_grid_x_axis + x];
+                if(element == walkable)
+                    continue;
+                element = walkable;
+                changed_clusters.insert(_GetCluster(x, y));
+            }
+        }
+    }
+
+    if(changed_clusters.empty())
+        return;
+
+    // The entrances along every border of the changed clusters are found again,
+    // which changes the entrances of their neighbours as well.
+    std::set<std::pair<uint32_t, bool> > borders;
+    std::set<uint32_t> updated_clusters;
+    for(std::set<uint32_t>::const_iterator it = changed_clusters.begin(); it != changed_clusters.end(); ++it) {
+        uint32_t cluster = *it;
+        uint32_t cluster_x = cluster % _num_clusters_x;
+        uint32_t cluster_y = cluster / _num_clusters_x;
+        updated_clusters.insert(cluster);
+
+        if(cluster_x + 1 < _num_clusters_x) {
+            borders.insert(std::make_pair(cluster, false));
+            updated_clusters.insert(cluster + 1);
+        }
+        if(cluster_y + 1 < _num_clusters_y) {
+            borders.insert(std::make_pair(cluster, true));
+            updated_clusters.insert(cluster + _num_clusters_x);
+        }
+        if(cluster_x > 0) {
+            borders.insert(std::make_pair(cluster - 1, false));
+            updated_clusters.insert(cluster - 1);
+        }
+        if(cluster_y > 0) {
+            borders.insert(std::make_pair(cluster - _num_clusters_x, true));
+            updated_clusters.insert(cluster - _num_clusters_x);
+        }
+    }
+
+    std::set<std::pair<uint32_t, bool> >::const_iterator border_it;
+    for(border_it = borders.begin(); border_it != borders.end(); ++border_it)
+        _RemoveBorderEntrances(border_it->first, border_it->second);
+    for(border_it = borders.begin(); border_it != borders.end(); ++border_it)
+        _AddBorderEntrances(border_it->first, border_it->second);
+
+    std::vector<uint32_t> costs;
+    for(std::set<uint32_t>::const_iterator it = updated_clusters.begin(); it != updated_clusters.end(); ++it)
+        _LinkClusterNodes(*it, costs);
+}
+
+bool PathHierarchy::FindWayPoints(const Position2D& source, const Position2D& destination,
+                                  std::vector<Position2D>& way_points) const
+{
+    way_points.clear();
+
+    int32_t source_x = static_cast<int32_t>(source.x);
+    int32_t source_y = static_cast<int32_t>(source.y);
+    int32_t dest_x = static_cast<int32_t>(destination.x);
+    int32_t dest_y = static_cast<int32_t>(destination.y);
+    if(source_x < 0 || source_y < 0 || source_x >= _num_grid_x_axis || source_y >= _num_grid_y_axis ||
+            dest_x < 0 || dest_y < 0 || dest_x >= _num_grid_x_axis || dest_y >= _num_grid_y_axis)
+        return false;
+    if(!_walkable[dest_y * _num_grid_x_axis + dest_x])
+        return false;
+
+    // Link the source and the destination to the entrances of their cluster.
+    std::vector<uint32_t> source_costs;
+    std::vector<uint32_t> dest_costs;
+    _ComputeClusterCosts(source_x, source_y, source_costs);
+    _ComputeClusterCosts(dest_x, dest_y, dest_costs);
+    uint32_t source_cluster = _GetCluster(source_x, source_y);
+    uint32_t dest_cluster = _GetCluster(dest_x, dest_y);
+
+    // Search the entrances with the A* algorithm. The source and destination get the last ids.
+    uint32_t source_node = _nodes.size();
+    uint32_t dest_node = _nodes.size() + 1;
+    std::vector<uint32_t> g_scores(_nodes.size() + 2, UNREACHABLE_COST);
+    std::vector<int32_t> parents(_nodes.size() + 2, -1);
+    std::vector<uint8_t> closed_nodes(_nodes.size() + 2, 0);
+    std::vector<PathOpenNode> open_nodes;
+
+    g_scores[source_node] = 0;
+    open_nodes.push_back(PathOpenNode(source_node, 0, 0));
+
+    std::vector<HierarchyEdge> edges;
+    bool destination_reached = false;
+    while(!open_nodes.empty()) {
+        std::pop_heap(open_nodes.begin(), open_nodes.end());
+        PathOpenNode best_node = open_nodes.back();
+        open_nodes.pop_back();
+
+        if(closed_nodes[best_node.index])
+            continue;
+        closed_nodes[best_node.index] = 1;
+
+        if(best_node.index == dest_node) {
+            destination_reached = true;
+            break;
+        }
+
+        // Gather the node links, along with the ones to the destination.
+        edges.clear();
+        if(best_node.index == source_node) {
+            const std::vector<uint32_t>& cluster_nodes = _cluster_nodes[source_cluster];
+            for(uint32_t i = 0; i < cluster_nodes.size(); ++i) {
+                uint32_t index = _nodes[cluster_nodes[i]].index;
+                uint32_t cost = source_costs[_GetClusterIndex(index % _num_grid_x_axis, index / _num_grid_x_axis)];
+                if(cost != UNREACHABLE_COST)
+                    edges.push_back(HierarchyEdge(cluster_nodes[i], cost));
+            }
+            if(source_cluster == dest_cluster && source_costs[_GetClusterIndex(dest_x, dest_y)] != UNREACHABLE_COST)
+                edges.push_back(HierarchyEdge(dest_node, source_costs[_GetClusterIndex(dest_x, dest_y)]));
+        }
+        else {
+            const HierarchyNode& node = _nodes[best_node.index];
+            edges = node.edges;
+            uint32_t x = node.index % _num_grid_x_axis;
+            uint32_t y = node.index / _num_grid_x_axis;
+            if(_GetCluster(x, y) == dest_cluster && dest_costs[_GetClusterIndex(x, y)] != UNREACHABLE_COST)
+                edges.push_back(HierarchyEdge(dest_node, dest_costs[_GetClusterIndex(x, y)]));
+        }
+
+        for(uint32_t i = 0; i < edges.size(); ++i) {
+            uint32_t node = edges[i].node;
+            uint32_t g_score = best_node.g_score + edges[i].cost;
+            if(closed_nodes[node] || g_scores[node] <= g_score)
+                continue;
+
+            uint32_t h_score = 0;
+            if(node != dest_node) {
+                uint32_t index = _nodes[node].index;
+                h_score = _GetDistanceCost(index % _num_grid_x_axis, index / _num_grid_x_axis, dest_x, dest_y);
+            }
+
+            g_scores[node] = g_score;
+            parents[node] = best_node.index;
+            open_nodes.push_back(PathOpenNode(node, g_score, h_score));
+            std::push_heap(open_nodes.begin(), open_nodes.end());
+        }
+    }
+
+    if(!destination_reached)
+        return false;
+
+    // Go backwards from the destination, the source and destination excluded.
+    for(int32_t node = parents[dest_node]; node >= 0 && static_cast<uint32_t>(node) != source_node; node = parents[node]) {
+        uint32_t index = _nodes[node].index;
+        way_points.push_back(Position2D(static_cast<float>(index % _num_grid_x_axis),
+                                        static_cast<float>(index / _num_grid_x_axis)));
+    }
+    std::reverse(way_points.begin(), way_points.end());
+    return true;
+}
+
+bool PathHierarchy::_ComputeWalkable(const CollisionBitmap& walls, uint32_t x, uint32_t y) const
+{
+    float left = static_cast<float>(x) + 0.5f - _coll_grid_half_width;
+    float right = static_cast<float>(x) + 0.5f + _coll_grid_half_width;
+    float top = static_cast<float>(y) + 0.5f - _coll_grid_height;
+    float bottom = static_cast<float>(y) + 0.5f;
+    if(left < 0.0f || right >= static_cast<float>(_num_grid_x_axis) ||
+            top < 0.0f || bottom >= static_cast<float>(_num_grid_y_axis))
+        return false;
+
+    return !walls.HasWall(static_cast<uint32_t>(left), static_cast<uint32_t>(top),
+                          static_cast<uint32_t>(right), static_cast<uint32_t>(bottom));
+}
+
+uint32_t PathHierarchy::_AddNode(uint32_t x, uint32_t y)
+{
+    uint32_t index = y * _num_grid_x_axis + x;
+    std::vector<uint32_t>& cluster_nodes = _cluster_nodes[_GetCluster(x, y)];
+    for(uint32_t i = 0; i < cluster_nodes.size(); ++i) {
+        if(_nodes[cluster_nodes[i]].index == index)
+            return cluster_nodes[i];
+    }
+
+    uint32_t node = _nodes.size();
+    if(_free_nodes.empty()) {
+        _nodes.push_back(HierarchyNode());
+    }
+    else {
+        node = _free_nodes.back();
+        _free_nodes.pop_back();
+    }
+    _nodes[node].index = index;
+    cluster_nodes.push_back(node);
+    return node;
+}
+
+void PathHierarchy::_AddEntrances(uint32_t x, uint32_t y, uint32_t step_x, uint32_t step_y,
+                                  uint32_t other_x, uint32_t other_y, uint32_t length)
+{
+    // Find the places where both sides of the border are walkable.
+    uint32_t start = 0;
+    for(uint32_t i = 0; i <= length; ++i) {
+        bool walkable = i < length
+                        && _walkable[(y + i * step_y) * _num_grid_x_axis + x + i * step_x]
+                        && _walkable[(other_y + i * step_y) * _num_grid_x_axis + other_x + i * step_x];
+        if(walkable)
+            continue;
+
+        // Add the entrance ending here, if any.
+        if(i > start) {
+            uint32_t end = i - 1;
+            std::vector<uint32_t> positions;
+            if(i - start < PATH_LONG_ENTRANCE_LENGTH) {
+                positions.push_back((start + end) / 2);
+            }
+            else {
+                positions.push_back(start);
+                positions.push_back(end);
+            }
+
+            for(uint32_t j = 0; j < positions.size(); ++j) {
+                uint32_t node = _AddNode(x + positions[j] * step_x, y + positions[j] * step_y);
+                uint32_t other_node = _AddNode(other_x + positions[j] * step_x, other_y + positions[j] * step_y);
+                _nodes[node].edges.push_back(HierarchyEdge(other_node, 10));
+                _nodes[other_node].edges.push_back(HierarchyEdge(node, 10));
+            }
+        }
+        start = i + 1;
+    }
+}
+
+void PathHierarchy::_AddBorderEntrances(uint32_t cluster, bool south_border)
+{
+    uint32_t cluster_x = cluster % _num_clusters_x;
+    uint32_t cluster_y = cluster / _num_clusters_x;
+    uint32_t x = cluster_x * PATH_CLUSTER_SIZE;
+    uint32_t y = cluster_y * PATH_CLUSTER_SIZE;
+    uint32_t width = std::min<uint32_t>(PATH_CLUSTER_SIZE, _num_grid_x_axis - x);
+    uint32_t height = std::min<uint32_t>(PATH_CLUSTER_SIZE, _num_grid_y_axis - y);
+
+    if(!south_border && cluster_x + 1 < _num_clusters_x)
+        _AddEntrances(x + width - 1, y, 0, 1, x + width, y, height);
+    else if(south_border && cluster_y + 1 < _num_clusters_y)
+        _AddEntrances(x, y + height - 1, 1, 0, x, y + height, width);
+}
+
+void PathHierarchy::_RemoveBorderEntrances(uint32_t cluster, bool south_border)
+{
+    uint32_t other_cluster = south_border ? cluster + _num_clusters_x : cluster + 1;
+    uint32_t clusters[2] = { cluster, other_cluster };
+
+    // Both clusters get linked again, so only the links to the other clusters than
+    // the one across the border are kept: those of the entrances along their other borders.
+    for(uint32_t i = 0; i < 2; ++i) {
+        std::vector<uint32_t>& cluster_nodes = _cluster_nodes[clusters[i]];
+        for(uint32_t j = 0; j < cluster_nodes.size();) {
+            std::vector<HierarchyEdge>& edges = _nodes[cluster_nodes[j]].edges;
+            for(uint32_t k = 0; k < edges.size();) {
+                uint32_t edge_cluster = _GetNodeCluster(edges[k].node);
+                if(edge_cluster == clusters[0] || edge_cluster == clusters[1]) {
+                    edges[k] = edges.back();
+                    edges.pop_back();
+                }
+                else {
+                    ++k;
+                }
+            }
+
+            // Free the nodes which are no longer an entrance.
+            if(!edges.empty()) {
+                ++j;
+                continue;
+            }
+            _free_nodes.push_back(cluster_nodes[j]);
+            cluster_nodes[j] = cluster_nodes.back();
+            cluster_nodes.pop_back();
+        }
+    }
+}
+
+void PathHierarchy::_LinkClusterNodes(uint32_t cluster, std::vector<uint32_t>& costs)
+{
+    const std::vector<uint32_t>& cluster_nodes = _cluster_nodes[cluster];
+    for(uint32_t i = 0; i < cluster_nodes.size(); ++i) {
+        HierarchyNode& node = _nodes[cluster_nodes[i]];
+
+        // Only keep the links to the other clusters.
+        for(uint32_t j = 0; j < node.edges.size();) {
+            if(_GetNodeCluster(node.edges[j].node) == cluster) {
+                node.edges[j] = node.edges.back();
+                node.edges.pop_back();
+            }
+            else {
+                ++j;
+            }
+        }
+
+        _ComputeClusterCosts(node.index % _num_grid_x_axis, node.index / _num_grid_x_axis, costs);
+        for(uint32_t j = 0; j < cluster_nodes.size(); ++j) {
+            if(i == j)
+                continue;
+            uint32_t other_index = _nodes[cluster_nodes[j]].index;
+            uint32_t cost = costs[_GetClusterIndex(other_index % _num_grid_x_axis, other_index / _num_grid_x_axis)];
+            if(cost != UNREACHABLE_COST)
+                node.edges.push_back(HierarchyEdge(cluster_nodes[j], cost));
+        }
+    }
+}
+
+void PathHierarchy::_ComputeClusterCosts(uint32_t x, uint32_t y, std::vector<uint32_t>& costs) const
+{
+    costs.assign(PATH_CLUSTER_SIZE * PATH_CLUSTER_SIZE, UNREACHABLE_COST);
+
+    int32_t cluster_left = (x / PATH_CLUSTER_SIZE) * PATH_CLUSTER_SIZE;
+    int32_t cluster_top = (y / PATH_CLUSTER_SIZE) * PATH_CLUSTER_SIZE;
+    int32_t cluster_right = std::min<int32_t>(cluster_left + PATH_CLUSTER_SIZE, _num_grid_x_axis);
+    int32_t cluster_bottom = std::min<int32_t>(cluster_top + PATH_CLUSTER_SIZE, _num_grid_y_axis);
+
+    // The relative coordinates of the eight adjacent elements, lateral ones first.
+    static const int32_t adjacent_nodes[8][2] = {
+        { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 },
+        { -1, -1 }, { -1, 1 }, { 1, -1 }, { 1, 1 }
+    };
+
+    // Dijkstra's algorithm, the open nodes being ordered by cost only.
+    std::vector<PathOpenNode> open_nodes;
+    costs[_GetClusterIndex(x, y)] = 0;
+    open_nodes.push_back(PathOpenNode(y * _num_grid_x_axis + x, 0, 0));
+    while(!open_nodes.empty()) {
+        std::pop_heap(open_nodes.begin(), open_nodes.end());
+        PathOpenNode best_node = open_nodes.back();
+        open_nodes.pop_back();
+
+        int32_t best_x = best_node.index % _num_grid_x_axis;
+        int32_t best_y = best_node.index / _num_grid_x_axis;
+        if(best_node.g_score > costs[_GetClusterIndex(best_x, best_y)])
+            continue;
+
+        for(uint32_t i = 0; i < 8; ++i) {
+            int32_t node_x = best_x + adjacent_nodes[i][0];
+            int32_t node_y = best_y + adjacent_nodes[i][1];
+            if(node_x < cluster_left || node_x >= cluster_right || node_y < cluster_top || node_y >= cluster_bottom)
+                continue;
+
+            uint32_t index = node_y * _num_grid_x_axis + node_x;
+            if(!_walkable[index])
+                continue;
+
+            uint32_t cost = best_node.g_score + ((i < 4) ? 10 : 14);
+            uint32_t& node_cost = costs[_GetClusterIndex(node_x, node_y)];
+            if(cost >= node_cost)
+                continue;
+
+            node_cost = cost;
+            open_nodes.push_back(PathOpenNode(index, cost, 0));
+            std::push_heap(open_nodes.begin(), open_nodes.end());
+        }
+    }
+}
+
+} // namespace private_map
+
+} // namespace vt_map
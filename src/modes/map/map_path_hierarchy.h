@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_path_hierarchy.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the hierarchical path finding.
+***
+*** The collision grid is split into square clusters. The walkable places along
+*** the borders of two clusters are entrances, and the distances between the
+*** entrances of each cluster are computed once. Long paths are then first
+*** searched between entrances, which is fast, before being searched on the
+*** collision grid one cluster at a time.
+*** ***************************************************************************/
+
+#ifndef __MAP_PATH_HIERARCHY_HEADER__
+#define __MAP_PATH_HIERARCHY_HEADER__
+
+#include "modes/map/map_utils.h"
+#include "modes/map/map_collision_bitmap.h"
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief The size of the path hierarchy clusters, in collision grid elements.
+const uint32_t PATH_CLUSTER_SIZE = 10;
+
+/** \brief The minimum distance between the source and the destination of a path,
+*** in collision grid elements, for it to be searched through the hierarchy first.
+**/
+const uint32_t PATH_HIERARCHY_MIN_DISTANCE = 2 * PATH_CLUSTER_SIZE;
+
+/** ****************************************************************************
+*** \brief The clusters entrances of a collision grid, for a given sprite collision size.
+***
+*** Where a sprite can walk depends on its collision size, so a hierarchy is
+*** built for each collision size. It only takes the collision grid walls in
+*** account: the map objects are only avoided when the path is searched on the
+*** collision grid. The hierarchy is only modified by UpdateWalls(), while
+*** no path is searched, and can otherwise be used by several threads at once.
+*** ***************************************************************************/
+class PathHierarchy
+{
+public:
+    /** \brief Builds the hierarchy.
+    *** \param walls The collision grid walls.
+    *** \param num_grid_x_axis, num_grid_y_axis The collision grid size.
+    *** \param coll_grid_half_width, coll_grid_height The sprites collision size.
+    **/
+    PathHierarchy(const CollisionBitmap& walls,
+                  uint16_t num_grid_x_axis, uint16_t num_grid_y_axis,
+                  float coll_grid_half_width, float coll_grid_height);
+
+    /** \brief Finds the entrances a path goes through, from the source to the destination.
+    *** \param way_points Filled with the entrances positions, the source and destination excluded.
+    *** \return false if the hierarchy found no path.
+    **/
+    bool FindWayPoints(const vt_common::Position2D& source,
+                       const vt_common::Position2D& destination,
+                       std::vector<vt_common::Position2D>& way_points) const;
+
+    /** \brief Updates the clusters around the collision grid elements changed since the hierarchy was built.
+    *** \param walls The collision grid walls, once changed.
+    *** \param changed_elements The indices of the changed collision grid elements.
+    **/
+    void UpdateWalls(const CollisionBitmap& walls, const std::vector<uint32_t>& changed_elements);
+
+    uint32_t GetNumberEntrances() const {
+        return _nodes.size() - _free_nodes.size();
+    }
+
+    //! \brief Tells whether the sprites can stand in the middle of the given collision grid element.
+    bool IsWalkable(uint32_t x, uint32_t y) const {
+        return x < _num_grid_x_axis && y < _num_grid_y_axis && _walkable[y * _num_grid_x_axis + x];
+    }
+
+private:
+    //! \brief A link between two entrances, with the cost of the shortest path between them.
+    struct HierarchyEdge {
+        HierarchyEdge(uint32_t node_, uint32_t cost_) :
+            node(node_),
+            cost(cost_)
+        {}
+
+        uint32_t node;
+        uint32_t cost;
+    };
+
+    //! \brief An entrance, on one side of a cluster border.
+    struct HierarchyNode {
+        //! \brief The collision grid index of the entrance.
+        uint32_t index;
+
+        std::vector<HierarchyEdge> edges;
+    };
+
+    uint16_t _num_grid_x_axis;
+    uint16_t _num_grid_y_axis;
+
+    uint32_t _num_clusters_x;
+    uint32_t _num_clusters_y;
+
+    //! \brief The sprites collision size.
+    float _coll_grid_half_width;
+    float _coll_grid_height;
+
+    //! \brief Whether the sprites can stand on each collision grid element.
+    std::vector<uint8_t> _walkable;
+
+    std::vector<HierarchyNode> _nodes;
+
+    //! \brief The nodes no longer used since the walls were updated, reused by the next entrances.
+    std::vector<uint32_t> _free_nodes;
+
+    //! \brief The entrances of each cluster, row after row.
+    std::vector<std::vector<uint32_t> > _cluster_nodes;
+
+    //! \brief Returns the cluster of a collision grid element.
+    uint32_t _GetCluster(uint32_t x, uint32_t y) const {
+        return (y / PATH_CLUSTER_SIZE) * _num_clusters_x + x / PATH_CLUSTER_SIZE;
+    }
+
+    //! \brief Returns the cluster of an entrance.
+    uint32_t _GetNodeCluster(uint32_t node) const {
+        uint32_t index = _nodes[node].index;
+        return _GetCluster(index % _num_grid_x_axis, index / _num_grid_x_axis);
+    }
+
+    //! \brief Tells whether the sprite collision rectangle fits, when standing in the middle of the element.
+    bool _ComputeWalkable(const CollisionBitmap& walls, uint32_t x, uint32_t y) const;
+
+    //! \brief Adds an entrance, or returns the existing one at the given collision grid element.
+    uint32_t _AddNode(uint32_t x, uint32_t y);
+
+    //! \brief Adds the entrances between two clusters, along a border.
+    void _AddEntrances(uint32_t x, uint32_t y, uint32_t step_x, uint32_t step_y,
+                       uint32_t other_x, uint32_t other_y, uint32_t length);
+
+    //! \brief Adds the entrances along the east or south border of a cluster.
+    void _AddBorderEntrances(uint32_t cluster, bool south_border);
+
+    /** \brief Removes the entrances along the east or south border of a cluster, along with
+    *** the links within both clusters. The nodes left without a link are freed.
+    **/
+    void _RemoveBorderEntrances(uint32_t cluster, bool south_border);
+
+    /** \brief Links the entrances of a cluster with the cost of the shortest path between them,
+    *** replacing the former links.
+    **/
+    void _LinkClusterNodes(uint32_t cluster, std::vector<uint32_t>& costs);
+
+    /** \brief Computes the cost of the shortest paths from a collision grid element
+    *** to every other element of its cluster.
+    *** \param costs Filled with the costs, by element index within the cluster.
+    *** Unreachable elements get the maximum cost.
+    **/
+    void _ComputeClusterCosts(uint32_t x, uint32_t y, std::vector<uint32_t>& costs) const;
+
+    //! \brief Returns the index within its cluster of a collision grid element.
+    static uint32_t _GetClusterIndex(uint32_t x, uint32_t y) {
+        return (y % PATH_CLUSTER_SIZE) * PATH_CLUSTER_SIZE + x % PATH_CLUSTER_SIZE;
+    }
+};
+
+} // namespace private_map
+
+} // namespace vt_map
+
+#endif // __MAP_PATH_HIERARCHY_HEADER__
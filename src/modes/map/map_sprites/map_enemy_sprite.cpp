@@ -30,7 +30,8 @@ EnemySprite::EnemySprite() :
     _time_to_spawn(STANDARD_ENEMY_FIRST_SPAWN_TIME),
     _time_to_respawn(STANDARD_ENEMY_SPAWN_TIME),
     _is_boss(false),
-    _use_path(false)
+    _use_path(false),
+    _path_request(0)
 {
     _object_type = ENEMY_TYPE;
     _moving = false;
@@ -63,6 +64,7 @@ void EnemySprite::Reset()
     _current_node_id = 0;
     _path.clear();
     _use_path = false;
+    _CancelPathRequest();
 
     // Reset the currently selected way point
     _current_way_point_id = 0;
@@ -160,6 +162,7 @@ void EnemySprite::_HandleHostileUpdate()
     MapMode* map_mode = MapMode::CurrentInstance();
     if (player_in_aggro_range && map_mode->AttackAllowed()) {
         // We first cancel the potential previous path.
+        _CancelPathRequest();
         if (!_path.empty()) {
             // We cancel any previous path
             _path.clear();
@@ -173,7 +176,13 @@ void EnemySprite::_HandleHostileUpdate()
         if (this->IsCollidingWith(camera))
             map_mode->StartEnemyEncounter(this);
 
-        // Make the monster go toward the character
+        // Make the monster go toward the character, getting around the walls in between.
+        Position2D chase_destination;
+        if(map_mode->GetObjectSupervisor()->GetChaseDestination(this, camera->GetPosition(), chase_destination)) {
+            xdelta = GetXPosition() - chase_destination.x;
+            ydelta = GetYPosition() - chase_destination.y;
+        }
+
         if(xdelta > -0.5 && xdelta < 0.5 && ydelta < 0)
             SetDirection(SOUTH);
         else if(xdelta > -0.5 && xdelta < 0.5 && ydelta > 0)
@@ -198,11 +207,14 @@ void EnemySprite::_HandleHostileUpdate()
     // Handle monsters with way points.
     if (!_way_points.empty()) {
 
+        // Start following the path once found
+        _UpdatePathRequest();
+
         // Update the wait time until next path between two way points.
         if (!_use_path || !_moving)
             _time_elapsed += vt_system::SystemManager->GetUpdateTime();
 
-        if (_path.empty() && _time_elapsed >= _time_before_new_destination) {
+        if (_path.empty() && _path_request == 0 && _time_elapsed >= _time_before_new_destination) {
             if (!_SetPathToNextWayPoint()) {
                 // Fall back to simple movement mode
                 SetRandomDirection();
@@ -298,7 +310,7 @@ void EnemySprite::AddWayPoint(float destination_x, float destination_y)
 
 bool EnemySprite::_SetPathToNextWayPoint()
 {
-    //! Will be set to true if _SetDestination() is succeeding
+    //! Will be set to true once the path requested by _SetDestination() is found
     _use_path = false;
 
     // There must be at least two way points to permit supporting those.
@@ -351,6 +363,7 @@ bool EnemySprite::_SetDestination(float destination_x, float destination_y, uint
 {
     _path.clear();
     _use_path = false;
+    _CancelPathRequest();
 
     uint32_t dest_x = static_cast<uint32_t>(destination_x);
     uint32_t dest_y = static_cast<uint32_t>( destination_y);
@@ -364,11 +377,34 @@ bool EnemySprite::_SetDestination(float destination_x, float destination_y, uint
     Position2D dest(destination_x, destination_y);
     // We set the correct mask before finding the path
     _collision_mask = WALL_COLLISION | CHARACTER_COLLISION;
-    _path = MapMode::CurrentInstance()->GetObjectSupervisor()->FindPath(this, dest, max_cost);
+    _path_request = MapMode::CurrentInstance()->GetObjectSupervisor()->RequestPath(this, dest, max_cost);
 
-    if (_path.empty())
+    if (_path_request == 0)
         return false;
 
+    // The sprite waits for the path to be found.
+    _destination = dest;
+    _moving = false;
+    return true;
+}
+
+void EnemySprite::_UpdatePathRequest()
+{
+    if (_path_request == 0)
+        return;
+
+    ObjectSupervisor* object_supervisor = MapMode::CurrentInstance()->GetObjectSupervisor();
+    if (object_supervisor->GetRequestedPath(_path_request, _path) == PATH_REQUEST_PENDING)
+        return;
+    _path_request = 0;
+
+    if (_path.empty()) {
+        // Fall back to simple movement mode
+        SetRandomDirection();
+        _moving = true;
+        return;
+    }
+
     // But remove wall collision afterward to avoid making it stuck in corners.
     // Note: this function is only called when hostile, son we don't deal with
     // the spawning collision mask.
@@ -376,13 +412,20 @@ bool EnemySprite::_SetDestination(float destination_x, float destination_y, uint
 
     _current_node_id = 0;
     _last_node_position = GetPosition();
-    _destination = dest;
 
     _current_node = _path[_current_node_id];
 
     _moving = true;
     _use_path = true;
-    return true;
+}
+
+void EnemySprite::_CancelPathRequest()
+{
+    if (_path_request == 0)
+        return;
+
+    MapMode::CurrentInstance()->GetObjectSupervisor()->CancelPathRequest(_path_request);
+    _path_request = 0;
 }
 
 void EnemySprite::_SetSpritePathDirection()
@@ -272,6 +272,9 @@ private:
     //! \brief Holds the path needed to traverse from source to destination
     Path _path;
 
+    //! \brief The ticket of the path being searched, or 0.
+    uint32_t _path_request;
+
     //! \brief Way points used by the enemy when not hostile
     std::vector<vt_common::Position2D> _way_points;
     uint32_t _current_way_point_id;
@@ -281,9 +284,15 @@ private:
     //! \param destination_y The pixel y destination to find a path to.
     //! \param max_cost More or less the path max length in nodes or 0 if no limitations.
     //! Use this to avoid heavy computations.
-    //! \return whether it failed.
+    //! \return whether it failed. The path is then searched in the background.
     bool _SetDestination(float destination_x, float destination_y, uint32_t max_cost = 20);
 
+    //! \brief Starts following the requested path once found.
+    void _UpdatePathRequest();
+
+    //! \brief Cancels the path being searched, if any.
+    void _CancelPathRequest();
+
     //! \brief Set the actual sprite direction according to the current path node.
     void _SetSpritePathDirection();
 
@@ -14,6 +14,7 @@
 #include "modes/map/map_dialogue_supervisor.h"
 #include "modes/map/map_dialogues/map_sprite_dialogue.h"
 #include "modes/map/map_events.h"
+#include "modes/map/map_object_supervisor.h"
 
 #include "common/global/global.h"
 #include "common/rectangle_2d.h"
@@ -68,143 +69,19 @@ MapSprite* MapSprite::Create(MapObjectDrawLayer layer)
     return new MapSprite(layer);
 }
 
-bool _LoadAnimations(std::vector<vt_video::AnimatedImage>& animations, const std::string &filename)
+bool MapSprite::_LoadAnimations(std::vector<vt_video::AnimatedImage>& animations, const std::string &filename)
 {
-    // Prepare to add the animations for each directions, if needed.
-
-    // In case of reloading
-    animations.clear();
-    for(uint8_t i = 0; i < NUM_ANIM_DIRECTIONS; ++i)
-        animations.push_back(vt_video::AnimatedImage());
-
-    vt_script::ReadScriptDescriptor animations_script;
-    if(!animations_script.OpenFile(filename))
-        return false;
-
-    if(!animations_script.DoesTableExist("sprite_animation")) {
-        PRINT_WARNING << "No 'sprite_animation' table in 4-direction animation script file: " << filename << std::endl;
-        animations_script.CloseFile();
-        return false;
-    }
-
-    animations_script.OpenTable("sprite_animation");
-
-    std::string image_filename = animations_script.ReadString("image_filename");
-    if(!vt_utils::DoesFileExist(image_filename)) {
-        PRINT_WARNING << "The image file doesn't exist: " << image_filename << std::endl;
-        animations_script.CloseTable();
-        animations_script.CloseFile();
-        return false;
-    }
-
-    bool blended_animation = false;
-    if (animations_script.DoesBoolExist("blended_animation")) {
-        blended_animation = animations_script.ReadBool("blended_animation");
-    }
-
-    uint32_t rows = animations_script.ReadUInt("rows");
-    uint32_t columns = animations_script.ReadUInt("columns");
-
-    if(!animations_script.DoesTableExist("frames")) {
-        animations_script.CloseAllTables();
-        animations_script.CloseFile();
-        PRINT_WARNING << "No frame table in file: " << filename << std::endl;
-        return false;
-    }
-
-    std::vector<vt_video::StillImage> image_frames;
-    // Load the image data
-    if(!vt_video::ImageDescriptor::LoadMultiImageFromElementGrid(image_frames, image_filename, rows, columns)) {
-        PRINT_WARNING << "Couldn't load elements from image file: " << image_filename
-                      << " (in file: " << filename << ")" << std::endl;
-        animations_script.CloseAllTables();
-        animations_script.CloseFile();
+    SpriteAnimationCache& cache = MapMode::CurrentInstance()->GetObjectSupervisor()->GetSpriteAnimationCache();
+    const std::vector<vt_video::AnimatedImage>* cached_animations = cache.GetAnimations(filename);
+    if (!cached_animations) {
+        animations.assign(NUM_ANIM_DIRECTIONS, vt_video::AnimatedImage());
         return false;
     }
 
-    std::vector <uint32_t> frames_directions_ids;
-    animations_script.ReadTableKeys("frames", frames_directions_ids);
-
-    // open the frames table
-    animations_script.OpenTable("frames");
-
-    for(uint32_t i = 0; i < frames_directions_ids.size(); ++i) {
-        if(frames_directions_ids[i] >= NUM_ANIM_DIRECTIONS) {
-            PRINT_WARNING << "Invalid direction id(" << frames_directions_ids[i]
-                          << ") in file: " << filename << std::endl;
-            continue;
-        }
-
-        uint32_t anim_direction = frames_directions_ids[i];
-
-        // Opens frames[ANIM_DIRECTION]
-        animations_script.OpenTable(anim_direction);
-
-        // Loads the frames data
-        std::vector<uint32_t> frames_ids;
-        std::vector<uint32_t> frames_duration;
-
-        uint32_t num_frames = animations_script.GetTableSize();
-        for(uint32_t frames_table_id = 0;  frames_table_id < num_frames; ++frames_table_id) {
-            // Opens frames[ANIM_DIRECTION][frame_table_id]
-            animations_script.OpenTable(frames_table_id);
-
-            int32_t frame_id = animations_script.ReadInt("id");
-            int32_t frame_duration = animations_script.ReadInt("duration");
-
-            if(frame_id < 0 || frame_duration < 0 || frame_id >= (int32_t)image_frames.size()) {
-                PRINT_WARNING << "Invalid frame (" << frames_table_id << ") in file: "
-                              << filename << std::endl;
-                PRINT_WARNING << "Request for frame id: " << frame_id << ", duration: "
-                              << frame_duration << " is not possible." << std::endl;
-                continue;
-            }
-
-            frames_ids.push_back((uint32_t)frame_id);
-            frames_duration.push_back((uint32_t)frame_duration);
-
-            animations_script.CloseTable(); // frames[ANIM_DIRECTION][frame_table_id] table
-        }
-
-        // Actually create the animation data
-        animations[anim_direction].Clear();
-        animations[anim_direction].ResetAnimation();
-        animations[anim_direction].SetAnimationBlended(blended_animation);
-        for(uint32_t j = 0; j < frames_ids.size(); ++j) {
-            // Set the dimension of the requested frame
-            animations[anim_direction].AddFrame(image_frames[frames_ids[j]], frames_duration[j]);
-        }
-
-        // Closes frames[ANIM_DIRECTION]
-        animations_script.CloseTable();
-
-    } // for each directions
-
-    // Close the 'frames' table and set the dimensions
-    animations_script.CloseTable();
-
-    float frame_width = animations_script.ReadFloat("frame_width");
-    float frame_height = animations_script.ReadFloat("frame_height");
-
-    // Load requested dimensions
-    for(uint8_t i = 0; i < NUM_ANIM_DIRECTIONS; ++i) {
-        if(frame_width > 0.0f && frame_height > 0.0f) {
-            animations[i].SetDimensions(frame_width, frame_height);
-        } else if(vt_utils::IsFloatEqual(animations[i].GetWidth(), 0.0f)
-                  && vt_utils::IsFloatEqual(animations[i].GetHeight(), 0.0f)) {
-            // If the animation dimensions are not set, we're using the first frame size.
-            animations[i].SetDimensions(image_frames.begin()->GetWidth(), image_frames.begin()->GetHeight());
-        }
-
-        // Rescale to fit the map mode coordinates system.
-        MapMode::ScaleToMapZoomRatio(animations[i]);
-    }
-
-    animations_script.CloseTable(); // sprite_animation table
-    animations_script.CloseFile();
-
+    // The frames images share the cached ones textures.
+    animations = *cached_animations;
     return true;
-} // bool _LoadAnimations()
+}
 
 void MapSprite::ClearAnimations()
 {
@@ -302,6 +302,11 @@ protected:
 
     //! \brief Draws debug information, used for pathfinding mostly.
     void _DrawDebugInfo();
+
+    /** \brief Copies the animations of the given 4-direction animation script from the map cache.
+    *** \return false if the file couldn't be loaded, the animations being then empty.
+    **/
+    static bool _LoadAnimations(std::vector<vt_video::AnimatedImage>& animations, const std::string &filename);
 };
 
 } // namespace private_map
@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_sprite_animations.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the map sprites shared animations.
+*** ***************************************************************************/
+
+#include "modes/map/map_sprites/map_sprite_animations.h"
+
+#include "modes/map/map_mode.h"
+
+#include "script/script_read.h"
+
+#include "utils/utils_files.h"
+#include "utils/utils_numeric.h"
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief Loads the animations of a 4-direction animation script, one per direction.
+static bool _LoadAnimations(std::vector<vt_video::AnimatedImage>& animations, const std::string &filename)
+{
+    // Prepare to add the animations for each directions, if needed.
+    animations.assign(NUM_ANIM_DIRECTIONS, vt_video::AnimatedImage());
+
+    vt_script::ReadScriptDescriptor animations_script;
+    if(!animations_script.OpenFile(filename))
+        return false;
+
+    if(!animations_script.DoesTableExist("sprite_animation")) {
+        PRINT_WARNING << "No 'sprite_animation' table in 4-direction animation script file: " << filename << std::endl;
+        animations_script.CloseFile();
+        return false;
+    }
+
+    animations_script.OpenTable("sprite_animation");
+
+    std::string image_filename = animations_script.ReadString("image_filename");
+    if(!vt_utils::DoesFileExist(image_filename)) {
+        PRINT_WARNING << "The image file doesn't exist: " << image_filename << std::endl;
+        animations_script.CloseTable();
+        animations_script.CloseFile();
+        return false;
+    }
+
+    bool blended_animation = false;
+    if (animations_script.DoesBoolExist("blended_animation")) {
+        blended_animation = animations_script.ReadBool("blended_animation");
+    }
+
+    uint32_t rows = animations_script.ReadUInt("rows");
+    uint32_t columns = animations_script.ReadUInt("columns");
+
+    if(!animations_script.DoesTableExist("frames")) {
+        animations_script.CloseAllTables();
+        animations_script.CloseFile();
+        PRINT_WARNING << "No frame table in file: " << filename << std::endl;
+        return false;
+    }
+
+    std::vector<vt_video::StillImage> image_frames;
+    // Load the image data
+    if(!vt_video::ImageDescriptor::LoadMultiImageFromElementGrid(image_frames, image_filename, rows, columns)) {
+        PRINT_WARNING << "Couldn't load elements from image file: " << image_filename
+                      << " (in file: " << filename << ")" << std::endl;
+        animations_script.CloseAllTables();
+        animations_script.CloseFile();
+        return false;
+    }
+
+    std::vector <uint32_t> frames_directions_ids;
+    animations_script.ReadTableKeys("frames", frames_directions_ids);
+
+    // open the frames table
+    animations_script.OpenTable("frames");
+
+    for(uint32_t i = 0; i < frames_directions_ids.size(); ++i) {
+        if(frames_directions_ids[i] >= NUM_ANIM_DIRECTIONS) {
+            PRINT_WARNING << "Invalid direction id(" << frames_directions_ids[i]
+                          << ") in file: " << filename << std::endl;
+            continue;
+        }
+
+        uint32_t anim_direction = frames_directions_ids[i];
+
+        // Opens frames[ANIM_DIRECTION]
+        animations_script.OpenTable(anim_direction);
+
+        // Loads the frames data
+        std::vector<uint32_t> frames_ids;
+        std::vector<uint32_t> frames_duration;
+
+        uint32_t num_frames = animations_script.GetTableSize();
+        for(uint32_t frames_table_id = 0;  frames_table_id < num_frames; ++frames_table_id) {
+            // Opens frames[ANIM_DIRECTION][frame_table_id]
+            animations_script.OpenTable(frames_table_id);
+
+            int32_t frame_id = animations_script.ReadInt("id");
+            int32_t frame_duration = animations_script.ReadInt("duration");
+
+            if(frame_id < 0 || frame_duration < 0 || frame_id >= (int32_t)image_frames.size()) {
+                PRINT_WARNING << "Invalid frame (" << frames_table_id << ") in file: "
+                              << filename << std::endl;
+                PRINT_WARNING << "Request for frame id: " << frame_id << ", duration: "
+                              << frame_duration << " is not possible." << std::endl;
+                continue;
+            }
+
+            frames_ids.push_back((uint32_t)frame_id);
+            frames_duration.push_back((uint32_t)frame_duration);
+
+            animations_script.CloseTable(); // frames[ANIM_DIRECTION][frame_table_id] table
+        }
+
+        // Actually create the animation data
+        animations[anim_direction].Clear();
+        animations[anim_direction].ResetAnimation();
+        animations[anim_direction].SetAnimationBlended(blended_animation);
+        for(uint32_t j = 0; j < frames_ids.size(); ++j) {
+            // Set the dimension of the requested frame
+            animations[anim_direction].AddFrame(image_frames[frames_ids[j]], frames_duration[j]);
+        }
+
+        // Closes frames[ANIM_DIRECTION]
+        animations_script.CloseTable();
+
+    } // for each directions
+
+    // Close the 'frames' table and set the dimensions
+    animations_script.CloseTable();
+
+    float frame_width = animations_script.ReadFloat("frame_width");
+    float frame_height = animations_script.ReadFloat("frame_height");
+
+    // Load requested dimensions
+    for(uint8_t i = 0; i < NUM_ANIM_DIRECTIONS; ++i) {
+        if(frame_width > 0.0f && frame_height > 0.0f) {
+            animations[i].SetDimensions(frame_width, frame_height);
+        } else if(vt_utils::IsFloatEqual(animations[i].GetWidth(), 0.0f)
+                  && vt_utils::IsFloatEqual(animations[i].GetHeight(), 0.0f)) {
+            // If the animation dimensions are not set, we're using the first frame size.
+            animations[i].SetDimensions(image_frames.begin()->GetWidth(), image_frames.begin()->GetHeight());
+        }
+
+        // Rescale to fit the map mode coordinates system.
+        MapMode::ScaleToMapZoomRatio(animations[i]);
+    }
+
+    animations_script.CloseTable(); // sprite_animation table
+    animations_script.CloseFile();
+
+    return true;
+} // bool _LoadAnimations()
+
+const std::vector<vt_video::AnimatedImage>* SpriteAnimationCache::GetAnimations(const std::string& filename)
+{
+    std::map<std::string, std::vector<vt_video::AnimatedImage> >::const_iterator it = _animations.find(filename);
+    if (it == _animations.end()) {
+        std::vector<vt_video::AnimatedImage>& animations = _animations[filename];
+        if (!_LoadAnimations(animations, filename))
+            animations.clear();
+        it = _animations.find(filename);
+    }
+
+    return it->second.empty() ? nullptr : &it->second;
+}
+
+uint32_t SpriteAnimationCache::GetFramesCount() const
+{
+    uint32_t count = 0;
+    std::map<std::string, std::vector<vt_video::AnimatedImage> >::const_iterator it = _animations.begin();
+    for (; it != _animations.end(); ++it) {
+        for (uint32_t i = 0; i < it->second.size(); ++i)
+            count += it->second[i].GetNumFrames();
+    }
+    return count;
+}
+
+} // namespace private_map
+
+} // namespace vt_map
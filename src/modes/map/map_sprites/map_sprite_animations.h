@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_sprite_animations.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the map sprites shared animations.
+***
+*** Many sprites of a map use the same standing, walking and running animation
+*** files, e.g. the enemies spawned by a zone or a crowd of villagers.
+*** Those 4-direction animation scripts are read once per map into a cache,
+*** and the sprites then copy the cached animations: the frames share the same
+*** textures and timings, and each sprite only keeps its own playback state.
+*** ***************************************************************************/
+
+#ifndef __MAP_SPRITE_ANIMATIONS_HEADER__
+#define __MAP_SPRITE_ANIMATIONS_HEADER__
+
+#include "engine/video/image.h"
+
+#include <map>
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+/** ****************************************************************************
+*** \brief Keeps the 4-direction sprite animations loaded on a map, by filename.
+***
+*** The cached animations are never played nor modified, and are scaled to
+*** the map coordinates system already.
+*** ***************************************************************************/
+class SpriteAnimationCache
+{
+public:
+    SpriteAnimationCache()
+    {}
+
+    /** \brief Returns the animations, one per direction, of the given 4-direction animation script.
+    *** The file is only read the first time.
+    *** \return nullptr if the file couldn't be loaded.
+    **/
+    const std::vector<vt_video::AnimatedImage>* GetAnimations(const std::string& filename);
+
+    //! \brief Returns the number of cached animation files.
+    uint32_t GetAnimationsCount() const {
+        return _animations.size();
+    }
+
+    //! \brief Returns the number of frames of all the cached animations.
+    uint32_t GetFramesCount() const;
+
+    void Clear() {
+        _animations.clear();
+    }
+
+private:
+    /** \brief The animations by filename.
+    *** The files which couldn't be loaded are kept as empty vectors, so that they are only read once.
+    **/
+    std::map<std::string, std::vector<vt_video::AnimatedImage> > _animations;
+
+    SpriteAnimationCache(const SpriteAnimationCache&) = delete;
+    SpriteAnimationCache& operator=(const SpriteAnimationCache&) = delete;
+};
+
+} // namespace private_map
+
+} // namespace vt_map
+
+#endif // __MAP_SPRITE_ANIMATIONS_HEADER__
@@ -63,6 +63,18 @@ void VirtualSprite::Update()
     _SetNextPosition();
 } // void VirtualSprite::Update()
 
+/** \brief Tells whether an edge position is blocked.
+*** Away from the walls, only the object walked around is tested: the other objects
+*** are found by the final check of the position chosen.
+**/
+static bool _IsEdgeBlocked(ObjectSupervisor* object_supervisor, MapObject* collision_object,
+                           bool away_from_walls, float x, float y)
+{
+    if (away_from_walls)
+        return collision_object->GetGridCollisionRectangle().Contains(Position2D(x, y));
+    return object_supervisor->IsStaticCollision(x, y);
+}
+
 bool VirtualSprite::_HandleWallEdges(float& next_pos_x,
                                      float& next_pos_y,
                                      float distance_moved,
@@ -88,16 +100,26 @@ bool VirtualSprite::_HandleWallEdges(float& next_pos_x,
 
     ObjectSupervisor *object_supervisor = MapMode::CurrentInstance()->GetObjectSupervisor();
 
+    // When the edge positions can't reach any wall, the sprite can only be walking
+    // around an object, and the probes through every map object are skipped.
+    float wall_clearance = static_cast<float>(object_supervisor->GetWallDistance(_tile_position.x, _tile_position.y))
+                           - std::max(_coll_grid_height, _coll_grid_half_width) - 1.0f;
+    bool away_from_walls = (wall_clearance > distance_moved);
+    if (away_from_walls && !collision_object)
+        return false;
+
     if(_direction & NORTH) {
         // Test both the north-east and north west cases
-        if(!object_supervisor->IsStaticCollision(_tile_position.x + _coll_grid_half_width,
-                                                 _tile_position.y - _coll_grid_height - distance_moved)) {
+        if(!_IsEdgeBlocked(object_supervisor, collision_object, away_from_walls,
+                           _tile_position.x + _coll_grid_half_width,
+                           _tile_position.y - _coll_grid_height - distance_moved)) {
             edge_next_pos_x = _tile_position.x + edge_distance_moved;
             edge_next_pos_y = _tile_position.y;
             on_edge = true;
         }
-        else if (!object_supervisor->IsStaticCollision(_tile_position.x - _coll_grid_half_width,
-                                                       _tile_position.y - _coll_grid_height - distance_moved)) {
+        else if (!_IsEdgeBlocked(object_supervisor, collision_object, away_from_walls,
+                                 _tile_position.x - _coll_grid_half_width,
+                                 _tile_position.y - _coll_grid_height - distance_moved)) {
             edge_next_pos_x = _tile_position.x - edge_distance_moved;
             edge_next_pos_y = _tile_position.y;
             on_edge = true;
@@ -105,14 +127,16 @@ bool VirtualSprite::_HandleWallEdges(float& next_pos_x,
     }
     else if(_direction & SOUTH) {
         // Test both the south-east and south west cases
-        if(!object_supervisor->IsStaticCollision(_tile_position.x + _coll_grid_half_width,
-                                                 _tile_position.y + distance_moved)) {
+        if(!_IsEdgeBlocked(object_supervisor, collision_object, away_from_walls,
+                           _tile_position.x + _coll_grid_half_width,
+                           _tile_position.y + distance_moved)) {
             edge_next_pos_x = _tile_position.x + edge_distance_moved;
             edge_next_pos_y = _tile_position.y;
             on_edge = true;
         }
-        else if (!object_supervisor->IsStaticCollision(_tile_position.x - _coll_grid_half_width,
-                                                       _tile_position.y + distance_moved)) {
+        else if (!_IsEdgeBlocked(object_supervisor, collision_object, away_from_walls,
+                                 _tile_position.x - _coll_grid_half_width,
+                                 _tile_position.y + distance_moved)) {
             edge_next_pos_x = _tile_position.x - edge_distance_moved;
             edge_next_pos_y = _tile_position.y;
             on_edge = true;
@@ -120,14 +144,16 @@ bool VirtualSprite::_HandleWallEdges(float& next_pos_x,
     }
     else if(_direction & EAST) {
         // Test both the north-east and south-east cases
-        if(!object_supervisor->IsStaticCollision(_tile_position.x + _coll_grid_half_width + distance_moved,
-                                                 _tile_position.y - _coll_grid_height)) {
+        if(!_IsEdgeBlocked(object_supervisor, collision_object, away_from_walls,
+                           _tile_position.x + _coll_grid_half_width + distance_moved,
+                           _tile_position.y - _coll_grid_height)) {
             edge_next_pos_x = _tile_position.x;
             edge_next_pos_y = _tile_position.y - edge_distance_moved;
             on_edge = true;
         }
-        else if (!object_supervisor->IsStaticCollision(_tile_position.x + _coll_grid_half_width + distance_moved,
-                                                       _tile_position.y)) {
+        else if (!_IsEdgeBlocked(object_supervisor, collision_object, away_from_walls,
+                                 _tile_position.x + _coll_grid_half_width + distance_moved,
+                                 _tile_position.y)) {
             edge_next_pos_x = _tile_position.x;
             edge_next_pos_y = _tile_position.y + edge_distance_moved;
             on_edge = true;
@@ -135,14 +161,16 @@ bool VirtualSprite::_HandleWallEdges(float& next_pos_x,
     }
     else if(_direction & WEST) {
         // Test both the north-west and south-west cases
-        if(!object_supervisor->IsStaticCollision(_tile_position.x - _coll_grid_half_width - distance_moved,
-                                                 _tile_position.y - _coll_grid_height)) {
+        if(!_IsEdgeBlocked(object_supervisor, collision_object, away_from_walls,
+                           _tile_position.x - _coll_grid_half_width - distance_moved,
+                           _tile_position.y - _coll_grid_height)) {
             edge_next_pos_x = _tile_position.x;
             edge_next_pos_y = _tile_position.y - edge_distance_moved;
             on_edge = true;
         }
-        else if (!object_supervisor->IsStaticCollision(_tile_position.x - _coll_grid_half_width - distance_moved,
-                                                       _tile_position.y)) {
+        else if (!_IsEdgeBlocked(object_supervisor, collision_object, away_from_walls,
+                                 _tile_position.x - _coll_grid_half_width - distance_moved,
+                                 _tile_position.y)) {
             edge_next_pos_x = _tile_position.x;
             edge_next_pos_y = _tile_position.y + edge_distance_moved;
             on_edge = true;
@@ -18,6 +18,7 @@
 #include "modes/map/map_tiles.h"
 
 #include "modes/map/map_mode.h"
+#include "modes/map/map_data_file.h"
 
 #include "engine/video/video.h"
 
@@ -65,46 +66,10 @@ bool TileSupervisor::Load(ReadScriptDescriptor &map_file)
     _num_tile_on_y_axis = map_file.ReadInt("num_tile_rows");
     _num_tile_on_x_axis = map_file.ReadInt("num_tile_cols");
 
-    // Load all of the tileset images that are used by this map
-
     // Contains all of the tileset filenames used (string does not contain path information or file extensions)
     std::vector<std::string> tileset_filenames;
-    // Temporarily retains all tile images loaded for each tileset. Each inner vector contains 256 StillImage objects
-    std::vector<std::vector<StillImage> > tileset_images;
-
     map_file.ReadStringVector("tileset_filenames", tileset_filenames);
 
-    for(uint32_t i = 0; i < tileset_filenames.size(); i++) {
-        std::string tileset_file = tileset_filenames[i];
-
-        ReadScriptDescriptor tileset_script;
-        if (!tileset_script.OpenFile(tileset_file)) {
-            PRINT_ERROR << "Couldn't open the tileset definition file: " << tileset_file << std::endl;
-            return false;
-        }
-
-        if (!tileset_script.OpenTable("tileset")) {
-            PRINT_ERROR << "Couldn't open the 'tileset' table from file: " << tileset_file << std::endl;
-            tileset_script.CloseFile();
-            return false;
-        }
-
-        std::string image_filename = tileset_script.ReadString("image");
-        tileset_script.CloseFile();
-
-        tileset_images.push_back(std::vector<StillImage>(TILES_PER_TILESET));
-
-        // Each tileset image is 512x512 pixels, yielding 16 * 16 (== 256) 32x32 pixel tiles each
-        if(!ImageDescriptor::LoadMultiImageFromElementGrid(tileset_images[i], image_filename, 16, 16)) {
-            PRINT_ERROR << "failed to load tileset image: " << image_filename << std::endl;
-            return false;
-        }
-
-        for(uint32_t j = 0; j < TILES_PER_TILESET; j++) {
-            tileset_images[i][j].SetDimensions(TILE_LENGTH, TILE_LENGTH);
-        }
-    }
-
     if(!map_file.DoesTableExist("layers")) {
         PRINT_ERROR << "No 'layers' table in the map file." << std::endl;
         return false;
@@ -181,6 +146,74 @@ bool TileSupervisor::Load(ReadScriptDescriptor &map_file)
 
     map_file.CloseTable(); // layers
 
+    return _LoadTilesets(tileset_filenames);
+}
+
+bool TileSupervisor::Load(const MapDataFile &map_data)
+{
+    _num_tile_on_y_axis = map_data.GetNumTileRows();
+    _num_tile_on_x_axis = map_data.GetNumTileCols();
+
+    // The tile indeces are read as is, with the same meaning as in the Lua map files.
+    _tile_grid.clear();
+    _tile_grid.resize(map_data.GetNumberLayers());
+
+    for(uint32_t layer_id = 0; layer_id < map_data.GetNumberLayers(); ++layer_id) {
+        if(map_data.GetLayerType(layer_id) >= INVALID_LAYER) {
+            PRINT_ERROR << "Invalid layer type: " << map_data.GetLayerType(layer_id)
+                        << " in file: " << map_data.GetFilename() << std::endl;
+            return false;
+        }
+        _tile_grid[layer_id].layer_type = static_cast<LAYER_TYPE>(map_data.GetLayerType(layer_id));
+
+        _tile_grid[layer_id].tiles.resize(_num_tile_on_y_axis);
+        for(uint16_t y = 0; y < _num_tile_on_y_axis; ++y)
+            map_data.ReadLayerRow(layer_id, y, _tile_grid[layer_id].tiles[y]);
+    }
+
+    return _LoadTilesets(map_data.GetTilesetFilenames());
+}
+
+bool TileSupervisor::_LoadTilesets(const std::vector<std::string>& tileset_filenames)
+{
+    // Load all of the tileset images that are used by this map
+
+    // Temporarily retains all tile images loaded for each tileset. Each inner vector contains 256 StillImage objects
+    std::vector<std::vector<StillImage> > tileset_images;
+
+    for(uint32_t i = 0; i < tileset_filenames.size(); i++) {
+        std::string tileset_file = tileset_filenames[i];
+
+        ReadScriptDescriptor tileset_script;
+        if (!tileset_script.OpenFile(tileset_file)) {
+            PRINT_ERROR << "Couldn't open the tileset definition file: " << tileset_file << std::endl;
+            return false;
+        }
+
+        if (!tileset_script.OpenTable("tileset")) {
+            PRINT_ERROR << "Couldn't open the 'tileset' table from file: " << tileset_file << std::endl;
+            tileset_script.CloseFile();
+            return false;
+        }
+
+        std::string image_filename = tileset_script.ReadString("image");
+        tileset_script.CloseFile();
+
+        tileset_images.push_back(std::vector<StillImage>(TILES_PER_TILESET));
+
+        // Each tileset image is 512x512 pixels, yielding 16 * 16 (== 256) 32x32 pixel tiles each
+        if(!ImageDescriptor::LoadMultiImageFromElementGrid(tileset_images[i], image_filename, 16, 16)) {
+            PRINT_ERROR << "failed to load tileset image: " << image_filename << std::endl;
+            return false;
+        }
+
+        for(uint32_t j = 0; j < TILES_PER_TILESET; j++) {
+            tileset_images[i][j].SetDimensions(TILE_LENGTH, TILE_LENGTH);
+        }
+    }
+
+    uint32_t layers_number = _tile_grid.size();
+
     // Determine which tiles in each tileset are referenced in this map
 
     // Used to determine whether each tile is used by the map or not. An entry of -1 indicates that particular tile is not used
@@ -193,8 +226,18 @@ bool TileSupervisor::Load(ReadScriptDescriptor &map_file)
         // For each tile id
         for(uint32_t y = 0; y < _num_tile_on_y_axis; ++y) {
             for(uint32_t x = 0; x < _num_tile_on_x_axis; ++x) {
-                if(_tile_grid[layer_id].tiles[y][x] >= 0)
-                    tile_references[_tile_grid[layer_id].tiles[y][x] ] = 0;
+                int16_t tile_index = _tile_grid[layer_id].tiles[y][x];
+                if(tile_index < 0)
+                    continue;
+
+                // The map files may reference tiles of tilesets they don't load.
+                if(static_cast<uint32_t>(tile_index) >= tile_references.size()) {
+                    PRINT_ERROR << "Invalid tile index: " << tile_index << " at (" << x << ", " << y
+                                << ") in layer: " << layer_id << ", the map only has "
+                                << tile_references.size() << " tiles." << std::endl;
+                    return false;
+                }
+                tile_references[tile_index] = 0;
             }
         }
     }
@@ -221,6 +264,7 @@ bool TileSupervisor::Load(ReadScriptDescriptor &map_file)
         // For each tile id
         for(uint32_t y = 0; y < _num_tile_on_y_axis; ++y) {
             for(uint32_t x = 0; x < _num_tile_on_x_axis; ++x) {
+                // The tile indeces were checked above.
                 if(_tile_grid[layer_id].tiles[y][x] >= 0)
                     _tile_grid[layer_id].tiles[y][x] = tile_references[_tile_grid[layer_id].tiles[y][x] ];
             }
@@ -38,6 +38,8 @@ class MapMode;
 namespace private_map
 {
 
+class MapDataFile;
+
 //! \brief Layer types: Drawn before, along, or after the map objects according to their types.
 enum LAYER_TYPE {
     GROUND_LAYER = 0,
@@ -82,6 +84,9 @@ public:
     **/
     bool Load(vt_script::ReadScriptDescriptor &map_file);
 
+    //! \brief Loads the tilesets and the tile layers from a compiled map data file.
+    bool Load(const MapDataFile &map_data);
+
     //! \brief Updates all animated tile images
     void Update();
 
@@ -121,6 +126,11 @@ private:
     *** _tile_images vector, which contains both still and animated images.
     **/
     std::vector<vt_video::AnimatedImage *> _animated_tile_images;
+
+    /** \brief Loads the tileset images and animations referenced by the tile layers.
+    *** The tile layers indeces are translated into _tile_images indeces.
+    **/
+    bool _LoadTilesets(const std::vector<std::string>& tileset_filenames);
 }; // class TileSupervisor
 
 } // namespace private_map
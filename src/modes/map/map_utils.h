@@ -251,60 +251,57 @@ public:
 
 
 /** ****************************************************************************
-*** \brief A container class for node information in pathfinding.
+*** \brief A collision grid element information in pathfinding.
 ***
-*** This class is used in the MapMode#_FindPath function to find an optimal
-*** path from a given source to a destination. The path finding algorithm
-*** employed is A* and thus many members of this class are particular to the
-*** implementation of that algorithm.
+*** The object supervisor keeps one node per collision grid element, reused from
+*** one search to another: a node is only valid during the search matching its
+*** generation, which avoids clearing the whole grid before each search.
 *** ***************************************************************************/
 class PathNode
 {
 public:
-    /** \brief The grid coordinates for this node
-    *** These coordinates correspond to the collision grid, where each element
-    *** is a 16x16 pixel space on the map.
-    **/
-    int16_t tile_x, tile_y;
-
-    //! \name Path Scoring Members
-    //@{
-    //! \brief The total score for this node (f = g + h).
-    int16_t f_score;
-
-    //! \brief The score for this node relative to the source.
-    int16_t g_score;
-
-    //! \brief The Manhattan distance from this node to the destination.
-    int16_t h_score;
-    //@}
+    PathNode() : generation(0), g_score(0), parent(-1)
+    {}
 
-    //! \brief The grid coordinates for the parent of this node
-    int16_t parent_x, parent_y;
+    //! \brief The search this node was last reached by.
+    uint32_t generation;
 
-    // ---------- Methods
+    //! \brief The score of the best known path from the source to this node.
+    uint32_t g_score;
 
-    PathNode() : tile_x(-1), tile_y(-1), f_score(0), g_score(0), h_score(0), parent_x(0), parent_y(0)
-    {}
+    //! \brief The collision grid index of the node before this one on that path, or -1 for the source.
+    int32_t parent;
+}; // class PathNode
 
-    PathNode(int16_t x_, int16_t y_) : tile_x(x_), tile_y(y_), f_score(0), g_score(0), h_score(0), parent_x(0), parent_y(0)
+/** ****************************************************************************
+*** \brief A node waiting to be explored in pathfinding, kept in a binary heap.
+***
+*** A node whose score is improved is pushed again, the former entry
+*** being skipped once the node has been explored.
+*** ***************************************************************************/
+class PathOpenNode
+{
+public:
+    PathOpenNode(uint32_t index_, uint32_t g_score_, uint32_t h_score_) :
+        index(index_), g_score(g_score_), f_score(g_score_ + h_score_)
     {}
 
-    //! \brief Overloaded comparison operator, only checks that the tile_x and tile_y members are equal
-    bool operator==(const PathNode &that) const {
-        return ((this->tile_x == that.tile_x) && (this->tile_y == that.tile_y));
-    }
+    //! \brief The collision grid index of the node.
+    uint32_t index;
 
-    //! \brief Overloaded comparison operator, only checks that the tile_x or tile_y members are unequal
-    bool operator!=(const PathNode &that) const {
-        return ((this->tile_x != that.tile_x) || (this->tile_y != that.tile_y));
-    }
+    //! \brief The score relative to the source, and the total score (f = g + h).
+    uint32_t g_score;
+    uint32_t f_score;
 
-    //! \brief Overloaded comparison operator only used for path finding, compares the two f_scores
-    bool operator<(const PathNode &that) const {
-        return this->f_score > that.f_score;
+    /** \brief Overloaded comparison operator, making the standard heap functions
+    *** put the node with the lowest f score, then the highest g score, first.
+    **/
+    bool operator<(const PathOpenNode &that) const {
+        if(f_score != that.f_score)
+            return f_score > that.f_score;
+        return g_score < that.g_score;
     }
-}; // class PathNode
+}; // class PathOpenNode
 
 typedef std::vector<vt_common::Position2D> Path;
 
@@ -34,6 +34,29 @@ namespace vt_menu
 namespace private_menu
 {
 
+//! \brief Returns the inventory objects of an equipment category, sorted by id.
+static const std::vector<std::shared_ptr<GlobalObject>>& _GetEquipmentList(int32_t equip_category)
+{
+    ITEM_CATEGORY category = ITEM_WEAPON;
+    switch(equip_category) {
+    case EQUIP_HEAD:
+        category = ITEM_HEAD_ARMOR;
+        break;
+    case EQUIP_TORSO:
+        category = ITEM_TORSO_ARMOR;
+        break;
+    case EQUIP_ARMS:
+        category = ITEM_ARMS_ARMOR;
+        break;
+    case EQUIP_LEGS:
+        category = ITEM_LEGS_ARMOR;
+        break;
+    default:
+        break;
+    }
+    return GlobalManager->GetInventory().GetView(category, INVENTORY_SORT_ID);
+}
+
 EquipWindow::EquipWindow() :
     _active_box(EQUIP_ACTIVE_NONE),
     _character(nullptr)
@@ -254,10 +277,12 @@ void EquipWindow::Update()
             uint32_t id_num = 0;
             // Get the actual inventory index.
             uint32_t inventory_id = _equip_list_inv_index[_equip_list.GetSelection()];
+            const std::vector<std::shared_ptr<GlobalObject>>& equipment_list =
+                _GetEquipmentList(_equip_select.GetSelection());
 
             switch(_equip_select.GetSelection()) {
             case EQUIP_WEAPON: {
-                std::shared_ptr<GlobalWeapon> wpn = GlobalManager->GetInventoryWeapons()->at(inventory_id);
+                std::shared_ptr<GlobalWeapon> wpn = std::static_pointer_cast<GlobalWeapon>(equipment_list.at(inventory_id));
                 if(wpn->GetUsableBy() & _character->GetID()) {
                     id_num = wpn->GetID();
                     GlobalManager->AddToInventory(_character->EquipWeapon(std::dynamic_pointer_cast<GlobalWeapon>(GlobalManager->GetGlobalObject(id_num))));
@@ -269,7 +294,7 @@ void EquipWindow::Update()
             }
 
             case EQUIP_HEAD: {
-                std::shared_ptr<GlobalArmor> hlm = GlobalManager->GetInventoryHeadArmors()->at(inventory_id);
+                std::shared_ptr<GlobalArmor> hlm = std::static_pointer_cast<GlobalArmor>(equipment_list.at(inventory_id));
                 if(hlm->GetUsableBy() & _character->GetID()) {
                     id_num = hlm->GetID();
                     GlobalManager->AddToInventory(_character->EquipHeadArmor(std::dynamic_pointer_cast<GlobalArmor>(GlobalManager->GetGlobalObject(id_num))));
@@ -282,7 +307,7 @@ void EquipWindow::Update()
 
             case EQUIP_TORSO: {
                 std::shared_ptr<GlobalArmor> arm =
-                    GlobalManager->GetInventoryTorsoArmors()->at(inventory_id);
+                    std::static_pointer_cast<GlobalArmor>(equipment_list.at(inventory_id));
                 if(arm->GetUsableBy() & _character->GetID()) {
                     id_num = arm->GetID();
                     GlobalManager->AddToInventory(_character->EquipTorsoArmor(std::dynamic_pointer_cast<GlobalArmor>(GlobalManager->GetGlobalObject(id_num))));
@@ -295,7 +320,7 @@ void EquipWindow::Update()
 
             case EQUIP_ARMS: {
                 std::shared_ptr<GlobalArmor> shld =
-                    GlobalManager->GetInventoryArmArmors()->at(inventory_id);
+                    std::static_pointer_cast<GlobalArmor>(equipment_list.at(inventory_id));
                 if(shld->GetUsableBy() & _character->GetID()) {
                     id_num = shld->GetID();
                     GlobalManager->AddToInventory(_character->EquipArmArmor(std::dynamic_pointer_cast<GlobalArmor>(GlobalManager->GetGlobalObject(id_num))));
@@ -308,7 +333,7 @@ void EquipWindow::Update()
 
             case EQUIP_LEGS: {
                 std::shared_ptr<GlobalArmor> lgs =
-                    GlobalManager->GetInventoryLegArmors()->at(inventory_id);
+                    std::static_pointer_cast<GlobalArmor>(equipment_list.at(inventory_id));
                 if(lgs->GetUsableBy() & _character->GetID()) {
                     id_num = lgs->GetID();
                     GlobalManager->AddToInventory(_character->EquipLegArmor(std::dynamic_pointer_cast<GlobalArmor>(GlobalManager->GetGlobalObject(id_num))));
@@ -349,28 +374,9 @@ void EquipWindow::_UpdateEquipList()
 
     if(_active_box == EQUIP_ACTIVE_LIST) {
         uint32_t gearsize = 0;
-        std::vector<std::shared_ptr<GlobalObject>>* equipment_list = nullptr;
-
-        switch(_equip_select.GetSelection()) {
-        case EQUIP_WEAPON:
-            equipment_list = reinterpret_cast<std::vector<std::shared_ptr<GlobalObject>>*>(GlobalManager->GetInventoryWeapons());
-            break;
-        case EQUIP_HEAD:
-            equipment_list = reinterpret_cast<std::vector<std::shared_ptr<GlobalObject>>*>(GlobalManager->GetInventoryHeadArmors());
-            break;
-        case EQUIP_TORSO:
-            equipment_list = reinterpret_cast<std::vector<std::shared_ptr<GlobalObject>>*>(GlobalManager->GetInventoryTorsoArmors());
-            break;
-        case EQUIP_ARMS:
-            equipment_list = reinterpret_cast<std::vector<std::shared_ptr<GlobalObject>>*>(GlobalManager->GetInventoryArmArmors());
-            break;
-        case EQUIP_LEGS:
-            equipment_list = reinterpret_cast<std::vector<std::shared_ptr<GlobalObject>>*>(GlobalManager->GetInventoryLegArmors());
-            break;
-        } // switch
-
-        if (equipment_list != nullptr)
-            gearsize = equipment_list->size();
+        const std::vector<std::shared_ptr<GlobalObject>>& equipment_list =
+            _GetEquipmentList(_equip_select.GetSelection());
+        gearsize = equipment_list.size();
 
         // Clear the replacer ids
         _equip_list_inv_index.clear();
@@ -379,11 +385,11 @@ void EquipWindow::_UpdateEquipList()
             uint32_t usability_bitmask = 0;
             if(_equip_select.GetSelection() == EQUIP_WEAPON) {
                 std::shared_ptr<GlobalWeapon> selected_weapon =
-                    std::dynamic_pointer_cast<GlobalWeapon>(equipment_list->at(j));
+                    std::dynamic_pointer_cast<GlobalWeapon>(equipment_list.at(j));
                 usability_bitmask = selected_weapon->GetUsableBy();
             } else {
                 std::shared_ptr<GlobalArmor> selected_armor =
-                    std::dynamic_pointer_cast<GlobalArmor>(equipment_list->at(j));
+                    std::dynamic_pointer_cast<GlobalArmor>(equipment_list.at(j));
                 usability_bitmask = selected_armor->GetUsableBy();
             }
 
@@ -392,9 +398,9 @@ void EquipWindow::_UpdateEquipList()
                 continue;
 
             options.push_back(MakeUnicodeString("<") +
-                              MakeUnicodeString(equipment_list->at(j)->GetIconImage().GetFilename()) +
+                              MakeUnicodeString(equipment_list.at(j)->GetIconImage().GetFilename()) +
                               MakeUnicodeString("><70>") +
-                              equipment_list->at(j)->GetName());
+                              equipment_list.at(j)->GetName());
 
             // Add the actual inventory index
             _equip_list_inv_index.push_back(j);
@@ -501,30 +507,13 @@ void EquipWindow::_UpdateSelectedObject()
             return;
             break;
 
-        case EQUIP_WEAPON: {
-            _object = GlobalManager->GetInventoryWeapons()->at(inventory_id);
-            break;
-        }
-
-        case EQUIP_HEAD: {
-            _object = GlobalManager->GetInventoryHeadArmors()->at(inventory_id);
-            break;
-        }
-
-        case EQUIP_TORSO: {
-            _object = GlobalManager->GetInventoryTorsoArmors()->at(inventory_id);
-            break;
-        }
-
-        case EQUIP_ARMS: {
-            _object = GlobalManager->GetInventoryArmArmors()->at(inventory_id);
-            break;
-        }
-
-        case EQUIP_LEGS: {
-            _object = GlobalManager->GetInventoryLegArmors()->at(inventory_id);
+        case EQUIP_WEAPON:
+        case EQUIP_HEAD:
+        case EQUIP_TORSO:
+        case EQUIP_ARMS:
+        case EQUIP_LEGS:
+            _object = _GetEquipmentList(_equip_select.GetSelection()).at(inventory_id);
             break;
-        }
     }
 
     // We now update equipment info
@@ -43,6 +43,8 @@ InventoryWindow::InventoryWindow(MenuMode* mm) :
     _menu_mode(mm),
     _active_box(ITEM_ACTIVE_NONE),
     _previous_category(ITEM_ALL),
+    _item_objects_category(ITEM_ALL),
+    _item_objects_revision(0),
     _object(nullptr),
     _object_type(vt_global::GLOBAL_OBJECT_INVALID),
     _character(nullptr),
@@ -157,13 +159,9 @@ void InventoryWindow::_InitCategory()
 
 void InventoryWindow::_UpdateCategory()
 {
-    _item_categories.EnableOption(1, !(GlobalManager->GetInventoryItems()->empty()));
-    _item_categories.EnableOption(2, !(GlobalManager->GetInventoryWeapons()->empty()));
-    _item_categories.EnableOption(3, !(GlobalManager->GetInventoryHeadArmors()->empty()));
-    _item_categories.EnableOption(4, !(GlobalManager->GetInventoryTorsoArmors()->empty()));
-    _item_categories.EnableOption(5, !(GlobalManager->GetInventoryArmArmors()->empty()));
-    _item_categories.EnableOption(6, !(GlobalManager->GetInventoryLegArmors()->empty()));
-    _item_categories.EnableOption(7, !(GlobalManager->GetInventoryKeyItems()->empty()));
+    const GlobalInventory& inventory = GlobalManager->GetInventory();
+    for (uint32_t i = ITEM_ITEM; i < ITEM_CATEGORY_SIZE; ++i)
+        _item_categories.EnableOption(i, !inventory.IsEmpty(static_cast<ITEM_CATEGORY>(i)));
 }
 
 void InventoryWindow::Activate(bool new_status)
@@ -186,7 +184,7 @@ void InventoryWindow::Update()
 {
     GlobalMedia& media = GlobalManager->Media();
 
-    if(GlobalManager->GetInventory()->empty()) {
+    if(GlobalManager->GetInventory().IsEmpty()) {
         // no more items in inventory, exit inventory window
         Activate(false);
         return;
@@ -603,57 +601,22 @@ void InventoryWindow::_UpdateSelection()
 
 void InventoryWindow::_UpdateItemText()
 {
-    _item_objects.clear();
-    _inventory_items.ClearOptions();
-
     ITEM_CATEGORY current_selected_category =
         static_cast<ITEM_CATEGORY>(_item_categories.GetSelection());
-    switch(current_selected_category) {
-        case ITEM_ALL: {
-            auto inv = GlobalManager->GetInventory();
-            for (auto it = inv->begin(); it != inv->end(); ++it) {
-                _item_objects.push_back(it->second);
-            }
-            break;
-        }
-        case ITEM_ITEM:
-            _item_objects =
-                _GetObjectVector(GlobalManager->GetInventoryItems());
-            break;
-
-        case ITEM_WEAPON:
-            _item_objects =
-                _GetObjectVector(GlobalManager->GetInventoryWeapons());
-            break;
-
-        case ITEM_HEAD_ARMOR:
-            _item_objects =
-                _GetObjectVector(GlobalManager->GetInventoryHeadArmors());
-            break;
-
-        case ITEM_TORSO_ARMOR:
-            _item_objects =
-                _GetObjectVector(GlobalManager->GetInventoryTorsoArmors());
-            break;
 
-        case ITEM_ARMS_ARMOR:
-            _item_objects =
-                _GetObjectVector(GlobalManager->GetInventoryArmArmors());
-            break;
-
-        case ITEM_LEGS_ARMOR:
-            _item_objects =
-                _GetObjectVector(GlobalManager->GetInventoryLegArmors());
-            break;
+    // Only rebuild the list when the category content changed since the last time.
+    GlobalInventory& inventory = GlobalManager->GetInventory();
+    if (current_selected_category == _item_objects_category &&
+            inventory.GetRevision(current_selected_category) == _item_objects_revision) {
+        if(_item_objects.empty())
+            _inventory_items.SetCursorState(VIDEO_CURSOR_STATE_HIDDEN);
+        return;
+    }
+    _item_objects_category = current_selected_category;
+    _item_objects_revision = inventory.GetRevision(current_selected_category);
 
-        case ITEM_KEY: {
-            _item_objects =
-                _GetObjectVector(GlobalManager->GetInventoryKeyItems());
-            break;
-        }
-        default:
-            break;
-        }
+    _item_objects = inventory.GetView(current_selected_category, INVENTORY_SORT_ID);
+    _inventory_items.ClearOptions();
 
     // Before we update the current inventory_items option box,
     // if the actual available items WAS zero on the last frame, then we make sure
@@ -723,7 +686,7 @@ void InventoryWindow::_DrawSpecialItemDescription(vt_video::StillImage* special_
 void InventoryWindow::_DrawBottomInfo()
 {
     //if we are out of items, the bottom view should do no work
-    if(GlobalManager->GetInventory()->empty() || _item_objects.empty())
+    if(GlobalManager->GetInventory().IsEmpty() || _item_objects.empty())
         return;
 
     MenuMode* menu = MenuMode::CurrentInstance();
@@ -109,6 +109,10 @@ private:
     //! holds previous category. we were looking at
     vt_global::ITEM_CATEGORY _previous_category;
 
+    //! The category and inventory revision _item_objects was built from.
+    vt_global::ITEM_CATEGORY _item_objects_category;
+    uint32_t _item_objects_revision;
+
     //! The currently selected object
     std::shared_ptr<vt_global::GlobalObject> _object;
 
@@ -151,25 +155,8 @@ private:
 
     void _DrawBottomInfo();
 
-    template <class T> std::vector<std::shared_ptr<vt_global::GlobalObject>> _GetObjectVector(std::vector<std::shared_ptr<T>>* inv);
-
 };
 
-/*!
-* \brief Converts a vector of std::shared_ptr<GlobalItem>, etc. to a vector of std::shared_ptr<GlobalObject>
-* \return the same vector, with elements of type std::shared_ptr<GlobalObject>
-*/
-template <class T> std::vector<std::shared_ptr<vt_global::GlobalObject>> InventoryWindow::_GetObjectVector(std::vector<std::shared_ptr<T>>* inv)
-{
-    std::vector<std::shared_ptr<vt_global::GlobalObject>> obj_vector;
-
-    for (auto i = inv->begin(); i != inv->end(); i++) {
-        obj_vector.push_back(*i);
-    }
-
-    return obj_vector;
-}
-
 } // namespace private_menu
 
 } // namespace vt_menu
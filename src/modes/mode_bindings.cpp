@@ -101,6 +101,7 @@ void BindModeCode()
             .def("SetRunningEnabled", &MapMode::SetRunningEnabled)
 
             .def("DeleteMapObject", &MapMode::DeleteMapObject)
+            .def("SetMapCollision", &MapMode::SetMapCollision)
 
             .def("SetCamera", (void(MapMode:: *)(private_map::VirtualSprite *))&MapMode::SetCamera)
             .def("SetCamera", (void(MapMode:: *)(private_map::VirtualSprite *, uint32_t))&MapMode::SetCamera)
@@ -138,6 +139,7 @@ void BindModeCode()
             .def("SetAllEnemyStatesToDead", &MapMode::SetAllEnemyStatesToDead)
             .def("SetAutoSaveEnabled", &MapMode::SetAutoSaveEnabled)
             .def("GetAutoSaveEnabled", &MapMode::GetAutoSaveEnabled)
+            .def("DEBUG_BenchmarkCollisions", &MapMode::DEBUG_BenchmarkCollisions)
 
             // Namespace constants
             .enum_("constants") [
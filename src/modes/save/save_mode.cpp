@@ -54,6 +54,7 @@ const uint8_t SAVE_MODE_SAVE_COMPLETE    = 4;
 const uint8_t SAVE_MODE_SAVE_FAILED      = 5;
 const uint8_t SAVE_MODE_FADING_OUT       = 6;
 const uint8_t SAVE_MODE_NO_VALID_SAVES   = 7;
+const uint8_t SAVE_MODE_WRITING_SAVE     = 8;
 //@}
 
 const uint32_t CHARACTERS_SHOWN_SLOTS = 4;
@@ -64,7 +65,8 @@ SaveMode::SaveMode(bool save_mode, uint32_t x_position, uint32_t y_position) :
     _dim_color(0.35f, 0.35f, 0.35f, 1.0f), // A grayish opaque color
     _x_position(x_position),
     _y_position(y_position),
-    _save_mode(save_mode)
+    _save_mode(save_mode),
+    _writing_slot_id(0)
 {
     _window.Create(600.0f, 500.0f);
     _window.SetPosition(212.0f, 138.0f);
@@ -161,6 +163,14 @@ SaveMode::SaveMode(bool save_mode, uint32_t x_position, uint32_t y_position) :
     _save_failure_message.SetTextAlignment(VIDEO_X_CENTER, VIDEO_Y_BOTTOM);
     _save_failure_message.SetDisplayText(UTranslate("Unable to save game!\nSave FAILED!"));
 
+    // Initialize the save writing message box
+    _save_writing_message.SetPosition(centered_text_xpos, 314.0f);
+    _save_writing_message.SetDimensions(centered_text_width, 100.0f);
+    _save_writing_message.SetTextStyle(TextStyle("title22"));
+    _save_writing_message.SetAlignment(VIDEO_X_LEFT, VIDEO_Y_CENTER);
+    _save_writing_message.SetTextAlignment(VIDEO_X_CENTER, VIDEO_Y_BOTTOM);
+    _save_writing_message.SetDisplayText(UTranslate("Saving..."));
+
     _no_valid_saves_message.SetPosition(centered_text_xpos, 314.0f);
     _no_valid_saves_message.SetDimensions(centered_text_width, 100.0f);
     _no_valid_saves_message.SetTextStyle(TextStyle("title22"));
@@ -195,6 +205,9 @@ SaveMode::SaveMode(bool save_mode, uint32_t x_position, uint32_t y_position) :
     _drunes_icon = vt_global::GlobalManager->Media().GetDrunesIcon();
     _drunes_icon->SetWidthKeepRatio(30.0f);
 
+    // Let a previous autosave finish, so that the previews are up to date.
+    GlobalManager->WaitForSaveGame();
+
     if(_save_mode) {
         for (uint32_t i = 0; i < SystemManager->GetGameSaveSlots(); ++i) {
             _file_list.AddOption(MakeUnicodeString(VTranslate("Slot %d", i + 1)));
@@ -211,7 +224,7 @@ SaveMode::SaveMode(bool save_mode, uint32_t x_position, uint32_t y_position) :
 
     // Load the first slot data
     if(_file_list.GetSelection() > -1)
-        _PreviewGame(_BuildSaveFilename(_file_list.GetSelection()));
+        _PreviewGame(_file_list.GetSelection());
 }
 
 SaveMode::~SaveMode()
@@ -251,6 +264,13 @@ void SaveMode::Update()
         return;
     }
 
+    // The saved game file is being written in the background.
+    if(_current_state == SAVE_MODE_WRITING_SAVE) {
+        if(!GlobalManager->IsSavingGame())
+            _FinishSave(_writing_slot_id, GlobalManager->WaitForSaveGame());
+        return;
+    }
+
     _file_list.Update();
     _confirm_save_optionbox.Update();
     _load_auto_save_optionbox.Update();
@@ -270,19 +290,17 @@ void SaveMode::Update()
         case SAVE_MODE_CONFIRMING_SAVE:
             if(_confirm_save_optionbox.GetSelection() == 0) {
                 uint32_t id = static_cast<uint32_t>(_file_list.GetSelection());
-                uint32_t stamina = MapMode::CurrentInstance() ?
-                                   MapMode::CurrentInstance()->GetStamina() : 0;
-                GlobalManager->SetSaveStamina(stamina);
-
-                // Attempt to save the game
-                if(GlobalManager->SaveGame(_BuildSaveFilename(id), id, _x_position, _y_position)) {
-                    _current_state = SAVE_MODE_SAVE_COMPLETE;
-                    AudioManager->PlaySound("data/sounds/save_successful_nick_bowler_oga.wav");
-                    // Remove the autosave in that case.
-                    _DeleteAutoSave(id);
+                MapMode* map_mode = MapMode::CurrentInstance();
+                GlobalManager->SetSaveStamina(map_mode ? map_mode->GetStamina() : 0);
+                if (map_mode)
+                    GlobalManager->SetSaveLocation(map_mode->GetMapName(), map_mode->GetMapImage().GetFilename());
+
+                // Attempt to save the game. The file is then written in the background.
+                if(GlobalManager->SaveGame(GetSaveFilename(id), id, _x_position, _y_position)) {
+                    _writing_slot_id = id;
+                    _current_state = SAVE_MODE_WRITING_SAVE;
                 } else {
-                    _current_state = SAVE_MODE_SAVE_FAILED;
-                    AudioManager->PlaySound("data/sounds/cancel.wav");
+                    _FinishSave(id, false);
                 }
             } else {
                 _current_state = SAVE_MODE_SAVING;
@@ -292,15 +310,15 @@ void SaveMode::Update()
         case SAVE_MODE_SAVE_COMPLETE:
         case SAVE_MODE_SAVE_FAILED:
             _current_state = SAVE_MODE_SAVING;
-            _PreviewGame(_BuildSaveFilename(_file_list.GetSelection()));
+            _PreviewGame(_file_list.GetSelection());
             break;
         case SAVE_MODE_CONFIRM_AUTOSAVE:
             switch (_load_auto_save_optionbox.GetSelection()) {
             case 0: // Load autosave
-                _LoadGame(_BuildSaveFilename(_file_list.GetSelection(), true));
+                _LoadGame(_GetSavePreview(_file_list.GetSelection(), true).filename);
                 break;
             case 1: // Load save
-                _LoadGame(_BuildSaveFilename(_file_list.GetSelection()));
+                _LoadGame(_GetSavePreview(_file_list.GetSelection()).filename);
                 break;
             case 2: // Cancel
             default:
@@ -315,7 +333,7 @@ void SaveMode::Update()
                     _current_state = SAVE_MODE_CONFIRM_AUTOSAVE;
                 }
                 else {
-                    _LoadGame(_BuildSaveFilename(id));
+                    _LoadGame(_GetSavePreview(id).filename);
                 }
             } else {
                 // Leave right away where there is nothing else
@@ -342,11 +360,11 @@ void SaveMode::Update()
             break;
         case SAVE_MODE_CONFIRM_AUTOSAVE:
             _current_state = SAVE_MODE_LOADING;
-            _PreviewGame(_BuildSaveFilename(_file_list.GetSelection()));
+            _PreviewGame(_file_list.GetSelection());
             break;
         case SAVE_MODE_CONFIRMING_SAVE:
             _current_state = SAVE_MODE_SAVING;
-            _PreviewGame(_BuildSaveFilename(_file_list.GetSelection()));
+            _PreviewGame(_file_list.GetSelection());
             break;
         }
     }
@@ -357,7 +375,7 @@ void SaveMode::Update()
         case SAVE_MODE_LOADING:
             _file_list.InputUp();
             if(_file_list.GetSelection() > -1) {
-                _PreviewGame(_BuildSaveFilename(_file_list.GetSelection()));
+                _PreviewGame(_file_list.GetSelection());
             } else {
                 _ClearSaveData(false);
             }
@@ -378,7 +396,7 @@ void SaveMode::Update()
         case SAVE_MODE_LOADING:
             _file_list.InputDown();
             if(_file_list.GetSelection() > -1) {
-                _PreviewGame(_BuildSaveFilename(_file_list.GetSelection()));
+                _PreviewGame(_file_list.GetSelection());
             }
             else {
                 _ClearSaveData(false);
@@ -450,6 +468,9 @@ void SaveMode::DrawPostEffects()
     case SAVE_MODE_SAVE_FAILED:
         _save_failure_message.Draw();
         break;
+    case SAVE_MODE_WRITING_SAVE:
+        _save_writing_message.Draw();
+        break;
     case SAVE_MODE_NO_VALID_SAVES:
         _no_valid_saves_message.Draw();
         break;
@@ -462,6 +483,27 @@ void SaveMode::DrawPostEffects()
     }
 }
 
+void SaveMode::_FinishSave(uint32_t slot_id, bool saved)
+{
+    if(!saved) {
+        _current_state = SAVE_MODE_SAVE_FAILED;
+        AudioManager->PlaySound("data/sounds/cancel.wav");
+        return;
+    }
+
+    _current_state = SAVE_MODE_SAVE_COMPLETE;
+    AudioManager->PlaySound("data/sounds/save_successful_nick_bowler_oga.wav");
+    // Remove the autosave in that case.
+    _DeleteAutoSave(slot_id);
+
+    // The former Lua save of the slot is replaced by the new one.
+    std::string legacy_filename = GetLegacySaveFilename(slot_id);
+    if (vt_utils::DoesFileExist(legacy_filename))
+        vt_utils::DeleteFile(legacy_filename);
+
+    _ForgetSavePreviews(slot_id);
+}
+
 bool SaveMode::_LoadGame(const std::string& filename)
 {
     if(DoesFileExist(filename)) {
@@ -512,29 +554,174 @@ void SaveMode::_ClearSaveData(bool selected_file_exists)
         _character_window[i].SetCharacter(nullptr);
 }
 
+//! \brief Returns the name of a character in the current language, or an empty string if unknown.
+static ustring _GetCharacterName(uint32_t character_id)
+{
+    ReadScriptDescriptor& characters_script = GlobalManager->GetCharactersScript();
+    if (!characters_script.OpenTable(character_id))
+        return ustring();
+
+    ustring name = MakeUnicodeString(characters_script.ReadString("name"));
+    characters_script.CloseTable();
+    return name;
+}
+
+//! \brief Fills a character preview from a character loaded from a save file.
+static void _SetCharacterPreview(GlobalCharacter& character, private_save::SaveCharacterPreview& preview)
+{
+    preview.id = character.GetID();
+    preview.name = character.GetName();
+    preview.portrait = character.GetPortrait();
+    preview.experience_level = character.GetExperienceLevel();
+    preview.hit_points = character.GetHitPoints();
+    preview.max_hit_points = character.GetMaxHitPoints();
+    preview.skill_points = character.GetSkillPoints();
+    preview.max_skill_points = character.GetMaxSkillPoints();
+}
+
+const private_save::SavePreview& SaveMode::_GetSavePreview(uint32_t slot_id, bool autosave)
+{
+    std::map<uint32_t, private_save::SavePreview>& previews = autosave ? _autosave_previews : _save_previews;
+    std::map<uint32_t, private_save::SavePreview>::iterator it = previews.find(slot_id);
+    if (it != previews.end())
+        return it->second;
+
+    private_save::SavePreview& preview = previews[slot_id];
+    preview.filename = _BuildSaveFilename(slot_id, autosave);
+    _ReadSavePreview(preview);
+    return preview;
+}
 
-bool SaveMode::_PreviewGame(const std::string& filename)
+void SaveMode::_ForgetSavePreviews(uint32_t slot_id)
+{
+    _save_previews.erase(slot_id);
+    _autosave_previews.erase(slot_id);
+}
+
+void SaveMode::_ReadSavePreview(private_save::SavePreview& preview)
 {
     // Check for the file existence, prevents a useless warning
-    if(!vt_utils::DoesFileExist(filename)) {
-        _ClearSaveData(false);
+    preview.file_exists = vt_utils::DoesFileExist(preview.filename);
+    if (!preview.file_exists)
+        return;
+
+    bool read = IsBinarySaveFile(preview.filename) ?
+                _ReadBinarySavePreview(preview) :
+                _ReadLegacySavePreview(preview);
+
+    // Check whether the map files are available
+    preview.valid = read && !preview.map_data_filename.empty()
+                    && vt_utils::DoesFileExist(preview.map_data_filename)
+                    && vt_utils::DoesFileExist(preview.map_script_filename);
+    if (!preview.valid)
+        preview.characters.clear();
+}
+
+void SaveMode::_LoadLocationImage(private_save::SavePreview& preview, const std::string& map_image_filename)
+{
+    if (map_image_filename.empty()) {
+        preview.location_image.Clear();
+    }
+    else if (preview.location_image.Load(map_image_filename)) {
+        preview.location_image.SetWidthKeepRatio(340.0f);
+    }
+}
+
+bool SaveMode::_ReadBinarySavePreview(private_save::SavePreview& preview)
+{
+    SaveFileReader file;
+    if (!file.OpenFile(preview.filename))
+        return false;
+
+    // Saves written before the preview section existed are read as the game is loaded.
+    if (!file.OpenSection(SAVE_SECTION_PREVIEW))
+        return _ReadBinarySaveData(file, preview);
+
+    preview.map_data_filename = file.ReadString();
+    preview.map_script_filename = file.ReadString();
+    preview.map_name = file.ReadString();
+    std::string map_image_filename = file.ReadString();
+    preview.hours = file.ReadUInt32();
+    preview.minutes = file.ReadUInt32();
+    preview.seconds = file.ReadUInt32();
+    preview.drunes = file.ReadUInt32();
+
+    uint32_t characters_count = file.ReadUInt32();
+    for (uint32_t i = 0; i < characters_count && i < CHARACTERS_SHOWN_SLOTS; ++i) {
+        if (!file.OpenRecord())
+            break;
+
+        private_save::SaveCharacterPreview character;
+        character.id = file.ReadUInt32();
+        character.name = _GetCharacterName(character.id);
+        std::string portrait_filename = file.ReadString();
+        if (!portrait_filename.empty())
+            character.portrait.Load(portrait_filename);
+        character.experience_level = file.ReadUInt32();
+        character.hit_points = file.ReadUInt32();
+        character.max_hit_points = file.ReadUInt32();
+        character.skill_points = file.ReadUInt32();
+        character.max_skill_points = file.ReadUInt32();
+        preview.characters.push_back(character);
+
+        file.CloseRecord();
+    }
+    file.CloseSection();
+
+    _LoadLocationImage(preview, map_image_filename);
+    return !file.IsErrorDetected();
+}
+
+bool SaveMode::_ReadBinarySaveData(SaveFileReader& file, private_save::SavePreview& preview)
+{
+    if (!file.OpenSection(SAVE_SECTION_PLAY))
+        return false;
+
+    preview.map_data_filename = file.ReadString();
+    preview.map_script_filename = file.ReadString();
+    file.ReadUInt32(); // location_x
+    file.ReadUInt32(); // location_y
+    preview.hours = file.ReadUInt32();
+    preview.minutes = file.ReadUInt32();
+    preview.seconds = file.ReadUInt32();
+    preview.drunes = file.ReadUInt32();
+    file.CloseSection();
+
+    if (!file.OpenSection(SAVE_SECTION_CHARACTERS))
         return false;
+
+    // Loads only up to the first four slots (Visible battle characters)
+    uint32_t characters_count = file.ReadUInt32();
+    for (uint32_t i = 0; i < characters_count && i < CHARACTERS_SHOWN_SLOTS; ++i) {
+        if (!file.OpenRecord())
+            break;
+
+        GlobalCharacter character(file.ReadUInt32(), false);
+        if (character.LoadCharacter(file)) {
+            preview.characters.push_back(private_save::SaveCharacterPreview());
+            _SetCharacterPreview(character, preview.characters.back());
+        }
+
+        file.CloseRecord();
     }
+    file.CloseSection();
 
+    return _ReadMapScriptPreview(preview);
+}
+
+bool SaveMode::_ReadLegacySavePreview(private_save::SavePreview& preview)
+{
     ReadScriptDescriptor file;
 
     // Clear out the save data namespace to avoid loading false information
     // when dealing with a save game that has an invalid namespace
     ScriptManager->DropGlobalTable("save_game1");
 
-    if(!file.OpenFile(filename)) {
-        _ClearSaveData(true);
+    if(!file.OpenFile(preview.filename))
         return false;
-    }
 
     if(!file.DoesTableExist("save_game1")) {
         file.CloseFile();
-        _ClearSaveData(true);
         return false;
     }
 
@@ -543,19 +730,19 @@ bool SaveMode::_PreviewGame(const std::string& filename)
 
     // The map file, tested after the save game is closed.
     // DEPRECATED: Old way, will be removed in one release.
-    std::string map_script_filename;
-    std::string map_data_filename;
     if (file.DoesStringExist("map_filename")) {
-        map_script_filename = file.ReadString("map_filename");
-        map_data_filename = file.ReadString("map_filename");
+        preview.map_script_filename = file.ReadString("map_filename");
+        preview.map_data_filename = file.ReadString("map_filename");
     }
     else {
-        map_script_filename = file.ReadString("map_script_filename");
-        map_data_filename = file.ReadString("map_data_filename");
+        preview.map_script_filename = file.ReadString("map_script_filename");
+        preview.map_data_filename = file.ReadString("map_data_filename");
     }
 
     // DEPRECATED: Remove in one release
     // Hack to permit the split of last map data and scripts.
+    std::string& map_data_filename = preview.map_data_filename;
+    std::string& map_script_filename = preview.map_script_filename;
     if (!map_script_filename.empty() && map_data_filename == map_script_filename) {
         std::string map_common_name = map_data_filename.substr(0, map_data_filename.length() - 4);
         map_data_filename = map_common_name + "_map.lua";
@@ -569,24 +756,15 @@ bool SaveMode::_PreviewGame(const std::string& filename)
     if (map_script_filename.substr(0, 9) == "dat/maps/")
         map_script_filename = std::string("data/story/") + map_script_filename.substr(9, map_script_filename.length() - 9);
 
-    // Check whether the map data file is available
-    if (map_data_filename.empty() || !vt_utils::DoesFileExist(map_data_filename)) {
-        file.CloseTable(); // save_game1
-        file.CloseFile();
-        _ClearSaveData(true);
-        return false;
-    }
-
     // Used to store temp data to populate text boxes
-    int32_t hours = file.ReadInt("play_hours");
-    int32_t minutes = file.ReadInt("play_minutes");
-    int32_t seconds = file.ReadInt("play_seconds");
-    int32_t drunes = file.ReadInt("drunes");
+    preview.hours = file.ReadInt("play_hours");
+    preview.minutes = file.ReadInt("play_minutes");
+    preview.seconds = file.ReadInt("play_seconds");
+    preview.drunes = file.ReadInt("drunes");
 
     if(!file.DoesTableExist("characters")) {
         file.CloseTable(); // save_game1
         file.CloseFile();
-        _ClearSaveData(true);
         return false;
     }
 
@@ -594,35 +772,33 @@ bool SaveMode::_PreviewGame(const std::string& filename)
     file.OpenTable("characters");
     std::vector<uint32_t> char_ids;
     file.ReadUIntVector("order", char_ids);
-    // Prereserve characters slots
-    std::vector<GlobalCharacter*> characters;
-    characters.assign(CHARACTERS_SHOWN_SLOTS, nullptr);
 
     // Loads only up to the first four slots (Visible battle characters)
     for(uint32_t i = 0; i < char_ids.size() && i < CHARACTERS_SHOWN_SLOTS; ++i) {
-        // Create a new GlobalCharacter object using the provided id
-        // This loads all of the character's "static" data, such as their name, etc.
-        characters[i] = nullptr;
-
         if(!file.DoesTableExist(char_ids[i]))
             continue;
 
         file.OpenTable(char_ids[i]);
 
-        // Read in all of the character's stats data
-        characters[i] = new GlobalCharacter(char_ids[i], false);
-        characters[i]->SetExperienceLevel(file.ReadUInt("experience_level"));
+        // Create a new GlobalCharacter object using the provided id
+        // This loads all of the character's "static" data, such as their name, etc.
+        // and read in all of the character's stats data
+        GlobalCharacter character(char_ids[i], false);
+        character.SetExperienceLevel(file.ReadUInt("experience_level"));
         // DEPRECATED: Do not read experience_points anymore in one release
         uint32_t total_xp = file.ReadUInt("experience_points");
         if (total_xp == 0) {
             total_xp = file.ReadUInt("total_experience_points");
         }
-        characters[i]->SetTotalExperiencePoints(total_xp);
+        character.SetTotalExperiencePoints(total_xp);
+
+        character.SetMaxHitPoints(file.ReadUInt("max_hit_points"));
+        character.SetHitPoints(file.ReadUInt("hit_points"));
+        character.SetMaxSkillPoints(file.ReadUInt("max_skill_points"));
+        character.SetSkillPoints(file.ReadUInt("skill_points"));
 
-        characters[i]->SetMaxHitPoints(file.ReadUInt("max_hit_points"));
-        characters[i]->SetHitPoints(file.ReadUInt("hit_points"));
-        characters[i]->SetMaxSkillPoints(file.ReadUInt("max_skill_points"));
-        characters[i]->SetSkillPoints(file.ReadUInt("skill_points"));
+        preview.characters.push_back(private_save::SaveCharacterPreview());
+        _SetCharacterPreview(character, preview.characters.back());
 
         file.CloseTable(); // character id
     }
@@ -638,71 +814,72 @@ bool SaveMode::_PreviewGame(const std::string& filename)
     file.CloseTable(); // save_game1
     file.CloseFile();
 
-    for(uint32_t i = 0; i < CHARACTERS_SHOWN_SLOTS; ++i) {
-        _character_window[i].SetCharacter(characters[i]);
-    }
-
-    std::ostringstream time_text;
-    time_text << (hours < 10 ? "0" : "") << static_cast<uint32_t>(hours) << ":";
-    time_text << (minutes < 10 ? "0" : "") << static_cast<uint32_t>(minutes) << ":";
-    time_text << (seconds < 10 ? "0" : "") << static_cast<uint32_t>(seconds);
-    _time_textbox.SetDisplayText(MakeUnicodeString(time_text.str()));
-
-    std::ostringstream drunes_amount;
-    drunes_amount << drunes;
-    _drunes_textbox.SetDisplayText(MakeUnicodeString(drunes_amount.str()));
-
-    // Test the map file
+    return _ReadMapScriptPreview(preview);
+}
 
+bool SaveMode::_ReadMapScriptPreview(private_save::SavePreview& preview)
+{
     // Tests the map file and gets the untranslated map hud name from it.
     ReadScriptDescriptor map_file;
-    if(!map_file.OpenFile(map_script_filename)) {
-        _ClearSaveData(true);
+    if(!map_file.OpenFile(preview.map_script_filename))
         return false;
-    }
 
     if (map_file.OpenTablespace().empty()) {
-        _ClearSaveData(true);
         map_file.CloseFile();
         return false;
     }
 
-    // Read the in-game location of the save
-    std::string map_hud_name = map_file.ReadString("map_name");
-    _map_name_textbox.SetDisplayText(UTranslate(map_hud_name));
+    // Read the in-game location of the save, and its potential image
+    preview.map_name = map_file.ReadString("map_name");
+    _LoadLocationImage(preview, map_file.ReadString("map_image_filename"));
 
-    // Loads the potential location image
-    std::string map_image_filename = map_file.ReadString("map_image_filename");
-    if (map_image_filename.empty()) {
-        _location_image.Clear();
+    map_file.CloseTable(); // Tablespace
+    map_file.CloseFile();
+    return true;
+}
+
+bool SaveMode::_PreviewGame(uint32_t slot_id, bool autosave)
+{
+    const private_save::SavePreview& preview = _GetSavePreview(slot_id, autosave);
+    if (!preview.valid) {
+        _ClearSaveData(preview.file_exists);
+        return false;
     }
-    else {
-        if (_location_image.Load(map_image_filename))
-            _location_image.SetWidthKeepRatio(340.0f);
+
+    for(uint32_t i = 0; i < CHARACTERS_SHOWN_SLOTS; ++i) {
+        _character_window[i].SetCharacter(i < preview.characters.size() ? &preview.characters[i] : nullptr);
     }
 
-    map_file.CloseTable(); // Tablespace
-    map_file.CloseFile();
+    std::ostringstream time_text;
+    time_text << (preview.hours < 10 ? "0" : "") << preview.hours << ":";
+    time_text << (preview.minutes < 10 ? "0" : "") << preview.minutes << ":";
+    time_text << (preview.seconds < 10 ? "0" : "") << preview.seconds;
+    _time_textbox.SetDisplayText(MakeUnicodeString(time_text.str()));
+
+    std::ostringstream drunes_amount;
+    drunes_amount << preview.drunes;
+    _drunes_textbox.SetDisplayText(MakeUnicodeString(drunes_amount.str()));
+
+    // Test for empty strings to never trigger the default gettext msg string
+    _map_name_textbox.SetDisplayText(preview.map_name.empty() ? ustring() : UTranslate(preview.map_name));
+    _location_image = preview.location_image;
 
     return true;
 }
 
 bool SaveMode::_IsAutoSaveValid(uint32_t id)
 {
-    std::string autosave_filename = _BuildSaveFilename(id, true);
-    std::string save_filename = _BuildSaveFilename(id, false);
-    if (!vt_utils::DoesFileExist(autosave_filename) || !vt_utils::DoesFileExist(save_filename))
+    const private_save::SavePreview& autosave = _GetSavePreview(id, true);
+    const private_save::SavePreview& save = _GetSavePreview(id);
+    if (!autosave.file_exists || !save.file_exists)
         return false;
 
     // Check whether the autosave is strictly more recent than the save.
-    if (vt_utils::GetFileModTime(autosave_filename) <= vt_utils::GetFileModTime(_BuildSaveFilename(id)))
+    if (vt_utils::GetFileModTime(autosave.filename) <= vt_utils::GetFileModTime(save.filename))
         return false;
 
     // And check whether the autosave is valid.
-    if (!_PreviewGame(autosave_filename))
-        return false;
-
-    return true;
+    return autosave.valid;
 }
 
 void SaveMode::_InitSaveSlots()
@@ -723,7 +900,7 @@ void SaveMode::_InitSaveSlots()
             _file_list.AddOptionElementPosition(i, 30);
         }
 
-        if (!_PreviewGame(_BuildSaveFilename(i))) {
+        if (!_GetSavePreview(i).valid) {
             _file_list.EnableOption(i, false);
 
             // If the current selection is disabled, reset it.
@@ -741,59 +918,52 @@ void SaveMode::_InitSaveSlots()
 
 std::string SaveMode::_BuildSaveFilename(uint32_t id, bool autosave)
 {
-    std::ostringstream file;
-    file << GetUserDataPath() + "saved_game_" << id;
-    if (autosave)
-        file << "_autosave.lua";
-    else
-        file << ".lua";
-    return file.str();
+    return FindSaveFilename(id, autosave);
 }
 
 void SaveMode::_DeleteAutoSave(uint32_t id)
 {
-    std::string filename = _BuildSaveFilename(id, true);
-    vt_utils::DeleteFile(filename);
+    std::string filename = GetSaveFilename(id, true);
+    if (vt_utils::DoesFileExist(filename))
+        vt_utils::DeleteFile(filename);
+
+    filename = GetLegacySaveFilename(id, true);
+    if (vt_utils::DoesFileExist(filename))
+        vt_utils::DeleteFile(filename);
+
+    _autosave_previews.erase(id);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 // SmallCharacterWindow Class
 ////////////////////////////////////////////////////////////////////////////////
 
-SmallCharacterWindow::~SmallCharacterWindow()
-{
-    delete _character;
-}
-
-void SmallCharacterWindow::SetCharacter(GlobalCharacter* character)
+void SmallCharacterWindow::SetCharacter(const private_save::SaveCharacterPreview* character)
 {
-    delete _character;
-    _character = character;
-
-    if(!_character || _character->GetID() == vt_global::GLOBAL_CHARACTER_INVALID) {
+    if(!character || character->id == vt_global::GLOBAL_CHARACTER_INVALID) {
         _character_name.Clear();
         _character_data.Clear();
         _portrait = StillImage();
         return;
     }
 
-    _portrait = character->GetPortrait();
+    _portrait = character->portrait;
     // Only size up valid portraits
     if(!_portrait.GetFilename().empty())
         _portrait.SetDimensions(100.0f, 100.0f);
 
     // the characters' name is already translated.
-    _character_name.SetText(_character->GetName(), TextStyle("title22"));
+    _character_name.SetText(character->name, TextStyle("title22"));
 
     // And the rest of the data
     /// tr: level
-    ustring char_data = UTranslate("Lv: ") + MakeUnicodeString(NumberToString(_character->GetExperienceLevel()) + "\n");
+    ustring char_data = UTranslate("Lv: ") + MakeUnicodeString(NumberToString(character->experience_level) + "\n");
     /// tr: hit points
-    char_data += UTranslate("HP: ") + MakeUnicodeString(NumberToString(_character->GetHitPoints()) +
-                               " / " + NumberToString(_character->GetMaxHitPoints()) + "\n");
+    char_data += UTranslate("HP: ") + MakeUnicodeString(NumberToString(character->hit_points) +
+                               " / " + NumberToString(character->max_hit_points) + "\n");
     /// tr: skill points
-    char_data += UTranslate("SP: ") + MakeUnicodeString(NumberToString(_character->GetSkillPoints()) +
-                               " / " + NumberToString(_character->GetMaxSkillPoints()));
+    char_data += UTranslate("SP: ") + MakeUnicodeString(NumberToString(character->skill_points) +
+                               " / " + NumberToString(character->max_skill_points));
 
     _character_data.SetText(char_data, TextStyle("text20"));
 }
@@ -26,8 +26,12 @@
 #include "common/gui/textbox.h"
 #include "common/gui/option.h"
 
+#include "common/global/global_utils.h"
+
+#include <map>
+
 namespace vt_global {
-class GlobalCharacter;
+class SaveFileReader;
 }
 
 //! \brief All calls to save mode are wrapped in this namespace.
@@ -37,6 +41,72 @@ namespace vt_save
 //! \brief Determines whether the code in the vt_save namespace should print debug statements or not.
 extern bool SAVE_DEBUG;
 
+namespace private_save
+{
+
+//! \brief The character data shown when a save slot is selected.
+struct SaveCharacterPreview {
+    SaveCharacterPreview():
+        id(vt_global::GLOBAL_CHARACTER_INVALID),
+        experience_level(0),
+        hit_points(0),
+        max_hit_points(0),
+        skill_points(0),
+        max_skill_points(0)
+    {}
+
+    uint32_t id;
+
+    //! \brief The character name, in the current language.
+    vt_utils::ustring name;
+
+    vt_video::StillImage portrait;
+
+    uint32_t experience_level;
+    uint32_t hit_points;
+    uint32_t max_hit_points;
+    uint32_t skill_points;
+    uint32_t max_skill_points;
+};
+
+/** \brief The save data shown when a save slot is selected.
+*** It is read once per save file, and kept until the slot is saved again.
+**/
+struct SavePreview {
+    SavePreview():
+        file_exists(false),
+        valid(false),
+        hours(0),
+        minutes(0),
+        seconds(0),
+        drunes(0)
+    {}
+
+    std::string filename;
+
+    bool file_exists;
+
+    //! \brief Whether the save could be read and its map files exist.
+    bool valid;
+
+    std::string map_data_filename;
+    std::string map_script_filename;
+
+    //! \brief The untranslated map name, translated when shown.
+    std::string map_name;
+    vt_video::StillImage location_image;
+
+    uint32_t hours;
+    uint32_t minutes;
+    uint32_t seconds;
+    uint32_t drunes;
+
+    //! \brief The first visible characters.
+    std::vector<SaveCharacterPreview> characters;
+};
+
+} // namespace private_save
+
 /** ****************************************************************************
 *** \brief Represents an individual character window
 ***
@@ -47,16 +117,13 @@ extern bool SAVE_DEBUG;
 class SmallCharacterWindow : public vt_gui::MenuWindow
 {
 public:
-    SmallCharacterWindow():
-        _character(nullptr)
+    SmallCharacterWindow()
     {}
 
-    ~SmallCharacterWindow();
-
     /** \brief Set the character for this window
-    *** \param character the character to associate with this window
+    *** \param character the character to associate with this window, or nullptr to show none.
     **/
-    void SetCharacter(vt_global::GlobalCharacter* characters);
+    void SetCharacter(const private_save::SaveCharacterPreview* character);
 
     /** \brief render this window to the screen
     *** \return success/failure
@@ -64,9 +131,6 @@ public:
     void Draw();
 
 private:
-    //! The name of the character that this window corresponds to.
-    vt_global::GlobalCharacter* _character;
-
     //! The image of the character
     vt_video::StillImage _portrait;
 
@@ -109,8 +173,37 @@ private:
     //! \Returns true on success, false on fail
     bool _LoadGame(const std::string& filename);
 
-    //! \brief Loads preview data for the highlighted game
-    bool _PreviewGame(const std::string& filename);
+    //! \brief Shows the save result, and updates the slot files once its saved game file is written.
+    void _FinishSave(uint32_t slot_id, bool saved);
+
+    //! \brief Shows the preview data of the given slot save, or autosave.
+    bool _PreviewGame(uint32_t slot_id, bool autosave = false);
+
+    /** \brief Returns the preview data of the given slot save, or autosave.
+    *** The save file is only read the first time, the previews being then cached.
+    **/
+    const private_save::SavePreview& _GetSavePreview(uint32_t slot_id, bool autosave = false);
+
+    //! \brief Forgets the cached previews of the given slot, e.g. once it was saved again.
+    void _ForgetSavePreviews(uint32_t slot_id);
+
+    //! \brief Reads the preview data from the preview filename.
+    void _ReadSavePreview(private_save::SavePreview& preview);
+
+    //! \brief Reads the preview data of a binary save file. Returns false if the file is invalid.
+    bool _ReadBinarySavePreview(private_save::SavePreview& preview);
+
+    //! \brief Reads the preview data from the game data of binary saves written without preview section.
+    bool _ReadBinarySaveData(vt_global::SaveFileReader& file, private_save::SavePreview& preview);
+
+    //! \brief Reads the preview data of a former Lua save file. Returns false if the file is invalid.
+    bool _ReadLegacySavePreview(private_save::SavePreview& preview);
+
+    //! \brief Reads the map name and image from the preview map script, for saves without them.
+    bool _ReadMapScriptPreview(private_save::SavePreview& preview);
+
+    //! \brief Loads the location image of a preview, or clears it when there is none.
+    void _LoadLocationImage(private_save::SavePreview& preview, const std::string& map_image_filename);
 
     //! \brief Clears out the data saves. Used especially when the data is invalid.
     //! \param selected_file_exists Tells whether the selected file exists.
@@ -166,6 +259,9 @@ private:
     //! \brief Displays message that game was saved successfully
     vt_gui::TextBox _save_failure_message;
 
+    //! \brief Displays message while the saved game file is being written
+    vt_gui::TextBox _save_writing_message;
+
     //! \brief Tells the user no saves are valid.
     vt_gui::TextBox _no_valid_saves_message;
 
@@ -175,6 +271,10 @@ private:
     vt_gui::TextBox _drunes_textbox;
     vt_video::StillImage _location_image;
 
+    //! \brief The cached save and autosave previews, by slot id.
+    std::map<uint32_t, private_save::SavePreview> _save_previews;
+    std::map<uint32_t, private_save::SavePreview> _autosave_previews;
+
     //! Icon references from Global Media, do not delete those!
     vt_video::StillImage* _clock_icon;
     vt_video::StillImage* _drunes_icon;
@@ -184,6 +284,9 @@ private:
 
     //! \brief Tells whether we're in save or load mode.
     bool _save_mode;
+
+    //! \brief The slot whose saved game file is being written.
+    uint32_t _writing_slot_id;
 }; // class SaveMode : public vt_mode_manager::GameMode
 
 } // namespace vt_save
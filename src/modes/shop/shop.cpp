@@ -1021,6 +1021,8 @@ ShopMode::ShopMode(const std::string& shop_id) :
     GameMode(MODE_MANAGER_SHOP_MODE),
     _shop_id(shop_id),
     _sell_mode_enabled(true),
+    _available_sell_built(false),
+    _available_sell_revision(0),
     _initialized(false),
     _state(SHOP_STATE_ROOT),
     _buy_price_level(SHOP_PRICE_STANDARD),
@@ -1275,6 +1277,12 @@ void ShopMode::Initialize()
 
 void ShopMode::_UpdateAvailableObjectsToSell()
 {
+    // Only rebuild the list when the inventory changed since the last time.
+    GlobalInventory& inventory = GlobalManager->GetInventory();
+    if (_sell_mode_enabled && _available_sell_built
+            && inventory.GetRevision(ITEM_ALL) == _available_sell_revision)
+        return;
+
     // Reinitialize the data.
     for (auto item : _available_sell) {
         assert(item.second != nullptr);
@@ -1284,32 +1292,36 @@ void ShopMode::_UpdateAvailableObjectsToSell()
         }
     }
     _available_sell.clear();
+    _available_sell_built = false;
 
     // If sell mode is disabled, we can return now.
     if (!_sell_mode_enabled)
         return;
 
-    auto inventory = GlobalManager->GetInventory();
-    for (auto it = inventory->begin(); it != inventory->end(); ++it) {
+    _available_sell_built = true;
+    _available_sell_revision = inventory.GetRevision(ITEM_ALL);
+
+    const std::vector<std::shared_ptr<GlobalObject>>& objects = inventory.GetView(ITEM_ALL, INVENTORY_SORT_ID);
+    for (auto it = objects.begin(); it != objects.end(); ++it) {
         // Don't consider 0 worth objects.
-        if (it->second->GetPrice() == 0)
+        if ((*it)->GetPrice() == 0)
             continue;
 
         // Don't show key items either.
-        if (it->second->IsKeyItem())
+        if ((*it)->IsKeyItem())
             continue;
 
         // Check if the object already exists in the shop list and if so, set its ownership count
-        std::map<uint32_t, ShopObject *>::iterator shop_obj_iter = _available_sell.find(it->second->GetID());
+        std::map<uint32_t, ShopObject *>::iterator shop_obj_iter = _available_sell.find((*it)->GetID());
         if (shop_obj_iter != _available_sell.end()) {
-            shop_obj_iter->second->IncrementOwnCount(it->second->GetCount());
+            shop_obj_iter->second->IncrementOwnCount((*it)->GetCount());
         } else {
             // Otherwise, add the shop object to the list.
-            ShopObject *new_shop_object = new ShopObject(it->second);
-            new_shop_object->IncrementOwnCount(it->second->GetCount());
+            ShopObject *new_shop_object = new ShopObject(*it);
+            new_shop_object->IncrementOwnCount((*it)->GetCount());
             new_shop_object->SetPricing(GetBuyPriceLevel(),
                                         GetSellPriceLevel());
-            _available_sell.insert(std::make_pair(it->second->GetID(), new_shop_object));
+            _available_sell.insert(std::make_pair((*it)->GetID(), new_shop_object));
         }
     }
 }
@@ -668,6 +668,10 @@ private:
     //! \brief Tells whether the sell mode is enabled in this shop, thus whether the player can sell items.
     bool _sell_mode_enabled;
 
+    //! \brief Whether _available_sell was built, and from which inventory revision.
+    bool _available_sell_built;
+    uint32_t _available_sell_revision;
+
     //! \brief Set to true only after the shop has been initialized and is ready to be used by the player
     bool _initialized;
 
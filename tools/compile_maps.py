@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+#
+# This code is licensed under the GNU GPL version 2. It is free software
+# and you may modify it and/or redistribute it under the terms of this license.
+# See https://www.gnu.org/copyleft/gpl.html for details.
+
+"""Compiles the map data Lua files into the binary map data format.
+
+The format is described in src/modes/map/map_data_file.h. Each xxx_map.lua file
+gets a xxx_map.vtmap file next to it, used by the game as long as the Lua file
+isn't modified.
+Usage, from the game folder: tools/compile_maps.py [--compress] [data or map files]
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+MAP_DATA_MAGIC = b"VTMP"
+MAP_DATA_VERSION = 1
+MAP_DATA_COMPRESSED = 0x1
+MAP_DATA_EXTENSION = ".vtmap"
+
+# The LAYER_TYPE values.
+LAYER_TYPES = {"ground": 0, "sky": 1}
+
+NUMBER_LINE = re.compile(r'^map_data\.(num_tile_cols|num_tile_rows)\s*=\s*(\d+)$')
+TILESET_LINE = re.compile(r'^map_data\.tileset_filenames\[(\d+)\]\s*=\s*"([^"]*)"$')
+GRID_LINE = re.compile(r'^map_data\.map_grid\[(\d+)\]\s*=\s*\{([^}]*)\}$')
+LAYER_TYPE_LINE = re.compile(r'^map_data\.layers\[(\d+)\]\.type\s*=\s*"([^"]*)"$')
+LAYER_ROW_LINE = re.compile(r'^map_data\.layers\[(\d+)\]\[(\d+)\]\s*=\s*\{([^}]*)\}$')
+# Lines not needed by the game.
+IGNORED_LINE = re.compile(r'^(--.*|map_data(\.\w+(\[\d+\])?)?\s*=\s*\{\s*\}|map_data\.layers\[\d+\]\.name\s*=\s*".*")?$')
+
+
+class MapDataError(Exception):
+    pass
+
+
+def fnv1a_64(data):
+    """The hash used by vt_system::ComputeHash()."""
+    value = 14695981039346656037
+    for byte in data:
+        value ^= byte
+        value = (value * 1099511628211) & 0xFFFFFFFFFFFFFFFF
+    return value
+
+
+def parse_numbers(text):
+    return [int(value) for value in text.replace(" ", "").split(",") if value]
+
+
+def parse_map_data(source):
+    """Reads the map data written by the map editor, line by line."""
+    numbers = {}
+    tilesets = {}
+    grid = {}
+    layer_types = {}
+    layers = {}
+
+    for line_number, line in enumerate(source.decode("utf-8").splitlines(), 1):
+        line = line.strip()
+        match = NUMBER_LINE.match(line)
+        if match:
+            numbers[match.group(1)] = int(match.group(2))
+            continue
+        match = TILESET_LINE.match(line)
+        if match:
+            tilesets[int(match.group(1))] = match.group(2)
+            continue
+        match = GRID_LINE.match(line)
+        if match:
+            grid[int(match.group(1))] = parse_numbers(match.group(2))
+            continue
+        match = LAYER_TYPE_LINE.match(line)
+        if match:
+            if match.group(2) not in LAYER_TYPES:
+                raise MapDataError("invalid layer type '%s', line %d" % (match.group(2), line_number))
+            layer_types[int(match.group(1))] = LAYER_TYPES[match.group(2)]
+            continue
+        match = LAYER_ROW_LINE.match(line)
+        if match:
+            layers.setdefault(int(match.group(1)), {})[int(match.group(2))] = parse_numbers(match.group(3))
+            continue
+        if not IGNORED_LINE.match(line):
+            raise MapDataError("unhandled line %d: %s" % (line_number, line[:60]))
+
+    if "num_tile_cols" not in numbers or "num_tile_rows" not in numbers:
+        raise MapDataError("missing map dimensions")
+    cols = numbers["num_tile_cols"]
+    rows = numbers["num_tile_rows"]
+
+    # The Lua tables are read by the game in index order: tilesets from 1, the rest from 0.
+    tileset_list = [tilesets[i] for i in range(1, len(tilesets) + 1)] if tilesets else []
+    if len(tileset_list) != len(tilesets):
+        raise MapDataError("non contiguous tileset filenames")
+
+    if not grid:
+        raise MapDataError("no map grid")
+    grid_rows = [grid[y] for y in range(len(grid))]
+    grid_cols = len(grid_rows[0])
+    for row in grid_rows:
+        if len(row) != grid_cols or any(value not in (0, 1) for value in row):
+            raise MapDataError("the map grid must be rectangular and only contain 0 or 1")
+
+    layer_list = []
+    for layer_id in range(len(layer_types)):
+        if layer_id not in layer_types:
+            raise MapDataError("non contiguous layers")
+        tiles = layers.get(layer_id, {})
+        if len(tiles) != rows or any(len(tiles.get(y, [])) != cols for y in range(rows)):
+            raise MapDataError("layer %d doesn't match the map dimensions" % layer_id)
+        layer_list.append((layer_types[layer_id], [tiles[y] for y in range(rows)]))
+
+    return cols, rows, tileset_list, grid_cols, grid_rows, layer_list
+
+
+def pad(data):
+    return data + b"\0" * (-len(data) % 4)
+
+
+def compile_map(lua_filename, compress):
+    with open(lua_filename, "rb") as f:
+        source = f.read()
+
+    cols, rows, tilesets, grid_cols, grid_rows, layers = parse_map_data(source)
+
+    body = bytearray()
+    for tileset in tilesets:
+        encoded = tileset.encode("utf-8")
+        body += struct.pack("<H", len(encoded)) + encoded
+    body = pad(body)
+
+    row_size = (grid_cols + 7) // 8
+    for row in grid_rows:
+        bits = bytearray(row_size)
+        for x, value in enumerate(row):
+            if value:
+                bits[x >> 3] |= 1 << (x & 7)
+        body += bits
+    body = pad(body)
+
+    for layer_type, tiles in layers:
+        body += struct.pack("<I", layer_type)
+        for row in tiles:
+            body += struct.pack("<%dh" % cols, *row)
+        body = pad(body)
+
+    body = bytes(body)
+    flags = 0
+    stored = body
+    if compress:
+        compressed = zlib.compress(body, 9)
+        if len(compressed) < len(body):
+            stored = compressed
+            flags |= MAP_DATA_COMPRESSED
+
+    header = MAP_DATA_MAGIC + struct.pack("<IIIQHHHHIIII", MAP_DATA_VERSION, flags,
+                                          len(source), fnv1a_64(source),
+                                          cols, rows, grid_cols, len(grid_rows),
+                                          len(tilesets), len(layers), len(stored), len(body))
+
+    output = os.path.splitext(lua_filename)[0] + MAP_DATA_EXTENSION
+    with open(output, "wb") as f:
+        f.write(header)
+        f.write(stored)
+    return len(source), len(header) + len(stored)
+
+
+def list_map_files(paths):
+    files = []
+    for path in paths:
+        if os.path.isdir(path):
+            for root, dirs, names in os.walk(path):
+                dirs.sort()
+                files.extend(os.path.join(root, name) for name in sorted(names) if name.endswith("_map.lua"))
+        else:
+            files.append(path)
+    return files
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("paths", nargs="*", default=["data"],
+                        help="the map data files, or the folders to search for *_map.lua files (default: data)")
+    parser.add_argument("--compress", action="store_true",
+                        help="compress the map data, which then can't be read in place")
+    args = parser.parse_args()
+
+    errors = 0
+    source_size = 0
+    compiled_size = 0
+    files = list_map_files(args.paths)
+    for filename in files:
+        try:
+            sizes = compile_map(filename, args.compress)
+            source_size += sizes[0]
+            compiled_size += sizes[1]
+        except (MapDataError, IOError) as error:
+            sys.stderr.write("%s: %s\n" % (filename, error))
+            errors += 1
+
+    print("Compiled %d of %d map files (%d KiB -> %d KiB)"
+          % (len(files) - errors, len(files), source_size // 1024, compiled_size // 1024))
+    return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2012-2017 by Bertram (Valyria Tear)
+#
+# This code is licensed under the GNU GPL version 2. It is free software
+# and you may modify it and/or redistribute it under the terms of this license.
+# See https://www.gnu.org/copyleft/gpl.html for details.
+
+"""Packs the game data files into a single archive read by the virtual file system.
+
+The archive format is described in src/engine/virtual_file_system.h.
+The Lua scripts aren't packed: they are opened by the script descriptors of
+the vt-utils submodule, which read them from the disk. They must be shipped
+loose alongside the archive.
+Usage, from the game folder: tools/pack_data.py [-o data.vtpk] [data]
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+ARCHIVE_MAGIC = b"VTPK"
+ARCHIVE_VERSION = 1
+ARCHIVE_DATA_ALIGNMENT = 16
+ARCHIVE_ENTRY_COMPRESSED = 0x1
+
+# Only the text files are worth compressing. The images, sounds and fonts
+# are kept as is so that they can be read in place from the mapped archive.
+COMPRESSED_EXTENSIONS = (".txt", ".xml", ".json", ".glsl")
+
+# Files not needed by the game, and the scripts which are read from the disk.
+IGNORED_EXTENSIONS = (".xcf", ".psd", ".blend", ".tmx", ".tsx", ".svg", ".pyc", ".lua")
+
+
+def list_files(data_dir):
+    files = []
+    for root, dirs, names in os.walk(data_dir):
+        dirs.sort()
+        for name in sorted(names):
+            if name.startswith(".") or name.lower().endswith(IGNORED_EXTENSIONS):
+                continue
+            files.append(os.path.join(root, name))
+    return files
+
+
+def align(offset):
+    return (offset + ARCHIVE_DATA_ALIGNMENT - 1) // ARCHIVE_DATA_ALIGNMENT * ARCHIVE_DATA_ALIGNMENT
+
+
+def pack(data_dir, root_dir, output, compress):
+    entries = []
+    for filename in list_files(data_dir):
+        with open(filename, "rb") as f:
+            content = f.read()
+
+        flags = 0
+        stored = content
+        if compress and filename.lower().endswith(COMPRESSED_EXTENSIONS):
+            compressed = zlib.compress(content, 9)
+            if len(compressed) < len(content):
+                stored = compressed
+                flags |= ARCHIVE_ENTRY_COMPRESSED
+
+        # The paths are stored the way the game opens them: e.g. data/gui/logo.png
+        path = os.path.relpath(filename, root_dir).replace(os.sep, "/").encode("utf-8")
+        entries.append((path, flags, len(content), stored))
+
+    index_size = sum(22 + len(path) for path, _, _, _ in entries)
+    offset = align(16 + index_size)
+
+    index = bytearray()
+    offsets = []
+    for path, flags, size, stored in entries:
+        offsets.append(offset)
+        index += struct.pack("<QIIIH", offset, len(stored), size, flags, len(path)) + path
+        offset = align(offset + len(stored))
+
+    with open(output, "wb") as f:
+        f.write(ARCHIVE_MAGIC + struct.pack("<III", ARCHIVE_VERSION, len(entries), index_size))
+        f.write(index)
+        for (path, flags, size, stored), entry_offset in zip(entries, offsets):
+            f.write(b"\0" * (entry_offset - f.tell()))
+            f.write(stored)
+
+    total_size = sum(size for _, _, size, _ in entries)
+    print("Packed %d files (%d KiB) into %s (%d KiB)"
+          % (len(entries), total_size // 1024, output, os.path.getsize(output) // 1024))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("data_dir", nargs="?", default="data",
+                        help="the data folder to pack (default: data)")
+    parser.add_argument("-o", "--output", default="data.vtpk",
+                        help="the archive file to write (default: data.vtpk)")
+    parser.add_argument("--root", default=".",
+                        help="the folder the archive paths are relative to (default: .)")
+    parser.add_argument("--no-compression", action="store_true",
+                        help="store every file uncompressed")
+    args = parser.parse_args()
+
+    if not os.path.isdir(args.data_dir):
+        sys.stderr.write("Not a folder: %s\n" % args.data_dir)
+        return 1
+
+    pack(args.data_dir, args.root, args.output, not args.no_compression)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())